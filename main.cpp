@@ -1,7 +1,20 @@
 #include <QApplication>
 #include <QIcon> // <-- 1. INCLUA ISSO
+#include <QCommandLineParser>
+#include <QMessageBox>
 #include "dialogologin.h"
 #include "janelaprincipal.h"
+#include "repositorio.h"
+#include "armazenamentoarquivos.h"
+#include "armazenamentosqlite.h"
+#include "estresseconcorrencia.h"
+#include "compactacaoavaliacoes.h"
+#include "motornotas.h"
+#include "distribuicaoavaliadores.h"
+#include "agendaapresentacoes.h"
+#include "exportacaopdf.h"
+
+#include <QTextStream>
 
 int main(int argc, char *argv[])
 {
@@ -13,6 +26,116 @@ int main(int argc, char *argv[])
     // 3. DEFINA O ÍCONE NA APLICAÇÃO (ISSO AFETA TODAS AS JANELAS)
     a.setWindowIcon(QIcon(caminhoIconeApp));
 
+    // Backend de dados escolhido na linha de comando:
+    //   (padrão)                  arquivos texto no diretório atual
+    //   --sqlite dados.db         banco SQLite
+    //   --sqlite dados.db --importar   copia os arquivos para o banco antes
+    //   --sqlite dados.db --exportar   grava o banco de volta nos arquivos e sai
+    //   --estresse 4 [--gravacoes 100] teste de várias estações na mesma pasta
+    //   --compactar-avaliacoes avaliacoes.csv   tira as linhas repetidas e sai
+    //   --benchmark-notas 1000000   mede o recálculo das notas finais e sai
+    //   --benchmark-distribuicao 10000 [--avaliadores 1000]
+    //                               mede a distribuição automática de avaliadores e sai
+    //   --benchmark-agenda 5000 [--avaliadores 1000]
+    //                               mede a montagem da agenda de apresentações e sai
+    //   --benchmark-pdf 1000        mede a geração dos PDFs em lote (páginas/s) e sai
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption optSqlite("sqlite", "Usa o banco SQLite <arquivo>.", "arquivo");
+    QCommandLineOption optImportar("importar", "Importa os arquivos texto para o banco SQLite.");
+    QCommandLineOption optExportar("exportar", "Exporta o banco SQLite para os arquivos texto e sai.");
+    parser.addOption(optSqlite);
+    parser.addOption(optImportar);
+    QCommandLineOption optEstresse("estresse", "Teste de concorrência com <n> estações.", "n");
+    QCommandLineOption optGravacoes("gravacoes", "Gravações por estação no teste (padrão 100).", "n", "100");
+    QCommandLineOption optEstacao("estacao", "Uso interno do teste de concorrência.", "i");
+    QCommandLineOption optCompactar("compactar-avaliacoes",
+                                    "Mantém só a última avaliação de cada projeto/avaliador/ficha em <arquivo>.",
+                                    "arquivo");
+    parser.addOption(optExportar);
+    parser.addOption(optEstresse);
+    parser.addOption(optGravacoes);
+    parser.addOption(optEstacao);
+    QCommandLineOption optBenchmarkNotas("benchmark-notas",
+                                         "Mede o recálculo de notaFinal em <n> avaliações sintéticas.",
+                                         "n");
+    QCommandLineOption optBenchmarkDistribuicao("benchmark-distribuicao",
+                                                "Mede a distribuição de avaliadores em <n> projetos sintéticos.",
+                                                "n");
+    QCommandLineOption optBenchmarkAgenda("benchmark-agenda",
+                                          "Mede a montagem da agenda com <n> projetos sintéticos.",
+                                          "n");
+    QCommandLineOption optBenchmarkPdf("benchmark-pdf",
+                                       "Mede a geração em lote de <n> PDFs de avaliação.",
+                                       "n");
+    QCommandLineOption optAvaliadores("avaliadores", "Avaliadores nos benchmarks de distribuição e agenda (padrão 1000).",
+                                      "n", "1000");
+    parser.addOption(optCompactar);
+    parser.addOption(optBenchmarkNotas);
+    parser.addOption(optBenchmarkDistribuicao);
+    parser.addOption(optBenchmarkAgenda);
+    parser.addOption(optBenchmarkPdf);
+    parser.addOption(optAvaliadores);
+    parser.process(a);
+
+    if (parser.isSet(optBenchmarkNotas))
+        return executarBenchmarkNotas(parser.value(optBenchmarkNotas).toInt());
+    if (parser.isSet(optBenchmarkDistribuicao))
+        return executarBenchmarkDistribuicao(parser.value(optBenchmarkDistribuicao).toInt(),
+                                             parser.value(optAvaliadores).toInt());
+    if (parser.isSet(optBenchmarkPdf))
+        return executarBenchmarkPdf(parser.value(optBenchmarkPdf).toInt());
+    if (parser.isSet(optBenchmarkAgenda))
+        return executarBenchmarkAgenda(parser.value(optBenchmarkAgenda).toInt(),
+                                       parser.value(optAvaliadores).toInt());
+
+    if (parser.isSet(optCompactar)) {
+        const ResultadoCompactacao r = compactarAvaliacoes(parser.value(optCompactar));
+        QTextStream out(stdout);
+        if (!r.ok) {
+            out << r.erro << "\n";
+            return 1;
+        }
+        out << r.linhasAntes << " -> " << r.linhasDepois << " linhas ("
+            << r.linhasRecuperadas() << " removidas), "
+            << r.bytesRecuperados() << " bytes recuperados\n";
+        return 0;
+    }
+
+    // Dados do sistema: lidos uma única vez e compartilhados pelas telas
+    Repositorio repositorio;
+
+    if (parser.isSet(optEstresse))
+        return executarEstresse(parser.value(optEstresse).toInt(),
+                                parser.value(optGravacoes).toInt());
+    if (parser.isSet(optEstacao))
+        return executarEstacaoEstresse(parser.value(optEstacao).toInt(),
+                                       parser.value(optGravacoes).toInt());
+
+    if (parser.isSet(optSqlite)) {
+        const QString banco = parser.value(optSqlite);
+
+        if (parser.isSet(optExportar)) {
+            ArmazenamentoSqlite origem(banco);
+            ArmazenamentoArquivos destino;
+            return copiarDados(origem, destino) ? 0 : 1;
+        }
+
+        std::unique_ptr<Armazenamento> sqlite(new ArmazenamentoSqlite(banco));
+        if (parser.isSet(optImportar)) {
+            ArmazenamentoArquivos origem;
+            if (!copiarDados(origem, *sqlite)) {
+                QMessageBox::warning(nullptr, "Importar",
+                                     "Não foi possível importar os arquivos para '" + banco + "'.");
+                return 1;
+            }
+        }
+        repositorio.definirArmazenamento(std::move(sqlite));
+    }
+
+    // Lê os dados em segundo plano enquanto o login é digitado
+    repositorio.carregarEmSegundoPlano();
+
     DialogoLogin dlg;
     // NÃo precisa mais de dlg.setWindowIcon(),
     // pois ela já vai "herdar" o ícone da aplicação.
@@ -0,0 +1,221 @@
+// acompanhamentoavaliacoes.cpp
+#include "acompanhamentoavaliacoes.h"
+#include "leitorcsv.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+#include <QDateTime>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+// ================== CONVERSÃO ==================
+
+namespace {
+
+// "8.50|7.00|9.25" -> {8.5, 7.0, 9.25}, sem QStringList intermediária
+QVector<double> lerNotasQuesitos(const CampoCsv& s)
+{
+    QVector<double> res;
+    if (s.emBranco())
+        return res;
+
+    const char* ini = s.dados;
+    const char* fim = s.dados + s.tamanho;
+    for (const char* p = ini; ; ++p) {
+        if (p == fim || *p == '|') {
+            res.append(CampoCsv{ini, int(p - ini)}.toDouble());
+            if (p == fim) break;
+            ini = p + 1;
+        }
+    }
+    return res;
+}
+
+QString escreverNotasQuesitos(const QVector<double>& notas)
+{
+    QStringList partes;
+    partes.reserve(notas.size());
+    for (double v : notas)
+        partes << QString::number(v, 'f', 2);
+    return partes.join('|');
+}
+
+} // namespace
+
+bool estadoDoArquivo(const QString& arquivo, qint64& tamanho, quint64& identidade)
+{
+#ifdef Q_OS_UNIX
+    struct stat st;
+    if (::stat(QFile::encodeName(arquivo).constData(), &st) != 0)
+        return false;
+    tamanho    = qint64(st.st_size);
+    identidade = quint64(st.st_ino) ^ (quint64(st.st_dev) << 32);
+#else
+    // Sem inode: a data de criação do arquivo novo é diferente
+    const QFileInfo info(arquivo);
+    if (!info.exists())
+        return false;
+    tamanho    = info.size();
+    identidade = quint64(info.birthTime().toMSecsSinceEpoch());
+#endif
+    return true;
+}
+
+QString avaliacaoParaLinha(const Avaliacao& a)
+{
+    return QString::number(a.idProjeto) + ';'
+         + a.nomeProjeto + ';'
+         + (a.responsavel.isEmpty() ? QString("-") : a.responsavel) + ';'
+         + QString::number(a.idFicha) + ';'
+         + a.nomeFicha + ';'
+         + a.cpfAvaliador + ';'
+         + a.nomeAvaliador + ';'
+         + QString::number(a.notaFinal, 'f', 2) + ';'
+         + escreverNotasQuesitos(a.notasQuesitos);
+}
+
+bool linhaParaAvaliacao(const LeitorCsv& csv, Avaliacao& a)
+{
+    if (csv.numCampos() < 8)
+        return false;
+
+    bool ok = false;
+    const int idProj = csv[0].toInt(&ok);
+    if (!ok)
+        return false; // cabeçalho
+
+    a.idProjeto     = idProj;
+    a.nomeProjeto   = csv[1].toString();
+    a.responsavel   = csv[2].toString();
+    a.idFicha       = csv[3].toInt();
+    a.nomeFicha     = csv[4].toString();
+    a.cpfAvaliador  = csv[5].toString();
+    a.nomeAvaliador = csv[6].toString();
+    a.notaFinal     = csv[7].toDouble();
+    a.notasQuesitos = lerNotasQuesitos(csv[8]);
+    return true;
+}
+
+// ================== ACOMPANHAMENTO ==================
+
+AcompanhamentoAvaliacoes::AcompanhamentoAvaliacoes(const QString& arquivo, QObject* parent)
+    : QObject(parent)
+    , m_arquivo(arquivo)
+{
+    m_agrupador.setSingleShot(true);
+    m_agrupador.setInterval(100);
+    connect(&m_agrupador, &QTimer::timeout, this, &AcompanhamentoAvaliacoes::verificar);
+
+    m_periodico.setInterval(IntervaloVerificacaoMs);
+    connect(&m_periodico, &QTimer::timeout, this, &AcompanhamentoAvaliacoes::verificar);
+
+    auto agendar = [this] { m_agrupador.start(); };
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged,      this, agendar);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, agendar);
+}
+
+void AcompanhamentoAvaliacoes::iniciar()
+{
+    m_ativo = true;
+    vigiar();
+    m_periodico.start();
+}
+
+void AcompanhamentoAvaliacoes::vigiar()
+{
+    if (!m_ativo)
+        return;
+
+    // A pasta avisa quando o arquivo é criado ou trocado por rename; o
+    // arquivo em si sai da lista do watcher nesses casos e é recolocado aqui.
+    const QFileInfo info(m_arquivo);
+    const QString pasta = info.absolutePath();
+    if (!m_watcher.directories().contains(pasta))
+        m_watcher.addPath(pasta);
+    if (info.exists() && !m_watcher.files().contains(info.absoluteFilePath()))
+        m_watcher.addPath(info.absoluteFilePath());
+}
+
+void AcompanhamentoAvaliacoes::reposicionar(qint64 deslocamento)
+{
+    qint64 tamanho = 0;
+    quint64 identidade = 0;
+    if (!estadoDoArquivo(m_arquivo, tamanho, identidade))
+        deslocamento = 0;
+
+    m_deslocamento = deslocamento;
+    m_identidade   = identidade;
+    m_linhasProprias.clear();
+    vigiar();
+}
+
+void AcompanhamentoAvaliacoes::registrarLinhaPropria(const QByteArray& linha)
+{
+    m_linhasProprias.append(linha);
+}
+
+void AcompanhamentoAvaliacoes::verificar()
+{
+    vigiar();
+
+    qint64 tamanho = 0;
+    quint64 identidade = 0;
+    const bool existe = estadoDoArquivo(m_arquivo, tamanho, identidade);
+
+    if (!existe || identidade != m_identidade || tamanho < m_deslocamento) {
+        if (!existe && m_identidade == 0)
+            return; // continua sem arquivo
+
+        // Já marca o estado atual: se ninguém recarregar, não avisa de novo
+        m_deslocamento = existe ? tamanho : 0;
+        m_identidade   = existe ? identidade : 0;
+        m_linhasProprias.clear();
+        emit arquivoSubstituido();
+        return;
+    }
+
+    if (tamanho == m_deslocamento)
+        return;
+
+    QFile f(m_arquivo);
+    if (!f.open(QIODevice::ReadOnly) || !f.seek(m_deslocamento))
+        return;
+
+    QByteArray novos = f.read(tamanho - m_deslocamento);
+    f.close();
+
+    // Só linhas completas: a última pode estar no meio da escrita
+    const int ultimaQuebra = novos.lastIndexOf('\n');
+    if (ultimaQuebra < 0)
+        return;
+    novos.truncate(ultimaQuebra + 1);
+    m_deslocamento += novos.size();
+
+    QVector<Avaliacao> lidas;
+    LeitorCsv csv(novos);
+    csv.abrir();
+    while (csv.proximaLinha()) {
+        if (csv.linhaEmBranco())
+            continue;
+
+        // Linha que esta estação gravou: já está na memória. As anteriores
+        // da fila que não apareceram (append que falhou) são descartadas.
+        const CampoCsv l = csv.linha();
+        const int propria = m_linhasProprias.indexOf(QByteArray::fromRawData(l.dados, l.tamanho));
+        if (propria >= 0) {
+            m_linhasProprias.erase(m_linhasProprias.begin(),
+                                   m_linhasProprias.begin() + propria + 1);
+            continue;
+        }
+
+        Avaliacao a;
+        if (linhaParaAvaliacao(csv, a))
+            lidas.append(a);
+    }
+
+    if (!lidas.isEmpty())
+        emit novasAvaliacoes(lidas);
+}
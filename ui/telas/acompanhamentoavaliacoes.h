@@ -0,0 +1,85 @@
+// acompanhamentoavaliacoes.h
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QByteArray>
+#include <QList>
+#include <QTimer>
+#include <QFileSystemWatcher>
+
+#include "registros.h"
+
+class LeitorCsv;
+
+// Conversão Avaliacao <-> linha do avaliacoes.csv (sem o '\n')
+// Formato: idProjeto;nomeProjeto;responsavel;idFicha;nomeFicha;
+//          cpfAvaliador;nomeAvaliador;notaFinal;notasQuesitos(a|b|c)
+QString avaliacaoParaLinha(const Avaliacao& a);
+bool    linhaParaAvaliacao(const LeitorCsv& csv, Avaliacao& a);
+
+constexpr char CabecalhoAvaliacoes[] =
+    "idProjeto;nomeProjeto;responsavel;"
+    "idFicha;nomeFicha;"
+    "cpfAvaliador;nomeAvaliador;"
+    "notaFinal;notasQuesitos\n";
+
+// Tamanho e identidade do arquivo. A identidade muda quando o arquivo é
+// trocado por outro (QSaveFile grava num temporário e renomeia por cima).
+bool estadoDoArquivo(const QString& arquivo, qint64& tamanho, quint64& identidade);
+
+// ===== Acompanhamento do avaliacoes.csv =====
+//
+// Com várias estações avaliando sobre a mesma pasta, o avaliacoes.csv só
+// cresce por append. Em vez de recarregar tudo, guardamos até onde o arquivo
+// já foi lido (deslocamento) e a identidade dele (inode/tamanho) e, quando
+// o QFileSystemWatcher avisa, lemos apenas os bytes novos:
+//
+//   - bytes novos até o último '\n'     -> novasAvaliacoes(lista)
+//   - arquivo trocado, truncado ou
+//     apagado (reescrita por outra
+//     estação, remoção de nota...)      -> arquivoSubstituido()
+//
+// As linhas que esta estação acrescentou são informadas com
+// registrarLinhaPropria() e puladas na leitura (já estão na memória).
+// Compartilhamentos de rede nem sempre geram eventos de arquivo, então há
+// também uma verificação periódica (só um stat quando nada mudou).
+class AcompanhamentoAvaliacoes : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int IntervaloVerificacaoMs = 2000;
+
+    explicit AcompanhamentoAvaliacoes(const QString& arquivo, QObject* parent = nullptr);
+
+    // Liga o watcher e a verificação periódica
+    void iniciar();
+
+    // O arquivo foi lido (ou reescrito) por inteiro até 'deslocamento'
+    void reposicionar(qint64 deslocamento);
+
+    // Esta estação acabou de acrescentar 'linha' (sem o '\n')
+    void registrarLinhaPropria(const QByteArray& linha);
+
+public slots:
+    // Lê o que houver de novo desde a última verificação
+    void verificar();
+
+signals:
+    void novasAvaliacoes(const QVector<Avaliacao>& avaliacoes);
+    void arquivoSubstituido();
+
+private:
+    QString            m_arquivo;
+    QFileSystemWatcher m_watcher;
+    QTimer             m_agrupador;   // junta rajadas de eventos do watcher
+    QTimer             m_periodico;
+
+    bool               m_ativo{false};
+    qint64             m_deslocamento{0};
+    quint64            m_identidade{0};
+    QList<QByteArray>  m_linhasProprias;
+
+    void vigiar();
+};
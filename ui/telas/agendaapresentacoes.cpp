@@ -0,0 +1,328 @@
+// agendaapresentacoes.cpp
+#include "agendaapresentacoes.h"
+#include "leitorcsv.h"
+
+#include <QBitArray>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+const QString FormatoDataHora = "dd/MM/yyyy HH:mm";
+
+struct Pendente {
+    int          idProjeto{0};
+    QVector<int> avaliadores;   // posições em 'disponivel'/'ocupante'
+    QStringList  cpfs;
+    int          viaveis{0};    // horários com todos os avaliadores disponíveis
+    int          carga{0};      // soma dos projetos dos avaliadores
+};
+
+} // namespace
+
+QDateTime lerDataHora(const QString& texto)
+{
+    return QDateTime::fromString(texto.simplified(), FormatoDataHora);
+}
+
+QHash<Cpf, QVector<PeriodoAgenda>> carregarDisponibilidade(const QString& arquivo,
+                                                           QStringList* erros)
+{
+    QHash<Cpf, QVector<PeriodoAgenda>> res;
+
+    LeitorCsv csv(arquivo);
+    if (!csv.abrir()) {
+        if (erros)
+            *erros << "Não foi possível abrir " + arquivo;
+        return res;
+    }
+
+    int linha = 0;
+    while (csv.proximaLinha()) {
+        ++linha;
+        if (csv.linhaEmBranco()) continue;
+
+        const Cpf cpf(csv[0].toString());
+        PeriodoAgenda p;
+        if (csv.numCampos() >= 3) {
+            p.inicio = lerDataHora(csv[1].toString());
+            p.fim    = lerDataHora(csv[2].toString());
+        }
+        if (cpf.vazio() || !p.inicio.isValid() || !p.fim.isValid() || p.fim <= p.inicio) {
+            if (erros)
+                *erros << QString("Linha %1 ignorada").arg(linha);
+            continue;
+        }
+        res[cpf].append(p);
+    }
+    return res;
+}
+
+// ================== AGENDA ==================
+
+ResultadoAgenda montarAgenda(const QVector<Projeto>& projetos,
+                             const QVector<VinculoProjeto>& vinculos,
+                             const ConfiguracaoAgenda& config)
+{
+    ResultadoAgenda r;
+
+    // ----- Horários -----
+    const qint64 passo = qint64(config.duracaoMinutos) * 60;
+    if (passo > 0) {
+        for (const PeriodoAgenda& p : config.periodos) {
+            if (!p.inicio.isValid() || !p.fim.isValid())
+                continue;
+            for (QDateTime t = p.inicio; t.addSecs(passo) <= p.fim; t = t.addSecs(passo))
+                r.horarios.append(t);
+        }
+    }
+    std::sort(r.horarios.begin(), r.horarios.end());
+    r.horarios.erase(std::unique(r.horarios.begin(), r.horarios.end()), r.horarios.end());
+
+    const int horarios = r.horarios.size();
+    const int salas    = config.salas.size();
+
+    if (horarios == 0 || salas == 0) {
+        for (const Projeto& p : projetos)
+            r.semHorario.append(p.id);
+        std::sort(r.semHorario.begin(), r.semHorario.end());
+        return r;
+    }
+
+    // ----- Apresentações e avaliadores -----
+    QVector<Pendente> pend(projetos.size());
+    QHash<int, int>   porProjeto;
+    for (int i = 0; i < projetos.size(); ++i) {
+        pend[i].idProjeto = projetos[i].id;
+        porProjeto.insert(projetos[i].id, i);
+    }
+
+    QHash<Cpf, int>    posicao;
+    QVector<QBitArray> disponivel;
+    QVector<int>       carga;
+
+    for (const VinculoProjeto& v : vinculos) {
+        const int i = porProjeto.value(v.idProjeto, -1);
+        const Cpf cpf = v.cpf();
+        if (i < 0 || cpf.vazio())
+            continue;
+
+        auto it = posicao.constFind(cpf);
+        if (it == posicao.constEnd()) {
+            const auto d = config.disponibilidade.constFind(cpf);
+            const bool semRestricao = d == config.disponibilidade.constEnd();
+            QBitArray bits(horarios, semRestricao);
+            if (!semRestricao) {
+                for (int h = 0; h < horarios; ++h) {
+                    const QDateTime fim = r.horarios[h].addSecs(passo);
+                    for (const PeriodoAgenda& p : d.value()) {
+                        if (p.inicio <= r.horarios[h] && fim <= p.fim) {
+                            bits.setBit(h);
+                            break;
+                        }
+                    }
+                }
+            }
+            it = posicao.insert(cpf, disponivel.size());
+            disponivel.append(bits);
+            carga.append(0);
+        }
+
+        const int e = it.value();
+        if (!pend[i].avaliadores.contains(e)) {
+            pend[i].avaliadores.append(e);
+            pend[i].cpfs.append(v.cpfAvaliador);
+            ++carga[e];
+        }
+    }
+
+    for (Pendente& p : pend) {
+        for (int h = 0; h < horarios; ++h) {
+            bool todos = true;
+            for (int e : p.avaliadores)
+                todos = todos && disponivel[e].testBit(h);
+            p.viaveis += todos;
+        }
+        for (int e : p.avaliadores)
+            p.carga += carga[e];
+    }
+
+    // Mais restritos primeiro; ID no fim para o resultado ser estável
+    QVector<int> ordem(pend.size());
+    std::iota(ordem.begin(), ordem.end(), 0);
+    std::sort(ordem.begin(), ordem.end(), [&pend](int a, int b) {
+        const Pendente& x = pend[a];
+        const Pendente& y = pend[b];
+        if (x.viaveis != y.viaveis) return x.viaveis < y.viaveis;
+        if (x.carga != y.carga)     return x.carga > y.carga;
+        return x.idProjeto < y.idProjeto;
+    });
+
+    // ----- Gulosa: primeiro horário possível -----
+    QVector<int>          livres(horarios, salas);
+    QVector<QVector<int>> ocupante(disponivel.size(), QVector<int>(horarios, -1));
+    QVector<int>          horarioDe(pend.size(), -1);
+
+    const auto cabe = [&](int i, int h) {
+        if (livres[h] == 0)
+            return false;
+        for (int e : pend[i].avaliadores)
+            if (!disponivel[e].testBit(h) || ocupante[e][h] >= 0)
+                return false;
+        return true;
+    };
+    const auto colocar = [&](int i, int h) {
+        --livres[h];
+        for (int e : pend[i].avaliadores)
+            ocupante[e][h] = i;
+        horarioDe[i] = h;
+    };
+    const auto retirar = [&](int i) {
+        const int h = horarioDe[i];
+        ++livres[h];
+        for (int e : pend[i].avaliadores)
+            ocupante[e][h] = -1;
+        horarioDe[i] = -1;
+    };
+
+    QVector<int> fora;
+    for (int i : ordem) {
+        int h = 0;
+        while (h < horarios && !cabe(i, h))
+            ++h;
+        if (h < horarios)
+            colocar(i, h);
+        else
+            fora.append(i);
+    }
+
+    // ----- Reparo: tira do caminho a única apresentação que impede -----
+    for (int i : fora) {
+        bool colocado = false;
+        for (int h = 0; h < horarios && !colocado; ++h) {
+            int  bloqueio = -1;
+            bool possivel = true;
+            for (int e : pend[i].avaliadores) {
+                if (!disponivel[e].testBit(h)) { possivel = false; break; }
+                const int o = ocupante[e][h];
+                if (o < 0) continue;
+                if (bloqueio >= 0 && bloqueio != o) { possivel = false; break; }
+                bloqueio = o;
+            }
+            // Sala cheia só serve se a apresentação retirada liberar uma
+            if (!possivel || (livres[h] == 0 && bloqueio < 0))
+                continue;
+
+            if (bloqueio < 0) {   // vaga aberta por um reparo anterior
+                colocar(i, h);
+                colocado = true;
+                break;
+            }
+
+            retirar(bloqueio);
+            colocar(i, h);
+            int destino = 0;
+            while (destino < horarios && (destino == h || !cabe(bloqueio, destino)))
+                ++destino;
+            if (destino < horarios) {
+                colocar(bloqueio, destino);
+                ++r.remanejadas;
+                colocado = true;
+            } else {
+                retirar(i);
+                colocar(bloqueio, h);
+            }
+        }
+        if (!colocado)
+            r.semHorario.append(pend[i].idProjeto);
+    }
+    std::sort(r.semHorario.begin(), r.semHorario.end());
+
+    // ----- Salas: em cada horário, na ordem do ID do projeto -----
+    QVector<int> agendados;
+    agendados.reserve(pend.size());
+    for (int i = 0; i < pend.size(); ++i)
+        if (horarioDe[i] >= 0)
+            agendados.append(i);
+    std::sort(agendados.begin(), agendados.end(), [&](int a, int b) {
+        if (horarioDe[a] != horarioDe[b]) return horarioDe[a] < horarioDe[b];
+        return pend[a].idProjeto < pend[b].idProjeto;
+    });
+
+    r.apresentacoes.reserve(agendados.size());
+    int sala = 0;
+    for (int k = 0; k < agendados.size(); ++k) {
+        const int i = agendados[k];
+        if (k > 0 && horarioDe[agendados[k - 1]] != horarioDe[i])
+            sala = 0;
+
+        Apresentacao a;
+        a.idProjeto   = pend[i].idProjeto;
+        a.horario     = horarioDe[i];
+        a.sala        = sala++;
+        a.avaliadores = pend[i].cpfs;
+        r.apresentacoes.append(a);
+    }
+    return r;
+}
+
+// ================== BENCHMARK ==================
+
+int executarBenchmarkAgenda(int quantidadeProjetos, int quantidadeAvaliadores)
+{
+    QTextStream out(stdout);
+    if (quantidadeProjetos <= 0 || quantidadeAvaliadores < MaxAvaliadoresPorProjeto) {
+        out << QString("Quantidade de projetos deve ser positiva e de avaliadores ao menos %1.\n")
+                   .arg(MaxAvaliadoresPorProjeto);
+        return 1;
+    }
+
+    // Dois dias, manhã e tarde, apresentações de 20 minutos: 48 horários
+    ConfiguracaoAgenda config;
+    const QDate dia(2025, 10, 20);
+    for (int d = 0; d < 2; ++d) {
+        config.periodos.append({QDateTime(dia.addDays(d), QTime(8, 0)),
+                                QDateTime(dia.addDays(d), QTime(12, 0))});
+        config.periodos.append({QDateTime(dia.addDays(d), QTime(14, 0)),
+                                QDateTime(dia.addDays(d), QTime(18, 0))});
+    }
+    const int horarios = 48;
+    for (int s = 0; s < (quantidadeProjetos + horarios - 1) / horarios + 1; ++s)
+        config.salas << QString("Sala %1").arg(s + 1);
+
+    QVector<Projeto> projetos(quantidadeProjetos);
+    QVector<VinculoProjeto> vinculos;
+    vinculos.reserve(quantidadeProjetos * MaxAvaliadoresPorProjeto);
+    for (int i = 0; i < quantidadeProjetos; ++i) {
+        projetos[i].id = i + 1;
+        for (int k = 0; k < MaxAvaliadoresPorProjeto; ++k) {
+            VinculoProjeto v;
+            v.idProjeto    = i + 1;
+            v.cpfAvaliador = QString::number(10000000000LL
+                                             + (i * MaxAvaliadoresPorProjeto + k) % quantidadeAvaliadores);
+            vinculos.append(v);
+        }
+    }
+
+    // Um em cada dez avaliadores só vem no primeiro dia
+    for (int a = 0; a < quantidadeAvaliadores; a += 10)
+        config.disponibilidade[Cpf(QString::number(10000000000LL + a))]
+            << config.periodos[0] << config.periodos[1];
+
+    out << QString("%1 projetos, %2 avaliadores, %3 salas, %4 horários\n")
+               .arg(quantidadeProjetos).arg(quantidadeAvaliadores)
+               .arg(config.salas.size()).arg(horarios);
+
+    QElapsedTimer t;
+    t.start();
+    const ResultadoAgenda r = montarAgenda(projetos, vinculos, config);
+    const qint64 ns = t.nsecsElapsed();
+
+    out << QString("montarAgenda: %1 ms, %2 agendadas, %3 sem horário, %4 remanejadas\n")
+               .arg(ns / 1e6, 0, 'f', 1)
+               .arg(r.apresentacoes.size()).arg(r.semHorario.size()).arg(r.remanejadas);
+    return 0;
+}
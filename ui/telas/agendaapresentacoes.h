@@ -0,0 +1,76 @@
+// agendaapresentacoes.h
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+#include "registros.h"
+#include "vinculos.h"
+
+// ===== Agenda das apresentações =====
+//
+// Cada projeto é apresentado uma vez, numa sala e num horário, com todos os
+// avaliadores vinculados presentes. Os horários saem dos períodos de
+// apresentação (ex.: 08:00-12:00 de cada dia) cortados na duração de uma
+// apresentação.
+//
+// Restrições: um avaliador não está em duas apresentações no mesmo
+// horário e só entra nos horários em que está disponível; cada sala tem
+// uma apresentação por horário.
+//
+// Heurística (gulosa + reparo):
+//   1. os projetos mais restritos vão primeiro: menos horários em que
+//      todos os avaliadores estão disponíveis e, no empate, avaliadores
+//      mais carregados;
+//   2. cada um fica no primeiro horário com sala livre e avaliadores
+//      livres, o que enche as salas dos primeiros horários;
+//   3. quem não coube tenta um horário em que só uma apresentação o
+//      impede: ela é levada para outro horário possível e o projeto
+//      fica no lugar dela.
+// O custo é O(projetos · horários · avaliadores por projeto) no passo 2;
+// milhares de apresentações levam bem menos de um segundo.
+//
+// disponibilidade.csv: cpf;dd/MM/yyyy HH:mm;dd/MM/yyyy HH:mm
+//   (uma linha por intervalo; quem não aparece está sempre disponível)
+
+struct PeriodoAgenda {
+    QDateTime inicio;
+    QDateTime fim;
+};
+
+struct ConfiguracaoAgenda {
+    QStringList            salas;
+    QVector<PeriodoAgenda> periodos;
+    int                    duracaoMinutos{20};
+    QHash<Cpf, QVector<PeriodoAgenda>> disponibilidade;
+};
+
+struct Apresentacao {
+    int         idProjeto{0};
+    int         horario{0};   // índice em ResultadoAgenda::horarios
+    int         sala{0};      // índice em ConfiguracaoAgenda::salas
+    QStringList avaliadores;  // CPFs como estão nos vínculos
+};
+
+struct ResultadoAgenda {
+    QVector<QDateTime>    horarios;        // início de cada horário
+    QVector<Apresentacao> apresentacoes;   // por horário e sala
+    QVector<int>          semHorario;      // projetos que não couberam
+    int                   remanejadas{0};  // movidas pelo passo de reparo
+};
+
+// "dd/MM/yyyy HH:mm"; inválido se o texto não estiver nesse formato
+QDateTime lerDataHora(const QString& texto);
+
+// Lê disponibilidade.csv; linhas com data inválida entram em 'erros'
+QHash<Cpf, QVector<PeriodoAgenda>> carregarDisponibilidade(const QString& arquivo,
+                                                           QStringList* erros = nullptr);
+
+ResultadoAgenda montarAgenda(const QVector<Projeto>& projetos,
+                             const QVector<VinculoProjeto>& vinculos,
+                             const ConfiguracaoAgenda& config);
+
+// Mede montarAgenda com dados sintéticos (linha de comando)
+int executarBenchmarkAgenda(int projetos, int avaliadores);
@@ -0,0 +1,75 @@
+// agregadosnotas.cpp
+#include "agregadosnotas.h"
+
+#include <QtMath>
+
+#include <algorithm>
+
+// ================== AGREGADO ==================
+
+double AgregadoProjeto::variancia() const
+{
+    if (quantidade == 0)
+        return 0.0;
+    const double m = media();
+    // E[x²] - m²; arredondamento pode dar um negativo minúsculo
+    return std::max(0.0, somaQuadrados / quantidade - m * m);
+}
+
+double AgregadoProjeto::desvioPadrao() const
+{
+    return qSqrt(variancia());
+}
+
+// ================== MANUTENÇÃO ==================
+
+void AgregadosNotas::reconstruir(const QVector<Nota>& notas)
+{
+    m_projetos.clear();
+    for (const Nota& n : notas)
+        acrescentar(n.idProjeto, n.notaFinal);
+}
+
+void AgregadosNotas::acrescentar(int idProjeto, double nota)
+{
+    AgregadoProjeto& a = m_projetos[idProjeto];
+    ++a.quantidade;
+    a.soma          += nota;
+    a.somaQuadrados += nota * nota;
+    ++a.valores[nota];
+}
+
+void AgregadosNotas::retirar(int idProjeto, double nota)
+{
+    const auto it = m_projetos.find(idProjeto);
+    if (it == m_projetos.end())
+        return;
+
+    AgregadoProjeto& a = it.value();
+    const auto v = a.valores.find(nota);
+    if (v == a.valores.end())
+        return;   // não estava contada
+    if (--v.value() == 0)
+        a.valores.erase(v);
+
+    if (--a.quantidade == 0) {
+        m_projetos.erase(it);
+        return;
+    }
+    a.soma          -= nota;
+    a.somaQuadrados -= nota * nota;
+}
+
+void AgregadosNotas::substituir(int idProjetoAntes, double antes, int idProjeto, double nota)
+{
+    if (idProjetoAntes == idProjeto && antes == nota)
+        return;
+    retirar(idProjetoAntes, antes);
+    acrescentar(idProjeto, nota);
+}
+
+const AgregadoProjeto* AgregadosNotas::doProjeto(int idProjeto) const
+{
+    const auto it = m_projetos.constFind(idProjeto);
+    return it == m_projetos.constEnd() ? nullptr : &it.value();
+}
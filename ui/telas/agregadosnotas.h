@@ -0,0 +1,45 @@
+// agregadosnotas.h
+#pragma once
+
+#include <QHash>
+#include <QMap>
+#include <QVector>
+
+#include "registros.h"
+
+// ===== Agregados das notas por projeto =====
+//
+// Quantidade, soma e soma dos quadrados das notas de cada projeto,
+// atualizadas a cada nota lançada, alterada ou removida: média, variância
+// e desvio saem direto, sem percorrer as notas. Mínima e máxima vêm de um
+// contador por valor (poucas notas por projeto), o que permite retirar
+// uma nota sem reler as outras.
+struct AgregadoProjeto {
+    int    quantidade{0};
+    double soma{0.0};
+    double somaQuadrados{0.0};
+    QMap<double, int> valores;   // nota -> quantas vezes
+
+    double media() const     { return quantidade > 0 ? soma / quantidade : 0.0; }
+    double variancia() const;    // populacional (as notas são todas as do projeto)
+    double desvioPadrao() const;
+    double minima() const    { return valores.isEmpty() ? 0.0 : valores.firstKey(); }
+    double maxima() const    { return valores.isEmpty() ? 0.0 : valores.lastKey(); }
+};
+
+class AgregadosNotas
+{
+public:
+    void reconstruir(const QVector<Nota>& notas);
+
+    void acrescentar(int idProjeto, double nota);
+    void retirar(int idProjeto, double nota);
+    // Nota alterada: (projeto, valor) antigo -> novo
+    void substituir(int idProjetoAntes, double antes, int idProjeto, double nota);
+
+    const AgregadoProjeto* doProjeto(int idProjeto) const;
+    const QHash<int, AgregadoProjeto>& projetos() const { return m_projetos; }
+
+private:
+    QHash<int, AgregadoProjeto> m_projetos;
+};
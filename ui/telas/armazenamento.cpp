@@ -0,0 +1,53 @@
+// armazenamento.cpp
+#include "armazenamento.h"
+
+#include <QStringList>
+
+bool Armazenamento::carregarTudo(DadosSistema& d)
+{
+    return carregarFichas(d.fichas)
+        && carregarProjetos(d.projetos)
+        && carregarAvaliadores(d.avaliadores)
+        && carregarVinculos(d.vinculos)
+        && carregarNotas(d.notas)
+        && carregarAvaliacoes(d.avaliacoes)
+        && carregarConflitos(d.conflitos);
+}
+
+bool copiarDados(Armazenamento& origem, Armazenamento& destino)
+{
+    if (!origem.abrir() || !destino.abrir())
+        return false;
+
+    DadosSistema d;
+    if (!origem.carregarTudo(d))
+        return false;
+
+    return destino.substituirTudo(d);
+}
+
+void Armazenamento::avisarAlteracaoExterna(const QString& colecao, const QString& tipo,
+                                           const QList<int>& conflitos) const
+{
+    if (!conflitos.isEmpty()) {
+        const QString mensagem = mensagemConflito(tipo, conflitos);
+        if (m_avisoConflitos)
+            m_avisoConflitos(colecao, conflitos, mensagem);
+        else
+            qWarning("%s", qPrintable(mensagem));
+    }
+    if (m_avisoAlteracaoExterna)
+        m_avisoAlteracaoExterna(colecao);
+}
+
+QString Armazenamento::mensagemConflito(const QString& tipo, const QList<int>& ids)
+{
+    if (ids.isEmpty())
+        return QString();
+
+    QStringList partes;
+    for (int id : ids)
+        partes << QString::number(id);
+    return tipo + " " + partes.join(", ") + " foi alterado(a) em outra estação ao mesmo tempo.\n"
+           "A alteração feita aqui não foi gravada; os dados foram recarregados.";
+}
@@ -0,0 +1,174 @@
+// armazenamento.h
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QList>
+#include <QSet>
+
+#include <functional>
+
+#include "registros.h"
+#include "ficha.h"
+#include "vinculos.h"
+#include "conflitos.h"
+#include "motornotas.h"
+
+class AcompanhamentoAvaliacoes;
+
+// Conjunto completo de dados (usado pelo importador/exportador)
+struct DadosSistema {
+    QVector<Projeto>        projetos;
+    QVector<Avaliador>      avaliadores;
+    QVector<Ficha>          fichas;
+    QVector<VinculoProjeto> vinculos;
+    QVector<Nota>           notas;
+    QVector<Avaliacao>      avaliacoes;
+    QVector<ConflitoDeclarado> conflitos;
+};
+
+// ===== Backend de armazenamento =====
+//
+// O Repositorio mantém tudo em memória; o backend só carrega e persiste.
+// Nas gravações, 'todos' é o vetor já alterado em memória e os demais
+// parâmetros identificam o registro afetado: o backend de arquivos reescreve
+// a partir de 'todos', o SQLite grava apenas a linha correspondente.
+class Armazenamento
+{
+public:
+    virtual ~Armazenamento() = default;
+
+    // Nome amigável ("Arquivos", "SQLite: dados.db") para status/mensagens
+    virtual QString descricao() const = 0;
+
+    // Prepara o backend (abre conexão, cria tabelas...). Chamado uma vez.
+    virtual bool abrir() = 0;
+
+    // ----- Carga -----
+    virtual bool carregarProjetos(QVector<Projeto>& projetos) = 0;
+    virtual bool carregarAvaliadores(QVector<Avaliador>& avaliadores) = 0;
+    virtual bool carregarFichas(QVector<Ficha>& fichas) = 0;
+    virtual bool carregarVinculos(QVector<VinculoProjeto>& vinculos) = 0;
+    virtual bool carregarNotas(QVector<Nota>& notas) = 0;
+    virtual bool carregarAvaliacoes(QVector<Avaliacao>& avaliacoes) = 0;
+    virtual bool carregarConflitos(QVector<ConflitoDeclarado>& conflitos) = 0;
+
+    // ----- Carga em paralelo -----
+    // Leituras sem mensagens e sem estado da thread principal, que podem
+    // rodar ao mesmo tempo em threads de trabalho (carregamento inicial, ver
+    // Repositorio::carregarEmSegundoPlano). Backends presos a uma thread
+    // (a conexão SQLite) ficam com leituraParalela() == false.
+    virtual bool leituraParalela() const { return false; }
+    virtual bool lerProjetos(QVector<Projeto>&) const { return false; }
+    virtual bool lerAvaliadores(QVector<Avaliador>&) const { return false; }
+    virtual bool lerFichas(QVector<Ficha>&) const { return false; }
+    virtual bool lerVinculos(QVector<VinculoProjeto>&) const { return false; }
+    virtual bool lerNotas(QVector<Nota>&) { return false; }
+    virtual bool lerAvaliacoes(QVector<Avaliacao>&) { return false; }
+    // Na thread principal, depois de lerAvaliacoes()
+    virtual void avaliacoesLidas(const QVector<Avaliacao>&) {}
+
+    // ----- Gravação -----
+    virtual bool gravarProjeto(const QVector<Projeto>& todos, const Projeto& p) = 0;
+    virtual bool removerProjeto(const QVector<Projeto>& todos, int id) = 0;
+
+    virtual bool gravarAvaliador(const QVector<Avaliador>& todos, const Avaliador& a) = 0;
+    virtual bool removerAvaliador(const QVector<Avaliador>& todos, int id) = 0;
+
+    virtual bool gravarFicha(const QVector<Ficha>& todas, const Ficha& f) = 0;
+    virtual bool removerFicha(const QVector<Ficha>& todas, int id) = 0;
+
+    // Registro criado aqui, com o próximo id livre na memória. Outra estação
+    // pode ter criado outro registro com o mesmo id ao mesmo tempo: o
+    // backend grava com o próximo id livre no disco e avisa a alteração
+    // externa, para a memória ser relida com o id definitivo.
+    virtual bool gravarProjetoNovo(const QVector<Projeto>& todos, const Projeto& p) = 0;
+    virtual bool gravarAvaliadorNovo(const QVector<Avaliador>& todos, const Avaliador& a) = 0;
+    virtual bool gravarFichaNova(const QVector<Ficha>& todas, const Ficha& f) = 0;
+
+    // Substitui os vínculos de um projeto pelos presentes em 'todos'
+    virtual bool gravarVinculosDoProjeto(const QVector<VinculoProjeto>& todos, int idProjeto) = 0;
+    // O mesmo para vários projetos numa gravação só (distribuição automática)
+    virtual bool gravarVinculosDosProjetos(const QVector<VinculoProjeto>& todos,
+                                           const QSet<int>& idsProjetos) = 0;
+    virtual bool removerVinculosDoAvaliador(const QVector<VinculoProjeto>& todos, const QString& cpf) = 0;
+
+    // Lista inteira de conflitos declarados (pequena, só o administrador altera)
+    virtual bool gravarConflitos(const QVector<ConflitoDeclarado>& todos) = 0;
+
+    virtual bool gravarNota(const QVector<Nota>& todas, const Nota& n) = 0;
+    virtual bool removerNota(const QVector<Nota>& todas, int idNota) = 0;
+
+    virtual bool registrarAvaliacao(const QVector<Avaliacao>& todas, const Avaliacao& a) = 0;
+    // Remove as avaliações de (projeto, CPF normalizado)
+    virtual bool removerAvaliacoes(const QVector<Avaliacao>& todas,
+                                   int idProjeto, const QString& cpf) = 0;
+    // Refaz a notaFinal das avaliações gravadas da ficha de 'pesos' (pesos
+    // dos quesitos alterados); 'todas' já está recalculado em memória
+    virtual bool recalcularNotasDaFicha(const QVector<Avaliacao>& todas,
+                                        const PesosFicha& pesos) = 0;
+
+    // Grava o que estiver pendente (backends que agrupam gravações).
+    // Chamado na saída do programa.
+    virtual bool descarregar() { return true; }
+
+    // Leitura incremental das avaliações gravadas por outras estações.
+    // nullptr quando o backend não tem como acompanhar (SQLite).
+    virtual AcompanhamentoAvaliacoes* acompanhamentoAvaliacoes() { return nullptr; }
+
+    // ----- Importação/exportação -----
+    bool carregarTudo(DadosSistema& d);
+    virtual bool substituirTudo(const DadosSistema& d) = 0;
+
+    // ----- Várias estações -----
+    // Chamado quando uma gravação encontrou 'colecao' ("projetos",
+    // "avaliadores", "fichas", "vinculos", "notas", "avaliacoes") alterada
+    // por outra estação: a memória de quem carregou precisa ser relida.
+    void definirAvisoAlteracaoExterna(std::function<void(const QString& colecao)> aviso)
+    {
+        m_avisoAlteracaoExterna = std::move(aviso);
+    }
+
+    // Alterações daqui recusadas por conflito de versão ('ids' da coleção;
+    // 'mensagem' pronta para o usuário). Pode vir de dentro de uma gravação
+    // adiada: o aviso não deve abrir janela. Sem aviso definido, a mensagem
+    // só vai para o log.
+    void definirAvisoConflitos(std::function<void(const QString& colecao, const QList<int>& ids,
+                                                  const QString& mensagem)> aviso)
+    {
+        m_avisoConflitos = std::move(aviso);
+    }
+
+    // Resultado das gravações adiadas (backends que agrupam gravações):
+    // ok == false quando a coleção não foi gravada e ficou na fila para uma
+    // nova tentativa
+    void definirAvisoGravacao(std::function<void(const QString& colecao, bool ok)> aviso)
+    {
+        m_avisoGravacao = std::move(aviso);
+    }
+
+protected:
+    void avisarGravacao(const QString& colecao, bool ok) const
+    {
+        if (m_avisoGravacao)
+            m_avisoGravacao(colecao, ok);
+    }
+
+    // Avisa os 'conflitos' (registros do 'tipo' cuja alteração daqui foi
+    // recusada), se houver, e dispara o aviso de alteração externa
+    void avisarAlteracaoExterna(const QString& colecao,
+                                const QString& tipo = QString(),
+                                const QList<int>& conflitos = QList<int>()) const;
+
+    // "Projeto 3, 7 foi alterado(a) em outra estação..." (vazio se não há ids)
+    static QString mensagemConflito(const QString& tipo, const QList<int>& ids);
+
+private:
+    std::function<void(const QString&)> m_avisoAlteracaoExterna;
+    std::function<void(const QString&, const QList<int>&, const QString&)> m_avisoConflitos;
+    std::function<void(const QString&, bool)> m_avisoGravacao;
+};
+
+// Copia todos os dados de 'origem' para 'destino' (substituindo o conteúdo).
+// Usado para importar os arquivos para o SQLite e exportar de volta.
+bool copiarDados(Armazenamento& origem, Armazenamento& destino);
@@ -0,0 +1,1011 @@
+// armazenamentoarquivos.cpp
+#include "armazenamentoarquivos.h"
+#include "leitorcsv.h"
+#include "acompanhamentoavaliacoes.h"
+#include "travaarquivo.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QMessageBox>
+#include <QHash>
+#include <QSet>
+
+#include <algorithm>
+
+const QString ArmazenamentoArquivos::ArquivoProjetos    = "projetos.txt";
+const QString ArmazenamentoArquivos::ArquivoAvaliadores = "avaliadores.csv";
+const QString ArmazenamentoArquivos::ArquivoFichas      = "fichas.txt";
+const QString ArmazenamentoArquivos::ArquivoVinculos    = "vinculos_projetos.csv";
+const QString ArmazenamentoArquivos::ArquivoNotas       = "notas.csv";
+const QString ArmazenamentoArquivos::ArquivoAvaliacoes  = "avaliacoes.csv";
+const QString ArmazenamentoArquivos::ArquivoConflitos   = "conflitos.csv";
+
+// ================== HELPERS DE ARQUIVO ==================
+
+namespace {
+
+// As gravações rodam no flush adiado (GravacaoAgrupada): uma janela ali
+// abriria um loop de eventos no meio da gravação, e outra a cada nova
+// tentativa. A falha vai para o log; quem está usando o programa vê pelo
+// gravacaoConcluida(colecao, false) na barra de status.
+void registrarFalha(const QString& titulo, const QString& erro)
+{
+    qWarning("%s: %s", qPrintable(titulo), qPrintable(erro));
+}
+
+bool abrirLeitura(QFile& f, QTextStream& in)
+{
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+    in.setDevice(&f);
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+    in.setCodec("UTF-8");
+#endif
+    return true;
+}
+
+// Gravação atômica: o conteúdo vai para um temporário ao lado do arquivo
+// e só substitui o original no commit (flush + fsync + rename). Uma queda no
+// meio da escrita deixa o arquivo antigo intacto.
+bool abrirEscrita(QSaveFile& f, QTextStream& out, const QString& titulo)
+{
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        registrarFalha(titulo, "Não foi possível abrir '" + f.fileName() + "' para escrita.");
+        return false;
+    }
+    out.setDevice(&f);
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+    out.setCodec("UTF-8");
+#endif
+    return true;
+}
+
+bool concluirEscrita(QSaveFile& f, QTextStream& out, const QString& titulo)
+{
+    out.flush();
+    if (out.status() != QTextStream::Ok)
+        f.cancelWriting();
+
+    if (!f.commit()) {
+        registrarFalha(titulo, "Não foi possível gravar '" + f.fileName() + "'.");
+        return false;
+    }
+    return true;
+}
+
+// Evita quebrar o arquivo com ';' dentro dos textos
+QString semSeparador(QString s)
+{
+    s.replace(';', ',');
+    return s;
+}
+
+Projeto linhaParaProjeto(const LeitorCsv& p)
+{
+    Projeto proj;
+    proj.id          = p[0].toInt();
+    proj.nome        = p[1].toString();
+    proj.descricao   = p[2].toString();
+    proj.responsavel = p[3].toString();
+    proj.categoria   = p[4].toString();
+    proj.status      = p.numCampos() >= 6 ? p[5].toString() : "Cadastrado";
+    proj.ficha       = p.numCampos() >= 7 ? p[6].toString() : "Não definida";
+    bool ok = false;
+    const int idFicha = p[7].toInt(&ok);
+    proj.idFicha     = (p.numCampos() >= 8 && ok) ? idFicha : -1;
+    proj.versao      = p.numCampos() >= 9 ? p[8].toInt() : 0;
+    return proj;
+}
+
+Avaliador linhaParaAvaliador(const LeitorCsv& p)
+{
+    Avaliador a;
+    a.id        = p[0].toInt();
+    a.nome      = p[1].toString();
+    a.email     = p[2].toString();
+    a.cpf       = p[3].toString();
+    a.categoria = p[4].toString();
+    a.senha     = p.numCampos() >= 6 ? p[5].toString() : "";
+    a.status    = p.numCampos() >= 7 ? p[6].toString() : "Ativo";
+    a.projetosAtribuidos = p.numCampos() >= 8 ? p[7].toInt() : 0;
+    a.versao    = p.numCampos() >= 9 ? p[8].toInt() : 0;
+    return a;
+}
+
+// ----- Mescla entre estações -----
+
+bool mesmaVersao(const Projeto& a, const Projeto& b)     { return a.versao == b.versao; }
+bool mesmaVersao(const Avaliador& a, const Avaliador& b) { return a.versao == b.versao; }
+bool mesmaVersao(const Ficha& a, const Ficha& b)         { return fichaParaLinha(a) == fichaParaLinha(b); }
+
+int versaoDe(const Projeto& p)   { return p.versao; }
+int versaoDe(const Avaliador& a) { return a.versao; }
+int versaoDe(const Ficha&)       { return 0; }
+
+// Base de um registro criado nesta estação (em 'alterados', no lugar da versão)
+constexpr int BaseRegistroNovo = -2;
+
+// Aplica sobre o conteúdo atual do disco só os registros que esta estação
+// alterou ('alterados': id -> versão em que a alteração se baseou, -1 =
+// sem conferir, BaseRegistroNovo = criado aqui). Se outra estação gravou o
+// registro depois dessa versão, a alteração daqui é descartada e o id vai
+// para 'conflitos'. Um registro criado aqui com um id que outra estação
+// já gravou ganha o próximo id livre do disco ('trocados': id daqui ->
+// id gravado), como as notas no JournalNotas.
+// Devolve true se o disco tinha alterações de outras estações.
+template <typename T>
+bool mesclarRegistros(QVector<T>& disco, const QVector<T>& memoria,
+                      const QHash<int, int>& alterados, QList<int>& conflitos,
+                      QHash<int, int>& trocados)
+{
+    QHash<int, int> posDisco, posMemoria;
+    int maxId = 0;
+    for (int i = 0; i < disco.size(); ++i) {
+        posDisco.insert(disco[i].id, i);
+        maxId = std::max(maxId, disco[i].id);
+    }
+    for (int i = 0; i < memoria.size(); ++i) {
+        posMemoria.insert(memoria[i].id, i);
+        maxId = std::max(maxId, memoria[i].id);
+    }
+
+    bool externo = false;
+    for (const T& d : disco) {
+        if (alterados.contains(d.id)) continue;
+        const auto m = posMemoria.constFind(d.id);
+        if (m == posMemoria.constEnd() || !mesmaVersao(memoria[m.value()], d))
+            externo = true;
+    }
+    for (const T& m : memoria) {
+        if (!alterados.contains(m.id) && !posDisco.contains(m.id))
+            externo = true;
+    }
+
+    QSet<int> removidos;
+    for (auto it = alterados.constBegin(); it != alterados.constEnd(); ++it) {
+        const int id     = it.key();
+        const int base   = it.value();
+        const int iDisco = posDisco.value(id, -1);
+        const int iMem   = posMemoria.value(id, -1);
+
+        if (base == BaseRegistroNovo) {
+            if (iMem < 0)
+                continue;
+            T novo = memoria[iMem];
+            if (iDisco >= 0) {
+                // Outra estação criou um registro com o mesmo id
+                novo.id = ++maxId;
+                trocados.insert(id, novo.id);
+            }
+            posDisco.insert(novo.id, disco.size());
+            disco.append(novo);
+            continue;
+        }
+
+        if (base >= 0 && (iDisco >= 0 ? versaoDe(disco[iDisco]) : 0) != base) {
+            conflitos << id;
+            continue;
+        }
+
+        if (iMem < 0) {
+            if (iDisco >= 0) removidos.insert(id);
+        } else if (iDisco >= 0) {
+            disco[iDisco] = memoria[iMem];
+        } else {
+            posDisco.insert(id, disco.size());
+            disco.append(memoria[iMem]);
+        }
+    }
+
+    if (!removidos.isEmpty()) {
+        disco.erase(std::remove_if(disco.begin(), disco.end(),
+                                   [&removidos](const T& r) { return removidos.contains(r.id); }),
+                    disco.end());
+    }
+    return externo || !conflitos.isEmpty() || !trocados.isEmpty();
+}
+
+// Relê 'arquivo' com a trava, aplica as alterações pendentes desta estação
+// e regrava, tudo dentro da seção crítica. Se não conseguir gravar, as
+// alterações voltam para 'pendentes' e vão na próxima tentativa.
+template <typename T, typename Ler, typename Salvar>
+bool mesclarArquivo(const QString& arquivo, const QString& titulo,
+                    QHash<int, int>& pendentes, const QVector<T>& memoria,
+                    Ler ler, Salvar salvar, QList<int>& conflitos,
+                    QHash<int, int>& trocados, bool& externo)
+{
+    QHash<int, int> alterados;
+    alterados.swap(pendentes);
+
+    QString erro;
+    {
+        TravaArquivo trava(arquivo);
+        QVector<T> disco;
+        if (!trava.travada()) {
+            erro = trava.descricaoErro();
+        } else if (!ler(disco)) {
+            erro = "Não foi possível reler '" + arquivo + "'.";
+        } else {
+            externo = mesclarRegistros(disco, memoria, alterados, conflitos, trocados);
+            if (salvar(disco))
+                return true;
+            trocados.clear();   // nada foi gravado: vale o id daqui
+        }
+    }
+
+    for (auto it = alterados.constBegin(); it != alterados.constEnd(); ++it) {
+        if (!pendentes.contains(it.key()))
+            pendentes.insert(it.key(), it.value());
+    }
+    if (!erro.isEmpty())
+        registrarFalha(titulo, erro);
+    return false;
+}
+
+QString chaveProjetoCpf(int idProjeto, const QString& cpf)
+{
+    return QString::number(idProjeto) + ';' + normalizarCpf(cpf);
+}
+
+} // namespace
+
+
+ArmazenamentoArquivos::ArmazenamentoArquivos()
+    : m_journalNotas(ArquivoNotas)
+    , m_acompanhamento(ArquivoAvaliacoes)
+{
+    // Fichas antes de projetos (idFicha de ficha nova renumerada) e
+    // projetos antes de vínculos (idProjeto renumerado)
+    m_gravacao.definirOrdem({ "fichas", "projetos", "vinculos",
+                              "avaliadores", "notas", "avaliacoes" });
+
+    // A chave de cada gravação agendada é o nome da coleção
+    QObject::connect(&m_gravacao, &GravacaoAgrupada::gravacaoConcluida, &m_gravacao,
+                     [this](const QString& colecao, bool ok) { avisarGravacao(colecao, ok); });
+}
+
+ArmazenamentoArquivos::~ArmazenamentoArquivos()
+{
+    // Última tentativa do que ainda está na fila. O que falhar aqui não tem
+    // mais como ser gravado: fica no log em vez de perder calado.
+    if (!m_gravacao.descarregar())
+        registrarFalha("Salvar", "Algumas alterações não puderam ser gravadas e foram perdidas.");
+    m_gravacao.descartarPendencias();
+    m_compactacaoAvaliacoes.waitForFinished();
+}
+
+bool ArmazenamentoArquivos::abrir()
+{
+    m_acompanhamento.iniciar();
+    return true;
+}
+
+
+// ================== PROJETOS ==================
+
+bool ArmazenamentoArquivos::lerProjetos(QVector<Projeto>& projetos) const
+{
+    projetos.clear();
+    if (!QFile::exists(ArquivoProjetos))
+        return true;
+
+    LeitorCsv csv(ArquivoProjetos);
+    if (!csv.abrir())
+        return false;
+
+    while (csv.proximaLinha()) {
+        if (csv.linhaEmBranco()) continue;
+        if (csv.numCampos() < 5) continue; // ID + 4 campos básicos
+
+        projetos.append(linhaParaProjeto(csv));
+    }
+    return true;
+}
+
+bool ArmazenamentoArquivos::carregarProjetos(QVector<Projeto>& projetos)
+{
+    m_gravacao.descarregar(); // não reler por cima de gravações pendentes
+    m_idsFichasTrocadas.clear(); // a memória passa a usar os ids gravados
+    if (!lerProjetos(projetos)) {
+        QMessageBox::warning(nullptr, "Carregar Projetos",
+                             "Não foi possível abrir o arquivo de projetos para leitura.");
+        return false;
+    }
+    return true;
+}
+
+bool ArmazenamentoArquivos::gravarProjeto(const QVector<Projeto>& todos, const Projeto& p)
+{
+    // Várias gravações na mesma janela: vale a versão lida antes da primeira
+    if (!m_projetosAlterados.contains(p.id))
+        m_projetosAlterados.insert(p.id, p.versao - 1);
+    m_gravacao.agendar("projetos", [this, todos] { return mesclarProjetos(todos); });
+    return !m_gravacao.falhou("projetos");
+}
+
+bool ArmazenamentoArquivos::gravarProjetoNovo(const QVector<Projeto>& todos, const Projeto& p)
+{
+    m_projetosAlterados.insert(p.id, BaseRegistroNovo);
+    m_gravacao.agendar("projetos", [this, todos] { return mesclarProjetos(todos); });
+    return !m_gravacao.falhou("projetos");
+}
+
+bool ArmazenamentoArquivos::removerProjeto(const QVector<Projeto>& todos, int id)
+{
+    m_projetosAlterados.insert(id, -1); // remover não confere versão
+    m_gravacao.agendar("projetos", [this, todos] { return mesclarProjetos(todos); });
+    return !m_gravacao.falhou("projetos");
+}
+
+bool ArmazenamentoArquivos::mesclarProjetos(const QVector<Projeto>& memoria)
+{
+    // Ficha nova gravada com outro id (mesclarFichas roda antes, na mesma
+    // descarga): os projetos daqui passam a apontar para o id gravado
+    QVector<Projeto> comFichas;
+    if (!m_idsFichasTrocadas.isEmpty()) {
+        comFichas = memoria;
+        for (Projeto& p : comFichas)
+            p.idFicha = m_idsFichasTrocadas.value(p.idFicha, p.idFicha);
+    }
+
+    QList<int> conflitos;
+    QHash<int, int> trocados;
+    bool externo = false;
+    const bool ok = mesclarArquivo(
+        ArquivoProjetos, "Salvar Projetos", m_projetosAlterados,
+        comFichas.isEmpty() ? memoria : comFichas,
+        [this](QVector<Projeto>& v) { return lerProjetos(v); },
+        [this](const QVector<Projeto>& v) { return salvarProjetos(v); },
+        conflitos, trocados, externo);
+
+    for (auto it = trocados.cbegin(); it != trocados.cend(); ++it)
+        m_idsProjetosTrocados.insert(it.key(), it.value());
+
+    if (externo)
+        avisarAlteracaoExterna("projetos", "Projeto", conflitos);
+    // Os vínculos dos projetos daqui vão para o id gravado (mesclarVinculos);
+    // a memória deles precisa ser relida junto com a dos projetos
+    if (!trocados.isEmpty())
+        avisarAlteracaoExterna("vinculos");
+    return ok;
+}
+
+bool ArmazenamentoArquivos::salvarProjetos(const QVector<Projeto>& projetos) const
+{
+    QSaveFile f(ArquivoProjetos);
+    QTextStream out;
+    if (!abrirEscrita(f, out, "Salvar Projetos"))
+        return false;
+
+    for (const Projeto& p : projetos) {
+        out << p.id                        << ';'
+            << semSeparador(p.nome)        << ';'
+            << semSeparador(p.descricao)   << ';'
+            << semSeparador(p.responsavel) << ';'
+            << semSeparador(p.categoria)   << ';'
+            << semSeparador(p.status)      << ';'
+            << semSeparador(p.ficha)       << ';'
+            << p.idFicha                   << ';'
+            << p.versao                    << '\n';
+    }
+    return concluirEscrita(f, out, "Salvar Projetos");
+}
+
+// ================== AVALIADORES ==================
+
+bool ArmazenamentoArquivos::lerAvaliadores(QVector<Avaliador>& avaliadores) const
+{
+    avaliadores.clear();
+    if (!QFile::exists(ArquivoAvaliadores))
+        return true;
+
+    LeitorCsv csv(ArquivoAvaliadores);
+    if (!csv.abrir())
+        return false;
+
+    while (csv.proximaLinha()) {
+        if (csv.linhaEmBranco()) continue;
+        if (csv.numCampos() < 5) continue; // ID + Nome + Email + CPF + Categoria
+
+        avaliadores.append(linhaParaAvaliador(csv));
+    }
+    return true;
+}
+
+bool ArmazenamentoArquivos::carregarAvaliadores(QVector<Avaliador>& avaliadores)
+{
+    m_gravacao.descarregar(); // não reler por cima de gravações pendentes
+    if (!lerAvaliadores(avaliadores)) {
+        QMessageBox::warning(nullptr, "Carregar",
+                             "Não foi possível abrir '" + ArquivoAvaliadores + "' para leitura.");
+        return false;
+    }
+    return true;
+}
+
+bool ArmazenamentoArquivos::gravarAvaliador(const QVector<Avaliador>& todos, const Avaliador& a)
+{
+    if (!m_avaliadoresAlterados.contains(a.id))
+        m_avaliadoresAlterados.insert(a.id, a.versao - 1);
+    m_gravacao.agendar("avaliadores", [this, todos] { return mesclarAvaliadores(todos); });
+    return !m_gravacao.falhou("avaliadores");
+}
+
+bool ArmazenamentoArquivos::gravarAvaliadorNovo(const QVector<Avaliador>& todos, const Avaliador& a)
+{
+    m_avaliadoresAlterados.insert(a.id, BaseRegistroNovo);
+    m_gravacao.agendar("avaliadores", [this, todos] { return mesclarAvaliadores(todos); });
+    return !m_gravacao.falhou("avaliadores");
+}
+
+bool ArmazenamentoArquivos::removerAvaliador(const QVector<Avaliador>& todos, int id)
+{
+    m_avaliadoresAlterados.insert(id, -1);
+    m_gravacao.agendar("avaliadores", [this, todos] { return mesclarAvaliadores(todos); });
+    return !m_gravacao.falhou("avaliadores");
+}
+
+bool ArmazenamentoArquivos::mesclarAvaliadores(const QVector<Avaliador>& memoria)
+{
+    // Vínculos, notas e login usam o CPF: um id trocado não afeta ninguém
+    QList<int> conflitos;
+    QHash<int, int> trocados;
+    bool externo = false;
+    const bool ok = mesclarArquivo(
+        ArquivoAvaliadores, "Salvar", m_avaliadoresAlterados, memoria,
+        [this](QVector<Avaliador>& v) { return lerAvaliadores(v); },
+        [this](const QVector<Avaliador>& v) { return salvarAvaliadores(v); },
+        conflitos, trocados, externo);
+
+    if (externo)
+        avisarAlteracaoExterna("avaliadores", "Avaliador", conflitos);
+    return ok;
+}
+
+bool ArmazenamentoArquivos::salvarAvaliadores(const QVector<Avaliador>& avaliadores) const
+{
+    QSaveFile f(ArquivoAvaliadores);
+    QTextStream out;
+    if (!abrirEscrita(f, out, "Salvar"))
+        return false;
+
+    for (const Avaliador& a : avaliadores) {
+        out << a.id                      << ';'
+            << semSeparador(a.nome)      << ';'
+            << semSeparador(a.email)     << ';'
+            << semSeparador(a.cpf)       << ';'
+            << semSeparador(a.categoria) << ';'
+            << semSeparador(a.senha)     << ';'
+            << semSeparador(a.status)    << ';'
+            << a.projetosAtribuidos      << ';'
+            << a.versao                  << '\n';
+    }
+    return concluirEscrita(f, out, "Salvar");
+}
+
+// ================== FICHAS ==================
+
+bool ArmazenamentoArquivos::lerFichas(QVector<Ficha>& fichas) const
+{
+    fichas.clear();
+
+    QFile f(ArquivoFichas);
+    if (!f.exists())
+        return true;
+
+    QTextStream in;
+    if (!abrirLeitura(f, in))
+        return false;
+
+    while (!in.atEnd()) {
+        const QString line = in.readLine();
+        if (line.trimmed().isEmpty()) continue;
+
+        Ficha ficha = linhaParaFicha(line);
+        if (ficha.id > 0)
+            fichas.append(ficha);
+    }
+    return true;
+}
+
+bool ArmazenamentoArquivos::carregarFichas(QVector<Ficha>& fichas)
+{
+    m_gravacao.descarregar(); // não reler por cima de gravações pendentes
+    if (!lerFichas(fichas)) {
+        QMessageBox::warning(nullptr, "Carregar Fichas",
+                             "Não foi possível abrir o arquivo para leitura.");
+        return false;
+    }
+    return true;
+}
+
+// Fichas não têm versão: a mescla só evita apagar as fichas das outras
+// estações (a última gravação de cada ficha vale).
+bool ArmazenamentoArquivos::gravarFicha(const QVector<Ficha>& todas, const Ficha& f)
+{
+    if (m_fichasAlteradas.value(f.id) != BaseRegistroNovo)
+        m_fichasAlteradas.insert(f.id, -1);
+    m_gravacao.agendar("fichas", [this, todas] { return mesclarFichas(todas); });
+    return !m_gravacao.falhou("fichas");
+}
+
+bool ArmazenamentoArquivos::gravarFichaNova(const QVector<Ficha>& todas, const Ficha& f)
+{
+    m_fichasAlteradas.insert(f.id, BaseRegistroNovo);
+    m_gravacao.agendar("fichas", [this, todas] { return mesclarFichas(todas); });
+    return !m_gravacao.falhou("fichas");
+}
+
+bool ArmazenamentoArquivos::removerFicha(const QVector<Ficha>& todas, int id)
+{
+    m_fichasAlteradas.insert(id, -1);
+    m_gravacao.agendar("fichas", [this, todas] { return mesclarFichas(todas); });
+    return !m_gravacao.falhou("fichas");
+}
+
+bool ArmazenamentoArquivos::mesclarFichas(const QVector<Ficha>& memoria)
+{
+    QList<int> conflitos;
+    QHash<int, int> trocados;
+    bool externo = false;
+    const bool ok = mesclarArquivo(
+        ArquivoFichas, "Salvar Fichas", m_fichasAlteradas, memoria,
+        [this](QVector<Ficha>& v) { return lerFichas(v); },
+        [this](const QVector<Ficha>& v) { return salvarFichas(v); },
+        conflitos, trocados, externo);
+
+    for (auto it = trocados.cbegin(); it != trocados.cend(); ++it)
+        m_idsFichasTrocadas.insert(it.key(), it.value());
+
+    if (externo)
+        avisarAlteracaoExterna("fichas");
+    // Os projetos daqui que usam a ficha são regravados com o id novo
+    if (!trocados.isEmpty())
+        avisarAlteracaoExterna("projetos");
+    return ok;
+}
+
+bool ArmazenamentoArquivos::salvarFichas(const QVector<Ficha>& fichas) const
+{
+    QSaveFile f(ArquivoFichas);
+    QTextStream out;
+    if (!abrirEscrita(f, out, "Salvar Fichas"))
+        return false;
+
+    for (const Ficha& ficha : fichas)
+        out << fichaParaLinha(ficha) << '\n';
+    return concluirEscrita(f, out, "Salvar Fichas");
+}
+
+// ================== VÍNCULOS ==================
+
+bool ArmazenamentoArquivos::carregarVinculos(QVector<VinculoProjeto>& vinculos)
+{
+    m_gravacao.descarregar(); // não reler por cima de gravações pendentes
+    m_idsProjetosTrocados.clear(); // a memória passa a usar os ids gravados
+    if (!lerVinculos(vinculos)) {
+        QMessageBox::warning(nullptr, "Carregar",
+                             "Não foi possível abrir '" + ArquivoVinculos + "' para leitura.");
+        return false;
+    }
+    return true;
+}
+
+bool ArmazenamentoArquivos::lerVinculos(QVector<VinculoProjeto>& vinculos) const
+{
+    return ::lerVinculos(ArquivoVinculos, vinculos);
+}
+
+bool ArmazenamentoArquivos::gravarVinculosDoProjeto(const QVector<VinculoProjeto>& todos,
+                                                    int idProjeto)
+{
+    m_vinculosProjetos.insert(idProjeto);
+    m_gravacao.agendar("vinculos", [this, todos] { return mesclarVinculos(todos); });
+    return !m_gravacao.falhou("vinculos");
+}
+
+bool ArmazenamentoArquivos::gravarVinculosDosProjetos(const QVector<VinculoProjeto>& todos,
+                                                      const QSet<int>& idsProjetos)
+{
+    m_vinculosProjetos.unite(idsProjetos);
+    m_gravacao.agendar("vinculos", [this, todos] { return mesclarVinculos(todos); });
+    return !m_gravacao.falhou("vinculos");
+}
+
+bool ArmazenamentoArquivos::removerVinculosDoAvaliador(const QVector<VinculoProjeto>& todos,
+                                                       const QString& cpf)
+{
+    m_vinculosCpfsRemovidos.insert(Cpf(cpf));
+    m_gravacao.agendar("vinculos", [this, todos] { return mesclarVinculos(todos); });
+    return !m_gravacao.falhou("vinculos");
+}
+
+// Os vínculos dos projetos redefinidos aqui saem da memória; os demais
+// ficam como estão no disco.
+bool ArmazenamentoArquivos::mesclarVinculos(const QVector<VinculoProjeto>& original)
+{
+    QSet<int> projetos;
+    QSet<Cpf> cpfs;
+    projetos.swap(m_vinculosProjetos);
+    cpfs.swap(m_vinculosCpfsRemovidos);
+
+    // Projeto novo gravado com outro id (mesclarProjetos): os vínculos
+    // dele vão para o id gravado
+    QVector<VinculoProjeto> comIds;
+    if (!m_idsProjetosTrocados.isEmpty()) {
+        comIds = original;
+        for (VinculoProjeto& v : comIds)
+            v.idProjeto = m_idsProjetosTrocados.value(v.idProjeto, v.idProjeto);
+        QSet<int> trocados;
+        for (int id : projetos)
+            trocados.insert(m_idsProjetosTrocados.value(id, id));
+        projetos.swap(trocados);
+    }
+    const QVector<VinculoProjeto>& memoria = comIds.isEmpty() ? original : comIds;
+
+    const auto tocado = [&](const VinculoProjeto& v) {
+        return projetos.contains(v.idProjeto) || cpfs.contains(v.cpf());
+    };
+
+    bool externo = false;
+    bool ok = false;
+    QString erro;
+    {
+        TravaArquivo trava(ArquivoVinculos);
+        QVector<VinculoProjeto> disco;
+        if (!trava.travada()) {
+            erro = trava.descricaoErro();
+        } else if (!lerVinculos(disco)) {
+            // Ler como vazio apagaria os vínculos das outras estações
+            erro = "Não foi possível reler '" + ArquivoVinculos + "'.";
+        } else {
+            QVector<VinculoProjeto> resultado;
+            QSet<QString> doDisco, daMemoria;
+
+            for (const VinculoProjeto& v : disco) {
+                if (tocado(v)) continue;
+                resultado.append(v);
+                doDisco.insert(chaveProjetoCpf(v.idProjeto, v.cpfAvaliador));
+            }
+            for (const VinculoProjeto& v : memoria) {
+                if (projetos.contains(v.idProjeto))
+                    resultado.append(v);
+                else if (!tocado(v))
+                    daMemoria.insert(chaveProjetoCpf(v.idProjeto, v.cpfAvaliador));
+            }
+
+            externo = doDisco != daMemoria;
+            ok = salvarVinculosNoArquivo(resultado);
+        }
+    }
+
+    if (!ok) {
+        m_vinculosProjetos.unite(projetos);
+        m_vinculosCpfsRemovidos.unite(cpfs);
+        if (!erro.isEmpty())
+            registrarFalha("Salvar Vínculos", erro);
+        return false;
+    }
+
+    if (externo)
+        avisarAlteracaoExterna("vinculos");
+    return true;
+}
+
+// ================== CONFLITOS ==================
+
+bool ArmazenamentoArquivos::carregarConflitos(QVector<ConflitoDeclarado>& conflitos)
+{
+    conflitos = ::carregarConflitos(ArquivoConflitos);
+    return true;
+}
+
+// A lista é pequena e só muda pelo administrador: grava inteira, direto.
+// A falha volta para o diálogo, que avisa.
+bool ArmazenamentoArquivos::gravarConflitos(const QVector<ConflitoDeclarado>& todos)
+{
+    TravaArquivo trava(ArquivoConflitos);
+    if (!trava.travada()) {
+        registrarFalha("Salvar Conflitos", trava.descricaoErro());
+        return false;
+    }
+    if (!salvarConflitos(ArquivoConflitos, todos)) {
+        registrarFalha("Salvar Conflitos", "Não foi possível salvar os conflitos de interesse.");
+        return false;
+    }
+    return true;
+}
+
+bool ArmazenamentoArquivos::salvarVinculosNoArquivo(const QVector<VinculoProjeto>& vinculos) const
+{
+    if (!salvarVinculos(ArquivoVinculos, vinculos)) {
+        registrarFalha("Salvar Vínculos", "Não foi possível salvar os vínculos.");
+        return false;
+    }
+    return true;
+}
+
+// ================== NOTAS ==================
+
+bool ArmazenamentoArquivos::carregarNotas(QVector<Nota>& notas)
+{
+    m_gravacao.descarregar(); // não reler por cima de gravações pendentes
+    if (!lerNotas(notas)) {
+        QMessageBox::warning(nullptr, "Carregar Notas",
+                             "Não foi possível abrir '" + ArquivoNotas + "' para leitura.");
+        notas.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ArmazenamentoArquivos::lerNotas(QVector<Nota>& notas)
+{
+    return m_journalNotas.carregar(notas);
+}
+
+bool ArmazenamentoArquivos::gravarNota(const QVector<Nota>&, const Nota& n)
+{
+    m_journalNotas.registrarGravacao(n);
+    agendarJournal();
+    return !m_gravacao.falhou("notas");
+}
+
+bool ArmazenamentoArquivos::removerNota(const QVector<Nota>&, int idNota)
+{
+    m_journalNotas.registrarRemocao(idNota);
+    agendarJournal();
+    return !m_gravacao.falhou("notas");
+}
+
+void ArmazenamentoArquivos::agendarJournal()
+{
+    // Os registros ficam em memória no JournalNotas e vão para o disco
+    // juntos (um append + fsync) quando a janela fecha.
+    m_gravacao.agendar("notas", [this] {
+        if (!m_journalNotas.descarregar()) {
+            registrarFalha("Salvar Notas",
+                           "Não foi possível gravar em '" + m_journalNotas.arquivoJournal() + "'.");
+            return false;
+        }
+
+        // Guarda antes de compactar (a compactação descarrega de novo)
+        const QList<int> conflitos = m_journalNotas.conflitos();
+        const bool externo = m_journalNotas.houveAlteracaoExterna();
+
+        if (m_journalNotas.precisaCompactar())
+            m_journalNotas.compactarEmSegundoPlano();
+        if (externo)
+            avisarAlteracaoExterna("notas", "Nota", conflitos);
+        return true;
+    });
+}
+
+// ================== AVALIAÇÕES (QUESITOS) ==================
+
+bool ArmazenamentoArquivos::lerAvaliacoes(QVector<Avaliacao>& avaliacoes, qint64* lido) const
+{
+    avaliacoes.clear();
+    if (lido)
+        *lido = 0;
+    if (!QFile::exists(ArquivoAvaliacoes))
+        return true;
+
+    LeitorCsv csv(ArquivoAvaliacoes);
+    if (!csv.abrir())
+        return false;
+
+    while (csv.proximaLinha()) {
+        if (!csv.linhaCompleta()) break;
+        if (lido)
+            *lido = csv.deslocamento();
+
+        if (csv.linhaEmBranco()) continue;
+        Avaliacao a;
+        if (linhaParaAvaliacao(csv, a))
+            avaliacoes.append(a);
+    }
+    return true;
+}
+
+bool ArmazenamentoArquivos::carregarAvaliacoes(QVector<Avaliacao>& avaliacoes)
+{
+    m_gravacao.descarregar(); // não reler por cima de gravações pendentes
+    if (!lerAvaliacoes(avaliacoes))
+        return false;
+    avaliacoesLidas(avaliacoes);
+    return true;
+}
+
+bool ArmazenamentoArquivos::lerAvaliacoes(QVector<Avaliacao>& avaliacoes)
+{
+    return lerAvaliacoes(avaliacoes, &m_avaliacoesLidasAte);
+}
+
+void ArmazenamentoArquivos::avaliacoesLidas(const QVector<Avaliacao>& avaliacoes)
+{
+    // Daqui em diante o acompanhamento só lê o que for acrescentado
+    m_acompanhamento.reposicionar(m_avaliacoesLidasAte);
+
+    // Reavaliações só acrescentam linhas; passando do limite, compacta.
+    // O arquivo trocado faz o acompanhamento pedir uma nova carga.
+    if (avaliacoes.size() >= MinimoLinhasRepetidas && !m_compactacaoAvaliacoes.isRunning()) {
+        QSet<QString> chaves;
+        chaves.reserve(avaliacoes.size());
+        for (const Avaliacao& a : avaliacoes)
+            chaves.insert(chaveProjetoCpf(a.idProjeto, a.cpfAvaliador) + ';' + QString::number(a.idFicha));
+
+        const int repetidas = avaliacoes.size() - chaves.size();
+        if (repetidas >= MinimoLinhasRepetidas && repetidas * 4 >= avaliacoes.size())
+            m_compactacaoAvaliacoes = compactarAvaliacoesEmSegundoPlano(ArquivoAvaliacoes);
+    }
+}
+
+bool ArmazenamentoArquivos::registrarAvaliacao(const QVector<Avaliacao>&, const Avaliacao& a)
+{
+    // Se já há uma reescrita do arquivo na fila, a avaliação entra nela
+    // (um append agora seria sobrescrito)
+    if (m_gravacao.pendente("avaliacoes")) {
+        m_avaliacoesNovas.append(a);
+        return !m_gravacao.falhou("avaliacoes");
+    }
+
+    // Sem como acrescentar agora: a avaliação entra na reescrita adiada,
+    // que tenta de novo e avisa pela gravação concluída
+    const auto adiar = [this, &a](const QString& erro) {
+        registrarFalha("Salvar Avaliações", erro);
+        m_avaliacoesNovas.append(a);
+        m_gravacao.agendar("avaliacoes", [this] { return mesclarAvaliacoes(); });
+        return !m_gravacao.falhou("avaliacoes");
+    };
+
+    TravaArquivo trava(ArquivoAvaliacoes);
+    if (!trava.travada())
+        return adiar(trava.descricaoErro());
+
+    QFile file(ArquivoAvaliacoes);
+    const bool arquivoExistia = file.exists();
+
+    if (!file.open(QIODevice::Append | QIODevice::Text))
+        return adiar("Não foi possível abrir " + ArquivoAvaliacoes);
+
+    // Grava os bytes direto: o acompanhamento reconhece a própria linha
+    // quando ela aparece no fim do arquivo
+    const QByteArray linha = avaliacaoParaLinha(a).toUtf8();
+    QByteArray bloco;
+    if (!arquivoExistia)
+        bloco = CabecalhoAvaliacoes;
+    bloco += linha;
+    bloco += '\n';
+
+    if (file.write(bloco) != bloco.size()) {
+        // Uma linha pela metade fica de fora na releitura da reescrita
+        file.close();
+        return adiar("Não foi possível gravar em " + ArquivoAvaliacoes);
+    }
+    file.close();
+
+    if (arquivoExistia)
+        m_acompanhamento.registrarLinhaPropria(linha);
+    else
+        m_acompanhamento.reposicionar(QFileInfo(ArquivoAvaliacoes).size());
+    return true;
+}
+
+bool ArmazenamentoArquivos::removerAvaliacoes(const QVector<Avaliacao>&,
+                                              int idProjeto, const QString& cpf)
+{
+    const QString chave = chaveProjetoCpf(idProjeto, cpf);
+    m_avaliacoesRemovidas.insert(chave);
+
+    // As que estavam na fila antes da remoção também saem
+    m_avaliacoesNovas.erase(std::remove_if(m_avaliacoesNovas.begin(), m_avaliacoesNovas.end(),
+                                           [&chave](const Avaliacao& a) {
+                                               return chaveProjetoCpf(a.idProjeto, a.cpfAvaliador) == chave;
+                                           }),
+                            m_avaliacoesNovas.end());
+
+    m_gravacao.agendar("avaliacoes", [this] { return mesclarAvaliacoes(); });
+    return !m_gravacao.falhou("avaliacoes");
+}
+
+bool ArmazenamentoArquivos::recalcularNotasDaFicha(const QVector<Avaliacao>&,
+                                                   const PesosFicha& pesos)
+{
+    // Recalculado sobre o arquivo relido, junto com as linhas de outras estações
+    m_fichasRecalcular.insert(pesos.idFicha(), pesos);
+    m_gravacao.agendar("avaliacoes", [this] { return mesclarAvaliacoes(); });
+    return !m_gravacao.falhou("avaliacoes");
+}
+
+bool ArmazenamentoArquivos::mesclarAvaliacoes()
+{
+    QSet<QString>          removidas;
+    QVector<Avaliacao>     novas;
+    QHash<int, PesosFicha> recalcular;
+    removidas.swap(m_avaliacoesRemovidas);
+    novas.swap(m_avaliacoesNovas);
+    recalcular.swap(m_fichasRecalcular);
+
+    bool ok = false;
+    QString erro;
+    {
+        TravaArquivo trava(ArquivoAvaliacoes);
+        QVector<Avaliacao> disco;
+        if (!trava.travada()) {
+            erro = trava.descricaoErro();
+        } else if (!lerAvaliacoes(disco, nullptr)) {
+            erro = "Não foi possível reler '" + ArquivoAvaliacoes + "'.";
+        } else {
+            disco.erase(std::remove_if(disco.begin(), disco.end(),
+                                       [&removidas](const Avaliacao& a) {
+                                           return removidas.contains(chaveProjetoCpf(a.idProjeto,
+                                                                                     a.cpfAvaliador));
+                                       }),
+                        disco.end());
+            disco += novas;
+            for (const PesosFicha& pesos : recalcular)
+                recalcularNotasFinais(pesos, disco);
+            ok = salvarAvaliacoes(disco);
+        }
+    }
+
+    if (!ok) {
+        m_avaliacoesRemovidas.unite(removidas);
+        m_avaliacoesNovas = novas + m_avaliacoesNovas;
+        for (auto it = recalcular.cbegin(); it != recalcular.cend(); ++it) {
+            if (!m_fichasRecalcular.contains(it.key()))
+                m_fichasRecalcular.insert(it.key(), it.value());
+        }
+        if (!erro.isEmpty())
+            registrarFalha("Salvar Avaliações", erro);
+    }
+    // O acompanhamento não é reposicionado: o arquivo trocado faz a memória
+    // ser relida, já com o que outras estações acrescentaram.
+    return ok;
+}
+
+bool ArmazenamentoArquivos::salvarAvaliacoes(const QVector<Avaliacao>& avaliacoes) const
+{
+    QSaveFile f(ArquivoAvaliacoes);
+    QTextStream out;
+    if (!abrirEscrita(f, out, "Salvar Avaliações"))
+        return false;
+
+    out << CabecalhoAvaliacoes;
+    for (const Avaliacao& a : avaliacoes)
+        out << avaliacaoParaLinha(a) << '\n';
+    return concluirEscrita(f, out, "Salvar Avaliações");
+}
+
+// ================== EXPORTAÇÃO ==================
+
+bool ArmazenamentoArquivos::descarregar()
+{
+    return m_gravacao.descarregar();
+}
+
+bool ArmazenamentoArquivos::substituirTudo(const DadosSistema& d)
+{
+    m_gravacao.descarregar();
+
+    const auto comTrava = [](const QString& arquivo, const std::function<bool()>& gravar) {
+        TravaArquivo trava(arquivo);
+        if (!trava.travada()) {
+            QMessageBox::warning(nullptr, "Exportar", trava.descricaoErro());
+            return false;
+        }
+        return gravar();
+    };
+
+    return comTrava(ArquivoFichas,      [&] { return salvarFichas(d.fichas); })
+        && comTrava(ArquivoProjetos,    [&] { return salvarProjetos(d.projetos); })
+        && comTrava(ArquivoAvaliadores, [&] { return salvarAvaliadores(d.avaliadores); })
+        && comTrava(ArquivoVinculos,    [&] { return salvarVinculosNoArquivo(d.vinculos); })
+        && m_journalNotas.substituir(d.notas)  // trava própria
+        && comTrava(ArquivoAvaliacoes,  [&] { return salvarAvaliacoes(d.avaliacoes); })
+        && comTrava(ArquivoConflitos,   [&] { return salvarConflitos(ArquivoConflitos, d.conflitos); });
+}
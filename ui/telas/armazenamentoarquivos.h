@@ -0,0 +1,145 @@
+// armazenamentoarquivos.h
+#pragma once
+
+#include "armazenamento.h"
+#include "journalnotas.h"
+#include "gravacaoagrupada.h"
+#include "acompanhamentoavaliacoes.h"
+#include "compactacaoavaliacoes.h"
+
+#include <QHash>
+#include <QSet>
+#include <QFuture>
+
+// ===== Backend de arquivos texto (formato original) =====
+//
+// projetos.txt, avaliadores.csv, fichas.txt, vinculos_projetos.csv,
+// notas.csv (+ journal) e avaliacoes.csv no diretório de trabalho.
+// As gravações são agrupadas (GravacaoAgrupada) e cada arquivo é reescrito
+// de forma atômica com QSaveFile. Os appends de outras estações no
+// avaliacoes.csv são lidos incrementalmente (AcompanhamentoAvaliacoes);
+// quando as reavaliações deixam muitas linhas repetidas nele, o arquivo é
+// compactado numa thread de trabalho (compactacaoavaliacoes.h).
+//
+// Várias estações podem usar a mesma pasta: cada gravação trava o arquivo
+// (TravaArquivo), relê o disco, aplica só os registros alterados aqui e
+// regrava. Projetos, avaliadores e notas levam um número de versão; uma
+// alteração baseada numa versão que outra estação já substituiu é recusada
+// e a coleção é recarregada (avisarAlteracaoExterna). Um registro criado
+// aqui com um id que outra estação criou ao mesmo tempo é gravado com o
+// próximo id livre (como as notas no journal).
+//
+// As gravações só agendam: o resultado de cada uma chega por
+// avisarGravacao(), e uma coleção que não pôde ser gravada fica na fila e é
+// tentada de novo. Enquanto isso as gravações dela devolvem false.
+class ArmazenamentoArquivos : public Armazenamento
+{
+public:
+    ArmazenamentoArquivos();
+    ~ArmazenamentoArquivos() override;
+
+    static const QString ArquivoProjetos;
+    static const QString ArquivoAvaliadores;
+    static const QString ArquivoFichas;
+    static const QString ArquivoVinculos;
+    static const QString ArquivoNotas;
+    static const QString ArquivoAvaliacoes;
+    static const QString ArquivoConflitos;
+
+    QString descricao() const override { return "Arquivos"; }
+    bool abrir() override;
+
+    bool carregarProjetos(QVector<Projeto>& projetos) override;
+    bool carregarAvaliadores(QVector<Avaliador>& avaliadores) override;
+    bool carregarFichas(QVector<Ficha>& fichas) override;
+    bool carregarVinculos(QVector<VinculoProjeto>& vinculos) override;
+    bool carregarNotas(QVector<Nota>& notas) override;
+    bool carregarAvaliacoes(QVector<Avaliacao>& avaliacoes) override;
+    bool carregarConflitos(QVector<ConflitoDeclarado>& conflitos) override;
+
+    bool leituraParalela() const override { return true; }
+    bool lerProjetos(QVector<Projeto>& projetos) const override;
+    bool lerAvaliadores(QVector<Avaliador>& avaliadores) const override;
+    bool lerFichas(QVector<Ficha>& fichas) const override;
+    bool lerVinculos(QVector<VinculoProjeto>& vinculos) const override;
+    bool lerNotas(QVector<Nota>& notas) override;
+    bool lerAvaliacoes(QVector<Avaliacao>& avaliacoes) override;
+    void avaliacoesLidas(const QVector<Avaliacao>& avaliacoes) override;
+
+    bool gravarProjeto(const QVector<Projeto>& todos, const Projeto& p) override;
+    bool removerProjeto(const QVector<Projeto>& todos, int id) override;
+
+    bool gravarAvaliador(const QVector<Avaliador>& todos, const Avaliador& a) override;
+    bool removerAvaliador(const QVector<Avaliador>& todos, int id) override;
+
+    bool gravarFicha(const QVector<Ficha>& todas, const Ficha& f) override;
+    bool removerFicha(const QVector<Ficha>& todas, int id) override;
+
+    bool gravarProjetoNovo(const QVector<Projeto>& todos, const Projeto& p) override;
+    bool gravarAvaliadorNovo(const QVector<Avaliador>& todos, const Avaliador& a) override;
+    bool gravarFichaNova(const QVector<Ficha>& todas, const Ficha& f) override;
+
+    bool gravarVinculosDoProjeto(const QVector<VinculoProjeto>& todos, int idProjeto) override;
+    bool gravarVinculosDosProjetos(const QVector<VinculoProjeto>& todos,
+                                   const QSet<int>& idsProjetos) override;
+    bool removerVinculosDoAvaliador(const QVector<VinculoProjeto>& todos, const QString& cpf) override;
+
+    bool gravarConflitos(const QVector<ConflitoDeclarado>& todos) override;
+
+    bool gravarNota(const QVector<Nota>& todas, const Nota& n) override;
+    bool removerNota(const QVector<Nota>& todas, int idNota) override;
+
+    bool registrarAvaliacao(const QVector<Avaliacao>& todas, const Avaliacao& a) override;
+    bool removerAvaliacoes(const QVector<Avaliacao>& todas, int idProjeto, const QString& cpf) override;
+    bool recalcularNotasDaFicha(const QVector<Avaliacao>& todas, const PesosFicha& pesos) override;
+
+    bool descarregar() override;
+    AcompanhamentoAvaliacoes* acompanhamentoAvaliacoes() override { return &m_acompanhamento; }
+    bool substituirTudo(const DadosSistema& d) override;
+
+private:
+    // notas.csv é gravado por journal (ver journalnotas.h)
+    JournalNotas     m_journalNotas;
+    GravacaoAgrupada m_gravacao;
+    AcompanhamentoAvaliacoes m_acompanhamento;
+
+    // Compacta o avaliacoes.csv a partir de tantas linhas substituídas
+    // por reavaliações (e pelo menos 1/4 do arquivo)
+    static constexpr int MinimoLinhasRepetidas = 1000;
+    QFuture<ResultadoCompactacao> m_compactacaoAvaliacoes;
+
+    qint64 m_avaliacoesLidasAte{0};   // fim da última leitura completa
+
+    // Alterações desta estação ainda não gravadas. Registros com versão:
+    // id -> versão em que a alteração se baseou (-1 = não conferir, -2 =
+    // registro criado aqui).
+    QHash<int, int>    m_projetosAlterados;
+    QHash<int, int>    m_avaliadoresAlterados;
+    QHash<int, int>    m_fichasAlteradas;
+    QSet<int>          m_vinculosProjetos;        // vínculos redefinidos
+    QSet<Cpf>          m_vinculosCpfsRemovidos;
+    QSet<QString>      m_avaliacoesRemovidas;     // "idProjeto;cpf"
+    QVector<Avaliacao> m_avaliacoesNovas;         // à espera da reescrita
+    QHash<int, PesosFicha> m_fichasRecalcular;    // idFicha -> pesos novos
+
+    // Registros criados aqui e gravados com outro id (outra estação usou o
+    // mesmo): id na memória -> id gravado, até a memória ser relida
+    QHash<int, int>    m_idsProjetosTrocados;
+    QHash<int, int>    m_idsFichasTrocadas;
+
+    bool lerAvaliacoes(QVector<Avaliacao>& avaliacoes, qint64* lido) const;
+
+    // Gravação agendada: trava, relê, aplica as alterações pendentes, grava
+    bool mesclarProjetos(const QVector<Projeto>& memoria);
+    bool mesclarAvaliadores(const QVector<Avaliador>& memoria);
+    bool mesclarFichas(const QVector<Ficha>& memoria);
+    bool mesclarVinculos(const QVector<VinculoProjeto>& memoria);
+    bool mesclarAvaliacoes();
+
+    bool salvarProjetos(const QVector<Projeto>& projetos) const;
+    bool salvarAvaliadores(const QVector<Avaliador>& avaliadores) const;
+    bool salvarFichas(const QVector<Ficha>& fichas) const;
+    bool salvarVinculosNoArquivo(const QVector<VinculoProjeto>& vinculos) const;
+    bool salvarAvaliacoes(const QVector<Avaliacao>& avaliacoes) const;
+    void agendarJournal();
+};
@@ -0,0 +1,781 @@
+// armazenamentosqlite.cpp
+#include "armazenamentosqlite.h"
+
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QVariant>
+#include <QStringList>
+#include <QMessageBox>
+#include <QSqlRecord>
+
+// ================== HELPERS ==================
+
+namespace {
+
+QString notasQuesitosParaTexto(const QVector<double>& notas)
+{
+    QStringList partes;
+    partes.reserve(notas.size());
+    for (double v : notas)
+        partes << QString::number(v, 'f', 2);
+    return partes.join('|');
+}
+
+QVector<double> textoParaNotasQuesitos(const QString& s)
+{
+    QVector<double> res;
+    if (s.trimmed().isEmpty())
+        return res;
+    const QStringList partes = s.split('|');
+    res.reserve(partes.size());
+    for (const QString& v : partes)
+        res.append(v.toDouble());
+    return res;
+}
+
+const QStringList Esquema = {
+    "CREATE TABLE IF NOT EXISTS projetos ("
+    " id INTEGER PRIMARY KEY, nome TEXT, descricao TEXT, responsavel TEXT,"
+    " categoria TEXT, status TEXT, ficha TEXT, idFicha INTEGER,"
+    " versao INTEGER NOT NULL DEFAULT 0)",
+    "CREATE INDEX IF NOT EXISTS idx_projetos_ficha ON projetos(idFicha)",
+
+    "CREATE TABLE IF NOT EXISTS avaliadores ("
+    " id INTEGER PRIMARY KEY, nome TEXT, email TEXT, cpf TEXT, cpfNorm TEXT,"
+    " categoria TEXT, senha TEXT, status TEXT, projetosAtribuidos INTEGER,"
+    " versao INTEGER NOT NULL DEFAULT 0)",
+    "CREATE INDEX IF NOT EXISTS idx_avaliadores_cpf ON avaliadores(cpfNorm)",
+
+    // A ficha inteira fica serializada no formato do fichas.txt
+    "CREATE TABLE IF NOT EXISTS fichas ("
+    " id INTEGER PRIMARY KEY, curso TEXT, dados TEXT)",
+
+    "CREATE TABLE IF NOT EXISTS vinculos ("
+    " idProjeto INTEGER, cpf TEXT, cpfNorm TEXT)",
+    "CREATE INDEX IF NOT EXISTS idx_vinculos_projeto ON vinculos(idProjeto)",
+    "CREATE INDEX IF NOT EXISTS idx_vinculos_cpf ON vinculos(cpfNorm)",
+
+    "CREATE TABLE IF NOT EXISTS notas ("
+    " idNota INTEGER PRIMARY KEY, idProjeto INTEGER, cpf TEXT, nome TEXT,"
+    " notaFinal REAL, idFicha INTEGER, versao INTEGER NOT NULL DEFAULT 0)",
+    "CREATE INDEX IF NOT EXISTS idx_notas_projeto_cpf ON notas(idProjeto, cpf)",
+    "CREATE INDEX IF NOT EXISTS idx_notas_cpf ON notas(cpf)",
+    "CREATE INDEX IF NOT EXISTS idx_notas_ficha ON notas(idFicha)",
+
+    "CREATE TABLE IF NOT EXISTS avaliacoes ("
+    " seq INTEGER PRIMARY KEY AUTOINCREMENT, idProjeto INTEGER, nomeProjeto TEXT,"
+    " responsavel TEXT, idFicha INTEGER, nomeFicha TEXT, cpf TEXT, cpfNorm TEXT,"
+    " nome TEXT, notaFinal REAL, notasQuesitos TEXT)",
+    "CREATE INDEX IF NOT EXISTS idx_avaliacoes_projeto_cpf ON avaliacoes(idProjeto, cpfNorm)",
+    "CREATE INDEX IF NOT EXISTS idx_avaliacoes_ficha ON avaliacoes(idFicha)",
+
+    "CREATE TABLE IF NOT EXISTS conflitos ("
+    " cpf TEXT, cpfNorm TEXT, idProjeto INTEGER, curso TEXT, motivo TEXT)",
+};
+
+// Bancos criados antes da coluna de versão
+const QStringList TabelasComVersao = { "projetos", "avaliadores", "notas" };
+
+} // namespace
+
+// ================== CONEXÃO ==================
+
+ArmazenamentoSqlite::ArmazenamentoSqlite(const QString& arquivoBanco)
+    : m_arquivo(arquivoBanco)
+    , m_conexao("avalia_sqlite_" + arquivoBanco)
+{
+}
+
+ArmazenamentoSqlite::~ArmazenamentoSqlite()
+{
+    // As consultas precisam morrer antes da conexão
+    m_consultas.clear();
+    {
+        QSqlDatabase db = QSqlDatabase::database(m_conexao, false);
+        if (db.isValid())
+            db.close();
+    }
+    if (QSqlDatabase::contains(m_conexao))
+        QSqlDatabase::removeDatabase(m_conexao);
+}
+
+bool ArmazenamentoSqlite::abrir()
+{
+    if (m_aberto)
+        return true;
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", m_conexao);
+    db.setDatabaseName(m_arquivo);
+    // Outra estação gravando: espera a vez em vez de falhar na hora
+    db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+    if (!db.open()) {
+        QMessageBox::warning(nullptr, "Banco de dados",
+                             "Não foi possível abrir '" + m_arquivo + "':\n"
+                                 + db.lastError().text());
+        return false;
+    }
+
+    // Journal de rollback (DELETE), não WAL: o banco pode estar numa pasta
+    // de rede compartilhada pelas estações, e o WAL depende de memória
+    // compartilhada num mesmo computador (em rede corrompe o banco). Um
+    // banco que ficou em WAL volta para DELETE quando ninguém mais o usa.
+    executarLote({ "PRAGMA journal_mode=DELETE", "PRAGMA synchronous=FULL" });
+
+    m_aberto = criarTabelas();
+    return m_aberto;
+}
+
+bool ArmazenamentoSqlite::criarTabelas()
+{
+    QSqlDatabase db = QSqlDatabase::database(m_conexao);
+    db.transaction();
+    if (!executarLote(Esquema)) {
+        db.rollback();
+        return false;
+    }
+    for (const QString& tabela : TabelasComVersao) {
+        if (!db.record(tabela).contains("versao")
+            && !executarLote({ "ALTER TABLE " + tabela
+                               + " ADD COLUMN versao INTEGER NOT NULL DEFAULT 0" })) {
+            db.rollback();
+            return false;
+        }
+    }
+    return db.commit();
+}
+
+// IMMEDIATE: a trava de escrita do banco é pega já no BEGIN, então a versão
+// conferida não muda até o COMMIT
+bool ArmazenamentoSqlite::iniciarTransacao()
+{
+    return executarLote({ "BEGIN IMMEDIATE" });
+}
+
+bool ArmazenamentoSqlite::concluirTransacao(bool ok)
+{
+    QSqlQuery q(QSqlDatabase::database(m_conexao));
+    if (ok && q.exec("COMMIT"))
+        return true;
+    q.exec("ROLLBACK");
+    return false;
+}
+
+// Versão do registro no banco; 0 se não existe
+int ArmazenamentoSqlite::versaoNoBanco(const QString& tabela, const QString& colunaId, int id)
+{
+    QSqlQuery& q = preparada("SELECT versao FROM " + tabela + " WHERE " + colunaId + " = ?");
+    q.addBindValue(id);
+    int versao = 0;
+    if (q.exec() && q.next())
+        versao = q.value(0).toInt();
+    q.finish();
+    return versao;
+}
+
+// Grava se o registro ainda está na versão em que a alteração se baseou
+// (versao - 1); senão avisa o conflito e não grava nada.
+bool ArmazenamentoSqlite::gravarComVersao(const QString& tabela, const QString& colunaId,
+                                          int id, int versao, const QString& tipo,
+                                          const std::function<bool()>& inserir)
+{
+    if (!iniciarTransacao())
+        return false;
+
+    if (versaoNoBanco(tabela, colunaId, id) != versao - 1) {
+        concluirTransacao(false);
+        avisarAlteracaoExterna(tabela, tipo, { id });
+        return false;
+    }
+    return concluirTransacao(inserir());
+}
+
+// Registro criado nesta estação: se outra estação já gravou o mesmo id, o
+// registro ganha o próximo livre e a memória é recarregada para pegar o id
+// definitivo (como as notas novas em gravarNota)
+bool ArmazenamentoSqlite::gravarNovo(const QString& tabela, int id,
+                                     const std::function<bool(int id)>& inserir)
+{
+    if (!iniciarTransacao())
+        return false;
+
+    QSqlQuery& q = preparada("SELECT 1 FROM " + tabela + " WHERE id = ?");
+    q.addBindValue(id);
+    const bool ocupado = q.exec() && q.next();
+    q.finish();
+
+    int idGravado = id;
+    if (ocupado) {
+        QSqlQuery& maior = preparada("SELECT COALESCE(MAX(id), 0) + 1 FROM " + tabela);
+        if (maior.exec() && maior.next())
+            idGravado = maior.value(0).toInt();
+        maior.finish();
+    }
+
+    const bool ok = concluirTransacao(inserir(idGravado));
+    if (ok && idGravado != id)
+        avisarAlteracaoExterna(tabela);
+    return ok;
+}
+
+QSqlQuery& ArmazenamentoSqlite::preparada(const QString& sql)
+{
+    auto it = m_consultas.find(sql);
+    if (it == m_consultas.end()) {
+        QSqlQuery q(QSqlDatabase::database(m_conexao));
+        q.prepare(sql);
+        it = m_consultas.insert(sql, q);
+    }
+    return it.value();
+}
+
+bool ArmazenamentoSqlite::executar(QSqlQuery& q)
+{
+    if (q.exec())
+        return true;
+
+    QMessageBox::warning(nullptr, "Banco de dados",
+                         "Erro ao gravar em '" + m_arquivo + "':\n"
+                             + q.lastError().text());
+    return false;
+}
+
+bool ArmazenamentoSqlite::executarLote(const QStringList& comandos)
+{
+    QSqlQuery q(QSqlDatabase::database(m_conexao));
+    for (const QString& sql : comandos) {
+        if (!q.exec(sql)) {
+            QMessageBox::warning(nullptr, "Banco de dados",
+                                 "Erro ao preparar '" + m_arquivo + "':\n"
+                                     + q.lastError().text());
+            return false;
+        }
+    }
+    return true;
+}
+
+// ================== CARGA ==================
+
+bool ArmazenamentoSqlite::carregarProjetos(QVector<Projeto>& projetos)
+{
+    projetos.clear();
+    QSqlQuery& q = preparada(
+        "SELECT id, nome, descricao, responsavel, categoria, status, ficha, idFicha, versao"
+        " FROM projetos ORDER BY id");
+    if (!executar(q))
+        return false;
+
+    while (q.next()) {
+        Projeto p;
+        p.id          = q.value(0).toInt();
+        p.nome        = q.value(1).toString();
+        p.descricao   = q.value(2).toString();
+        p.responsavel = q.value(3).toString();
+        p.categoria   = q.value(4).toString();
+        p.status      = q.value(5).toString();
+        p.ficha       = q.value(6).toString();
+        p.idFicha     = q.value(7).toInt();
+        p.versao      = q.value(8).toInt();
+        projetos.append(p);
+    }
+    q.finish();
+    return true;
+}
+
+bool ArmazenamentoSqlite::carregarAvaliadores(QVector<Avaliador>& avaliadores)
+{
+    avaliadores.clear();
+    QSqlQuery& q = preparada(
+        "SELECT id, nome, email, cpf, categoria, senha, status, projetosAtribuidos, versao"
+        " FROM avaliadores ORDER BY id");
+    if (!executar(q))
+        return false;
+
+    while (q.next()) {
+        Avaliador a;
+        a.id                 = q.value(0).toInt();
+        a.nome               = q.value(1).toString();
+        a.email              = q.value(2).toString();
+        a.cpf                = q.value(3).toString();
+        a.categoria          = q.value(4).toString();
+        a.senha              = q.value(5).toString();
+        a.status             = q.value(6).toString();
+        a.projetosAtribuidos = q.value(7).toInt();
+        a.versao             = q.value(8).toInt();
+        avaliadores.append(a);
+    }
+    q.finish();
+    return true;
+}
+
+bool ArmazenamentoSqlite::carregarFichas(QVector<Ficha>& fichas)
+{
+    fichas.clear();
+    QSqlQuery& q = preparada("SELECT dados FROM fichas ORDER BY id");
+    if (!executar(q))
+        return false;
+
+    while (q.next()) {
+        Ficha f = linhaParaFicha(q.value(0).toString());
+        if (f.id > 0)
+            fichas.append(f);
+    }
+    q.finish();
+    return true;
+}
+
+bool ArmazenamentoSqlite::carregarVinculos(QVector<VinculoProjeto>& vinculos)
+{
+    vinculos.clear();
+    QSqlQuery& q = preparada("SELECT idProjeto, cpf FROM vinculos ORDER BY rowid");
+    if (!executar(q))
+        return false;
+
+    while (q.next()) {
+        VinculoProjeto v;
+        v.idProjeto    = q.value(0).toInt();
+        v.cpfAvaliador = q.value(1).toString();
+        vinculos.append(v);
+    }
+    q.finish();
+    return true;
+}
+
+bool ArmazenamentoSqlite::carregarNotas(QVector<Nota>& notas)
+{
+    notas.clear();
+    QSqlQuery& q = preparada(
+        "SELECT idNota, idProjeto, cpf, nome, notaFinal, idFicha, versao"
+        " FROM notas ORDER BY idNota");
+    if (!executar(q))
+        return false;
+
+    while (q.next()) {
+        Nota n;
+        n.idNota        = q.value(0).toInt();
+        n.idProjeto     = q.value(1).toInt();
+        n.cpfAvaliador  = q.value(2).toString();
+        n.nomeAvaliador = q.value(3).toString();
+        n.notaFinal     = q.value(4).toDouble();
+        n.idFicha       = q.value(5).toInt();
+        n.versao        = q.value(6).toInt();
+        notas.append(n);
+    }
+    q.finish();
+    return true;
+}
+
+bool ArmazenamentoSqlite::carregarAvaliacoes(QVector<Avaliacao>& avaliacoes)
+{
+    avaliacoes.clear();
+    QSqlQuery& q = preparada(
+        "SELECT idProjeto, nomeProjeto, responsavel, idFicha, nomeFicha,"
+        " cpf, nome, notaFinal, notasQuesitos FROM avaliacoes ORDER BY seq");
+    if (!executar(q))
+        return false;
+
+    while (q.next()) {
+        Avaliacao a;
+        a.idProjeto     = q.value(0).toInt();
+        a.nomeProjeto   = q.value(1).toString();
+        a.responsavel   = q.value(2).toString();
+        a.idFicha       = q.value(3).toInt();
+        a.nomeFicha     = q.value(4).toString();
+        a.cpfAvaliador  = q.value(5).toString();
+        a.nomeAvaliador = q.value(6).toString();
+        a.notaFinal     = q.value(7).toDouble();
+        a.notasQuesitos = textoParaNotasQuesitos(q.value(8).toString());
+        avaliacoes.append(a);
+    }
+    q.finish();
+    return true;
+}
+
+bool ArmazenamentoSqlite::carregarConflitos(QVector<ConflitoDeclarado>& conflitos)
+{
+    conflitos.clear();
+    QSqlQuery& q = preparada(
+        "SELECT cpf, idProjeto, curso, motivo FROM conflitos ORDER BY rowid");
+    if (!executar(q))
+        return false;
+
+    while (q.next()) {
+        ConflitoDeclarado c;
+        c.cpfAvaliador = q.value(0).toString();
+        c.idProjeto    = q.value(1).toInt();
+        c.curso        = q.value(2).toString();
+        c.motivo       = q.value(3).toString();
+        conflitos.append(c);
+    }
+    q.finish();
+    return true;
+}
+
+// ================== INSERÇÃO (INSERT OR REPLACE) ==================
+
+bool ArmazenamentoSqlite::inserirProjeto(const Projeto& p)
+{
+    QSqlQuery& q = preparada(
+        "INSERT OR REPLACE INTO projetos"
+        " (id, nome, descricao, responsavel, categoria, status, ficha, idFicha, versao)"
+        " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    q.addBindValue(p.id);
+    q.addBindValue(p.nome);
+    q.addBindValue(p.descricao);
+    q.addBindValue(p.responsavel);
+    q.addBindValue(p.categoria);
+    q.addBindValue(p.status);
+    q.addBindValue(p.ficha);
+    q.addBindValue(p.idFicha);
+    q.addBindValue(p.versao);
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::inserirAvaliador(const Avaliador& a)
+{
+    QSqlQuery& q = preparada(
+        "INSERT OR REPLACE INTO avaliadores"
+        " (id, nome, email, cpf, cpfNorm, categoria, senha, status, projetosAtribuidos, versao)"
+        " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    q.addBindValue(a.id);
+    q.addBindValue(a.nome);
+    q.addBindValue(a.email);
+    q.addBindValue(a.cpf);
+    q.addBindValue(normalizarCpf(a.cpf));
+    q.addBindValue(a.categoria);
+    q.addBindValue(a.senha);
+    q.addBindValue(a.status);
+    q.addBindValue(a.projetosAtribuidos);
+    q.addBindValue(a.versao);
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::inserirFicha(const Ficha& f)
+{
+    QSqlQuery& q = preparada(
+        "INSERT OR REPLACE INTO fichas (id, curso, dados) VALUES (?, ?, ?)");
+    q.addBindValue(f.id);
+    q.addBindValue(f.curso);
+    q.addBindValue(fichaParaLinha(f));
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::inserirVinculo(const VinculoProjeto& v)
+{
+    QSqlQuery& q = preparada(
+        "INSERT INTO vinculos (idProjeto, cpf, cpfNorm) VALUES (?, ?, ?)");
+    q.addBindValue(v.idProjeto);
+    q.addBindValue(v.cpfAvaliador);
+    q.addBindValue(normalizarCpf(v.cpfAvaliador));
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::inserirNota(const Nota& n)
+{
+    QSqlQuery& q = preparada(
+        "INSERT OR REPLACE INTO notas (idNota, idProjeto, cpf, nome, notaFinal, idFicha, versao)"
+        " VALUES (?, ?, ?, ?, ?, ?, ?)");
+    q.addBindValue(n.idNota);
+    q.addBindValue(n.idProjeto);
+    q.addBindValue(n.cpfAvaliador);
+    q.addBindValue(n.nomeAvaliador);
+    q.addBindValue(n.notaFinal);
+    q.addBindValue(n.idFicha);
+    q.addBindValue(n.versao);
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::inserirAvaliacao(const Avaliacao& a)
+{
+    QSqlQuery& q = preparada(
+        "INSERT INTO avaliacoes (idProjeto, nomeProjeto, responsavel, idFicha, nomeFicha,"
+        " cpf, cpfNorm, nome, notaFinal, notasQuesitos)"
+        " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    q.addBindValue(a.idProjeto);
+    q.addBindValue(a.nomeProjeto);
+    q.addBindValue(a.responsavel);
+    q.addBindValue(a.idFicha);
+    q.addBindValue(a.nomeFicha);
+    q.addBindValue(a.cpfAvaliador);
+    q.addBindValue(normalizarCpf(a.cpfAvaliador));
+    q.addBindValue(a.nomeAvaliador);
+    q.addBindValue(a.notaFinal);
+    q.addBindValue(notasQuesitosParaTexto(a.notasQuesitos));
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::inserirConflito(const ConflitoDeclarado& c)
+{
+    QSqlQuery& q = preparada(
+        "INSERT INTO conflitos (cpf, cpfNorm, idProjeto, curso, motivo) VALUES (?, ?, ?, ?, ?)");
+    q.addBindValue(c.cpfAvaliador);
+    q.addBindValue(normalizarCpf(c.cpfAvaliador));
+    q.addBindValue(c.idProjeto);
+    q.addBindValue(c.curso);
+    q.addBindValue(c.motivo);
+    return executar(q);
+}
+
+// ================== GRAVAÇÃO ==================
+
+bool ArmazenamentoSqlite::gravarProjeto(const QVector<Projeto>&, const Projeto& p)
+{
+    return gravarComVersao("projetos", "id", p.id, p.versao, "Projeto",
+                           [this, &p] { return inserirProjeto(p); });
+}
+
+bool ArmazenamentoSqlite::gravarProjetoNovo(const QVector<Projeto>&, const Projeto& p)
+{
+    return gravarNovo("projetos", p.id, [this, &p](int id) {
+        Projeto novo = p;
+        novo.id = id;
+        return inserirProjeto(novo);
+    });
+}
+
+bool ArmazenamentoSqlite::removerProjeto(const QVector<Projeto>&, int id)
+{
+    QSqlQuery& q = preparada("DELETE FROM projetos WHERE id = ?");
+    q.addBindValue(id);
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::gravarAvaliador(const QVector<Avaliador>&, const Avaliador& a)
+{
+    return gravarComVersao("avaliadores", "id", a.id, a.versao, "Avaliador",
+                           [this, &a] { return inserirAvaliador(a); });
+}
+
+bool ArmazenamentoSqlite::gravarAvaliadorNovo(const QVector<Avaliador>&, const Avaliador& a)
+{
+    return gravarNovo("avaliadores", a.id, [this, &a](int id) {
+        Avaliador novo = a;
+        novo.id = id;
+        return inserirAvaliador(novo);
+    });
+}
+
+bool ArmazenamentoSqlite::removerAvaliador(const QVector<Avaliador>&, int id)
+{
+    QSqlQuery& q = preparada("DELETE FROM avaliadores WHERE id = ?");
+    q.addBindValue(id);
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::gravarFicha(const QVector<Ficha>&, const Ficha& f)
+{
+    return inserirFicha(f);
+}
+
+bool ArmazenamentoSqlite::gravarFichaNova(const QVector<Ficha>&, const Ficha& f)
+{
+    return gravarNovo("fichas", f.id, [this, &f](int id) {
+        Ficha nova = f;
+        nova.id = id;
+        return inserirFicha(nova);
+    });
+}
+
+bool ArmazenamentoSqlite::removerFicha(const QVector<Ficha>&, int id)
+{
+    QSqlQuery& q = preparada("DELETE FROM fichas WHERE id = ?");
+    q.addBindValue(id);
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::gravarVinculosDoProjeto(const QVector<VinculoProjeto>& todos,
+                                                  int idProjeto)
+{
+    QSqlDatabase db = QSqlDatabase::database(m_conexao);
+    db.transaction();
+
+    QSqlQuery& del = preparada("DELETE FROM vinculos WHERE idProjeto = ?");
+    del.addBindValue(idProjeto);
+    bool ok = executar(del);
+
+    for (const VinculoProjeto& v : todos) {
+        if (!ok) break;
+        if (v.idProjeto == idProjeto)
+            ok = inserirVinculo(v);
+    }
+
+    if (!ok) {
+        db.rollback();
+        return false;
+    }
+    return db.commit();
+}
+
+bool ArmazenamentoSqlite::gravarVinculosDosProjetos(const QVector<VinculoProjeto>& todos,
+                                                    const QSet<int>& idsProjetos)
+{
+    QSqlDatabase db = QSqlDatabase::database(m_conexao);
+    db.transaction();
+
+    bool ok = true;
+    for (int idProjeto : idsProjetos) {
+        QSqlQuery& del = preparada("DELETE FROM vinculos WHERE idProjeto = ?");
+        del.addBindValue(idProjeto);
+        if (!(ok = executar(del)))
+            break;
+    }
+
+    for (const VinculoProjeto& v : todos) {
+        if (!ok) break;
+        if (idsProjetos.contains(v.idProjeto))
+            ok = inserirVinculo(v);
+    }
+
+    if (!ok) {
+        db.rollback();
+        return false;
+    }
+    return db.commit();
+}
+
+bool ArmazenamentoSqlite::gravarConflitos(const QVector<ConflitoDeclarado>& todos)
+{
+    QSqlDatabase db = QSqlDatabase::database(m_conexao);
+    db.transaction();
+
+    bool ok = executarLote({ "DELETE FROM conflitos" });
+    for (int i = 0; ok && i < todos.size(); ++i)
+        ok = inserirConflito(todos[i]);
+
+    if (!ok) {
+        db.rollback();
+        return false;
+    }
+    return db.commit();
+}
+
+bool ArmazenamentoSqlite::removerVinculosDoAvaliador(const QVector<VinculoProjeto>&,
+                                                     const QString& cpf)
+{
+    QSqlQuery& q = preparada("DELETE FROM vinculos WHERE cpfNorm = ?");
+    q.addBindValue(normalizarCpf(cpf));
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::gravarNota(const QVector<Nota>&, const Nota& n)
+{
+    // Nota nova com um id que outra estação já usou: ganha o próximo livre
+    // e a memória é recarregada para pegar o id definitivo
+    if (n.versao == 1) {
+        if (!iniciarTransacao())
+            return false;
+
+        QSqlQuery& q = preparada("SELECT idProjeto, cpf FROM notas WHERE idNota = ?");
+        q.addBindValue(n.idNota);
+        const bool ocupado = q.exec() && q.next()
+                          && (q.value(0).toInt() != n.idProjeto || q.value(1).toString() != n.cpfAvaliador);
+        q.finish();
+
+        if (ocupado) {
+            QSqlQuery& maior = preparada("SELECT COALESCE(MAX(idNota), 0) + 1 FROM notas");
+            Nota nova = n;
+            if (maior.exec() && maior.next())
+                nova.idNota = maior.value(0).toInt();
+            maior.finish();
+
+            const bool ok = concluirTransacao(inserirNota(nova));
+            if (ok)
+                avisarAlteracaoExterna("notas");
+            return ok;
+        }
+        concluirTransacao(false);
+    }
+
+    return gravarComVersao("notas", "idNota", n.idNota, n.versao, "Nota",
+                           [this, &n] { return inserirNota(n); });
+}
+
+bool ArmazenamentoSqlite::removerNota(const QVector<Nota>&, int idNota)
+{
+    QSqlQuery& q = preparada("DELETE FROM notas WHERE idNota = ?");
+    q.addBindValue(idNota);
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::registrarAvaliacao(const QVector<Avaliacao>&, const Avaliacao& a)
+{
+    return inserirAvaliacao(a);
+}
+
+bool ArmazenamentoSqlite::removerAvaliacoes(const QVector<Avaliacao>&,
+                                            int idProjeto, const QString& cpf)
+{
+    QSqlQuery& q = preparada("DELETE FROM avaliacoes WHERE idProjeto = ? AND cpfNorm = ?");
+    q.addBindValue(idProjeto);
+    q.addBindValue(normalizarCpf(cpf));
+    return executar(q);
+}
+
+bool ArmazenamentoSqlite::recalcularNotasDaFicha(const QVector<Avaliacao>&,
+                                                 const PesosFicha& pesos)
+{
+    if (!iniciarTransacao())
+        return false;
+
+    // Recalcula a partir do banco (pode ter linhas de outras estações)
+    QVector<qint64>    seqs;
+    QVector<Avaliacao> linhas;
+    QSqlQuery& sel = preparada(
+        "SELECT seq, notaFinal, notasQuesitos FROM avaliacoes WHERE idFicha = ?");
+    sel.addBindValue(pesos.idFicha());
+    if (!executar(sel))
+        return concluirTransacao(false);
+    while (sel.next()) {
+        Avaliacao a;
+        a.idFicha       = pesos.idFicha();
+        a.notaFinal     = sel.value(1).toDouble();
+        a.notasQuesitos = textoParaNotasQuesitos(sel.value(2).toString());
+        seqs.append(sel.value(0).toLongLong());
+        linhas.append(a);
+    }
+    sel.finish();
+
+    QVector<double> antes;
+    antes.reserve(linhas.size());
+    for (const Avaliacao& a : linhas)
+        antes.append(a.notaFinal);
+    if (recalcularNotasFinais(pesos, linhas) == 0)
+        return concluirTransacao(true);
+
+    bool ok = true;
+    QSqlQuery& upd = preparada("UPDATE avaliacoes SET notaFinal = ? WHERE seq = ?");
+    for (int i = 0; ok && i < linhas.size(); ++i) {
+        if (linhas[i].notaFinal == antes[i])
+            continue;
+        upd.addBindValue(linhas[i].notaFinal);
+        upd.addBindValue(seqs[i]);
+        ok = executar(upd);
+    }
+    return concluirTransacao(ok);
+}
+
+// ================== IMPORTAÇÃO ==================
+
+bool ArmazenamentoSqlite::substituirTudo(const DadosSistema& d)
+{
+    QSqlDatabase db = QSqlDatabase::database(m_conexao);
+    db.transaction();
+
+    bool ok = executarLote({ "DELETE FROM projetos", "DELETE FROM avaliadores",
+                             "DELETE FROM fichas",   "DELETE FROM vinculos",
+                             "DELETE FROM notas",    "DELETE FROM avaliacoes",
+                             "DELETE FROM conflitos" });
+
+    for (int i = 0; ok && i < d.fichas.size(); ++i)      ok = inserirFicha(d.fichas[i]);
+    for (int i = 0; ok && i < d.projetos.size(); ++i)    ok = inserirProjeto(d.projetos[i]);
+    for (int i = 0; ok && i < d.avaliadores.size(); ++i) ok = inserirAvaliador(d.avaliadores[i]);
+    for (int i = 0; ok && i < d.vinculos.size(); ++i)    ok = inserirVinculo(d.vinculos[i]);
+    for (int i = 0; ok && i < d.notas.size(); ++i)       ok = inserirNota(d.notas[i]);
+    for (int i = 0; ok && i < d.avaliacoes.size(); ++i)  ok = inserirAvaliacao(d.avaliacoes[i]);
+    for (int i = 0; ok && i < d.conflitos.size(); ++i)   ok = inserirConflito(d.conflitos[i]);
+
+    if (!ok) {
+        db.rollback();
+        return false;
+    }
+    return db.commit();
+}
@@ -0,0 +1,98 @@
+// armazenamentosqlite.h
+#pragma once
+
+#include <QHash>
+#include <QSqlQuery>
+
+#include <functional>
+
+#include "armazenamento.h"
+
+// ===== Backend SQLite (driver QSQLITE do Qt Sql) =====
+//
+// Uma tabela por tipo de registro, com índices em idProjeto, CPF
+// (normalizado) e idFicha. Cada gravação altera só a linha afetada, sempre
+// por consultas preparadas (reaproveitadas entre chamadas).
+// Projetos, avaliadores e notas conferem a coluna 'versao' dentro de uma
+// transação BEGIN IMMEDIATE antes de gravar (ver registros.h).
+//
+// Várias estações podem abrir o mesmo arquivo numa pasta de rede: por isso
+// o journal é o de rollback (DELETE) e não WAL, e quem encontra o banco
+// ocupado espera até 5 s pela vez. A pasta precisa ter travas de arquivo
+// funcionando (compartilhamento Windows/SMB; NFS sem lockd não serve).
+class ArmazenamentoSqlite : public Armazenamento
+{
+public:
+    explicit ArmazenamentoSqlite(const QString& arquivoBanco);
+    ~ArmazenamentoSqlite() override;
+
+    QString descricao() const override { return "SQLite: " + m_arquivo; }
+    bool abrir() override;
+
+    bool carregarProjetos(QVector<Projeto>& projetos) override;
+    bool carregarAvaliadores(QVector<Avaliador>& avaliadores) override;
+    bool carregarFichas(QVector<Ficha>& fichas) override;
+    bool carregarVinculos(QVector<VinculoProjeto>& vinculos) override;
+    bool carregarNotas(QVector<Nota>& notas) override;
+    bool carregarAvaliacoes(QVector<Avaliacao>& avaliacoes) override;
+    bool carregarConflitos(QVector<ConflitoDeclarado>& conflitos) override;
+
+    bool gravarProjeto(const QVector<Projeto>&, const Projeto& p) override;
+    bool removerProjeto(const QVector<Projeto>&, int id) override;
+
+    bool gravarAvaliador(const QVector<Avaliador>&, const Avaliador& a) override;
+    bool removerAvaliador(const QVector<Avaliador>&, int id) override;
+
+    bool gravarFicha(const QVector<Ficha>&, const Ficha& f) override;
+    bool removerFicha(const QVector<Ficha>&, int id) override;
+
+    bool gravarProjetoNovo(const QVector<Projeto>&, const Projeto& p) override;
+    bool gravarAvaliadorNovo(const QVector<Avaliador>&, const Avaliador& a) override;
+    bool gravarFichaNova(const QVector<Ficha>&, const Ficha& f) override;
+
+    bool gravarVinculosDoProjeto(const QVector<VinculoProjeto>& todos, int idProjeto) override;
+    bool gravarVinculosDosProjetos(const QVector<VinculoProjeto>& todos,
+                                   const QSet<int>& idsProjetos) override;
+    bool removerVinculosDoAvaliador(const QVector<VinculoProjeto>&, const QString& cpf) override;
+
+    bool gravarConflitos(const QVector<ConflitoDeclarado>& todos) override;
+
+    bool gravarNota(const QVector<Nota>&, const Nota& n) override;
+    bool removerNota(const QVector<Nota>&, int idNota) override;
+
+    bool registrarAvaliacao(const QVector<Avaliacao>&, const Avaliacao& a) override;
+    bool removerAvaliacoes(const QVector<Avaliacao>&, int idProjeto, const QString& cpf) override;
+    bool recalcularNotasDaFicha(const QVector<Avaliacao>&, const PesosFicha& pesos) override;
+
+    bool substituirTudo(const DadosSistema& d) override;
+
+private:
+    QString m_arquivo;
+    QString m_conexao;
+    bool    m_aberto{false};
+
+    // SQL -> consulta já preparada
+    QHash<QString, QSqlQuery> m_consultas;
+
+    QSqlQuery& preparada(const QString& sql);
+    bool executar(QSqlQuery& q);
+    bool executarLote(const QStringList& comandos);
+    bool criarTabelas();
+
+    bool iniciarTransacao();
+    bool concluirTransacao(bool ok);   // COMMIT se ok, senão ROLLBACK
+    int  versaoNoBanco(const QString& tabela, const QString& colunaId, int id);
+    bool gravarComVersao(const QString& tabela, const QString& colunaId,
+                         int id, int versao, const QString& tipo,
+                         const std::function<bool()>& inserir);
+    bool gravarNovo(const QString& tabela, int id,
+                    const std::function<bool(int id)>& inserir);
+
+    bool inserirProjeto(const Projeto& p);
+    bool inserirAvaliador(const Avaliador& a);
+    bool inserirFicha(const Ficha& f);
+    bool inserirVinculo(const VinculoProjeto& v);
+    bool inserirNota(const Nota& n);
+    bool inserirAvaliacao(const Avaliacao& a);
+    bool inserirConflito(const ConflitoDeclarado& c);
+};
@@ -0,0 +1,171 @@
+// compactacaoavaliacoes.cpp
+#include "compactacaoavaliacoes.h"
+#include "acompanhamentoavaliacoes.h"
+#include "leitorcsv.h"
+#include "travaarquivo.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QHash>
+#include <QVector>
+#include <QtConcurrent>
+
+// ================== HELPERS ==================
+
+namespace {
+
+// "idProjeto;cpf só dígitos;idFicha", direto dos bytes da linha.
+// Vazio se a linha não é de dados (cabeçalho, linha quebrada).
+QByteArray chaveDaLinha(const LeitorCsv& csv)
+{
+    if (csv.numCampos() < 8)
+        return QByteArray();
+
+    bool ok = false;
+    const int idProjeto = csv[0].toInt(&ok);
+    if (!ok)
+        return QByteArray();
+
+    QByteArray chave = QByteArray::number(idProjeto);
+    chave += ';';
+    const CampoCsv cpf = csv[5];
+    for (int i = 0; i < cpf.tamanho; ++i) {
+        if (cpf.dados[i] >= '0' && cpf.dados[i] <= '9')
+            chave += cpf.dados[i];
+    }
+    chave += ';';
+    chave += QByteArray::number(csv[3].toInt());
+    return chave;
+}
+
+// Copia as linhas completas de [inicio, fim) de 'arquivo' para 'destino'.
+// Devolve o número de linhas de dados copiadas, ou -1 em erro.
+int copiarTrecho(const QString& arquivo, qint64 inicio, qint64 fim, QIODevice& destino)
+{
+    if (fim <= inicio)
+        return 0;
+
+    QFile f(arquivo);
+    if (!f.open(QIODevice::ReadOnly) || !f.seek(inicio))
+        return -1;
+
+    QByteArray trecho = f.read(fim - inicio);
+    trecho.truncate(trecho.lastIndexOf('\n') + 1);
+
+    int linhas = 0;
+    LeitorCsv csv(trecho);
+    csv.abrir();
+    while (csv.proximaLinha()) {
+        if (!chaveDaLinha(csv).isEmpty())
+            ++linhas;
+    }
+    return destino.write(trecho) == trecho.size() ? linhas : -1;
+}
+
+} // namespace
+
+// ================== COMPACTAÇÃO ==================
+
+ResultadoCompactacao compactarAvaliacoes(const QString& arquivo)
+{
+    ResultadoCompactacao r;
+
+    qint64  tamanho = 0;
+    quint64 identidade = 0;
+    if (!estadoDoArquivo(arquivo, tamanho, identidade)) {
+        r.ok = true; // nada a compactar
+        return r;
+    }
+
+    LeitorCsv csv(arquivo);
+    if (!csv.abrir()) {
+        r.erro = "Não foi possível abrir '" + arquivo + "' para leitura.";
+        return r;
+    }
+
+    // 1ª passada: em que linha está a última ocorrência de cada chave.
+    // Só até 'tamanho' (o que foi acrescentado depois é copiado no fim).
+    QHash<QByteArray, int> ultima;
+    QVector<QByteArray>    chaves;
+    qint64 lido = 0;
+    while (csv.proximaLinha() && csv.linhaCompleta() && csv.deslocamento() <= tamanho) {
+        lido = csv.deslocamento();
+        const QByteArray chave = chaveDaLinha(csv);
+        if (!chave.isEmpty()) {
+            ultima.insert(chave, chaves.size());
+            ++r.linhasAntes;
+        }
+        chaves.append(chave);
+    }
+
+    if (r.linhasAntes == ultima.size()) {
+        // Nenhuma linha repetida: não vale reescrever o arquivo
+        r.ok = true;
+        r.bytesAntes = r.bytesDepois = tamanho;
+        r.linhasDepois = r.linhasAntes;
+        return r;
+    }
+
+    // 2ª passada: grava o cabeçalho e as linhas que sobreviveram
+    QSaveFile destino(arquivo);
+    if (!destino.open(QIODevice::WriteOnly)) {
+        r.erro = "Não foi possível abrir '" + arquivo + "' para escrita.";
+        return r;
+    }
+    destino.write(CabecalhoAvaliacoes);
+
+    LeitorCsv segunda(arquivo);
+    if (!segunda.abrir()) {
+        destino.cancelWriting();
+        r.erro = "Não foi possível reler '" + arquivo + "'.";
+        return r;
+    }
+    for (int i = 0; i < chaves.size() && segunda.proximaLinha(); ++i) {
+        if (chaves[i].isEmpty() || ultima.value(chaves[i]) != i)
+            continue;
+        const CampoCsv l = segunda.linha();
+        destino.write(l.dados, l.tamanho);
+        destino.write("\n", 1);
+        ++r.linhasDepois;
+    }
+
+    // Fim: trava, confere que é o mesmo arquivo e traz o que chegou depois
+    TravaArquivo trava(arquivo);
+    if (!trava.travada()) {
+        destino.cancelWriting();
+        r.erro = trava.descricaoErro();
+        return r;
+    }
+
+    qint64  tamanhoAgora = 0;
+    quint64 identidadeAgora = 0;
+    if (!estadoDoArquivo(arquivo, tamanhoAgora, identidadeAgora)
+        || identidadeAgora != identidade || tamanhoAgora < lido) {
+        destino.cancelWriting();
+        r.erro = "'" + arquivo + "' foi reescrito durante a compactação.";
+        return r;
+    }
+
+    const int acrescentadas = copiarTrecho(arquivo, lido, tamanhoAgora, destino);
+    if (acrescentadas < 0) {
+        destino.cancelWriting();
+        r.erro = "Não foi possível copiar as linhas novas de '" + arquivo + "'.";
+        return r;
+    }
+    r.linhasAntes  += acrescentadas;
+    r.linhasDepois += acrescentadas;
+    r.bytesAntes    = tamanhoAgora;
+    r.bytesDepois   = destino.size();
+
+    if (!destino.commit()) {
+        r.erro = "Não foi possível gravar '" + arquivo + "'.";
+        return r;
+    }
+    r.ok = true;
+    return r;
+}
+
+QFuture<ResultadoCompactacao> compactarAvaliacoesEmSegundoPlano(const QString& arquivo)
+{
+    return QtConcurrent::run([arquivo] { return compactarAvaliacoes(arquivo); });
+}
@@ -0,0 +1,35 @@
+// compactacaoavaliacoes.h
+#pragma once
+
+#include <QString>
+#include <QFuture>
+
+// ===== Compactação do avaliacoes.csv =====
+//
+// Cada reavaliação acrescenta uma linha nova no avaliacoes.csv em vez de
+// trocar a antiga. A compactação deixa só a última linha de cada
+// (idProjeto, cpfAvaliador, idFicha), na ordem em que aparecem, e troca o
+// arquivo de forma atômica (QSaveFile).
+//
+// O arquivo é lido sem trava (só cresce por append); a trava entre
+// estações fica presa apenas no fim, para copiar o que foi acrescentado
+// durante a leitura e renomear. Se o arquivo foi reescrito nesse meio
+// tempo, nada é gravado.
+struct ResultadoCompactacao {
+    bool    ok{false};
+    QString erro;
+
+    qint64  bytesAntes{0};
+    qint64  bytesDepois{0};
+    int     linhasAntes{0};     // linhas de dados (sem o cabeçalho)
+    int     linhasDepois{0};
+
+    qint64  bytesRecuperados() const { return bytesAntes - bytesDepois; }
+    int     linhasRecuperadas() const { return linhasAntes - linhasDepois; }
+};
+
+// Compacta na thread atual (linha de comando)
+ResultadoCompactacao compactarAvaliacoes(const QString& arquivo);
+
+// Mesma coisa numa thread de trabalho
+QFuture<ResultadoCompactacao> compactarAvaliacoesEmSegundoPlano(const QString& arquivo);
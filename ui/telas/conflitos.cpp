@@ -0,0 +1,198 @@
+// conflitos.cpp
+#include "conflitos.h"
+#include "leitorcsv.h"
+#include "filtrobusca.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QRegularExpression>
+
+namespace {
+
+// Vínculos por tarefa da auditoria; abaixo disso fica na thread atual
+constexpr int VinculosPorBloco = 4096;
+
+QString chaveNome(const QString& nome)
+{
+    return chaveBusca(nome.simplified());
+}
+
+} // namespace
+
+QString descreverConflito(MotivoConflito motivo)
+{
+    switch (motivo) {
+    case MotivoConflito::Responsavel:      return "Avaliador é o responsável do projeto";
+    case MotivoConflito::DeclaradoProjeto: return "Conflito declarado com o projeto";
+    case MotivoConflito::DeclaradoCurso:   return "Conflito declarado com o curso do projeto";
+    case MotivoConflito::Nenhum:           break;
+    }
+    return QString();
+}
+
+// ================== ARQUIVO ==================
+
+QVector<ConflitoDeclarado> carregarConflitos(const QString& arquivo)
+{
+    QVector<ConflitoDeclarado> res;
+
+    if (!QFile::exists(arquivo))
+        return res; // nenhum conflito declarado ainda
+
+    LeitorCsv csv(arquivo);
+    if (!csv.abrir())
+        return res;
+
+    while (csv.proximaLinha()) {
+        if (csv.linhaEmBranco()) continue;
+        if (csv.numCampos() < 2) continue;
+
+        ConflitoDeclarado c;
+        c.cpfAvaliador = csv[0].toStringTrimmed();
+        c.idProjeto    = csv[1].toInt();
+        if (csv.numCampos() > 2) c.curso  = csv[2].toStringTrimmed();
+        if (csv.numCampos() > 3) c.motivo = csv[3].toStringTrimmed();
+        if (c.idProjeto <= 0 && c.curso.isEmpty()) continue;
+        res.push_back(c);
+    }
+    return res;
+}
+
+bool salvarConflitos(const QString& arquivo, const QVector<ConflitoDeclarado>& lista)
+{
+    // Temporário + fsync + rename: o arquivo antigo só some no commit()
+    QSaveFile f(arquivo);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Text))
+        return false;
+
+    QTextStream out(&f);
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+    out.setCodec("UTF-8");
+#endif
+
+    for (const auto& c : lista) {
+        QString curso = c.curso;
+        QString motivo = c.motivo;
+        curso.replace(';', ',');
+        motivo.replace(';', ',');
+        out << c.cpfAvaliador << ';' << c.idProjeto << ';' << curso << ';' << motivo << '\n';
+    }
+    out.flush();
+    return f.commit();
+}
+
+// ================== ÍNDICE ==================
+
+void IndiceConflitos::reconstruir(const QVector<Projeto>& projetos,
+                                  const QVector<Avaliador>& avaliadores,
+                                  const QVector<Ficha>& fichas,
+                                  const QVector<ConflitoDeclarado>& declarados)
+{
+    m_projetos.clear();
+    m_nomeAvaliador.clear();
+    m_declaradosProjeto.clear();
+    m_declaradosCurso.clear();
+
+    QHash<int, QString> cursoDaFicha;
+    for (const Ficha& f : fichas)
+        cursoDaFicha.insert(f.id, chaveNome(f.curso));
+
+    static const QRegularExpression separadores("[,/]");
+    m_projetos.reserve(projetos.size());
+    for (const Projeto& p : projetos) {
+        DadosProjeto d;
+        for (const QString& nome : p.responsavel.split(separadores)) {
+            const QString chave = chaveNome(nome);
+            if (!chave.isEmpty())
+                d.responsaveis << chave;
+        }
+        const Cpf cpf(p.responsavel);
+        if (cpf.valido())
+            d.cpfResponsavel = cpf;
+        // sem ficha: o curso que vem depois do '-' na categoria
+        d.curso = cursoDaFicha.value(p.idFicha);
+        if (d.curso.isEmpty()) {
+            const int sep = p.categoria.indexOf('-');
+            if (sep >= 0)
+                d.curso = chaveNome(p.categoria.mid(sep + 1));
+        }
+        m_projetos.insert(p.id, d);
+    }
+
+    m_nomeAvaliador.reserve(avaliadores.size());
+    for (const Avaliador& a : avaliadores) {
+        const Cpf cpf(a.cpf);
+        const QString nome = chaveNome(a.nome);
+        if (!cpf.vazio() && !nome.isEmpty())
+            m_nomeAvaliador.insert(cpf, nome);
+    }
+
+    for (const ConflitoDeclarado& c : declarados) {
+        const Cpf cpf(c.cpfAvaliador);
+        if (cpf.vazio())
+            continue;
+        if (c.idProjeto > 0)
+            m_declaradosProjeto.insert(qMakePair(c.idProjeto, cpf));
+        else if (!c.curso.trimmed().isEmpty())
+            m_declaradosCurso.insert(qMakePair(chaveNome(c.curso), cpf));
+    }
+}
+
+MotivoConflito IndiceConflitos::conflito(int idProjeto, const Cpf& cpf) const
+{
+    if (m_declaradosProjeto.contains(qMakePair(idProjeto, cpf)))
+        return MotivoConflito::DeclaradoProjeto;
+
+    const auto p = m_projetos.constFind(idProjeto);
+    if (p == m_projetos.constEnd())
+        return MotivoConflito::Nenhum;
+
+    if (!p->cpfResponsavel.vazio() && p->cpfResponsavel == cpf)
+        return MotivoConflito::Responsavel;
+
+    const auto nome = m_nomeAvaliador.constFind(cpf);
+    if (nome != m_nomeAvaliador.constEnd() && p->responsaveis.contains(nome.value()))
+        return MotivoConflito::Responsavel;
+
+    if (!p->curso.isEmpty() && m_declaradosCurso.contains(qMakePair(p->curso, cpf)))
+        return MotivoConflito::DeclaradoCurso;
+
+    return MotivoConflito::Nenhum;
+}
+
+// ================== AUDITORIA ==================
+
+QVector<ViolacaoConflito> auditarVinculos(const IndiceConflitos& indice,
+                                          const QVector<VinculoProjeto>& vinculos)
+{
+    const int blocos = (vinculos.size() + VinculosPorBloco - 1) / VinculosPorBloco;
+    QVector<QVector<ViolacaoConflito>> porBloco(blocos);
+    QVector<ViolacaoConflito>* saida = porBloco.data();   // um bloco por tarefa
+
+    const auto auditar = [&](int b) {
+        const int fim = qMin((b + 1) * VinculosPorBloco, vinculos.size());
+        for (int i = b * VinculosPorBloco; i < fim; ++i) {
+            const VinculoProjeto& v = vinculos[i];
+            const MotivoConflito m = indice.conflito(v.idProjeto, v.cpf());
+            if (m != MotivoConflito::Nenhum)
+                saida[b].append({v, m});
+        }
+    };
+
+    if (blocos <= 1) {
+        if (blocos == 1)
+            auditar(0);
+    } else {
+        QVector<int> indices(blocos);
+        for (int b = 0; b < blocos; ++b)
+            indices[b] = b;
+        QtConcurrent::blockingMap(indices, [&auditar](int b) { auditar(b); });
+    }
+
+    QVector<ViolacaoConflito> res;
+    for (const auto& bloco : porBloco)
+        res += bloco;
+    return res;
+}
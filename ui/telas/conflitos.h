@@ -0,0 +1,80 @@
+// conflitos.h
+#pragma once
+
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "registros.h"
+#include "ficha.h"
+#include "vinculos.h"
+
+// ===== Conflitos de interesse =====
+//
+// Um avaliador não pode avaliar um projeto quando:
+//   - é o responsável do projeto: nome igual (sem diferença de maiúsculas
+//     e acentos; "Ana, Bruno" são dois responsáveis) ou o CPF dele escrito
+//     no campo Responsavel;
+//   - o administrador declarou conflito dele com o projeto;
+//   - o administrador declarou conflito dele com o curso da ficha do
+//     projeto (sem ficha, o curso da categoria "Graduação - Curso").
+//
+// conflitos.csv: cpfAvaliador;idProjeto;curso;motivo  (idProjeto 0 = curso)
+
+struct ConflitoDeclarado {
+    QString cpfAvaliador;
+    int     idProjeto{0};   // 0: o conflito é com o curso
+    QString curso;
+    QString motivo;
+};
+
+enum class MotivoConflito : quint8 {
+    Nenhum,
+    Responsavel,
+    DeclaradoProjeto,
+    DeclaradoCurso
+};
+
+QString descreverConflito(MotivoConflito motivo);
+
+// Carrega/salva a lista de conflitos declarados (salvar é atômico)
+QVector<ConflitoDeclarado> carregarConflitos(const QString& arquivo);
+bool salvarConflitos(const QString& arquivo, const QVector<ConflitoDeclarado>& lista);
+
+// Tabelas de hash por projeto e por CPF, montadas de uma vez a partir dos
+// cadastros: conflito() é O(1) e pode ser chamado de várias threads.
+class IndiceConflitos
+{
+public:
+    void reconstruir(const QVector<Projeto>& projetos,
+                     const QVector<Avaliador>& avaliadores,
+                     const QVector<Ficha>& fichas,
+                     const QVector<ConflitoDeclarado>& declarados);
+
+    MotivoConflito conflito(int idProjeto, const Cpf& cpf) const;
+
+private:
+    struct DadosProjeto {
+        QStringList responsaveis;    // chaveBusca() de cada nome
+        Cpf         cpfResponsavel;
+        QString     curso;           // chaveBusca() do curso da ficha
+    };
+
+    QHash<int, DadosProjeto>  m_projetos;
+    QHash<Cpf, QString>       m_nomeAvaliador;   // chaveBusca()
+    QSet<QPair<int, Cpf>>     m_declaradosProjeto;
+    QSet<QPair<QString, Cpf>> m_declaradosCurso;
+};
+
+struct ViolacaoConflito {
+    VinculoProjeto vinculo;
+    MotivoConflito motivo{MotivoConflito::Nenhum};
+};
+
+// Confere todos os vínculos em paralelo (blocos em threads de trabalho);
+// as violações saem na ordem da lista
+QVector<ViolacaoConflito> auditarVinculos(const IndiceConflitos& indice,
+                                          const QVector<VinculoProjeto>& vinculos);
@@ -0,0 +1,64 @@
+// cpf.cpp
+#include "cpf.h"
+
+Cpf::Cpf(const QString& texto)
+{
+    quint64 numero = 0;
+    int quantidade = 0;
+    for (const QChar c : texto) {
+        const ushort u = c.unicode();
+        if (u < '0' || u > '9')
+            continue; // máscara, espaços...
+        if (++quantidade > 11)
+            return;
+        numero = numero * 10 + (u - '0');
+    }
+    if (quantidade > 0) {
+        m_numero     = numero;
+        m_quantidade = quantidade;
+    }
+}
+
+bool Cpf::valido() const
+{
+    if (m_quantidade != 11)
+        return false;
+
+    int d[11];
+    quint64 n = m_numero;
+    for (int i = 10; i >= 0; --i) {
+        d[i] = int(n % 10);
+        n /= 10;
+    }
+
+    bool todosIguais = true;
+    for (int i = 1; i < 11; ++i) {
+        if (d[i] != d[0]) { todosIguais = false; break; }
+    }
+    if (todosIguais)
+        return false;
+
+    const auto verificador = [&d](int len) {
+        int soma = 0;
+        for (int i = 0; i < len; ++i)
+            soma += d[i] * (len + 1 - i);
+        const int r = soma % 11;
+        return (r < 2) ? 0 : 11 - r;
+    };
+    return verificador(9) == d[9] && verificador(10) == d[10];
+}
+
+QString Cpf::digitos() const
+{
+    if (vazio())
+        return QString();
+    return QString::number(m_numero).rightJustified(11, '0');
+}
+
+QString Cpf::formatado() const
+{
+    const QString s = digitos();
+    if (s.isEmpty())
+        return s;
+    return s.left(3) + '.' + s.mid(3, 3) + '.' + s.mid(6, 3) + '-' + s.right(2);
+}
@@ -0,0 +1,53 @@
+// cpf.h
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+#include <QHash>
+
+// ===== CPF =====
+//
+// O CPF aparece com e sem máscara nos arquivos e nos campos de texto
+// ("123.456.789-09" e "12345678909"). Cpf guarda só o número (64 bits),
+// lido uma vez, e serve de chave: comparação e hash são de um inteiro.
+//
+//   Cpf(texto)      -> ignora tudo que não é dígito
+//   vazio()         -> nenhum dígito, ou mais de 11
+//   valido()        -> exatamente 11 dígitos digitados, com os
+//                      verificadores corretos
+//   digitos()       -> "12345678909" (com zeros à esquerda)
+//   formatado()     -> "123.456.789-09"
+//
+// Igualdade e hash olham só o número: "012.345.678-90" e "12345678-90"
+// são a mesma chave.
+class Cpf
+{
+public:
+    Cpf() = default;
+    explicit Cpf(const QString& texto);
+
+    bool    vazio() const  { return m_numero == Vazio; }
+    bool    valido() const;
+    quint64 numero() const { return m_numero; }
+
+    QString digitos() const;
+    QString formatado() const;
+
+    friend bool operator==(const Cpf& a, const Cpf& b) { return a.m_numero == b.m_numero; }
+    friend bool operator!=(const Cpf& a, const Cpf& b) { return a.m_numero != b.m_numero; }
+    friend bool operator<(const Cpf& a, const Cpf& b)  { return a.m_numero <  b.m_numero; }
+
+private:
+    static constexpr quint64 Vazio = ~quint64(0);
+    quint64 m_numero{Vazio};
+    int     m_quantidade{0};   // dígitos no texto original
+};
+
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+inline uint qHash(const Cpf& cpf, uint seed = 0)
+#else
+inline size_t qHash(const Cpf& cpf, size_t seed = 0)
+#endif
+{
+    return ::qHash(cpf.numero(), seed);
+}
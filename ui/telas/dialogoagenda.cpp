@@ -0,0 +1,431 @@
+#include "dialogoagenda.h"
+#include "repositorio.h"
+#include "modelohtml.h"
+
+#include <QTableView>
+#include <QStandardItemModel>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QPlainTextEdit>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QLabel>
+#include <QMessageBox>
+#include <QFileDialog>
+#include <QFile>
+#include <QTextStream>
+#include <QTextDocument>
+#include <QPrinter>
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+DialogoAgenda::DialogoAgenda(QWidget* parent)
+    : QDialog(parent)
+    , m_editSalas(new QLineEdit(this))
+    , m_editPeriodos(new QPlainTextEdit(this))
+    , m_spinDuracao(new QSpinBox(this))
+    , m_btnDisponibilidade(new QPushButton(" Carregar Disponibilidade...", this))
+    , m_lblDisponibilidade(new QLabel(this))
+    , m_btnMontar(new QPushButton(" Montar Agenda", this))
+    , m_table(new QTableView(this))
+    , m_model(new QStandardItemModel(0, 5, this))
+    , m_lblResumo(new QLabel(this))
+    , m_comboExportar(new QComboBox(this))
+    , m_btnExportCsv(new QPushButton("📊 Exportar CSV", this))
+    , m_btnExportPdf(new QPushButton(" Exportar PDF", this))
+    , m_btnFechar(new QPushButton("Fechar", this))
+{
+    setModal(true);
+    setMinimumSize(950, 650);
+    setWindowTitle("Agenda de Apresentações");
+    if (parent)
+        setStyleSheet(parent->styleSheet());
+
+    auto* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(24, 24, 24, 24);
+    mainLayout->setSpacing(16);
+
+    auto* titulo = new QLabel("Agenda de Apresentações", this);
+    QFont ft = titulo->font();
+    ft.setPointSize(ft.pointSize() + 3);
+    ft.setBold(true);
+    titulo->setFont(ft);
+    titulo->setStyleSheet("color: #00D4FF; padding-bottom: 6px;");
+    mainLayout->addWidget(titulo);
+
+    // ----- Configuração -----
+    m_editSalas->setText("Sala 1, Sala 2, Sala 3");
+    m_editSalas->setPlaceholderText("Nomes das salas separados por vírgula");
+
+    const QDate amanha = QDate::currentDate().addDays(1);
+    m_editPeriodos->setPlainText(
+        QString("%1 08:00 - 12:00\n%1 14:00 - 18:00").arg(amanha.toString("dd/MM/yyyy")));
+    m_editPeriodos->setMaximumHeight(90);
+    m_editPeriodos->setToolTip("Um período por linha: dd/MM/aaaa HH:mm - HH:mm");
+
+    m_spinDuracao->setRange(5, 240);
+    m_spinDuracao->setValue(20);
+    m_spinDuracao->setSuffix(" min");
+
+    m_lblDisponibilidade->setText("Todos os avaliadores disponíveis em todos os períodos.");
+
+    auto* linhaDisp = new QHBoxLayout();
+    linhaDisp->addWidget(m_btnDisponibilidade);
+    linhaDisp->addWidget(m_lblDisponibilidade, 1);
+
+    auto* form = new QFormLayout();
+    form->addRow("Salas:", m_editSalas);
+    form->addRow("Períodos:", m_editPeriodos);
+    form->addRow("Duração:", m_spinDuracao);
+    form->addRow("Disponibilidade:", linhaDisp);
+    mainLayout->addLayout(form);
+
+    auto* linhaMontar = new QHBoxLayout();
+    linhaMontar->addWidget(m_btnMontar);
+    linhaMontar->addWidget(m_lblResumo, 1);
+    mainLayout->addLayout(linhaMontar);
+
+    configurarTabela();
+    mainLayout->addWidget(m_table, 1);
+
+    m_comboExportar->addItem("Agenda por sala");
+    m_comboExportar->addItem("Agenda por avaliador");
+
+    auto* footer = new QHBoxLayout();
+    footer->addWidget(m_comboExportar);
+    footer->addWidget(m_btnExportCsv);
+    footer->addWidget(m_btnExportPdf);
+    footer->addStretch();
+    footer->addWidget(m_btnFechar);
+    mainLayout->addLayout(footer);
+
+    m_btnExportCsv->setEnabled(false);
+    m_btnExportPdf->setEnabled(false);
+
+    connect(m_btnDisponibilidade, &QPushButton::clicked, this, &DialogoAgenda::onCarregarDisponibilidade);
+    connect(m_btnMontar,          &QPushButton::clicked, this, &DialogoAgenda::onMontar);
+    connect(m_btnExportCsv,       &QPushButton::clicked, this, &DialogoAgenda::onExportCsv);
+    connect(m_btnExportPdf,       &QPushButton::clicked, this, &DialogoAgenda::onExportPdf);
+    connect(m_btnFechar,          &QPushButton::clicked, this, &DialogoAgenda::accept);
+}
+
+void DialogoAgenda::configurarTabela()
+{
+    m_model->setHorizontalHeaderLabels({
+        "Horário", "Sala", "ID Projeto", "Projeto", "Avaliadores"
+    });
+
+    m_table->setModel(m_model);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->setAlternatingRowColors(true);
+
+    auto* header = m_table->horizontalHeader();
+    for (int c = 0; c < m_model->columnCount(); ++c)
+        header->setSectionResizeMode(c, QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(3, QHeaderView::Stretch);
+}
+
+// ================== CONFIGURAÇÃO ==================
+
+void DialogoAgenda::onCarregarDisponibilidade()
+{
+    QString filename = QFileDialog::getOpenFileName(
+        this,
+        "Disponibilidade dos avaliadores",
+        "disponibilidade.csv",
+        "Arquivos CSV (*.csv);;Todos os arquivos (*.*)"
+        );
+
+    if (filename.isEmpty())
+        return;
+
+    QStringList erros;
+    m_disponibilidade = carregarDisponibilidade(filename, &erros);
+
+    m_lblDisponibilidade->setText(
+        QString("%1 avaliadores com horários restritos; os demais disponíveis sempre.")
+            .arg(m_disponibilidade.size()));
+
+    if (!erros.isEmpty())
+        QMessageBox::warning(this, "Disponibilidade",
+                             "Formato esperado: cpf;dd/MM/aaaa HH:mm;dd/MM/aaaa HH:mm\n\n"
+                                 + erros.mid(0, 20).join('\n'));
+}
+
+bool DialogoAgenda::lerConfiguracao(ConfiguracaoAgenda& config)
+{
+    config = ConfiguracaoAgenda();
+
+    for (const QString& sala : m_editSalas->text().split(',')) {
+        const QString nome = sala.trimmed();
+        if (!nome.isEmpty())
+            config.salas << nome;
+    }
+    if (config.salas.isEmpty()) {
+        QMessageBox::warning(this, "Agenda", "Informe ao menos uma sala.");
+        return false;
+    }
+
+    // "20/10/2025 08:00 - 12:00": o fim é no mesmo dia do início
+    const QStringList linhas = m_editPeriodos->toPlainText().split('\n');
+    for (int i = 0; i < linhas.size(); ++i) {
+        const QString linha = linhas[i].trimmed();
+        if (linha.isEmpty())
+            continue;
+
+        const int sep = linha.lastIndexOf('-');
+        PeriodoAgenda p;
+        if (sep > 0) {
+            p.inicio = lerDataHora(linha.left(sep));
+            const QTime fim = QTime::fromString(linha.mid(sep + 1).trimmed(), "HH:mm");
+            if (p.inicio.isValid() && fim.isValid())
+                p.fim = QDateTime(p.inicio.date(), fim);
+        }
+        if (!p.inicio.isValid() || !p.fim.isValid() || p.fim <= p.inicio) {
+            QMessageBox::warning(this, "Agenda",
+                                 QString("Período inválido na linha %1: \"%2\".\n"
+                                         "Use dd/MM/aaaa HH:mm - HH:mm.")
+                                     .arg(i + 1).arg(linha));
+            return false;
+        }
+        config.periodos.append(p);
+    }
+    if (config.periodos.isEmpty()) {
+        QMessageBox::warning(this, "Agenda", "Informe ao menos um período.");
+        return false;
+    }
+
+    config.duracaoMinutos  = m_spinDuracao->value();
+    config.disponibilidade = m_disponibilidade;
+    return true;
+}
+
+// ================== AGENDA ==================
+
+void DialogoAgenda::onMontar()
+{
+    ConfiguracaoAgenda config;
+    if (!lerConfiguracao(config))
+        return;
+
+    const auto& repo = Repositorio::instancia();
+
+    QElapsedTimer t;
+    t.start();
+    m_resultado = montarAgenda(repo.projetos(), repo.vinculos(), config);
+    const qint64 ms = t.elapsed();
+    m_config = config;
+
+    m_model->removeRows(0, m_model->rowCount());
+    for (const Apresentacao& a : m_resultado.apresentacoes) {
+        const Projeto* p = repo.projetoPorId(a.idProjeto);
+
+        QStringList nomes;
+        for (const QString& cpf : a.avaliadores) {
+            const Avaliador* av = repo.avaliadorPorCpf(cpf);
+            nomes << (av ? av->nome : cpf);
+        }
+
+        QList<QStandardItem*> row;
+        row << new QStandardItem(textoHorario(a.horario));
+        row << new QStandardItem(m_config.salas.value(a.sala));
+        row << new QStandardItem(QString::number(a.idProjeto));
+        row << new QStandardItem(p ? p->nome : QString());
+        row << new QStandardItem(nomes.join(", "));
+        m_model->appendRow(row);
+    }
+
+    QString resumo = QString("%1 apresentações em %2 horários (%3 ms)")
+                         .arg(m_resultado.apresentacoes.size())
+                         .arg(m_resultado.horarios.size())
+                         .arg(ms);
+    if (!m_resultado.semHorario.isEmpty()) {
+        QStringList ids;
+        for (int id : m_resultado.semHorario.mid(0, 20))
+            ids << QString::number(id);
+        if (m_resultado.semHorario.size() > 20)
+            ids << "...";
+        resumo += QString(" — <b>%1 sem horário</b> (projetos %2)")
+                      .arg(m_resultado.semHorario.size()).arg(ids.join(", "));
+    }
+    m_lblResumo->setText(resumo);
+
+    const bool temAgenda = !m_resultado.apresentacoes.isEmpty();
+    m_btnExportCsv->setEnabled(temAgenda);
+    m_btnExportPdf->setEnabled(temAgenda);
+
+    if (!m_resultado.semHorario.isEmpty())
+        QMessageBox::warning(this, "Agenda",
+                             QString("%1 projetos não couberam: faltam salas, horários "
+                                     "ou disponibilidade dos avaliadores.")
+                                 .arg(m_resultado.semHorario.size()));
+}
+
+QString DialogoAgenda::textoHorario(int horario) const
+{
+    return m_resultado.horarios.value(horario).toString("dd/MM/yyyy HH:mm");
+}
+
+QVector<DialogoAgenda::LinhaAgenda> DialogoAgenda::linhasAgenda(bool porAvaliador) const
+{
+    const auto& repo = Repositorio::instancia();
+    QVector<LinhaAgenda> linhas;
+
+    for (const Apresentacao& a : m_resultado.apresentacoes) {
+        const Projeto* p = repo.projetoPorId(a.idProjeto);
+
+        QStringList nomes;
+        for (const QString& cpf : a.avaliadores) {
+            const Avaliador* av = repo.avaliadorPorCpf(cpf);
+            nomes << (av ? av->nome : cpf);
+        }
+
+        LinhaAgenda l;
+        l.horario     = a.horario;
+        l.sala        = m_config.salas.value(a.sala);
+        l.idProjeto   = a.idProjeto;
+        l.projeto     = p ? p->nome : QString();
+        l.avaliadores = nomes.join(", ");
+
+        if (!porAvaliador) {
+            l.grupo = l.sala;
+            linhas.append(l);
+            continue;
+        }
+        for (const QString& nome : nomes) {
+            l.grupo = nome;
+            linhas.append(l);
+        }
+    }
+
+    // Salas na ordem do cadastro; avaliadores por nome
+    const QStringList& salas = m_config.salas;
+    std::stable_sort(linhas.begin(), linhas.end(),
+                     [porAvaliador, &salas](const LinhaAgenda& a, const LinhaAgenda& b) {
+        if (a.grupo != b.grupo) {
+            if (porAvaliador)
+                return a.grupo.localeAwareCompare(b.grupo) < 0;
+            return salas.indexOf(a.grupo) < salas.indexOf(b.grupo);
+        }
+        return a.horario < b.horario;
+    });
+    return linhas;
+}
+
+// ================== EXPORTAÇÃO ==================
+
+void DialogoAgenda::onExportCsv()
+{
+    const bool porAvaliador = m_comboExportar->currentIndex() == 1;
+
+    QString filename = QFileDialog::getSaveFileName(
+        this,
+        "Exportar agenda para CSV",
+        porAvaliador ? "agenda_avaliadores.csv" : "agenda_salas.csv",
+        "Arquivos CSV (*.csv);;Todos os arquivos (*.*)"
+        );
+
+    if (filename.isEmpty())
+        return;
+
+    QFile f(filename);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, "Exportar CSV",
+                             "Não foi possível abrir o arquivo para escrita.");
+        return;
+    }
+
+    QTextStream out(&f);
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+    out.setCodec("UTF-8");
+#endif
+
+    out << (porAvaliador ? "Avaliador" : "Sala")
+        << ";Horario;Sala;IdProjeto;Projeto;Avaliadores\n";
+
+    for (LinhaAgenda l : linhasAgenda(porAvaliador)) {
+        // Evita quebrar o CSV com ';' dentro dos textos
+        l.grupo.replace(';', ',');
+        l.sala.replace(';', ',');
+        l.projeto.replace(';', ',');
+        l.avaliadores.replace(';', ',');
+
+        out << l.grupo                  << ';'
+            << textoHorario(l.horario)  << ';'
+            << l.sala                   << ';'
+            << l.idProjeto              << ';'
+            << l.projeto                << ';'
+            << l.avaliadores            << '\n';
+    }
+
+    QMessageBox::information(this, "Exportar CSV",
+                             "Agenda exportada com sucesso.");
+}
+
+void DialogoAgenda::onExportPdf()
+{
+    const bool porAvaliador = m_comboExportar->currentIndex() == 1;
+
+    QString filename = QFileDialog::getSaveFileName(
+        this,
+        "Exportar agenda para PDF",
+        porAvaliador ? "agenda_avaliadores.pdf" : "agenda_salas.pdf",
+        "Arquivos PDF (*.pdf)"
+        );
+
+    if (filename.isEmpty())
+        return;
+
+    // Uma página por sala ou por avaliador
+    static const ModeloHtml modelo(QString(R"(<html><head><meta charset='UTF-8'></head><body>
+{{#grupos}}{{^primeiro}}<div style='page-break-before: always;'></div>{{/primeiro}}
+<h2>{{#porAvaliador}}Avaliador: {{/porAvaliador}}{{^porAvaliador}}Sala: {{/porAvaliador}}{{grupo}}</h2>
+<table border='1' cellspacing='0' cellpadding='4' width='100%' style='border-collapse: collapse;'>
+<tr style='background-color: #eeeeee;'><th>Horário</th>{{#porAvaliador}}<th>Sala</th>{{/porAvaliador}}<th>ID</th><th>Projeto</th><th>Avaliadores</th></tr>
+{{#linhas}}<tr><td align='center'>{{horario}}</td>{{#porAvaliador}}<td>{{sala}}</td>{{/porAvaliador}}<td align='center'>{{idProjeto}}</td><td>{{projeto}}</td><td>{{avaliadores}}</td></tr>
+{{/linhas}}</table>
+{{/grupos}}</body></html>)"));
+
+    DadosModelo dados;
+    dados.definirCondicao("porAvaliador", porAvaliador);
+
+    const QVector<LinhaAgenda> linhas = linhasAgenda(porAvaliador);
+    DadosModelo* grupo = nullptr;
+    for (int i = 0; i < linhas.size(); ++i) {
+        const LinhaAgenda& l = linhas[i];
+        if (i == 0 || l.grupo != linhas[i - 1].grupo) {
+            grupo = &dados.acrescentar("grupos");
+            grupo->definir("grupo", l.grupo);
+            grupo->definirCondicao("primeiro", i == 0);
+        }
+
+        DadosModelo& linha = grupo->acrescentar("linhas");
+        linha.definir("horario", textoHorario(l.horario));
+        linha.definir("sala", l.sala);
+        linha.definir("idProjeto", QString::number(l.idProjeto));
+        linha.definir("projeto", l.projeto);
+        linha.definir("avaliadores", l.avaliadores);
+    }
+    const QString html = modelo.render(dados);
+
+    QPrinter printer(QPrinter::HighResolution);
+    printer.setOutputFormat(QPrinter::PdfFormat);
+    printer.setOutputFileName(filename);
+    printer.setPageSize(QPageSize::A4);
+    printer.setPageMargins(QMarginsF(15, 15, 15, 15), QPageLayout::Millimeter);
+
+    QTextDocument document;
+    document.setHtml(html);
+    document.print(&printer);
+
+    QMessageBox::information(this, "Exportar PDF",
+                             "PDF exportado com sucesso!");
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QDialog>
+
+#include "agendaapresentacoes.h"
+
+class QTableView;
+class QStandardItemModel;
+class QPushButton;
+class QSpinBox;
+class QComboBox;
+class QLineEdit;
+class QPlainTextEdit;
+class QLabel;
+
+// Monta a agenda das apresentações (salas x horários) a partir dos
+// vínculos e exporta as agendas por sala ou por avaliador em CSV e PDF
+// (ver agendaapresentacoes.h)
+class DialogoAgenda : public QDialog
+{
+    Q_OBJECT
+public:
+    explicit DialogoAgenda(QWidget* parent = nullptr);
+
+private slots:
+    void onCarregarDisponibilidade();
+    void onMontar();
+    void onExportCsv();
+    void onExportPdf();
+
+private:
+    // Uma linha da agenda exportada: agrupada por sala ou por avaliador
+    struct LinhaAgenda {
+        QString grupo;
+        int     horario{0};
+        QString sala;
+        int     idProjeto{0};
+        QString projeto;
+        QString avaliadores;
+    };
+
+    void configurarTabela();
+    bool lerConfiguracao(ConfiguracaoAgenda& config);
+    QVector<LinhaAgenda> linhasAgenda(bool porAvaliador) const;
+    QString textoHorario(int horario) const;
+
+    ConfiguracaoAgenda  m_config;
+    ResultadoAgenda     m_resultado;
+    QHash<Cpf, QVector<PeriodoAgenda>> m_disponibilidade;
+
+    QLineEdit*          m_editSalas{};
+    QPlainTextEdit*     m_editPeriodos{};
+    QSpinBox*           m_spinDuracao{};
+    QPushButton*        m_btnDisponibilidade{};
+    QLabel*             m_lblDisponibilidade{};
+    QPushButton*        m_btnMontar{};
+    QTableView*         m_table{};
+    QStandardItemModel* m_model{};
+    QLabel*             m_lblResumo{};
+    QComboBox*          m_comboExportar{};
+    QPushButton*        m_btnExportCsv{};
+    QPushButton*        m_btnExportPdf{};
+    QPushButton*        m_btnFechar{};
+};
@@ -1,4 +1,6 @@
 #include "dialogoavaliacaoficha.h"
+#include "repositorio.h"
+#include "exportacaopdf.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -16,6 +18,7 @@
 #include <QTextDocument>
 #include <QDateTime>
 #include <QPageSize>
+#include <QVarLengthArray>
 
 // ================== CONSTRUTOR SIMPLES (usado pela PaginaProjetos) ==================
 
@@ -199,81 +202,47 @@ DialogoAvaliacaoFicha::DialogoAvaliacaoFicha(int idProjeto,
     // carregarAvaliacoesQuesitos();
 }
 
-// ================== CARREGAR FICHA (fichas.txt real) ==================
+// ================== CARREGAR FICHA (repositório) ==================
 
 bool DialogoAvaliacaoFicha::carregarFicha(FichaSimples& ficha)
 {
-    QFile f(m_arquivoFichas);
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    const Ficha* f = Repositorio::instancia().fichaPorId(m_idFicha);
+    if (!f)
         return false;
-    }
-
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
-
-    while (!in.atEnd()) {
-        const QString line = in.readLine();
-        if (line.trimmed().isEmpty()) continue;
-
-        const QStringList p = line.split(';');
-        if (p.size() < 14) continue;
-
-        int idx = 0;
-        int id = p[idx++].toInt();
-        if (id != m_idFicha)
-            continue;
-
-        ficha.id        = id;
-        ficha.tipoFicha = p[idx++];
-        QString resolucaoNum = p[idx++];
-        QString resolucaoAno = p[idx++];
-        ficha.curso    = p[idx++];
-        QString categoriaCurso = p[idx++];
-        ficha.notaMin  = p[idx++].toDouble();
-        ficha.notaMax  = p[idx++].toDouble();
-        bool incluirData       = (p[idx++] == "1");
-        bool incluirProfAval   = (p[idx++] == "1");
-        bool incluirProfOrient = (p[idx++] == "1");
-        bool incluirObs        = (p[idx++] == "1");
-        QString textoAprov     = p[idx++];
-
-        int numSecoes = p[idx++].toInt();
-
-        ficha.secoes.clear();
-        for (int i = 0; i < numSecoes && idx < p.size(); ++i) {
-            SecaoSimples sec;
-            sec.identificador = p[idx++];
-            if (idx >= p.size()) break;
-            sec.titulo = p[idx++];
-            if (idx >= p.size()) break;
-            int numQuesitos = p[idx++].toInt();
-
-            for (int j = 0; j < numQuesitos && idx < p.size(); ++j) {
-                QuesitoCampo qc;
-                qc.idSecao      = sec.identificador;
-                qc.nomeQuesito  = p[idx++];
-                if (idx >= p.size()) break;
-                bool autoCalc   = (p[idx++] == "1");
-                if (idx >= p.size()) break;
-                qc.temPeso      = (p[idx++] == "1");
-                if (idx >= p.size()) break;
-                qc.peso         = p[idx++].toDouble();
-
-                // Se for quesito auto-calculado, não cria campo de input
-                if (!autoCalc) {
-                    sec.quesitos.append(qc);
-                }
-            }
 
-            ficha.secoes.append(sec);
+    ficha.id        = f->id;
+    ficha.tipoFicha = f->tipoFicha;
+    ficha.curso     = f->curso;
+    ficha.notaMin   = f->notaMin;
+    ficha.notaMax   = f->notaMax;
+    m_pesos         = PesosFicha(*f);
+
+    ficha.secoes.clear();
+    for (const Secao& s : f->secoes) {
+        SecaoSimples sec;
+        sec.identificador = s.identificador;
+        sec.titulo        = s.titulo;
+
+        for (const Quesito& q : s.quesitos) {
+            // Auto-calculado sem fórmula (ou com fórmula inválida) não
+            // aparece; com fórmula, aparece só para leitura
+            const bool calculado = temFormula(q) && m_pesos.erroFormulas().isEmpty();
+            if (q.autoCalculado && !calculado)
+                continue;
+
+            QuesitoCampo qc;
+            qc.idSecao     = sec.identificador;
+            qc.nomeQuesito = q.nome;
+            qc.temPeso     = q.temPeso;
+            qc.peso        = q.peso;
+            qc.calculado   = calculado;
+            sec.quesitos.append(qc);
         }
 
-        return true;
+        ficha.secoes.append(sec);
     }
 
-    return false;
+    return true;
 }
 
 // ================== MONTAR UI ==================
@@ -321,6 +290,16 @@ void DialogoAvaliacaoFicha::montarUI(const FichaSimples& ficha)
 
         for (const auto& q : sec.quesitos) {
             auto* lbl  = new QLabel(q.nomeQuesito, box);
+
+            if (q.calculado) {
+                QuesitoCampo campo = q;
+                campo.valor = new QLabel(box);
+                campo.valor->setToolTip("Calculado pela fórmula do quesito");
+                m_campos.append(campo);
+                form->addRow(lbl, campo.valor);
+                continue;
+            }
+
             auto* spin = new QDoubleSpinBox(box);
 
             spin->setRange(ficha.notaMin, ficha.notaMax);
@@ -333,10 +312,13 @@ void DialogoAvaliacaoFicha::montarUI(const FichaSimples& ficha)
             m_campos.append(campo);
 
             form->addRow(lbl, spin);
+            connect(spin, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+                    this, &DialogoAvaliacaoFicha::atualizarCalculados);
         }
 
         m_mainLayout->addWidget(box);
     }
+    atualizarCalculados();
 
     m_mainLayout->addStretch();
 
@@ -378,69 +360,63 @@ void DialogoAvaliacaoFicha::carregarAvaliacoesQuesitos()
 
 void DialogoAvaliacaoFicha::salvarAvaliacoesQuesitos()
 {
-    QFile file(m_arquivoAvaliacoes);
-    const bool arquivoExistia = file.exists();
-
-    if (!file.open(QIODevice::Append | QIODevice::Text)) {
-        QMessageBox::warning(this, "Erro",
-                             "Não foi possível abrir " + m_arquivoAvaliacoes);
-        return;
-    }
-
-    QTextStream out(&file);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    out.setCodec("UTF-8");
-#endif
-
-    if (!arquivoExistia) {
-        out << "idProjeto;nomeProjeto;responsavel;"
-               "idFicha;nomeFicha;"
-               "cpfAvaliador;nomeAvaliador;"
-               "notaFinal;notasQuesitos\n";
-    }
-
     const double notaFinal = calcularNotaFinal();
     m_notaFinal = notaFinal;
 
-    QStringList notasQuesitos;
+    Avaliacao a;
+    a.idProjeto     = m_idProjeto;
+    a.nomeProjeto   = m_nomeProjeto;
+    a.responsavel   = m_responsavelProjeto;
+    a.idFicha       = m_idFicha;
+    a.nomeFicha     = m_nomeFicha;
+    a.cpfAvaliador  = m_editCpfAvaliador->text();
+    a.nomeAvaliador = m_editNomeAvaliador->text();
+    a.notaFinal     = notaFinal;
+
     for (const auto& campo : m_campos) {
         if (campo.spin) {
-            notasQuesitos << QString::number(campo.spin->value(), 'f', 2);
+            a.notasQuesitos << campo.spin->value();
         }
     }
 
-    out << m_idProjeto                  << ';'
-        << m_nomeProjeto                << ';'
-        << (m_responsavelProjeto.isEmpty() ? "-" : m_responsavelProjeto) << ';'
-        << m_idFicha                    << ';'
-        << m_nomeFicha                  << ';'
-        << m_editCpfAvaliador->text()   << ';'
-        << m_editNomeAvaliador->text()  << ';'
-        << QString::number(notaFinal, 'f', 2) << ';'
-        << notasQuesitos.join('|')
-        << '\n';
-
-    file.close();
+    Repositorio::instancia().registrarAvaliacao(a);
 }
 
 // ================== CÁLCULO DA NOTA FINAL (com peso) ==================
 
 double DialogoAvaliacaoFicha::calcularNotaFinal() const
 {
-    double somaPonderada = 0.0;
-    double somaPesos     = 0.0;
-
+    // Mesmo cálculo do recálculo em lote (motornotas.h): um campo por
+    // quesito não auto-calculado, na ordem dos pesos
+    QVector<double> notas;
+    notas.reserve(m_campos.size());
     for (const QuesitoCampo& campo : m_campos) {
-        if (!campo.spin) continue;
-        double nota = campo.spin->value();
-        double peso = campo.temPeso ? campo.peso : 1.0;
+        if (campo.spin)
+            notas.append(campo.spin->value());
+    }
+    return m_pesos.notaFinal(notas);
+}
 
-        somaPonderada += nota * peso;
-        somaPesos     += peso;
+// Quesitos calculados acompanham as notas digitadas
+void DialogoAvaliacaoFicha::atualizarCalculados()
+{
+    QVector<double> notas;
+    notas.reserve(m_campos.size());
+    for (const QuesitoCampo& campo : m_campos) {
+        if (campo.spin)
+            notas.append(campo.spin->value());
     }
+    if (notas.size() != m_pesos.quantidade())
+        return;
+
+    QVarLengthArray<double, 64> valores(m_pesos.valores());
+    m_pesos.calcular(notas.constData(), valores.data());
 
-    if (somaPesos <= 0.0) return 0.0;
-    return somaPonderada / somaPesos;
+    int i = m_pesos.quantidade();
+    for (const QuesitoCampo& campo : m_campos) {
+        if (campo.valor)
+            campo.valor->setText(QString::number(valores[i++], 'f', 2));
+    }
 }
 
 // ================== PDF ==================
@@ -457,36 +433,24 @@ void DialogoAvaliacaoFicha::onSalvarPdf()
     if (filename.isEmpty())
         return;
 
-    QString html;
-    html += "<h1 align='center'>Avaliação de Projeto</h1><hr>";
-    html += "<p><b>Projeto:</b> " + m_nomeProjeto + "</p>";
-    html += "<p><b>Responsável:</b> "
-            + (m_responsavelProjeto.isEmpty() ? "N/A" : m_responsavelProjeto) + "</p>";
-    html += "<p><b>Ficha:</b> " + m_nomeFicha + "</p>";
-    html += "<p><b>Avaliador (CPF):</b> " + m_editCpfAvaliador->text() + "</p>";
-    html += "<p><b>Avaliador (Nome):</b> " + m_editNomeAvaliador->text() + "</p>";
-    html += "<p><b>Data:</b> "
-            + QDateTime::currentDateTime().toString("dd/MM/yyyy HH:mm") + "</p>";
-
-    html += "<br><table border='1' cellspacing='0' cellpadding='4' "
-            "width='100%' style='border-collapse: collapse;'>";
-    html += "<tr style='background-color: #eeeeee;'>"
-            "<th>Seção</th><th>Quesito</th><th>Nota</th></tr>";
+    DocumentoAvaliacaoPdf avaliacao;
+    avaliacao.idProjeto     = m_idProjeto;
+    avaliacao.idFicha       = m_idFicha;
+    avaliacao.projeto       = m_nomeProjeto;
+    avaliacao.responsavel   = m_responsavelProjeto;
+    avaliacao.ficha         = m_nomeFicha;
+    avaliacao.cpfAvaliador  = m_editCpfAvaliador->text();
+    avaliacao.nomeAvaliador = m_editNomeAvaliador->text();
+    avaliacao.notaFinal     = calcularNotaFinal();
 
     for (const auto& campo : m_campos) {
-        if (!campo.spin) continue;
-        html += "<tr>";
-        html += "<td align='center'>" + campo.idSecao + "</td>";
-        html += "<td>" + campo.nomeQuesito + "</td>";
-        html += "<td align='center'>" +
-                QString::number(campo.spin->value(), 'f', 2) + "</td>";
-        html += "</tr>";
+        if (!campo.spin && !campo.valor) continue;
+        avaliacao.linhas.append({campo.idSecao, campo.nomeQuesito,
+                                 campo.spin ? QString::number(campo.spin->value(), 'f', 2)
+                                            : campo.valor->text()});
     }
 
-    html += "</table>";
-
-    html += QString("<h3 align='right'>Nota Final: %1</h3>")
-                .arg(QString::number(calcularNotaFinal(), 'f', 2));
+    const QString html = htmlAvaliacao(avaliacao, QDateTime::currentDateTime());
 
     QPrinter printer(QPrinter::HighResolution);
     printer.setOutputFormat(QPrinter::PdfFormat);
@@ -6,8 +6,11 @@
 #include <QLineEdit>
 #include <QPushButton>
 
+#include "motornotas.h"
+
 class QVBoxLayout;
 class QDoubleSpinBox;
+class QLabel;
 
 class DialogoAvaliacaoFicha : public QDialog
 {
@@ -61,7 +64,9 @@ private:
         QString         nomeQuesito;
         double          peso{1.0};
         bool            temPeso{false};
+        bool            calculado{false};   // auto-calculado com fórmula
         QDoubleSpinBox* spin{};
+        QLabel*         valor{};            // calculado: resultado da fórmula
     };
 
     struct SecaoSimples {
@@ -82,19 +87,17 @@ private:
     // ===== Contexto geral =====
     int     m_idNota{-1};       // idNota já decidido pela PaginaNotas (ou -1 se não usado)
     double  m_notaFinal{0.0};
+    PesosFicha m_pesos;         // da ficha carregada
 
     // ===== UI =====
     QVBoxLayout*          m_mainLayout{};
     QVector<QuesitoCampo> m_campos;
 
-    // ===== Arquivos =====
-    const QString m_arquivoFichas     = "fichas.txt";
-    const QString m_arquivoAvaliacoes = "avaliacoes.csv";
-
     // ===== Funções auxiliares =====
     bool   carregarFicha(FichaSimples& ficha);
     void   montarUI(const FichaSimples& ficha);
     void   carregarAvaliacoesQuesitos();
     void   salvarAvaliacoesQuesitos();
     double calcularNotaFinal() const;
+    void   atualizarCalculados();
 };
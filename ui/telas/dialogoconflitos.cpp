@@ -0,0 +1,256 @@
+#include "dialogoconflitos.h"
+#include "repositorio.h"
+
+#include <QTableView>
+#include <QStandardItemModel>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QMessageBox>
+#include <QElapsedTimer>
+#include <QSet>
+
+namespace {
+
+// Dados do item do combo de alvo: ID do projeto ou nome do curso
+constexpr int PapelProjeto = Qt::UserRole;
+constexpr int PapelCurso   = Qt::UserRole + 1;
+
+} // namespace
+
+DialogoConflitos::DialogoConflitos(QWidget* parent)
+    : QDialog(parent)
+    , m_tabDeclarados(new QTableView(this))
+    , m_modelDeclarados(new QStandardItemModel(0, 4, this))
+    , m_comboAvaliador(new QComboBox(this))
+    , m_comboAlvo(new QComboBox(this))
+    , m_editMotivo(new QLineEdit(this))
+    , m_btnAdicionar(new QPushButton(" Adicionar", this))
+    , m_btnRemover(new QPushButton(" Remover", this))
+    , m_tabViolacoes(new QTableView(this))
+    , m_modelViolacoes(new QStandardItemModel(0, 4, this))
+    , m_btnAuditar(new QPushButton(" Auditar Vínculos", this))
+    , m_lblAuditoria(new QLabel(this))
+    , m_btnFechar(new QPushButton("Fechar", this))
+{
+    setModal(true);
+    setMinimumSize(900, 600);
+    setWindowTitle("Conflitos de Interesse");
+    if (parent)
+        setStyleSheet(parent->styleSheet());
+
+    auto* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(24, 24, 24, 24);
+    mainLayout->setSpacing(16);
+
+    auto* titulo = new QLabel("Conflitos de Interesse", this);
+    QFont ft = titulo->font();
+    ft.setPointSize(ft.pointSize() + 3);
+    ft.setBold(true);
+    titulo->setFont(ft);
+    titulo->setStyleSheet("color: #00D4FF; padding-bottom: 6px;");
+    mainLayout->addWidget(titulo);
+
+    auto* info = new QLabel(
+        "O responsável de um projeto nunca pode avaliá-lo. Aqui ficam os demais "
+        "conflitos: com um projeto ou com todos os projetos de um curso.", this);
+    info->setWordWrap(true);
+    mainLayout->addWidget(info);
+
+    // ----- Conflitos declarados -----
+    m_modelDeclarados->setHorizontalHeaderLabels({"Avaliador", "CPF", "Conflito com", "Motivo"});
+    configurarTabela(m_tabDeclarados, m_modelDeclarados);
+    mainLayout->addWidget(m_tabDeclarados, 1);
+
+    m_editMotivo->setPlaceholderText("Motivo (opcional)");
+    m_comboAvaliador->setMinimumWidth(200);
+    m_comboAlvo->setMinimumWidth(250);
+
+    auto* form = new QHBoxLayout();
+    form->addWidget(m_comboAvaliador);
+    form->addWidget(m_comboAlvo);
+    form->addWidget(m_editMotivo, 1);
+    form->addWidget(m_btnAdicionar);
+    form->addWidget(m_btnRemover);
+    mainLayout->addLayout(form);
+
+    // ----- Auditoria -----
+    m_modelViolacoes->setHorizontalHeaderLabels({"ID Projeto", "Projeto", "Avaliador", "Conflito"});
+    configurarTabela(m_tabViolacoes, m_modelViolacoes);
+    mainLayout->addWidget(m_tabViolacoes, 1);
+
+    auto* footer = new QHBoxLayout();
+    footer->addWidget(m_btnAuditar);
+    footer->addWidget(m_lblAuditoria, 1);
+    footer->addWidget(m_btnFechar);
+    mainLayout->addLayout(footer);
+
+    connect(m_btnAdicionar, &QPushButton::clicked, this, &DialogoConflitos::onAdicionar);
+    connect(m_btnRemover,   &QPushButton::clicked, this, &DialogoConflitos::onRemover);
+    connect(m_btnAuditar,   &QPushButton::clicked, this, &DialogoConflitos::onAuditar);
+    connect(m_btnFechar,    &QPushButton::clicked, this, &DialogoConflitos::accept);
+
+    auto& repo = Repositorio::instancia();
+    connect(&repo, &Repositorio::conflitosAlterados,   this, &DialogoConflitos::preencherDeclarados);
+    connect(&repo, &Repositorio::avaliadoresAlterados, this, &DialogoConflitos::preencherOpcoes);
+    connect(&repo, &Repositorio::projetosAlterados,    this, &DialogoConflitos::preencherOpcoes);
+    connect(&repo, &Repositorio::avaliadorAlterado,    this, &DialogoConflitos::preencherOpcoes);
+    connect(&repo, &Repositorio::projetoAlterado,      this, &DialogoConflitos::preencherOpcoes);
+    connect(&repo, &Repositorio::fichasAlteradas,      this, &DialogoConflitos::preencherOpcoes);
+
+    preencherOpcoes();
+    preencherDeclarados();
+}
+
+void DialogoConflitos::configurarTabela(QTableView* table, QStandardItemModel* model)
+{
+    table->setModel(model);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setSelectionMode(QAbstractItemView::SingleSelection);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->horizontalHeader()->setStretchLastSection(true);
+    table->verticalHeader()->setVisible(false);
+    table->setAlternatingRowColors(true);
+}
+
+// ================== LISTAS ==================
+
+void DialogoConflitos::preencherOpcoes()
+{
+    const auto& repo = Repositorio::instancia();
+
+    m_comboAvaliador->clear();
+    for (const Avaliador& a : repo.avaliadores())
+        m_comboAvaliador->addItem(QString("%1 (%2)").arg(a.nome, a.cpf), a.cpf);
+
+    m_comboAlvo->clear();
+    QSet<QString> cursos;
+    for (const Ficha& f : repo.fichas()) {
+        const QString curso = f.curso.trimmed();
+        if (curso.isEmpty() || cursos.contains(curso))
+            continue;
+        cursos.insert(curso);
+        m_comboAlvo->addItem("Curso: " + curso);
+        m_comboAlvo->setItemData(m_comboAlvo->count() - 1, 0, PapelProjeto);
+        m_comboAlvo->setItemData(m_comboAlvo->count() - 1, curso, PapelCurso);
+    }
+    for (const Projeto& p : repo.projetos()) {
+        m_comboAlvo->addItem(QString("%1 - %2").arg(p.id).arg(p.nome));
+        m_comboAlvo->setItemData(m_comboAlvo->count() - 1, p.id, PapelProjeto);
+    }
+}
+
+void DialogoConflitos::preencherDeclarados()
+{
+    const auto& repo = Repositorio::instancia();
+    m_modelDeclarados->removeRows(0, m_modelDeclarados->rowCount());
+
+    for (const ConflitoDeclarado& c : repo.conflitosDeclarados()) {
+        const Avaliador* a = repo.avaliadorPorCpf(c.cpfAvaliador);
+
+        QString alvo;
+        if (c.idProjeto > 0) {
+            const Projeto* p = repo.projetoPorId(c.idProjeto);
+            alvo = QString("%1 - %2").arg(c.idProjeto).arg(p ? p->nome : QString("(removido)"));
+        } else {
+            alvo = "Curso: " + c.curso;
+        }
+
+        QList<QStandardItem*> row;
+        row << new QStandardItem(a ? a->nome : QString())
+            << new QStandardItem(c.cpfAvaliador)
+            << new QStandardItem(alvo)
+            << new QStandardItem(c.motivo);
+        m_modelDeclarados->appendRow(row);
+    }
+}
+
+// ================== CADASTRO ==================
+
+void DialogoConflitos::onAdicionar()
+{
+    if (m_comboAvaliador->currentIndex() < 0 || m_comboAlvo->currentIndex() < 0) {
+        QMessageBox::information(this, "Conflitos de Interesse",
+                                 "Escolha o avaliador e o projeto ou curso.");
+        return;
+    }
+
+    ConflitoDeclarado c;
+    c.cpfAvaliador = m_comboAvaliador->currentData().toString();
+    c.idProjeto    = m_comboAlvo->currentData(PapelProjeto).toInt();
+    c.curso        = m_comboAlvo->currentData(PapelCurso).toString();
+    c.motivo       = m_editMotivo->text().trimmed();
+
+    auto& repo = Repositorio::instancia();
+    QVector<ConflitoDeclarado> lista = repo.conflitosDeclarados();
+
+    const Cpf cpf(c.cpfAvaliador);
+    for (const ConflitoDeclarado& existente : lista) {
+        if (Cpf(existente.cpfAvaliador) == cpf && existente.idProjeto == c.idProjeto
+            && existente.curso.compare(c.curso, Qt::CaseInsensitive) == 0) {
+            QMessageBox::information(this, "Conflitos de Interesse",
+                                     "Este conflito já está cadastrado.");
+            return;
+        }
+    }
+
+    lista.append(c);
+    if (!repo.definirConflitosDeclarados(lista)) {
+        QMessageBox::warning(this, "Erro", "Não foi possível salvar os conflitos.");
+        return;
+    }
+    m_editMotivo->clear();
+}
+
+void DialogoConflitos::onRemover()
+{
+    const QModelIndex idx = m_tabDeclarados->currentIndex();
+    if (!idx.isValid()) {
+        QMessageBox::information(this, "Conflitos de Interesse",
+                                 "Selecione um conflito.");
+        return;
+    }
+
+    auto& repo = Repositorio::instancia();
+    QVector<ConflitoDeclarado> lista = repo.conflitosDeclarados();
+    if (idx.row() >= lista.size())
+        return;
+
+    lista.removeAt(idx.row());
+    if (!repo.definirConflitosDeclarados(lista))
+        QMessageBox::warning(this, "Erro", "Não foi possível salvar os conflitos.");
+}
+
+// ================== AUDITORIA ==================
+
+void DialogoConflitos::onAuditar()
+{
+    const auto& repo = Repositorio::instancia();
+
+    QElapsedTimer t;
+    t.start();
+    const QVector<ViolacaoConflito> violacoes =
+        auditarVinculos(repo.indiceConflitos(), repo.vinculos());
+    const qint64 ms = t.elapsed();
+
+    m_modelViolacoes->removeRows(0, m_modelViolacoes->rowCount());
+    for (const ViolacaoConflito& v : violacoes) {
+        const Projeto*   p = repo.projetoPorId(v.vinculo.idProjeto);
+        const Avaliador* a = repo.avaliadorPorCpf(v.vinculo.cpfAvaliador);
+
+        QList<QStandardItem*> row;
+        row << new QStandardItem(QString::number(v.vinculo.idProjeto))
+            << new QStandardItem(p ? p->nome : QString())
+            << new QStandardItem(a ? a->nome : v.vinculo.cpfAvaliador)
+            << new QStandardItem(descreverConflito(v.motivo));
+        m_modelViolacoes->appendRow(row);
+    }
+
+    m_lblAuditoria->setText(
+        QString("%1 vínculos conferidos em %2 ms: <b>%3</b> em conflito.")
+            .arg(repo.vinculos().size()).arg(ms).arg(violacoes.size()));
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QDialog>
+
+class QTableView;
+class QStandardItemModel;
+class QPushButton;
+class QComboBox;
+class QLineEdit;
+class QLabel;
+
+// Cadastro dos conflitos de interesse declarados pelo administrador e
+// auditoria dos vínculos já existentes (ver conflitos.h)
+class DialogoConflitos : public QDialog
+{
+    Q_OBJECT
+public:
+    explicit DialogoConflitos(QWidget* parent = nullptr);
+
+private slots:
+    void onAdicionar();
+    void onRemover();
+    void onAuditar();
+    void preencherDeclarados();
+    void preencherOpcoes();
+
+private:
+    void configurarTabela(QTableView* table, QStandardItemModel* model);
+
+    QTableView*         m_tabDeclarados{};
+    QStandardItemModel* m_modelDeclarados{};
+    QComboBox*          m_comboAvaliador{};
+    QComboBox*          m_comboAlvo{};
+    QLineEdit*          m_editMotivo{};
+    QPushButton*        m_btnAdicionar{};
+    QPushButton*        m_btnRemover{};
+
+    QTableView*         m_tabViolacoes{};
+    QStandardItemModel* m_modelViolacoes{};
+    QPushButton*        m_btnAuditar{};
+    QLabel*             m_lblAuditoria{};
+    QPushButton*        m_btnFechar{};
+};
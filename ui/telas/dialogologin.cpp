@@ -1,14 +1,12 @@
 #include "dialogologin.h"
 #include "ui_dialogologin.h"
+#include "repositorio.h"
 
 #include <QVBoxLayout>
 #include <QFormLayout>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QLabel>
-#include <QFile>
-#include <QTextStream>
-#include <QRegularExpression>
 
 DialogoLogin::DialogoLogin(QWidget* parent)
     : QDialog(parent)
@@ -71,7 +69,7 @@ DialogoLogin::~DialogoLogin()
 void DialogoLogin::tentarLogin()
 {
     // Login digitado
-    QString login = m_editLogin->text().trimmed();
+    const QString login = m_editLogin->text().trimmed();
     const QString senhaDigitada = m_editSenha->text();
 
     if (login.isEmpty() || senhaDigitada.isEmpty()) {
@@ -89,60 +87,38 @@ void DialogoLogin::tentarLogin()
         return;
     }
 
-    // 2) AVALIADOR (login = CPF)
-    // se quiser aceitar com/sem máscara, normaliza:
-    // login.remove(QRegularExpression("\\D"));
-
-    QFile f("avaliadores.csv");
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        m_labelStatus->setText("Não foi possível abrir 'avaliadores.csv'. Tente como admin.");
+    // 2) AVALIADOR (login = CPF, com ou sem máscara)
+    const Cpf cpf(login);
+    if (cpf.vazio()) {
+        m_labelStatus->setText("Informe o CPF do avaliador.");
         return;
     }
 
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
-
-    bool encontrado = false;
-
-    // Formato real:
-    // 0:id ; 1:nome ; 2:email ; 3:cpf ; 4:cat+curso ; 5:senha ; 6:status ; 7:...
-    while (!in.atEnd()) {
-        const QString line = in.readLine();
-        if (line.trimmed().isEmpty()) continue;
-
-        const QStringList cols = line.split(';');
-        if (cols.size() < 6) continue;
-
-        QString cpfArquivo = cols[3].trimmed();
-        // se quiser aceitar CPF com máscara, descomenta:
-        // cpfArquivo.remove(QRegularExpression("\\D"));
-        // login.remove(QRegularExpression("\\D"));
-
-        if (cpfArquivo == login) {
-            encontrado = true;
-
-            const QString senhaArquivo = cols[5].trimmed();   // SENHA = col F
-            if (senhaArquivo != senhaDigitada) {
-                m_labelStatus->setText("Senha inválida para este avaliador.");
-                return;
-            }
-
-            m_isAdmin     = false;
-            m_cpfLogado   = cpfArquivo;
-            m_nomeLogado  = cols[1].trimmed();  // Nome
-            m_cursoLogado = cols[4].trimmed();  // "Graduação - Engenharia de Software"
-
-            accept();
-            return;
-        }
+    // Avaliadores ainda sendo carregados em segundo plano: tenta de novo
+    // assim que a carga terminar
+    auto& repo = Repositorio::instancia();
+    if (repo.carregando()) {
+        m_labelStatus->setText("Carregando dados, aguarde...");
+        connect(&repo, &Repositorio::carregamentoConcluido,
+                this, &DialogoLogin::tentarLogin, Qt::UniqueConnection);
+        return;
     }
 
-    if (!encontrado) {
+    const Avaliador* a = repo.avaliadorPorCpf(login);
+    if (!a) {
         m_labelStatus->setText("Avaliador não encontrado para esse CPF.");
+        return;
     }
-}
 
+    if (a->senha.trimmed() != senhaDigitada) {
+        m_labelStatus->setText("Senha inválida para este avaliador.");
+        return;
+    }
 
+    m_isAdmin     = false;
+    m_cpfLogado   = a->cpf.trimmed();
+    m_nomeLogado  = a->nome.trimmed();
+    m_cursoLogado = a->categoria.trimmed();  // "Graduação - Engenharia de Software"
 
+    accept();
+}
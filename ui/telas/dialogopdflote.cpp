@@ -0,0 +1,229 @@
+#include "dialogopdflote.h"
+#include "repositorio.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QComboBox>
+#include <QCheckBox>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QProgressBar>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QLabel>
+#include <QMessageBox>
+#include <QFileDialog>
+#include <QDir>
+#include <QSet>
+#include <QTimer>
+
+DialogoPdfLote::DialogoPdfLote(QWidget* parent)
+    : QDialog(parent)
+    , m_comboModo(new QComboBox(this))
+    , m_checkFichas(new QCheckBox("Incluir as fichas em branco", this))
+    , m_editDestino(new QLineEdit(this))
+    , m_btnDestino(new QPushButton("Escolher...", this))
+    , m_progresso(new QProgressBar(this))
+    , m_lblStatus(new QLabel(this))
+    , m_btnGerar(new QPushButton(" Gerar PDFs", this))
+    , m_btnCancelar(new QPushButton("Cancelar", this))
+    , m_btnFechar(new QPushButton("Fechar", this))
+    , m_timer(new QTimer(this))
+{
+    setModal(true);
+    setMinimumSize(650, 320);
+    setWindowTitle("PDFs em Lote");
+    if (parent)
+        setStyleSheet(parent->styleSheet());
+
+    auto* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(24, 24, 24, 24);
+    mainLayout->setSpacing(16);
+
+    auto* titulo = new QLabel("🖨 PDFs das Avaliações", this);
+    QFont ft = titulo->font();
+    ft.setPointSize(ft.pointSize() + 3);
+    ft.setBold(true);
+    titulo->setFont(ft);
+    titulo->setStyleSheet("color: #00D4FF; padding-bottom: 6px;");
+    mainLayout->addWidget(titulo);
+
+    m_comboModo->addItem("Um PDF por avaliação (pasta)",       int(ModoLotePdf::UmPorAvaliacao));
+    m_comboModo->addItem("Documento único com índice por projeto", int(ModoLotePdf::DocumentoUnico));
+
+    auto* linhaDestino = new QHBoxLayout();
+    linhaDestino->addWidget(m_editDestino, 1);
+    linhaDestino->addWidget(m_btnDestino);
+
+    auto* form = new QFormLayout();
+    form->addRow("Saída:", m_comboModo);
+    form->addRow("Destino:", linhaDestino);
+    form->addRow("", m_checkFichas);
+    mainLayout->addLayout(form);
+
+    m_progresso->setRange(0, 1);
+    m_progresso->setValue(0);
+    mainLayout->addWidget(m_progresso);
+
+    m_lblStatus->setWordWrap(true);
+    m_lblStatus->setText(
+        QString("%1 avaliações registradas; sai só a última de cada avaliador por projeto.")
+            .arg(Repositorio::instancia().avaliacoes().size()));
+    mainLayout->addWidget(m_lblStatus);
+    mainLayout->addStretch();
+
+    auto* footer = new QHBoxLayout();
+    footer->addStretch();
+    footer->addWidget(m_btnCancelar);
+    footer->addWidget(m_btnGerar);
+    footer->addWidget(m_btnFechar);
+    mainLayout->addLayout(footer);
+
+    m_btnCancelar->setEnabled(false);
+    m_timer->setInterval(100);
+
+    connect(m_comboModo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &DialogoPdfLote::onModoAlterado);
+    connect(m_btnDestino,  &QPushButton::clicked, this, &DialogoPdfLote::onEscolherDestino);
+    connect(m_btnGerar,    &QPushButton::clicked, this, &DialogoPdfLote::onGerar);
+    connect(m_btnCancelar, &QPushButton::clicked, this, &DialogoPdfLote::onCancelar);
+    connect(m_btnFechar,   &QPushButton::clicked, this, &DialogoPdfLote::reject);
+    connect(m_timer,       &QTimer::timeout,      this, &DialogoPdfLote::onProgresso);
+    connect(&m_observador, &QFutureWatcherBase::finished, this, &DialogoPdfLote::onConcluido);
+
+    onModoAlterado(0);
+}
+
+DialogoPdfLote::~DialogoPdfLote()
+{
+    aguardarLote();
+}
+
+void DialogoPdfLote::aguardarLote()
+{
+    if (m_lote && m_observador.isRunning()) {
+        m_lote->cancelar();
+        m_observador.waitForFinished();
+    }
+}
+
+void DialogoPdfLote::reject()
+{
+    // Fechar no meio cancela e espera as threads terminarem o documento atual
+    aguardarLote();
+    QDialog::reject();
+}
+
+// ================== DESTINO ==================
+
+void DialogoPdfLote::onModoAlterado(int)
+{
+    const bool unico = ModoLotePdf(m_comboModo->currentData().toInt()) == ModoLotePdf::DocumentoUnico;
+    m_editDestino->setText(unico ? QDir::current().filePath("avaliacoes.pdf")
+                                 : QDir::current().filePath("pdfs_avaliacoes"));
+}
+
+void DialogoPdfLote::onEscolherDestino()
+{
+    const bool unico = ModoLotePdf(m_comboModo->currentData().toInt()) == ModoLotePdf::DocumentoUnico;
+
+    const QString destino = unico
+        ? QFileDialog::getSaveFileName(this, "Documento único", m_editDestino->text(),
+                                       "Arquivos PDF (*.pdf)")
+        : QFileDialog::getExistingDirectory(this, "Pasta dos PDFs", m_editDestino->text());
+
+    if (!destino.isEmpty())
+        m_editDestino->setText(destino);
+}
+
+// ================== GERAÇÃO ==================
+
+void DialogoPdfLote::onGerar()
+{
+    const QString destino = m_editDestino->text().trimmed();
+    if (destino.isEmpty()) {
+        QMessageBox::warning(this, "PDFs em Lote", "Informe o destino.");
+        return;
+    }
+
+    // Cópia dos dados: o repositório pode mudar enquanto o lote roda
+    const auto& repo = Repositorio::instancia();
+    const QVector<DocumentoAvaliacaoPdf> avaliacoes =
+        documentosAvaliacoes(repo.avaliacoes(), repo.fichas());
+
+    QVector<Ficha> fichas;
+    if (m_checkFichas->isChecked()) {
+        QSet<int> usadas;
+        for (const DocumentoAvaliacaoPdf& d : avaliacoes)
+            usadas.insert(d.idFicha);
+        for (const Ficha& f : repo.fichas())
+            if (usadas.contains(f.id))
+                fichas.append(f);
+    }
+
+    if (avaliacoes.isEmpty() && fichas.isEmpty()) {
+        QMessageBox::information(this, "PDFs em Lote", "Nenhuma avaliação registrada.");
+        return;
+    }
+
+    const auto modo = ModoLotePdf(m_comboModo->currentData().toInt());
+    m_lote = std::make_shared<LotePdf>(avaliacoes, fichas, modo, destino);
+
+    m_progresso->setRange(0, m_lote->total());
+    m_progresso->setValue(0);
+    m_lblStatus->setText(QString("Gerando %1 documentos...").arg(m_lote->total()));
+
+    m_btnGerar->setEnabled(false);
+    m_btnCancelar->setEnabled(true);
+    m_comboModo->setEnabled(false);
+    m_editDestino->setEnabled(false);
+    m_btnDestino->setEnabled(false);
+    m_checkFichas->setEnabled(false);
+
+    const std::shared_ptr<LotePdf> lote = m_lote;
+    m_observador.setFuture(QtConcurrent::run([lote] { return lote->executar(); }));
+    m_timer->start();
+}
+
+void DialogoPdfLote::onCancelar()
+{
+    if (m_lote) {
+        m_lote->cancelar();
+        m_btnCancelar->setEnabled(false);
+        m_lblStatus->setText("Cancelando...");
+    }
+}
+
+void DialogoPdfLote::onProgresso()
+{
+    if (m_lote)
+        m_progresso->setValue(m_lote->concluidos());
+}
+
+void DialogoPdfLote::onConcluido()
+{
+    m_timer->stop();
+    onProgresso();
+
+    const ResultadoLotePdf r = m_observador.result();
+
+    m_btnGerar->setEnabled(true);
+    m_btnCancelar->setEnabled(false);
+    m_comboModo->setEnabled(true);
+    m_editDestino->setEnabled(true);
+    m_btnDestino->setEnabled(true);
+    m_checkFichas->setEnabled(true);
+
+    QString status = QString("%1 documentos, %2 páginas em %3 s (%4 páginas/s)")
+                         .arg(r.documentos).arg(r.paginas)
+                         .arg(r.ms / 1000.0, 0, 'f', 1)
+                         .arg(r.paginasPorSegundo(), 0, 'f', 1);
+    if (r.cancelado)
+        status = "Cancelado. " + status;
+    m_lblStatus->setText(status);
+
+    if (r.falhas > 0)
+        QMessageBox::warning(this, "PDFs em Lote",
+                             QString("%1 documentos não foram gravados:\n\n").arg(r.falhas)
+                                 + r.erros.mid(0, 10).join('\n'));
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QDialog>
+#include <QFutureWatcher>
+
+#include <memory>
+
+#include "exportacaopdf.h"
+
+class QComboBox;
+class QCheckBox;
+class QLineEdit;
+class QPushButton;
+class QProgressBar;
+class QLabel;
+class QTimer;
+
+// PDFs de todas as avaliações de uma vez, nas threads de trabalho, com
+// barra de progresso e cancelamento (ver exportacaopdf.h)
+class DialogoPdfLote : public QDialog
+{
+    Q_OBJECT
+public:
+    explicit DialogoPdfLote(QWidget* parent = nullptr);
+    ~DialogoPdfLote() override;
+
+public slots:
+    void reject() override;
+
+private slots:
+    void onModoAlterado(int index);
+    void onEscolherDestino();
+    void onGerar();
+    void onCancelar();
+    void onProgresso();
+    void onConcluido();
+
+private:
+    void aguardarLote();
+
+    std::shared_ptr<LotePdf>           m_lote;
+    QFutureWatcher<ResultadoLotePdf>   m_observador;
+
+    QComboBox*    m_comboModo{};
+    QCheckBox*    m_checkFichas{};
+    QLineEdit*    m_editDestino{};
+    QPushButton*  m_btnDestino{};
+    QProgressBar* m_progresso{};
+    QLabel*       m_lblStatus{};
+    QPushButton*  m_btnGerar{};
+    QPushButton*  m_btnCancelar{};
+    QPushButton*  m_btnFechar{};
+    QTimer*       m_timer{};
+};
@@ -0,0 +1,254 @@
+#include "dialogoranking.h"
+#include "repositorio.h"
+
+#include <QTableView>
+#include <QStandardItemModel>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QMessageBox>
+#include <QFileDialog>
+#include <QFile>
+#include <QTextStream>
+
+DialogoRanking::DialogoRanking(QWidget* parent)
+    : QDialog(parent)
+    , m_spinTamanho(new QSpinBox(this))
+    , m_comboAgrupamento(new QComboBox(this))
+    , m_table(new QTableView(this))
+    , m_model(new QStandardItemModel(0, 10, this))
+    , m_btnExportCsv(new QPushButton("📊 Exportar CSV", this))
+    , m_btnFechar(new QPushButton("Fechar", this))
+{
+    setModal(true);
+    setMinimumSize(900, 550);
+    setWindowTitle("Ranking dos Projetos");
+    if (parent)
+        setStyleSheet(parent->styleSheet());
+
+    auto* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(24, 24, 24, 24);
+    mainLayout->setSpacing(16);
+
+    auto* titulo = new QLabel("🏆 Ranking dos Projetos", this);
+    QFont ft = titulo->font();
+    ft.setPointSize(ft.pointSize() + 3);
+    ft.setBold(true);
+    titulo->setFont(ft);
+    titulo->setStyleSheet("color: #00D4FF; padding-bottom: 6px;");
+    mainLayout->addWidget(titulo);
+
+    // ----- Regras -----
+    const RegrasRanking padrao;
+
+    m_spinTamanho->setRange(1, 100);
+    m_spinTamanho->setValue(padrao.tamanho);
+
+    m_comboAgrupamento->addItem("Categoria", int(AgrupamentoRanking::Categoria));
+    m_comboAgrupamento->addItem("Tipo de ficha", int(AgrupamentoRanking::TipoFicha));
+
+    auto* regras = new QHBoxLayout();
+    regras->addWidget(new QLabel("Primeiros:", this));
+    regras->addWidget(m_spinTamanho);
+    regras->addSpacing(12);
+    regras->addWidget(new QLabel("Agrupar por:", this));
+    regras->addWidget(m_comboAgrupamento);
+    regras->addSpacing(12);
+    regras->addWidget(new QLabel("Desempate:", this));
+    for (int i = 0; i < 3; ++i) {
+        QComboBox* c = new QComboBox(this);
+        c->addItem("Maior nota de seção", int(CriterioDesempate::MaiorSecao));
+        c->addItem("Menor variância",     int(CriterioDesempate::MenorVariancia));
+        c->addItem("Primeira submissão",  int(CriterioDesempate::PrimeiraSubmissao));
+        c->addItem("—", -1);
+        c->setCurrentIndex(c->findData(int(padrao.desempate.value(i))));
+        regras->addWidget(c);
+        m_comboDesempate[i] = c;
+    }
+    regras->addStretch();
+    mainLayout->addLayout(regras);
+
+    auto* info = new QLabel(
+        "Ordem pela média das notas do projeto. Em caso de empate valem os "
+        "critérios acima, da esquerda para a direita, e por fim o ID do projeto.", this);
+    info->setWordWrap(true);
+    mainLayout->addWidget(info);
+
+    configurarTabela();
+    mainLayout->addWidget(m_table, 1);
+
+    auto* footer = new QHBoxLayout();
+    footer->addWidget(m_btnExportCsv);
+    footer->addStretch();
+    footer->addWidget(m_btnFechar);
+    mainLayout->addLayout(footer);
+
+    connect(m_spinTamanho, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &DialogoRanking::onRegrasAlteradas);
+    connect(m_comboAgrupamento, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &DialogoRanking::onRegrasAlteradas);
+    for (QComboBox* c : m_comboDesempate)
+        connect(c, QOverload<int>::of(&QComboBox::currentIndexChanged),
+                this, &DialogoRanking::onRegrasAlteradas);
+    connect(m_btnExportCsv, &QPushButton::clicked, this, &DialogoRanking::onExportCsv);
+    connect(m_btnFechar,    &QPushButton::clicked, this, &DialogoRanking::accept);
+
+    // Nota a nota só o grupo do projeto muda; o resto refaz tudo
+    auto& repo = Repositorio::instancia();
+    connect(&repo, &Repositorio::notaAlterada, this, &DialogoRanking::onNotaAlterada);
+    connect(&repo, &Repositorio::avaliacoesAcrescentadas, this, [this](int primeira, int quantidade) {
+        m_ranking.acrescentarAvaliacoes(Repositorio::instancia(), primeira, quantidade);
+    });
+    connect(&repo, &Repositorio::notasAlteradas,       this, &DialogoRanking::onReconstruir);
+    connect(&repo, &Repositorio::notaRemovida,         this, &DialogoRanking::onReconstruir);
+    connect(&repo, &Repositorio::avaliacoesAlteradas,  this, &DialogoRanking::onReconstruir);
+    connect(&repo, &Repositorio::projetosAlterados,    this, &DialogoRanking::onReconstruir);
+    connect(&repo, &Repositorio::projetoAlterado,      this, &DialogoRanking::onReconstruir);
+    connect(&repo, &Repositorio::fichasAlteradas,      this, &DialogoRanking::onReconstruir);
+
+    onReconstruir();
+}
+
+void DialogoRanking::configurarTabela()
+{
+    m_model->setHorizontalHeaderLabels({
+        "Grupo", "Posição", "ID Projeto", "Projeto", "Responsável",
+        "Notas", "Média", "Variância", "Melhor Seção", "1ª Nota"
+    });
+
+    m_table->setModel(m_model);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->setAlternatingRowColors(true);
+
+    auto* header = m_table->horizontalHeader();
+    for (int c = 0; c < m_model->columnCount(); ++c)
+        header->setSectionResizeMode(c, QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(3, QHeaderView::Stretch);
+}
+
+// ================== ATUALIZAÇÃO ==================
+
+void DialogoRanking::onRegrasAlteradas()
+{
+    RegrasRanking r;
+    r.tamanho     = m_spinTamanho->value();
+    r.agrupamento = AgrupamentoRanking(m_comboAgrupamento->currentData().toInt());
+    r.desempate.clear();
+    for (QComboBox* c : m_comboDesempate) {
+        const int v = c->currentData().toInt();
+        if (v < 0)
+            continue;
+        const auto criterio = CriterioDesempate(v);
+        if (!r.desempate.contains(criterio))
+            r.desempate.append(criterio);
+    }
+
+    m_ranking.definirRegras(r, Repositorio::instancia());
+    preencherTabela();
+}
+
+void DialogoRanking::onNotaAlterada(int idNota)
+{
+    if (!m_ranking.atualizarNota(Repositorio::instancia(), idNota))
+        m_ranking.reconstruir(Repositorio::instancia());
+    preencherTabela();
+}
+
+void DialogoRanking::onReconstruir()
+{
+    m_ranking.reconstruir(Repositorio::instancia());
+    preencherTabela();
+}
+
+void DialogoRanking::preencherTabela()
+{
+    const auto& repo = Repositorio::instancia();
+    m_model->removeRows(0, m_model->rowCount());
+
+    for (const QString& grupo : m_ranking.grupos()) {
+        for (const ItemRanking& item : m_ranking.topo(grupo)) {
+            const Projeto* p = repo.projetoPorId(item.idProjeto);
+
+            QList<QStandardItem*> row;
+            row << new QStandardItem(grupo);
+            row << new QStandardItem(QString("%1º").arg(item.posicao));
+            row << new QStandardItem(QString::number(item.idProjeto));
+            row << new QStandardItem(p ? p->nome : QString());
+            row << new QStandardItem(p ? p->responsavel : QString());
+            row << new QStandardItem(QString::number(item.quantidadeNotas));
+            row << new QStandardItem(QString::number(item.media, 'f', 2));
+            row << new QStandardItem(QString::number(item.variancia, 'f', 3));
+            row << new QStandardItem(QString::number(item.melhorSecao, 'f', 2));
+            row << new QStandardItem(QString::number(item.primeiraNota));
+
+            m_model->appendRow(row);
+        }
+    }
+}
+
+// ================== EXPORTAÇÃO ==================
+
+void DialogoRanking::onExportCsv()
+{
+    QString filename = QFileDialog::getSaveFileName(
+        this,
+        "Exportar ranking para CSV",
+        "ranking.csv",
+        "Arquivos CSV (*.csv);;Todos os arquivos (*.*)"
+        );
+
+    if (filename.isEmpty())
+        return;
+
+    QFile f(filename);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, "Exportar CSV",
+                             "Não foi possível abrir o arquivo para escrita.");
+        return;
+    }
+
+    QTextStream out(&f);
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+    out.setCodec("UTF-8");
+#endif
+
+    const auto& repo = Repositorio::instancia();
+
+    out << "Grupo;Posicao;IdProjeto;Projeto;Responsavel;"
+           "QtdNotas;Media;Variancia;MelhorSecao;PrimeiraNota\n";
+
+    for (const QString& grupo : m_ranking.grupos()) {
+        for (const ItemRanking& item : m_ranking.topo(grupo)) {
+            const Projeto* p = repo.projetoPorId(item.idProjeto);
+
+            // Evita quebrar o CSV com ';' dentro dos textos
+            QString nomeGrupo = grupo;
+            nomeGrupo.replace(';', ',');
+            QString nomeProj = p ? p->nome : QString();
+            nomeProj.replace(';', ',');
+            QString resp = p ? p->responsavel : QString();
+            resp.replace(';', ',');
+
+            out << nomeGrupo            << ';'
+                << item.posicao         << ';'
+                << item.idProjeto       << ';'
+                << nomeProj             << ';'
+                << resp                 << ';'
+                << item.quantidadeNotas << ';'
+                << item.media           << ';'
+                << item.variancia       << ';'
+                << item.melhorSecao     << ';'
+                << item.primeiraNota    << '\n';
+        }
+    }
+
+    QMessageBox::information(this, "Exportar CSV",
+                             "Ranking exportado com sucesso.");
+}
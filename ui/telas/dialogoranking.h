@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QDialog>
+
+#include "rankingprojetos.h"
+
+class QTableView;
+class QStandardItemModel;
+class QPushButton;
+class QSpinBox;
+class QComboBox;
+
+// Top-K dos projetos por categoria ou tipo de ficha, atualizado enquanto
+// as notas chegam (ver rankingprojetos.h)
+class DialogoRanking : public QDialog
+{
+    Q_OBJECT
+public:
+    explicit DialogoRanking(QWidget* parent = nullptr);
+
+private slots:
+    void onRegrasAlteradas();
+    void onNotaAlterada(int idNota);
+    void onReconstruir();
+    void onExportCsv();
+
+private:
+    void configurarTabela();
+    void preencherTabela();
+
+    RankingProjetos     m_ranking;
+
+    QSpinBox*           m_spinTamanho{};
+    QComboBox*          m_comboAgrupamento{};
+    QComboBox*          m_comboDesempate[3]{};
+    QTableView*         m_table{};
+    QStandardItemModel* m_model{};
+    QPushButton*        m_btnExportCsv{};
+    QPushButton*        m_btnFechar{};
+};
@@ -1,4 +1,5 @@
 #include "dialogoselecionarficha.h"
+#include "repositorio.h"
 
 #include <QTableView>
 #include <QStandardItemModel>
@@ -7,8 +8,6 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
-#include <QFile>
-#include <QTextStream>
 #include <QMessageBox>
 
 DialogoSelecionarFicha::DialogoSelecionarFicha(const QString& cursoProjeto,
@@ -87,88 +86,30 @@ void DialogoSelecionarFicha::configurarTabela()
 }
 void DialogoSelecionarFicha::carregarFichas()
 {
-    QFile f(m_arquivoFichas);
-    if (!f.exists())
-        return;
-
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QMessageBox::warning(this, "Fichas",
-                             "Não foi possível abrir o arquivo de fichas.");
-        return;
-    }
-
     m_model->removeRows(0, m_model->rowCount());
 
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
-
-    while (!in.atEnd()) {
-        const QString line = in.readLine().trimmed();
-        if (line.isEmpty())
-            continue;
-
-        const QStringList p = line.split(';');
-
-        // precisamos de pelo menos os campos fixos até numSecoes
-        if (p.size() < 14)
-            continue;
-
-        bool okId = false;
-        const int id = p.at(0).toInt(&okId);
-        if (!okId)
-            continue;
-
-        const QString tipo       = p.at(1);
-        const QString resolucao  = QString("%1/%2").arg(p.at(2), p.at(3));
-        const QString cursoFicha = p.at(4);   // <-- agora é o curso certo
-
-        // calcula o total de quesitos percorrendo as seções serializadas
-        int totalQuesitos = 0;
-        bool okNumSecoes = false;
-        const int numSecoes = p.at(13).toInt(&okNumSecoes);
-
-        int idx = 14; // início das seções
-        if (okNumSecoes) {
-            for (int s = 0; s < numSecoes && idx < p.size(); ++s) {
-                if (idx + 2 >= p.size())
-                    break;
-
-                // pula identificador e título
-                idx += 2;
-
-                // número de quesitos da seção
-                if (idx >= p.size())
-                    break;
-                bool okQtd = false;
-                const int qtd = p.at(idx).toInt(&okQtd);
-                ++idx;
-                if (!okQtd)
-                    break;
-
-                totalQuesitos += qtd;
-
-                // pula dados dos quesitos: 4 campos por quesito
-                idx += qtd * 4;
-            }
-        }
+    for (const Ficha& f : Repositorio::instancia().fichas()) {
+        const QString resolucao = QString("%1/%2").arg(f.resolucaoNum, f.resolucaoAno);
 
         // filtro por curso do projeto
         if (!m_cursoProjeto.isEmpty()) {
-            if (cursoFicha.trimmed() != m_cursoProjeto)
+            if (f.curso.trimmed() != m_cursoProjeto)
                 continue;
         }
 
+        int totalQuesitos = 0;
+        for (const Secao& sec : f.secoes)
+            totalQuesitos += sec.quesitos.size();
+
         QList<QStandardItem*> row;
-        auto* idItem = new QStandardItem(QString::number(id));
+        auto* idItem = new QStandardItem(QString::number(f.id));
         idItem->setEditable(false);
 
         row << idItem
-            << new QStandardItem(tipo)
+            << new QStandardItem(f.tipoFicha)
             << new QStandardItem(resolucao)
             << new QStandardItem(QString::number(totalQuesitos))
-            << new QStandardItem(cursoFicha);
+            << new QStandardItem(f.curso);
 
         for (auto* it : row)
             it->setEditable(false);
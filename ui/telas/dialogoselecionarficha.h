@@ -33,6 +33,4 @@ private:
 
     int     m_fichaIdSelecionada{-1};
     QString m_fichaLabelSelecionada;
-
-    const QString m_arquivoFichas{"fichas.txt"};
 };
@@ -1,4 +1,5 @@
 #include "dialogovincularavaliadores.h"
+#include "repositorio.h"
 
 #include <QTableView>
 #include <QStandardItemModel>
@@ -7,11 +8,8 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
-#include <QFile>
-#include <QTextStream>
 #include <QMessageBox>
-#include <QRegularExpression>
-#include <QSet>
+#include <QColor>
 
 DialogoVincularAvaliadores::DialogoVincularAvaliadores(int idProjeto,
                                                        const QString& nomeProjeto,
@@ -54,10 +52,11 @@ DialogoVincularAvaliadores::DialogoVincularAvaliadores(int idProjeto,
     lblInfo->setText(
         QString("Projeto: <b>%1</b> (ID: %2)<br>"
                 "Categoria: <b>%3</b><br>"
-                "Selecione até <b>3 avaliadores</b> com a mesma área/especialidade.")
+                "Selecione até <b>%4 avaliadores</b> com a mesma área/especialidade.")
             .arg(m_nomeProjeto)
             .arg(m_idProjeto)
-            .arg(m_categoriaProjeto));
+            .arg(m_categoriaProjeto)
+            .arg(MaxAvaliadoresPorProjeto));
     mainLayout->addWidget(lblInfo);
 
     // modelos
@@ -127,60 +126,35 @@ void DialogoVincularAvaliadores::configurarTabela(QTableView* table,
 
 void DialogoVincularAvaliadores::carregarDados()
 {
-    // quais CPFs já estão vinculados a este projeto
-    QVector<VinculoProjeto> vincs = carregarVinculos(m_arquivoVinculos);
-    QSet<QString> cpfsProjeto;
-
-    for (const auto& v : vincs) {
-        if (v.idProjeto == m_idProjeto) {
-            QString cpf = v.cpfAvaliador;
-            cpf.remove(QRegularExpression("\\D"));
-            cpfsProjeto.insert(cpf);
-        }
-    }
-
-    QFile f(m_arquivoAvaliadores);
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
-        return;
-
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
-    while (!in.atEnd()) {
-        const QString line = in.readLine().trimmed();
-        if (line.isEmpty()) continue;
-
-        const QStringList p = line.split(';');
-        if (p.size() < 7) continue; // ID, Nome, Email, CPF, Categoria, Senha, Status,...
-
-        const QString nome      = p.value(1);
-        const QString email     = p.value(2);
-        QString       cpf       = p.value(3);
-        const QString categoria = p.value(4);
-        const QString status    = p.value(6);
+    const auto& repo = Repositorio::instancia();
 
+    for (const Avaliador& a : repo.avaliadores()) {
         // só avaliadores ativos e da mesma categoria/especialidade do projeto
-        if (!status.compare("Ativo", Qt::CaseInsensitive) == 0 &&
-            status.trimmed() != "Ativo")
+        if (a.status.trimmed().compare("Ativo", Qt::CaseInsensitive) != 0)
             continue;
 
-        if (categoria.trimmed() != m_categoriaProjeto.trimmed())
+        if (a.categoria.trimmed() != m_categoriaProjeto.trimmed())
             continue;
 
-        QString cpfNorm = cpf;
-        cpfNorm.remove(QRegularExpression("\\D"));
-
         QList<QStandardItem*> row;
-        row << new QStandardItem(nome)
-            << new QStandardItem(email)
-            << new QStandardItem(cpf)
-            << new QStandardItem(categoria);
+        row << new QStandardItem(a.nome)
+            << new QStandardItem(a.email)
+            << new QStandardItem(a.cpf)
+            << new QStandardItem(a.categoria);
 
         for (auto* it : row)
             it->setEditable(false);
 
-        if (cpfsProjeto.contains(cpfNorm))
+        // avaliador em conflito continua na lista, mas marcado
+        const MotivoConflito conflito = repo.conflito(m_idProjeto, a.cpf);
+        if (conflito != MotivoConflito::Nenhum) {
+            for (auto* it : row) {
+                it->setForeground(QColor("#FF6B6B"));
+                it->setToolTip(descreverConflito(conflito));
+            }
+        }
+
+        if (repo.vinculado(m_idProjeto, a.cpf))
             m_modelSelecionados->appendRow(row);
         else
             m_modelDisponiveis->appendRow(row);
@@ -193,7 +167,8 @@ void DialogoVincularAvaliadores::atualizarResumo()
 {
     const int qtd = m_modelSelecionados->rowCount();
     m_lblResumo->setText(
-        QString("Avaliadores selecionados: <b>%1</b> de 3").arg(qtd));
+        QString("Avaliadores selecionados: <b>%1</b> de %2")
+            .arg(qtd).arg(MaxAvaliadoresPorProjeto));
 }
 
 int DialogoVincularAvaliadores::totalSelecionados() const
@@ -206,13 +181,24 @@ void DialogoVincularAvaliadores::onAdicionar()
     const QModelIndex idx = m_tabDisponiveis->currentIndex();
     if (!idx.isValid()) return;
 
-    if (m_modelSelecionados->rowCount() >= 3) {
+    if (m_modelSelecionados->rowCount() >= MaxAvaliadoresPorProjeto) {
         QMessageBox::warning(this, "Limite atingido",
-                             "Cada projeto pode ter no máximo 3 avaliadores.");
+                             QString("Cada projeto pode ter no máximo %1 avaliadores.")
+                                 .arg(MaxAvaliadoresPorProjeto));
         return;
     }
 
     const int row = idx.row();
+    const QString cpf = m_modelDisponiveis->item(row, 2)->text(); // coluna CPF
+    const MotivoConflito conflito = Repositorio::instancia().conflito(m_idProjeto, cpf);
+    if (conflito != MotivoConflito::Nenhum) {
+        QMessageBox::warning(this, "Conflito de interesse",
+                             QString("%1 não pode avaliar este projeto:\n%2.")
+                                 .arg(m_modelDisponiveis->item(row, 0)->text(),
+                                      descreverConflito(conflito)));
+        return;
+    }
+
     QList<QStandardItem*> novaLinha;
     for (int c = 0; c < m_modelDisponiveis->columnCount(); ++c) {
         auto* src = m_modelDisponiveis->item(row, c);
@@ -248,24 +234,34 @@ void DialogoVincularAvaliadores::onRemover()
 void DialogoVincularAvaliadores::onSalvar()
 {
     const int qtd = m_modelSelecionados->rowCount();
-    if (qtd > 3) {
+    if (qtd > MaxAvaliadoresPorProjeto) {
         QMessageBox::warning(this, "Erro",
-                             "O projeto não pode ter mais de 3 avaliadores.");
+                             QString("O projeto não pode ter mais de %1 avaliadores.")
+                                 .arg(MaxAvaliadoresPorProjeto));
         return;
     }
 
-    auto lista = carregarVinculos(m_arquivoVinculos);
-    removerVinculosPorProjeto(lista, m_idProjeto);
-
+    const auto& repo = Repositorio::instancia();
+    QStringList cpfs;
+    QStringList conflitos;
     for (int r = 0; r < m_modelSelecionados->rowCount(); ++r) {
-        QString cpf = m_modelSelecionados->item(r, 2)->text(); // coluna CPF
-        VinculoProjeto v;
-        v.idProjeto    = m_idProjeto;
-        v.cpfAvaliador = cpf;
-        lista.push_back(v);
+        const QString cpf = m_modelSelecionados->item(r, 2)->text(); // coluna CPF
+        const MotivoConflito conflito = repo.conflito(m_idProjeto, cpf);
+        if (conflito != MotivoConflito::Nenhum)
+            conflitos << QString("%1: %2").arg(m_modelSelecionados->item(r, 0)->text(),
+                                               descreverConflito(conflito));
+        cpfs << cpf;
+    }
+
+    // vínculos antigos podem ter ficado em conflito depois de uma declaração
+    if (!conflitos.isEmpty()) {
+        QMessageBox::warning(this, "Conflito de interesse",
+                             "Remova os avaliadores em conflito com o projeto:\n\n"
+                                 + conflitos.join('\n'));
+        return;
     }
 
-    if (!salvarVinculos(m_arquivoVinculos, lista)) {
+    if (!Repositorio::instancia().definirAvaliadoresDoProjeto(m_idProjeto, cpfs)) {
         QMessageBox::warning(this, "Erro",
                              "Não foi possível salvar os vínculos.");
         return;
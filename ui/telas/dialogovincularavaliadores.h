@@ -9,8 +9,6 @@ class QStandardItemModel;
 class QPushButton;
 class QLabel;
 
-#include "vinculos.h"
-
 class DialogoVincularAvaliadores : public QDialog
 {
     Q_OBJECT
@@ -45,10 +43,6 @@ private:
     QPushButton*        m_btnCancelar{};
     QLabel*             m_lblResumo{};
 
-    // arquivos
-    const QString m_arquivoAvaliadores{"avaliadores.csv"};
-    const QString m_arquivoVinculos{"vinculos_projetos.csv"};
-
     // métodos internos
     void configurarTabela(QTableView* table, QStandardItemModel* model);
     void carregarDados();
@@ -0,0 +1,205 @@
+// distribuicaoavaliadores.cpp
+#include "distribuicaoavaliadores.h"
+
+#include <QElapsedTimer>
+#include <QPair>
+#include <QSet>
+#include <QTextStream>
+#include <QVarLengthArray>
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+namespace {
+
+struct Candidato {
+    int carga;
+    int indice;   // em 'avaliadores'
+};
+
+// Menor carga no topo; empate pela ordem do cadastro
+struct MaisCarregado {
+    bool operator()(const Candidato& a, const Candidato& b) const
+    {
+        return a.carga != b.carga ? a.carga > b.carga : a.indice > b.indice;
+    }
+};
+
+using FilaCandidatos = std::priority_queue<Candidato, std::vector<Candidato>, MaisCarregado>;
+
+bool ativo(const Avaliador& a)
+{
+    return a.status.trimmed().compare("Ativo", Qt::CaseInsensitive) == 0;
+}
+
+} // namespace
+
+ResultadoDistribuicao distribuirAvaliadores(const QVector<Projeto>& projetos,
+                                            const QVector<Avaliador>& avaliadores,
+                                            const QVector<VinculoProjeto>& vinculos,
+                                            const QVector<Nota>& notas,
+                                            const OpcoesDistribuicao& opcoes)
+{
+    ResultadoDistribuicao r;
+
+    // ----- Avaliadores ativos por categoria -----
+    QVector<Cpf>   cpfs(avaliadores.size());
+    QVector<int>   carga(avaliadores.size(), 0);
+    QHash<Cpf, int> ativos;                       // CPF -> posição
+    QHash<QString, QVector<int>> porCategoria;
+    for (int i = 0; i < avaliadores.size(); ++i) {
+        const Avaliador& a = avaliadores[i];
+        cpfs[i] = Cpf(a.cpf);
+        if (!ativo(a) || cpfs[i].vazio())
+            continue;
+        ativos.insert(cpfs[i], i);
+        porCategoria[a.categoria.trimmed()].append(i);
+    }
+
+    // ----- Vínculos mantidos -----
+    QSet<QPair<int, Cpf>> comNota;
+    if (opcoes.refazer)
+        for (const Nota& n : notas)
+            comNota.insert(qMakePair(n.idProjeto, Cpf(n.cpfAvaliador)));
+
+    QHash<int, QStringList> mantidos;
+    QHash<int, int>         removidos;
+    for (const VinculoProjeto& v : vinculos) {
+        const Cpf cpf = v.cpf();
+        if (opcoes.refazer && !comNota.contains(qMakePair(v.idProjeto, cpf))) {
+            ++removidos[v.idProjeto];
+            continue;
+        }
+        mantidos[v.idProjeto].append(v.cpfAvaliador);
+        const auto it = ativos.constFind(cpf);
+        if (it != ativos.constEnd())
+            ++carga[it.value()];
+    }
+
+    QHash<QString, FilaCandidatos> filas;
+    for (auto it = porCategoria.cbegin(); it != porCategoria.cend(); ++it) {
+        FilaCandidatos& fila = filas[it.key()];
+        for (int i : it.value())
+            fila.push({carga[i], i});
+    }
+
+    // ----- Vagas, em ordem de ID (resultado estável entre execuções) -----
+    QVector<int> ordem(projetos.size());
+    std::iota(ordem.begin(), ordem.end(), 0);
+    std::sort(ordem.begin(), ordem.end(), [&projetos](int a, int b) {
+        return projetos[a].id < projetos[b].id;
+    });
+
+    std::vector<Candidato> devolver;
+    for (int pi : ordem) {
+        const Projeto& p = projetos[pi];
+        QStringList lista = mantidos.value(p.id);
+        const int antes = lista.size();
+        int vagas = opcoes.maximoPorProjeto - lista.size();
+
+        const auto fila = filas.find(p.categoria.trimmed());
+        if (vagas > 0 && fila != filas.end()) {
+            QVarLengthArray<Cpf, MaxAvaliadoresPorProjeto + 1> presentes;
+            for (const QString& cpf : lista)
+                presentes.append(Cpf(cpf));
+
+            // Quem já está no projeto ou está em conflito com ele sai do
+            // heap e volta com a carga de antes
+            devolver.clear();
+            while (vagas > 0 && !fila->empty()) {
+                Candidato c = fila->top();
+                fila->pop();
+                const bool livre =
+                    std::find(presentes.cbegin(), presentes.cend(), cpfs[c.indice])
+                        == presentes.cend()
+                    && (!opcoes.conflitos
+                        || opcoes.conflitos->conflito(p.id, cpfs[c.indice])
+                               == MotivoConflito::Nenhum);
+                if (livre) {
+                    lista.append(avaliadores[c.indice].cpf);
+                    presentes.append(cpfs[c.indice]);
+                    ++c.carga;
+                    ++carga[c.indice];
+                    --vagas;
+                }
+                devolver.push_back(c);
+            }
+            for (const Candidato& c : devolver)
+                fila->push(c);
+        }
+        if (vagas > 0)
+            ++r.projetosIncompletos;
+
+        const int novos = lista.size() - antes;
+        const int saiu  = removidos.value(p.id);
+        if (novos > 0 || saiu > 0) {
+            r.avaliadoresPorProjeto.insert(p.id, lista);
+            r.vinculosNovos     += novos;
+            r.vinculosRemovidos += saiu;
+        }
+    }
+
+    // ----- Carga final -----
+    bool primeiro = true;
+    for (int i : ativos) {
+        r.cargaMinima = primeiro ? carga[i] : qMin(r.cargaMinima, carga[i]);
+        r.cargaMaxima = primeiro ? carga[i] : qMax(r.cargaMaxima, carga[i]);
+        primeiro = false;
+    }
+    return r;
+}
+
+// ================== BENCHMARK ==================
+
+int executarBenchmarkDistribuicao(int quantidadeProjetos, int quantidadeAvaliadores)
+{
+    QTextStream out(stdout);
+    if (quantidadeProjetos <= 0 || quantidadeAvaliadores <= 0) {
+        out << QString("Quantidade de projetos e de avaliadores deve ser positiva.\n");
+        return 1;
+    }
+
+    const QStringList categorias{"Técnico", "Graduação"};
+
+    QVector<Projeto> projetos(quantidadeProjetos);
+    for (int i = 0; i < quantidadeProjetos; ++i) {
+        projetos[i].id        = i + 1;
+        projetos[i].categoria = categorias[i % categorias.size()];
+    }
+
+    QVector<Avaliador> avaliadores(quantidadeAvaliadores);
+    for (int i = 0; i < quantidadeAvaliadores; ++i) {
+        avaliadores[i].id        = i + 1;
+        avaliadores[i].cpf       = QString::number(10000000000LL + i);
+        avaliadores[i].categoria = categorias[i % categorias.size()];
+        if (i % 10 == 9)
+            avaliadores[i].status = "Inativo";
+    }
+
+    // Um terço dos projetos já com um avaliador
+    QVector<VinculoProjeto> vinculos;
+    for (int i = 0; i < quantidadeProjetos; i += 3) {
+        VinculoProjeto v;
+        v.idProjeto    = projetos[i].id;
+        v.cpfAvaliador = avaliadores[i % quantidadeAvaliadores].cpf;
+        vinculos.append(v);
+    }
+
+    out << QString("%1 projetos, %2 avaliadores, %3 vínculos fixos\n")
+               .arg(quantidadeProjetos).arg(quantidadeAvaliadores).arg(vinculos.size());
+
+    QElapsedTimer t;
+    t.start();
+    const ResultadoDistribuicao r =
+        distribuirAvaliadores(projetos, avaliadores, vinculos, QVector<Nota>());
+    const qint64 ns = t.nsecsElapsed();
+
+    out << QString("distribuirAvaliadores: %1 ms, %2 vínculos novos, %3 projetos incompletos, "
+                   "carga %4..%5\n")
+               .arg(ns / 1e6, 0, 'f', 1)
+               .arg(r.vinculosNovos).arg(r.projetosIncompletos)
+               .arg(r.cargaMinima).arg(r.cargaMaxima);
+    return 0;
+}
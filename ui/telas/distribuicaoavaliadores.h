@@ -0,0 +1,57 @@
+// distribuicaoavaliadores.h
+#pragma once
+
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+#include "registros.h"
+#include "vinculos.h"
+#include "conflitos.h"
+
+// ===== Distribuição automática de avaliadores =====
+//
+// Preenche as vagas de avaliador de todos os projetos de uma vez, com as
+// regras do DialogoVincularAvaliadores: até MaxAvaliadoresPorProjeto por
+// projeto, só avaliadores "Ativo" e da mesma categoria do projeto.
+//
+// A carga é equilibrada como num fluxo de custo mínimo em que cada projeto
+// a mais custa mais ao avaliador. Como a compatibilidade é a categoria,
+// todos os avaliadores de uma categoria servem aos mesmos projetos: cada
+// vaga vai para o avaliador de menor carga que ainda não está no projeto,
+// tirado de um heap por categoria. São O(vagas · log avaliadores), sem
+// montar o grafo projeto x avaliador (10 mil projetos e mil avaliadores
+// levam milissegundos).
+//
+// Vínculos existentes:
+//   completar  mantém todos e só preenche as vagas que faltam (projetos
+//              novos, avaliadores removidos...)
+//   refazer    mantém só os vínculos que já têm nota lançada e distribui
+//              o resto de novo
+//
+// Com um índice de conflitos, o avaliador em conflito com o projeto é
+// pulado (volta ao heap com a mesma carga) e a vaga vai para o próximo.
+struct OpcoesDistribuicao {
+    int  maximoPorProjeto{MaxAvaliadoresPorProjeto};
+    bool refazer{false};
+    const IndiceConflitos* conflitos{nullptr};
+};
+
+struct ResultadoDistribuicao {
+    // Só os projetos alterados, com a lista completa de CPFs
+    QHash<int, QStringList> avaliadoresPorProjeto;
+    int vinculosNovos{0};
+    int vinculosRemovidos{0};
+    int projetosIncompletos{0};   // vagas sem avaliador compatível
+    int cargaMinima{0};           // projetos por avaliador ativo
+    int cargaMaxima{0};
+};
+
+ResultadoDistribuicao distribuirAvaliadores(const QVector<Projeto>& projetos,
+                                            const QVector<Avaliador>& avaliadores,
+                                            const QVector<VinculoProjeto>& vinculos,
+                                            const QVector<Nota>& notas,
+                                            const OpcoesDistribuicao& opcoes = {});
+
+// Mede distribuirAvaliadores com dados sintéticos (linha de comando)
+int executarBenchmarkDistribuicao(int projetos, int avaliadores);
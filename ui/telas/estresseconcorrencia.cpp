@@ -0,0 +1,305 @@
+// estresseconcorrencia.cpp
+#include "estresseconcorrencia.h"
+#include "repositorio.h"
+#include "armazenamento.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QProcess>
+#include <QSet>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+// CPF fictício (11 dígitos) único por estação e gravação
+QString cpfDoTeste(int estacao, int gravacao)
+{
+    return QString("%1%2").arg(estacao + 1, 3, 10, QChar('0'))
+                          .arg(gravacao, 8, 10, QChar('0'));
+}
+
+double notaDoTeste(int estacao, int gravacao)
+{
+    return (estacao * 7 + gravacao) % 100 / 10.0;
+}
+
+QString descricaoDoTeste(int estacao, int gravacao)
+{
+    return QString("estacao %1 gravacao %2").arg(estacao).arg(gravacao);
+}
+
+// Projeto gravado por todas as estações (as outras mexem só no próprio)
+const QString NomeCompartilhado = QStringLiteral("Compartilhado");
+
+// Cadastros criados por cada estação (mesmos ids nas outras: renumerados)
+QString sufixoDoTeste(int estacao, int gravacao)
+{
+    return QString("%1-%2").arg(estacao).arg(gravacao);
+}
+
+QString cpfNovoDoTeste(int estacao, int gravacao)
+{
+    return QString("9%1%2").arg(estacao, 2, 10, QChar('0'))
+                           .arg(gravacao, 8, 10, QChar('0'));
+}
+
+// Gravações do projeto compartilhado aceitas pela estação
+QString arquivoAceitas(int estacao)
+{
+    return QString("estacao_%1.txt").arg(estacao);
+}
+
+// Confere que os ids da coleção não se repetem
+template <typename T>
+bool idsUnicos(const QVector<T>& registros)
+{
+    QSet<int> ids;
+    for (const T& r : registros) {
+        if (ids.contains(r.id))
+            return false;
+        ids.insert(r.id);
+    }
+    return true;
+}
+
+} // namespace
+
+// ================== ESTAÇÃO ==================
+
+int executarEstacaoEstresse(int estacao, int gravacoes)
+{
+    Repositorio& repo = Repositorio::instancia();
+    if (!repo.carregarTudo())
+        return 1;
+
+    const int idProjeto = estacao + 1;
+    int idCompartilhado = 0;
+    for (const Projeto& p : repo.projetos()) {
+        if (p.nome == NomeCompartilhado)
+            idCompartilhado = p.id;
+    }
+    QStringList cpfs;
+
+    // O projeto compartilhado é gravado por todas as estações: as gravações
+    // recusadas por versão vêm aqui em vez de abrir aviso
+    int recusadas = 0;
+    repo.armazenamento().definirAvisoConflitos(
+        [&recusadas, idCompartilhado](const QString& colecao, const QList<int>& ids, const QString&) {
+            if (colecao == "projetos" && ids.contains(idCompartilhado))
+                ++recusadas;
+        });
+
+    for (int i = 0; i < gravacoes; ++i) {
+        const QString cpf = cpfDoTeste(estacao, i);
+
+        Nota n;
+        n.idNota        = repo.proximoIdNota();
+        n.idProjeto     = idProjeto;
+        n.cpfAvaliador  = cpf;
+        n.nomeAvaliador = "Estacao " + QString::number(estacao);
+        n.notaFinal     = notaDoTeste(estacao, i);
+        repo.salvarNota(n);
+
+        Avaliacao a;
+        a.idProjeto     = idProjeto;
+        a.nomeProjeto   = "Projeto " + QString::number(idProjeto);
+        a.cpfAvaliador  = cpf;
+        a.nomeAvaliador = n.nomeAvaliador;
+        a.notaFinal     = n.notaFinal;
+        a.notasQuesitos = { n.notaFinal };
+        repo.registrarAvaliacao(a);
+
+        if (const Projeto* atual = repo.projetoPorId(idProjeto)) {
+            Projeto p = *atual;
+            p.descricao = descricaoDoTeste(estacao, i);
+            repo.atualizarProjeto(p);
+        }
+
+        cpfs << cpf;
+        repo.definirAvaliadoresDoProjeto(idProjeto, cpfs);
+
+        if (const Projeto* atual = repo.projetoPorId(idCompartilhado)) {
+            Projeto p = *atual;
+            p.descricao = descricaoDoTeste(estacao, i);
+            repo.atualizarProjeto(p);
+        }
+
+        // Inserções simultâneas: todas as estações criam com os mesmos ids
+        const QString sufixo = sufixoDoTeste(estacao, i);
+        Avaliador novoAvaliador;
+        novoAvaliador.nome = "Avaliador " + sufixo;
+        novoAvaliador.cpf  = cpfNovoDoTeste(estacao, i);
+        repo.adicionarAvaliador(novoAvaliador);
+
+        Ficha novaFicha;
+        novaFicha.tipoFicha = "Ficha " + sufixo;
+        repo.adicionarFicha(novaFicha);
+
+        Projeto novoProjeto;
+        novoProjeto.nome = "Novo " + sufixo;
+        repo.adicionarProjeto(novoProjeto);
+
+        // Cada iteração é uma "ação do usuário": grava e deixa rodar os
+        // recarregamentos agendados pelos avisos de alteração externa
+        repo.armazenamento().descarregar();
+        QCoreApplication::processEvents();
+    }
+    if (!repo.armazenamento().descarregar())
+        return 1;
+
+    QFile aceitas(arquivoAceitas(estacao));
+    if (!aceitas.open(QIODevice::WriteOnly | QIODevice::Text))
+        return 1;
+    aceitas.write(QByteArray::number(gravacoes - recusadas));
+    return 0;
+}
+
+// ================== COORDENADOR ==================
+
+int executarEstresse(int estacoes, int gravacoes)
+{
+    QTextStream out(stdout);
+    QTemporaryDir pasta;
+    if (!pasta.isValid() || estacoes < 1 || gravacoes < 1) {
+        out << "Não foi possível preparar o teste.\n";
+        return 1;
+    }
+
+    const QString anterior = QDir::currentPath();
+    QDir::setCurrent(pasta.path());
+
+    Repositorio& repo = Repositorio::instancia();
+    repo.carregarTudo();
+    for (int e = 0; e < estacoes; ++e) {
+        Projeto p;
+        p.nome = "Projeto " + QString::number(e + 1);
+        repo.adicionarProjeto(p);
+    }
+    Projeto compartilhado;
+    compartilhado.nome = NomeCompartilhado;
+    const int idCompartilhado = repo.adicionarProjeto(compartilhado);
+    repo.armazenamento().descarregar();
+
+    QElapsedTimer relogio;
+    relogio.start();
+
+    std::vector<std::unique_ptr<QProcess>> processos;
+    for (int e = 0; e < estacoes; ++e) {
+        auto proc = std::make_unique<QProcess>();
+        proc->setWorkingDirectory(pasta.path());
+        proc->setProcessChannelMode(QProcess::ForwardedChannels);
+        proc->start(QCoreApplication::applicationFilePath(),
+                    { "--estacao", QString::number(e),
+                      "--gravacoes", QString::number(gravacoes) });
+        processos.push_back(std::move(proc));
+    }
+
+    int falhas = 0;
+    for (int e = 0; e < estacoes; ++e) {
+        QProcess& proc = *processos[e];
+        if (!proc.waitForFinished(-1) || proc.exitStatus() != QProcess::NormalExit
+            || proc.exitCode() != 0) {
+            out << "Estação " << e << " terminou com erro.\n";
+            ++falhas;
+        }
+    }
+    const qint64 ms = relogio.elapsed();
+
+    // ----- Conferência -----
+    repo.carregarTudo();
+
+    if (repo.notas().size() != estacoes * gravacoes) {
+        out << "Notas: esperado " << estacoes * gravacoes
+            << ", encontrado " << repo.notas().size() << "\n";
+        ++falhas;
+    }
+    if (repo.avaliacoes().size() != estacoes * gravacoes) {
+        out << "Avaliações: esperado " << estacoes * gravacoes
+            << ", encontrado " << repo.avaliacoes().size() << "\n";
+        ++falhas;
+    }
+
+    for (int e = 0; e < estacoes; ++e) {
+        const int idProjeto = e + 1;
+
+        const Projeto* p = repo.projetoPorId(idProjeto);
+        if (!p || p->descricao != descricaoDoTeste(e, gravacoes - 1)) {
+            out << "Projeto " << idProjeto << ": última gravação perdida\n";
+            ++falhas;
+        }
+        if (repo.avaliadoresDoProjeto(idProjeto).size() != gravacoes) {
+            out << "Projeto " << idProjeto << ": vínculos esperados " << gravacoes
+                << ", encontrados " << repo.avaliadoresDoProjeto(idProjeto).size() << "\n";
+            ++falhas;
+        }
+        for (int i = 0; i < gravacoes; ++i) {
+            const Nota* n = repo.notaDoAvaliador(idProjeto, cpfDoTeste(e, i));
+            if (!n || n->notaFinal != notaDoTeste(e, i)) {
+                out << "Nota perdida: estação " << e << ", gravação " << i << "\n";
+                ++falhas;
+            }
+        }
+    }
+
+    // Projeto compartilhado: cada gravação aceita sobe a versão em 1 e a
+    // descrição é a de alguma delas
+    int aceitas = 0;
+    for (int e = 0; e < estacoes; ++e) {
+        QFile arquivo(arquivoAceitas(e));
+        if (arquivo.open(QIODevice::ReadOnly | QIODevice::Text))
+            aceitas += arquivo.readAll().trimmed().toInt();
+    }
+    const Projeto* comp = repo.projetoPorId(idCompartilhado);
+    if (!comp || comp->versao != 1 + aceitas) {
+        out << "Projeto compartilhado: versão esperada " << 1 + aceitas
+            << ", encontrada " << (comp ? comp->versao : 0) << "\n";
+        ++falhas;
+    } else {
+        bool valida = false;
+        for (int e = 0; !valida && e < estacoes; ++e)
+            for (int i = 0; !valida && i < gravacoes; ++i)
+                valida = comp->descricao == descricaoDoTeste(e, i);
+        if (!valida) {
+            out << "Projeto compartilhado: descrição inválida '" << comp->descricao << "'\n";
+            ++falhas;
+        }
+    }
+
+    // Inserções: nenhuma sobrescrita pela de outra estação com o mesmo id
+    QSet<QString> avaliadores, fichas, projetos;
+    for (const Avaliador& a : repo.avaliadores()) avaliadores.insert(a.cpf);
+    for (const Ficha& f : repo.fichas())          fichas.insert(f.tipoFicha);
+    for (const Projeto& p : repo.projetos())      projetos.insert(p.nome);
+    for (int e = 0; e < estacoes; ++e) {
+        for (int i = 0; i < gravacoes; ++i) {
+            const QString sufixo = sufixoDoTeste(e, i);
+            if (!avaliadores.contains(cpfNovoDoTeste(e, i))
+                || !fichas.contains("Ficha " + sufixo)
+                || !projetos.contains("Novo " + sufixo)) {
+                out << "Inserção perdida: estação " << e << ", gravação " << i << "\n";
+                ++falhas;
+            }
+        }
+    }
+    if (!idsUnicos(repo.avaliadores()) || !idsUnicos(repo.fichas()) || !idsUnicos(repo.projetos())) {
+        out << "Ids repetidos depois das inserções simultâneas\n";
+        ++falhas;
+    }
+
+    // 8 gravações por iteração: nota, avaliação, projeto, vínculos, projeto
+    // compartilhado e os três cadastros novos
+    const qint64 operacoes = qint64(estacoes) * gravacoes * 8;
+    out << estacoes << " estações, " << operacoes << " operações em " << ms << " ms ("
+        << (ms > 0 ? operacoes * 1000 / ms : operacoes) << " op/s)\n";
+    out << (falhas ? "FALHOU" : "OK") << "\n";
+    out.flush();
+
+    QDir::setCurrent(anterior);
+    return falhas ? 1 : 0;
+}
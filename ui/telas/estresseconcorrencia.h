@@ -0,0 +1,20 @@
+// estresseconcorrencia.h
+#pragma once
+
+// ===== Teste de estresse entre estações =====
+//
+// Simula várias estações gravando ao mesmo tempo na mesma pasta:
+//
+//   InterfaceAvaliacoes --estresse 4 --gravacoes 100
+//
+// cria uma pasta temporária com um projeto por estação e um compartilhado,
+// sobe 4 processos (--estacao i) que gravam notas, avaliações, o próprio
+// projeto e os vínculos dele, disputam o projeto compartilhado e criam
+// avaliadores, fichas e projetos novos (com os mesmos ids nas várias
+// estações). No fim relê tudo e confere que nenhuma gravação se perdeu,
+// que a versão do compartilhado conta só as gravações aceitas e que os
+// ids continuam únicos. Imprime operações/segundo; devolve != 0 se faltou algo.
+int executarEstresse(int estacoes, int gravacoes);
+
+// Um dos processos acima (diretório atual = pasta do teste)
+int executarEstacaoEstresse(int estacao, int gravacoes);
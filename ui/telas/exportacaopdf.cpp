@@ -0,0 +1,759 @@
+// exportacaopdf.cpp
+#include "exportacaopdf.h"
+#include "motornotas.h"
+#include "formulaquesito.h"
+#include "cpf.h"
+#include "vinculos.h"
+#include "modelohtml.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QAbstractTextDocumentLayout>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QMarginsF>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPageLayout>
+#include <QPageSize>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QTextDocument>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+
+namespace {
+
+// Texto do PDF é vetorial: a resolução só define a grade das coordenadas
+constexpr int ResolucaoPdf = 300;
+
+// Documentos diagramados de uma vez no documento único (limita a memória)
+constexpr int DocumentosPorLote = 64;
+
+void configurarPagina(QPdfWriter& pdf)
+{
+    pdf.setResolution(ResolucaoPdf);
+    pdf.setPageSize(QPageSize(QPageSize::A4));
+    pdf.setPageMargins(QMarginsF(15, 15, 15, 15), QPageLayout::Millimeter);
+}
+
+// Diagrama 'html' em páginas do tamanho da área útil de 'dispositivo'
+std::unique_ptr<QTextDocument> diagramar(const QString& html, QPaintDevice* dispositivo)
+{
+    std::unique_ptr<QTextDocument> doc(new QTextDocument);
+    doc->documentLayout()->setPaintDevice(dispositivo);
+    doc->setHtml(html);
+    doc->setPageSize(QSizeF(dispositivo->width(), dispositivo->height()));
+    return doc;
+}
+
+// Pinta todas as páginas de 'doc'; 'novaPagina' quando já há páginas no PDF
+int pintar(QTextDocument& doc, QPainter& pintor, QPdfWriter& pdf, bool novaPagina)
+{
+    const QSizeF pagina = doc.pageSize();
+    const int paginas = doc.pageCount();
+    for (int i = 0; i < paginas; ++i) {
+        if (novaPagina || i > 0)
+            pdf.newPage();
+        const QRectF area(0, i * pagina.height(), pagina.width(), pagina.height());
+        pintor.save();
+        pintor.translate(0, -area.top());
+        doc.drawContents(&pintor, area);
+        pintor.restore();
+    }
+    return paginas;
+}
+
+QString nomeArquivo(QString texto)
+{
+    texto = texto.toLower().simplified();
+    texto.replace(' ', '_');
+    texto.remove(QRegularExpression("[^\\w-]"));
+    return texto;
+}
+
+} // namespace
+
+// ================== HTML DA AVALIAÇÃO ==================
+
+namespace {
+
+// Modelos compilados na primeira chamada (estáticos locais: a inicialização
+// é segura com várias threads) e reaproveitados por todos os PDFs
+const ModeloHtml& modeloAvaliacao()
+{
+    static const ModeloHtml modelo(QString(R"(<h1 align='center'>Avaliação de Projeto</h1><hr>
+<p><b>Projeto:</b> {{projeto}}</p>
+<p><b>Responsável:</b> {{#responsavel}}{{responsavel}}{{/responsavel}}{{^responsavel}}N/A{{/responsavel}}</p>
+<p><b>Ficha:</b> {{ficha}}</p>
+<p><b>Avaliador (CPF):</b> {{cpfAvaliador}}</p>
+<p><b>Avaliador (Nome):</b> {{nomeAvaliador}}</p>
+<p><b>Data:</b> {{data}}</p>
+<br><table border='1' cellspacing='0' cellpadding='4' width='100%' style='border-collapse: collapse;'>
+<tr style='background-color: #eeeeee;'><th>Seção</th><th>Quesito</th><th>Nota</th></tr>
+{{#linhas}}<tr><td align='center'>{{secao}}</td><td>{{quesito}}</td><td align='center'>{{nota}}</td></tr>
+{{/linhas}}</table>
+<h3 align='right'>Nota Final: {{notaFinal}}</h3>
+)"));
+    return modelo;
+}
+
+const ModeloHtml& modeloFicha()
+{
+    static const ModeloHtml modelo(QString(R"(
+<!DOCTYPE html>
+<html>
+<head>
+<meta charset="UTF-8">
+<style>
+* {
+    margin: 0;
+    padding: 0;
+    box-sizing: border-box;
+}
+
+body {
+    font-family: 'Arial', sans-serif;
+    background: white;
+    color: #000;
+    padding: 20px;
+    font-size: 11pt;
+}
+
+.header {
+    text-align: center;
+    border-bottom: 3px solid #000;
+    padding-bottom: 15px;
+    margin-bottom: 25px;
+}
+
+.logo {
+    font-size: 20pt;
+    font-weight: bold;
+    color: #000;
+    margin-bottom: 10px;
+}
+
+.title {
+    font-size: 16pt;
+    font-weight: bold;
+    margin: 10px 0;
+    text-transform: uppercase;
+}
+
+.subtitle {
+    font-size: 10pt;
+    margin: 5px 0;
+}
+
+.info-box {
+    background: #f5f5f5;
+    border: 1px solid #ccc;
+    padding: 15px;
+    margin: 20px 0;
+    border-radius: 5px;
+}
+
+.info-row {
+    margin: 8px 0;
+}
+
+.info-label {
+    font-weight: bold;
+    display: inline-block;
+    width: 180px;
+}
+
+.section {
+    margin: 25px 0;
+    page-break-inside: avoid;
+}
+
+.section-header {
+    background: #e0e0e0;
+    padding: 10px;
+    font-weight: bold;
+    font-size: 12pt;
+    margin: 15px 0 10px 0;
+    border-left: 4px solid #000;
+}
+
+table {
+    width: 100%;
+    border-collapse: collapse;
+    margin: 15px 0;
+}
+
+th {
+    background: #d0d0d0;
+    border: 1px solid #666;
+    padding: 10px;
+    text-align: left;
+    font-weight: bold;
+    font-size: 10pt;
+}
+
+td {
+    border: 1px solid #999;
+    padding: 10px;
+    text-align: left;
+    font-size: 10pt;
+    vertical-align: top;
+}
+
+.quesito-nome {
+    font-weight: normal;
+}
+
+.quesito-auto {
+    font-style: italic;
+    color: #666;
+}
+
+.nota-cell {
+    width: 100px;
+    text-align: center;
+    background: #fafafa;
+}
+
+.campos-preenchimento {
+    margin: 30px 0;
+}
+
+.campo-linha {
+    margin: 15px 0;
+    padding: 10px 0;
+    border-bottom: 1px solid #ccc;
+}
+
+.campo-label {
+    font-weight: bold;
+    display: inline-block;
+    margin-right: 10px;
+}
+
+.campo-underline {
+    display: inline-block;
+    border-bottom: 1px solid #000;
+    width: 400px;
+    height: 20px;
+}
+
+.footer {
+    margin-top: 40px;
+    padding-top: 20px;
+    border-top: 2px solid #000;
+    text-align: center;
+    font-size: 9pt;
+}
+
+.observacoes-box {
+    margin: 20px 0;
+    border: 1px solid #999;
+    min-height: 100px;
+    padding: 10px;
+}
+
+.escala-notas {
+    background: #f9f9f9;
+    border: 1px solid #ddd;
+    padding: 10px;
+    margin: 15px 0;
+    text-align: center;
+    font-weight: bold;
+}
+
+@media print {
+    body {
+        padding: 10mm;
+    }
+
+    .section {
+        page-break-inside: avoid;
+    }
+}
+</style>
+</head>
+<body>
+
+<div class="header">
+    <div class="logo"> FUCAPI - FUNDAÇÃO CENTRO DE ANÁLISE, PESQUISA E INOVAÇÃO</div>
+    <div class="title">FICHA DE AVALIAÇÃO</div>
+{{#resolucaoNum}}<div class='subtitle'>RESOLUÇÃO Nº {{resolucaoNum}}/{{resolucaoAno}}</div>{{/resolucaoNum}}
+</div>
+<div class="info-box">
+<div class='info-row'><span class='info-label'>Tipo da Ficha:</span> {{tipoFicha}}</div>
+{{#curso}}<div class='info-row'><span class='info-label'>Curso:</span> {{curso}}</div>{{/curso}}
+    <div class='info-row'><span class='info-label'>Nome do Aluno(a):</span> <span class='campo-underline'></span></div>
+    <div class='info-row'><span class='info-label'>Título do Trabalho:</span> <span class='campo-underline'></span></div>
+{{#incluirProfessorOrientador}}<div class='info-row'><span class='info-label'>Professor Orientador:</span> <span class='campo-underline'></span></div>{{/incluirProfessorOrientador}}
+</div>
+<div class='escala-notas'>ESCALA DE NOTAS: {{notaMin}} a {{notaMax}}</div>
+{{#secoes}}<div class='section'>
+<div class='section-header'>{{identificador}} - {{titulo}}</div>
+{{#temQuesitos}}<table>
+<tr><th class='quesito-nome'>Quesito</th><th class='nota-cell'>Nota</th></tr>
+{{#quesitos}}<tr><td class='quesito-nome'>{{nome}}{{#formula}} <span class='quesito-auto'>[= {{formula}}]</span>{{/formula}}{{#auto}} <span class='quesito-auto'>[AUTO-CALCULADO]</span>{{/auto}}{{#peso}} <span class='quesito-auto'>(Peso: {{peso}})</span>{{/peso}}</td><td class='nota-cell'></td></tr>
+{{/quesitos}}</table>{{/temQuesitos}}
+{{^temQuesitos}}<p><i>Nenhum quesito cadastrado para esta seção.</i></p>{{/temQuesitos}}
+</div>
+{{/secoes}}<div class='campos-preenchimento'>
+{{#incluirDataAvaliacao}}
+        <div class='campo-linha'>
+            <span class='campo-label'>Data da Avaliação:</span>
+            _____ / _____ / __________
+        </div>{{/incluirDataAvaliacao}}
+{{#incluirProfessorAvaliador}}
+        <div class='campo-linha'>
+            <span class='campo-label'>Professor Avaliador:</span>
+            <span class='campo-underline'></span>
+        </div>{{/incluirProfessorAvaliador}}
+{{#incluirObservacoes}}
+        <div class='campo-linha'>
+            <span class='campo-label'>Observações / Comentários:</span>
+            <div class='observacoes-box'></div>
+        </div>{{/incluirObservacoes}}
+</div>
+{{#textoAprovacao}}<div class='footer'>{{textoAprovacao}}</div>{{/textoAprovacao}}
+</body>
+</html>
+)"));
+    return modelo;
+}
+
+const ModeloHtml& modeloPreviaFicha()
+{
+    static const ModeloHtml modelo(QString(R"(
+<html>
+<head>
+<style>
+body { font-family: Arial; background: white; color: black; padding: 20px; }
+.header { text-align: center; border-bottom: 2px solid #333; padding-bottom: 10px; margin-bottom: 20px; }
+.title { font-size: 18px; font-weight: bold; }
+.section { margin: 20px 0; }
+.section-title { background: #f0f0f0; padding: 8px; font-weight: bold; margin-top: 15px; }
+table { width: 100%; border-collapse: collapse; margin: 10px 0; }
+th, td { border: 1px solid #666; padding: 8px; text-align: left; }
+th { background: #e0e0e0; }
+.footer { margin-top: 30px; text-align: center; font-size: 10px; }
+</style>
+</head>
+<body>
+<div class="header">
+<div class="title">FICHA DE AVALIAÇÃO</div>
+<div>{{tipoFicha}} - Resolução Nº {{resolucaoNum}}/{{resolucaoAno}}</div>
+<div>Curso: {{curso}}</div>
+</div>
+
+<div class="section">
+<strong>Escala de Notas:</strong> {{notaMin}} a {{notaMax}}
+</div>
+{{#secoes}}<div class='section-title'>{{identificador}} - {{titulo}}</div><table><tr><th>Quesito</th><th>Nota</th></tr>{{#quesitos}}<tr><td>{{nome}}</td><td></td></tr>{{/quesitos}}</table>
+{{/secoes}}{{#incluirDataAvaliacao}}<div class='section'>Data da Avaliação: ___/___/______</div>{{/incluirDataAvaliacao}}
+{{#incluirProfessorAvaliador}}<div class='section'>Professor Avaliador: ________________________________</div>{{/incluirProfessorAvaliador}}
+{{#incluirProfessorOrientador}}<div class='section'>Professor Orientador: ________________________________</div>{{/incluirProfessorOrientador}}
+{{#textoAprovacao}}<div class='footer'>{{textoAprovacao}}</div>{{/textoAprovacao}}
+</body></html>)"));
+    return modelo;
+}
+
+const ModeloHtml& modeloIndice()
+{
+    static const ModeloHtml modelo(QString(R"(<h1 align='center'>Índice</h1><hr>
+<table border='1' cellspacing='0' cellpadding='4' width='100%' style='border-collapse: collapse;'>
+<tr style='background-color: #eeeeee;'><th>Documento</th><th>Avaliações</th><th>Página</th></tr>
+{{#itens}}<tr><td>{{titulo}}</td><td align='center'>{{avaliacoes}}</td><td align='center'>{{pagina}}</td></tr>
+{{/itens}}</table>
+)"));
+    return modelo;
+}
+
+// Campos comuns à ficha impressa e à pré-visualização
+DadosModelo dadosFicha(const Ficha& ficha)
+{
+    DadosModelo dados;
+    dados.definir("tipoFicha", ficha.tipoFicha);
+    dados.definir("curso", ficha.curso);
+    dados.definir("resolucaoNum", ficha.resolucaoNum);
+    dados.definir("resolucaoAno", ficha.resolucaoAno);
+    dados.definir("notaMin", QString::number(ficha.notaMin));
+    dados.definir("notaMax", QString::number(ficha.notaMax));
+    dados.definirCondicao("incluirProfessorOrientador", ficha.incluirProfessorOrientador);
+    dados.definirCondicao("incluirDataAvaliacao", ficha.incluirDataAvaliacao);
+    dados.definirCondicao("incluirProfessorAvaliador", ficha.incluirProfessorAvaliador);
+    dados.definirCondicao("incluirObservacoes", ficha.incluirObservacoes);
+    // Texto de aprovação é cadastrado já em HTML
+    dados.definirHtml("textoAprovacao", ficha.textoAprovacao);
+
+    for (const auto& secao : ficha.secoes) {
+        DadosModelo& s = dados.acrescentar("secoes");
+        s.definir("identificador", secao.identificador);
+        s.definir("titulo", secao.titulo);
+        s.definirCondicao("temQuesitos", !secao.quesitos.isEmpty());
+
+        for (const auto& quesito : secao.quesitos) {
+            DadosModelo& q = s.acrescentar("quesitos");
+            q.definir("nome", quesito.nome);
+            const bool comFormula = quesito.autoCalculado && temFormula(quesito);
+            q.definir("formula", comFormula ? quesito.formula : QString());
+            q.definirCondicao("auto", quesito.autoCalculado && !comFormula);
+            q.definir("peso", quesito.temPeso && quesito.peso != 1.0
+                                  ? QString::number(quesito.peso) : QString());
+        }
+    }
+    return dados;
+}
+
+} // namespace
+
+QString htmlAvaliacao(const DocumentoAvaliacaoPdf& doc, const QDateTime& data)
+{
+    DadosModelo dados;
+    dados.definir("projeto", doc.projeto);
+    dados.definir("responsavel", doc.responsavel);
+    dados.definir("ficha", doc.ficha);
+    dados.definir("cpfAvaliador", doc.cpfAvaliador);
+    dados.definir("nomeAvaliador", doc.nomeAvaliador);
+    dados.definir("data", data.toString("dd/MM/yyyy HH:mm"));
+    dados.definir("notaFinal", QString::number(doc.notaFinal, 'f', 2));
+
+    for (const auto& linha : doc.linhas) {
+        DadosModelo& l = dados.acrescentar("linhas");
+        l.definir("secao", linha.secao);
+        l.definir("quesito", linha.quesito);
+        l.definir("nota", linha.nota);
+    }
+    return modeloAvaliacao().render(dados);
+}
+
+// ================== HTML DA FICHA ==================
+
+QString gerarHtmlFicha(const Ficha& ficha)
+{
+    return modeloFicha().render(dadosFicha(ficha));
+}
+
+QString htmlPreviaFicha(const Ficha& ficha)
+{
+    return modeloPreviaFicha().render(dadosFicha(ficha));
+}
+
+// ================== AVALIAÇÕES ==================
+
+QVector<DocumentoAvaliacaoPdf> documentosAvaliacoes(const QVector<Avaliacao>& avaliacoes,
+                                                    const QVector<Ficha>& fichas)
+{
+    QHash<int, const Ficha*> fichaPorId;
+    QHash<int, PesosFicha>   pesos;
+    for (const Ficha& f : fichas) {
+        fichaPorId.insert(f.id, &f);
+        pesos.insert(f.id, PesosFicha(f));
+    }
+
+    // Reavaliações acrescentam linhas: vale a última de cada combinação
+    QHash<QString, int> ultima;
+    for (int i = 0; i < avaliacoes.size(); ++i) {
+        const Avaliacao& a = avaliacoes[i];
+        ultima.insert(QString("%1|%2|%3").arg(a.idProjeto)
+                          .arg(Cpf(a.cpfAvaliador).numero()).arg(a.idFicha), i);
+    }
+    QVector<int> indices;
+    indices.reserve(ultima.size());
+    for (int i : ultima)
+        indices.append(i);
+    std::sort(indices.begin(), indices.end(), [&avaliacoes](int x, int y) {
+        const Avaliacao& a = avaliacoes[x];
+        const Avaliacao& b = avaliacoes[y];
+        if (a.idProjeto != b.idProjeto) return a.idProjeto < b.idProjeto;
+        const int c = a.nomeAvaliador.localeAwareCompare(b.nomeAvaliador);
+        if (c != 0) return c < 0;
+        return x < y;
+    });
+
+    QVector<DocumentoAvaliacaoPdf> res;
+    res.reserve(indices.size());
+    for (int i : indices) {
+        const Avaliacao& a = avaliacoes[i];
+
+        DocumentoAvaliacaoPdf d;
+        d.idProjeto     = a.idProjeto;
+        d.idFicha       = a.idFicha;
+        d.projeto       = a.nomeProjeto;
+        d.responsavel   = a.responsavel;
+        d.ficha         = a.nomeFicha;
+        d.cpfAvaliador  = a.cpfAvaliador;
+        d.nomeAvaliador = a.nomeAvaliador;
+        d.notaFinal     = a.notaFinal;
+
+        const Ficha* f = fichaPorId.value(a.idFicha, nullptr);
+        if (f) {
+            if (d.ficha.isEmpty())
+                d.ficha = f->tipoFicha;
+
+            // Mesmos quesitos que DialogoAvaliacaoFicha mostra; calculados
+            // só quando as notas digitadas batem com a ficha atual
+            const PesosFicha& p = pesos[a.idFicha];
+            const bool completo = a.notasQuesitos.size() == p.quantidade();
+            QVector<double> valores(p.valores());
+            if (completo)
+                p.calcular(a.notasQuesitos.constData(), valores.data());
+
+            int digitado  = 0;
+            int calculado = p.quantidade();
+            for (const Secao& s : f->secoes) {
+                for (const Quesito& q : s.quesitos) {
+                    const bool comFormula = temFormula(q) && p.erroFormulas().isEmpty();
+                    if (q.autoCalculado && !comFormula)
+                        continue;
+
+                    LinhaAvaliacaoPdf l;
+                    l.secao   = s.identificador;
+                    l.quesito = q.nome;
+                    if (comFormula) {
+                        l.nota = completo ? QString::number(valores[calculado], 'f', 2) : "-";
+                        ++calculado;
+                    } else {
+                        l.nota = digitado < a.notasQuesitos.size()
+                                     ? QString::number(a.notasQuesitos[digitado], 'f', 2) : "-";
+                        ++digitado;
+                    }
+                    d.linhas.append(l);
+                }
+            }
+        }
+        res.append(d);
+    }
+    return res;
+}
+
+// ================== LOTE ==================
+
+LotePdf::LotePdf(const QVector<DocumentoAvaliacaoPdf>& avaliacoes,
+                 const QVector<Ficha>& fichas,
+                 ModoLotePdf modo,
+                 const QString& destino)
+    : m_avaliacoes(avaliacoes)
+    , m_fichas(fichas)
+    , m_modo(modo)
+    , m_destino(destino)
+    , m_data(QDateTime::currentDateTime())
+{
+    const QDir pasta(destino);
+
+    m_itens.reserve(m_fichas.size() + m_avaliacoes.size());
+    for (int i = 0; i < m_fichas.size(); ++i) {
+        const Ficha& f = m_fichas[i];
+        Item item;
+        item.titulo  = QString("Ficha %1 - %2").arg(f.id).arg(f.tipoFicha);
+        item.arquivo = pasta.filePath(QString("ficha_%1_%2.pdf").arg(f.id).arg(nomeArquivo(f.tipoFicha)));
+        item.indice  = i;
+        m_itens.append(item);
+    }
+    for (int i = 0; i < m_avaliacoes.size(); ++i) {
+        const DocumentoAvaliacaoPdf& d = m_avaliacoes[i];
+        Item item;
+        item.titulo    = QString("Projeto %1 - %2").arg(d.idProjeto).arg(d.projeto);
+        item.arquivo   = pasta.filePath(QString("avaliacao_%1_%2_%3.pdf")
+                                            .arg(d.idProjeto).arg(d.idFicha)
+                                            .arg(Cpf(d.cpfAvaliador).digitos()));
+        item.idProjeto = d.idProjeto;
+        item.indice    = i;
+        m_itens.append(item);
+    }
+}
+
+QString LotePdf::html(const Item& item) const
+{
+    return item.idProjeto == 0 ? gerarHtmlFicha(m_fichas[item.indice])
+                               : htmlAvaliacao(m_avaliacoes[item.indice], m_data);
+}
+
+ResultadoLotePdf LotePdf::executar()
+{
+    ResultadoLotePdf r;
+    QElapsedTimer t;
+    t.start();
+
+    m_concluidos = 0;
+    if (m_modo == ModoLotePdf::UmPorAvaliacao)
+        gravarArquivos(r);
+    else
+        gravarDocumentoUnico(r);
+
+    r.cancelado = m_cancelado;
+    r.ms = t.elapsed();
+    return r;
+}
+
+void LotePdf::gravarArquivos(ResultadoLotePdf& r)
+{
+    if (!QDir().mkpath(m_destino)) {
+        r.erros << "Não foi possível criar a pasta " + m_destino;
+        r.falhas = m_itens.size();
+        return;
+    }
+
+    std::atomic<int> documentos{0};
+    std::atomic<int> paginas{0};
+    QMutex mutexErros;
+
+    QVector<int> indices(m_itens.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    // Cada tarefa tem o seu QPdfWriter e o seu QTextDocument
+    QtConcurrent::blockingMap(indices, [&](int i) {
+        if (m_cancelado)
+            return;
+
+        const Item& item = m_itens[i];
+        QPdfWriter pdf(item.arquivo);
+        configurarPagina(pdf);
+        const std::unique_ptr<QTextDocument> doc = diagramar(html(item), &pdf);
+
+        QPainter pintor;
+        if (pintor.begin(&pdf)) {
+            paginas += pintar(*doc, pintor, pdf, false);
+            pintor.end();
+            ++documentos;
+        } else {
+            QMutexLocker trava(&mutexErros);
+            r.erros << "Não foi possível gravar " + item.arquivo;
+        }
+        ++m_concluidos;
+    });
+
+    r.documentos = documentos;
+    r.paginas    = paginas;
+    r.falhas     = r.erros.size();
+}
+
+void LotePdf::gravarDocumentoUnico(ResultadoLotePdf& r)
+{
+    QPdfWriter pdf(m_destino);
+    configurarPagina(pdf);
+    pdf.setTitle("Avaliações");
+
+    QPainter pintor;
+    if (!pintor.begin(&pdf)) {
+        r.erros << "Não foi possível gravar " + m_destino;
+        r.falhas = m_itens.size();
+        return;
+    }
+
+    // Página inicial de cada item, para o índice
+    QVector<int> primeiraPagina(m_itens.size(), 0);
+    QThread* pintura = QThread::currentThread();
+
+    // Diagramar é a parte cara e roda em paralelo; a pintura no QPdfWriter
+    // é sequencial. Enquanto o lote é diagramado ninguém pinta: as tarefas
+    // só leem as medidas de 'pdf'.
+    for (int inicio = 0; inicio < m_itens.size() && !m_cancelado; inicio += DocumentosPorLote) {
+        const int fim = qMin(inicio + DocumentosPorLote, m_itens.size());
+
+        std::vector<std::unique_ptr<QTextDocument>> docs(fim - inicio);
+        QVector<int> indices(fim - inicio);
+        std::iota(indices.begin(), indices.end(), inicio);
+
+        QtConcurrent::blockingMap(indices, [&](int i) {
+            if (m_cancelado)
+                return;
+            std::unique_ptr<QTextDocument> doc = diagramar(html(m_itens[i]), &pdf);
+            doc->pageCount();   // força a diagramação aqui
+            doc->moveToThread(pintura);
+            docs[i - inicio] = std::move(doc);
+        });
+
+        for (int i = inicio; i < fim && !m_cancelado; ++i) {
+            if (!docs[i - inicio])
+                break;
+            primeiraPagina[i] = r.paginas + 1;
+            r.paginas += pintar(*docs[i - inicio], pintor, pdf, r.paginas > 0);
+            ++r.documentos;
+            ++m_concluidos;
+        }
+    }
+
+    if (m_cancelado) {
+        pintor.end();
+        QFile::remove(m_destino);
+        return;
+    }
+
+    // ----- Índice: primeira página de cada projeto e de cada ficha -----
+    if (!m_itens.isEmpty()) {
+        DadosModelo indice;
+        for (int i = 0; i < m_itens.size(); ) {
+            int j = i + 1;
+            if (m_itens[i].idProjeto != 0)
+                while (j < m_itens.size() && m_itens[j].idProjeto == m_itens[i].idProjeto)
+                    ++j;
+            DadosModelo& linha = indice.acrescentar("itens");
+            linha.definir("titulo", m_itens[i].titulo);
+            linha.definir("avaliacoes", m_itens[i].idProjeto != 0 ? QString::number(j - i) : QString("-"));
+            linha.definir("pagina", QString::number(primeiraPagina[i]));
+            i = j;
+        }
+
+        const std::unique_ptr<QTextDocument> doc = diagramar(modeloIndice().render(indice), &pdf);
+        r.paginas += pintar(*doc, pintor, pdf, true);
+    }
+    pintor.end();
+}
+
+// ================== BENCHMARK ==================
+
+int executarBenchmarkPdf(int quantidade)
+{
+    QTextStream out(stdout);
+    if (quantidade <= 0) {
+        out << QString("Quantidade de avaliações deve ser positiva.\n");
+        return 1;
+    }
+
+    QTemporaryDir pasta;
+    if (!pasta.isValid()) {
+        out << QString("Não foi possível criar a pasta temporária.\n");
+        return 1;
+    }
+
+    // Ficha com três seções de quatro quesitos
+    QVector<DocumentoAvaliacaoPdf> avaliacoes(quantidade);
+    for (int i = 0; i < quantidade; ++i) {
+        DocumentoAvaliacaoPdf& d = avaliacoes[i];
+        d.idProjeto     = i / MaxAvaliadoresPorProjeto + 1;
+        d.idFicha       = 1;
+        d.projeto       = QString("Projeto %1").arg(d.idProjeto);
+        d.responsavel   = "Responsável";
+        d.ficha         = "TCC";
+        d.cpfAvaliador  = QString::number(10000000000LL + i % MaxAvaliadoresPorProjeto);
+        d.nomeAvaliador = QString("Avaliador %1").arg(i % MaxAvaliadoresPorProjeto + 1);
+        d.notaFinal     = 8.5;
+        for (int s = 0; s < 3; ++s)
+            for (int q = 0; q < 4; ++q)
+                d.linhas.append({QString(QChar('A' + s)), QString("Quesito %1").arg(q + 1), "8.50"});
+    }
+
+    out << QString("%1 avaliações, %2 threads\n")
+               .arg(quantidade).arg(QThreadPool::globalInstance()->maxThreadCount());
+
+    const struct { ModoLotePdf modo; QString destino; const char* nome; } casos[] = {
+        {ModoLotePdf::UmPorAvaliacao, pasta.path(), "um arquivo por avaliação"},
+        {ModoLotePdf::DocumentoUnico, pasta.filePath("avaliacoes.pdf"), "documento único"},
+    };
+    for (const auto& c : casos) {
+        LotePdf lote(avaliacoes, QVector<Ficha>(), c.modo, c.destino);
+        const ResultadoLotePdf r = lote.executar();
+        out << QString("%1: %2 ms, %3 páginas, %4 páginas/s, %5 falhas\n")
+                   .arg(c.nome).arg(r.ms).arg(r.paginas)
+                   .arg(r.paginasPorSegundo(), 0, 'f', 1).arg(r.falhas);
+    }
+    return 0;
+}
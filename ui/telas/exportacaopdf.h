@@ -0,0 +1,121 @@
+// exportacaopdf.h
+#pragma once
+
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <atomic>
+
+#include "ficha.h"
+#include "registros.h"
+
+// ===== HTML dos PDFs =====
+//
+// Gerados a partir de modelos compilados uma única vez (modelohtml.h).
+
+// Uma avaliação pronta para o PDF: as notas já na ordem da ficha, com os
+// quesitos calculados preenchidos
+struct LinhaAvaliacaoPdf {
+    QString secao;
+    QString quesito;
+    QString nota;
+};
+
+struct DocumentoAvaliacaoPdf {
+    int     idProjeto{0};
+    int     idFicha{0};
+    QString projeto;
+    QString responsavel;
+    QString ficha;
+    QString cpfAvaliador;
+    QString nomeAvaliador;
+    double  notaFinal{0.0};
+    QVector<LinhaAvaliacaoPdf> linhas;
+};
+
+// Layout do PDF da avaliação (o mesmo de DialogoAvaliacaoFicha)
+QString htmlAvaliacao(const DocumentoAvaliacaoPdf& doc, const QDateTime& data);
+
+// Ficha em branco para impressão
+QString gerarHtmlFicha(const Ficha& ficha);
+
+// Resumo da ficha para a pré-visualização da tela de fichas
+QString htmlPreviaFicha(const Ficha& ficha);
+
+// Última avaliação de cada (projeto, avaliador, ficha), ordenadas por
+// projeto e avaliador, com as notas montadas a partir da ficha
+QVector<DocumentoAvaliacaoPdf> documentosAvaliacoes(const QVector<Avaliacao>& avaliacoes,
+                                                    const QVector<Ficha>& fichas);
+
+// ===== PDFs em lote =====
+//
+// Gera os PDFs de todas as avaliações (e, se pedido, das fichas em branco)
+// com QPdfWriter nas threads de trabalho, sem QPrinter nem a thread da
+// interface.
+//
+//   UmPorAvaliacao  cada documento é um arquivo na pasta de destino; cada
+//                   tarefa monta o HTML, diagrama e grava um arquivo
+//   DocumentoUnico  um só PDF: os documentos são diagramados em paralelo,
+//                   em lotes, e pintados em ordem no mesmo QPdfWriter; no
+//                   fim vem um índice com a página de cada projeto
+//
+// executar() bloqueia e deve rodar fora da thread da interface; concluidos()
+// e cancelar() podem ser chamados de qualquer thread.
+enum class ModoLotePdf {
+    UmPorAvaliacao,
+    DocumentoUnico
+};
+
+struct ResultadoLotePdf {
+    int         documentos{0};
+    int         paginas{0};
+    int         falhas{0};
+    bool        cancelado{false};
+    qint64      ms{0};
+    QStringList erros;
+
+    double paginasPorSegundo() const { return ms > 0 ? paginas * 1000.0 / ms : 0.0; }
+};
+
+class LotePdf
+{
+public:
+    // 'destino': pasta (UmPorAvaliacao) ou arquivo .pdf (DocumentoUnico)
+    LotePdf(const QVector<DocumentoAvaliacaoPdf>& avaliacoes,
+            const QVector<Ficha>& fichas,
+            ModoLotePdf modo,
+            const QString& destino);
+
+    ResultadoLotePdf executar();
+    void cancelar() { m_cancelado = true; }
+
+    int total() const      { return m_itens.size(); }
+    int concluidos() const { return m_concluidos; }
+
+private:
+    struct Item {
+        QString titulo;
+        QString arquivo;
+        int     idProjeto{0};   // 0: ficha em branco
+        int     indice{0};      // em m_avaliacoes ou m_fichas
+    };
+
+    QString html(const Item& item) const;
+    void    gravarArquivos(ResultadoLotePdf& r);
+    void    gravarDocumentoUnico(ResultadoLotePdf& r);
+
+    QVector<DocumentoAvaliacaoPdf> m_avaliacoes;
+    QVector<Ficha>                 m_fichas;
+    QVector<Item>                  m_itens;
+    ModoLotePdf                    m_modo;
+    QString                        m_destino;
+    QDateTime                      m_data;
+    std::atomic<int>               m_concluidos{0};
+    std::atomic<bool>              m_cancelado{false};
+};
+
+// Mede o lote com avaliações sintéticas numa pasta temporária (linha de
+// comando)
+int executarBenchmarkPdf(int quantidade);
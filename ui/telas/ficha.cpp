@@ -0,0 +1,110 @@
+// ficha.cpp
+#include "ficha.h"
+
+#include <QStringList>
+
+QString fichaParaLinha(const Ficha& f) {
+    QStringList parts;
+
+    // Dados básicos
+    parts << QString::number(f.id);
+    parts << f.tipoFicha;
+    parts << f.resolucaoNum;
+    parts << f.resolucaoAno;
+    parts << f.curso;
+    parts << f.categoriaCurso;
+    parts << QString::number(f.notaMin);
+    parts << QString::number(f.notaMax);
+    parts << (f.incluirDataAvaliacao ? "1" : "0");
+    parts << (f.incluirProfessorAvaliador ? "1" : "0");
+    parts << (f.incluirProfessorOrientador ? "1" : "0");
+    parts << (f.incluirObservacoes ? "1" : "0");
+    parts << f.textoAprovacao;
+
+    // Número de seções
+    parts << QString::number(f.secoes.size());
+
+    // Serializar cada seção
+    for (const auto& secao : f.secoes) {
+        parts << secao.identificador;
+        parts << secao.titulo;
+        parts << QString::number(secao.quesitos.size());
+
+        // Serializar cada quesito
+        for (const auto& q : secao.quesitos) {
+            parts << q.nome;
+            if (q.autoCalculado && !q.formula.trimmed().isEmpty())
+                parts << "1=" + q.formula.trimmed();
+            else
+                parts << (q.autoCalculado ? "1" : "0");
+            parts << (q.temPeso ? "1" : "0");
+            parts << QString::number(q.peso);
+        }
+    }
+
+    return parts.join(";");
+}
+
+Ficha linhaParaFicha(const QString& linha) {
+    Ficha f;
+    const QStringList p = linha.split(';');
+
+    if (p.size() < 14) return f;
+
+    int idx = 0;
+
+    // Dados básicos
+    f.id = p[idx++].toInt();
+    f.tipoFicha = p[idx++];
+    f.resolucaoNum = p[idx++];
+    f.resolucaoAno = p[idx++];
+    f.curso = p[idx++];
+    f.categoriaCurso = p[idx++];
+    f.notaMin = p[idx++].toDouble();
+    f.notaMax = p[idx++].toDouble();
+    f.incluirDataAvaliacao = (p[idx++] == "1");
+    f.incluirProfessorAvaliador = (p[idx++] == "1");
+    f.incluirProfessorOrientador = (p[idx++] == "1");
+    f.incluirObservacoes = (p[idx++] == "1");
+    f.textoAprovacao = p[idx++];
+
+    // Número de seções
+    int numSecoes = p[idx++].toInt();
+
+    // Deserializar cada seção
+    for (int i = 0; i < numSecoes && idx < p.size(); ++i) {
+        Secao secao;
+
+        secao.identificador = p[idx++];
+        if (idx >= p.size()) break;
+        secao.titulo = p[idx++];
+
+        if (idx >= p.size()) break;
+        int numQuesitos = p[idx++].toInt();
+
+        // Deserializar cada quesito
+        for (int j = 0; j < numQuesitos && idx < p.size(); ++j) {
+            Quesito q;
+
+            q.nome = p[idx++];
+            if (idx >= p.size()) break;
+
+            const QString autoCalc = p[idx++];
+            q.autoCalculado = autoCalc.startsWith('1');
+            if (autoCalc.startsWith("1="))
+                q.formula = autoCalc.mid(2);
+            if (idx >= p.size()) break;
+
+            q.temPeso = (p[idx++] == "1");
+            if (idx >= p.size()) break;
+
+            q.peso = p[idx++].toDouble();
+
+            secao.quesitos.append(q);
+        }
+
+        f.secoes.append(secao);
+    }
+
+    return f;
+}
@@ -0,0 +1,50 @@
+// ficha.h
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+// ===== Estruturas de Dados =====
+
+struct Quesito {
+    QString nome;
+    double notaMin{0.0};
+    double notaMax{10.0};
+    bool temPeso{false};
+    double peso{1.0};
+    bool autoCalculado{false};
+    QString formula; // "MEDIA", "SOMA(B:TODOS)"... (ver formulaquesito.h)
+    int ordem{0};
+};
+
+struct Secao {
+    QString identificador;
+    QString titulo;
+    QVector<Quesito> quesitos;
+};
+
+struct Ficha {
+    int id{0};
+    QString tipoFicha;
+    QString resolucaoNum;
+    QString resolucaoAno;
+    QString curso;
+    QString categoriaCurso;
+    double notaMin{0.0};
+    double notaMax{10.0};
+    QVector<Secao> secoes;
+
+    bool incluirDataAvaliacao{true};
+    bool incluirProfessorAvaliador{true};
+    bool incluirProfessorOrientador{false};
+    bool incluirObservacoes{false};
+    QString textoAprovacao;
+};
+
+// Conversão Ficha <-> linha do fichas.txt
+// Formato: id;tipo;resNum;resAno;curso;categoria;notaMin;notaMax;
+//          data;profAval;profOrient;obs;textoAprov;numSecoes;
+//          [idSecao;titulo;numQuesitos;[nome;auto;temPeso;peso]...]...
+// 'auto' é 0, 1 ou "1=fórmula" (quesito calculado com fórmula)
+QString fichaParaLinha(const Ficha& f);
+Ficha   linhaParaFicha(const QString& linha);
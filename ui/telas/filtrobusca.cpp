@@ -0,0 +1,497 @@
+// filtrobusca.cpp
+#include "filtrobusca.h"
+
+#include <QAbstractProxyModel>
+
+#include <algorithm>
+#include <climits>
+
+// ================== CHAVE DE BUSCA ==================
+
+QString chaveBusca(const QString& texto)
+{
+    bool ascii = true;
+    for (const QChar c : texto) {
+        if (c.unicode() >= 0x80) {
+            ascii = false;
+            break;
+        }
+    }
+    if (ascii)
+        return texto.toLower();
+
+    // NFD separa a letra do acento ("ã" -> "a" + til combinante)
+    const QString decomposto = texto.normalized(QString::NormalizationForm_D);
+    QString semAcento;
+    semAcento.reserve(decomposto.size());
+    for (const QChar c : decomposto) {
+        if (c.category() != QChar::Mark_NonSpacing)
+            semAcento.append(c);
+    }
+    return semAcento.toCaseFolded();
+}
+
+// ================== LINHAS ACEITAS ==================
+
+// Proxy interno do FiltroBusca: guarda as chaves de busca de cada linha de
+// origem e, em ordem crescente, as linhas de origem que passam no filtro.
+// A linha N deste proxy é a linha m_linhas[N] da origem.
+class LinhasAceitas : public QAbstractProxyModel
+{
+public:
+    LinhasAceitas(int colunaNome, int colunaCategoria, QObject* parent)
+        : QAbstractProxyModel(parent)
+        , m_colunaNome(colunaNome)
+        , m_colunaCategoria(colunaCategoria)
+    {
+    }
+
+    void definirColunaId(int coluna)
+    {
+        m_colunaId = coluna;
+        m_linhaDoId.clear();
+    }
+
+    // nome e categoria já dobrados. relevancia != nullptr: só passam as
+    // linhas cujo id está nela (o nome já foi resolvido pelo índice).
+    // Retorna se o conjunto de linhas aceitas mudou.
+    bool filtrar(const QString& nome, const QString& categoria,
+                 const QHash<int, int>* relevancia)
+    {
+        // m_linhas está sempre em dia com o filtro atual, então um texto
+        // que contém o anterior só precisa olhar as que já passavam
+        const bool refinar = !relevancia && !m_relevancia
+                             && nome.contains(m_nome)
+                             && categoria.contains(m_categoria);
+
+        m_nome       = nome;
+        m_categoria  = categoria;
+        m_relevancia = relevancia;
+
+        QVector<int> novas;
+        if (relevancia) {
+            indexarIds();
+            novas.reserve(relevancia->size());
+            for (auto it = relevancia->cbegin(); it != relevancia->cend(); ++it) {
+                const int linha = m_linhaDoId.value(it.key(), -1);
+                if (linha >= 0 && aceita(linha))
+                    novas.append(linha);
+            }
+            std::sort(novas.begin(), novas.end());
+        } else if (refinar) {
+            novas.reserve(m_linhas.size());
+            const QVector<int>& atuais = m_linhas;
+            for (const int linha : atuais) {
+                if (aceita(linha))
+                    novas.append(linha);
+            }
+        } else {
+            novas = todasAceitas();
+        }
+        return trocarLinhas(std::move(novas));
+    }
+
+    void setSourceModel(QAbstractItemModel* modelo) override
+    {
+        beginResetModel();
+        for (const auto& c : m_conexoes)
+            disconnect(c);
+        m_conexoes.clear();
+
+        QAbstractProxyModel::setSourceModel(modelo);
+        if (modelo)
+            conectar(modelo);
+
+        reconstruir();
+        endResetModel();
+    }
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override
+    {
+        if (parent.isValid() || row < 0 || row >= m_linhas.size()
+            || column < 0 || column >= columnCount())
+            return QModelIndex();
+        return createIndex(row, column);
+    }
+
+    QModelIndex parent(const QModelIndex&) const override { return QModelIndex(); }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_linhas.size();
+    }
+
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override
+    {
+        return (parent.isValid() || !sourceModel()) ? 0 : sourceModel()->columnCount();
+    }
+
+    QModelIndex mapToSource(const QModelIndex& indice) const override
+    {
+        if (!indice.isValid() || !sourceModel() || indice.row() >= m_linhas.size())
+            return QModelIndex();
+        return sourceModel()->index(m_linhas[indice.row()], indice.column());
+    }
+
+    QModelIndex mapFromSource(const QModelIndex& indice) const override
+    {
+        if (!indice.isValid() || indice.parent().isValid())
+            return QModelIndex();
+        const int p = posicao(indice.row());
+        if (p >= m_linhas.size() || m_linhas[p] != indice.row())
+            return QModelIndex();
+        return createIndex(p, indice.column());
+    }
+
+private:
+    struct Chaves {
+        QString nome;
+        QString categoria;
+    };
+
+    int m_colunaNome;
+    int m_colunaCategoria;
+    int m_colunaId{-1};
+
+    QString m_nome;
+    QString m_categoria;
+    const QHash<int, int>* m_relevancia{nullptr};   // do FiltroBusca
+
+    QVector<Chaves> m_chaves;      // uma por linha de origem
+    QVector<int>    m_linhas;      // linhas de origem aceitas, crescentes
+    QHash<int, int> m_linhaDoId;   // id -> linha de origem; refeito sob demanda
+    bool m_removendo{false};
+    QVector<QMetaObject::Connection> m_conexoes;
+
+    void conectar(QAbstractItemModel* modelo)
+    {
+        m_conexoes << connect(modelo, &QAbstractItemModel::rowsInserted, this,
+            [this](const QModelIndex& pai, int primeira, int ultima) {
+                if (!pai.isValid())
+                    inserirLinhas(primeira, ultima);
+            });
+        m_conexoes << connect(modelo, &QAbstractItemModel::rowsAboutToBeRemoved, this,
+            [this](const QModelIndex& pai, int primeira, int ultima) {
+                if (pai.isValid())
+                    return;
+                const int de = posicao(primeira);
+                const int ate = posicao(ultima + 1);
+                m_removendo = de < ate;
+                if (m_removendo)
+                    beginRemoveRows(QModelIndex(), de, ate - 1);
+            });
+        m_conexoes << connect(modelo, &QAbstractItemModel::rowsRemoved, this,
+            [this](const QModelIndex& pai, int primeira, int ultima) {
+                if (!pai.isValid())
+                    removerLinhas(primeira, ultima);
+            });
+        m_conexoes << connect(modelo, &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex& de, const QModelIndex& ate, const QVector<int>& papeis) {
+                if (!de.parent().isValid())
+                    alterarLinhas(de, ate, papeis);
+            });
+
+        // Mudanças de estrutura inteira: recomeça do zero
+        const auto comecar = [this] { beginResetModel(); };
+        const auto terminar = [this] {
+            reconstruir();
+            endResetModel();
+        };
+        m_conexoes << connect(modelo, &QAbstractItemModel::modelAboutToBeReset, this, comecar);
+        m_conexoes << connect(modelo, &QAbstractItemModel::modelReset, this, terminar);
+        m_conexoes << connect(modelo, &QAbstractItemModel::layoutAboutToBeChanged, this, comecar);
+        m_conexoes << connect(modelo, &QAbstractItemModel::layoutChanged, this, terminar);
+        m_conexoes << connect(modelo, &QAbstractItemModel::rowsAboutToBeMoved, this, comecar);
+        m_conexoes << connect(modelo, &QAbstractItemModel::rowsMoved, this, terminar);
+    }
+
+    // Posição em m_linhas da primeira linha de origem >= linha
+    int posicao(int linha) const
+    {
+        return int(std::lower_bound(m_linhas.cbegin(), m_linhas.cend(), linha)
+                   - m_linhas.cbegin());
+    }
+
+    bool aceita(int linha) const
+    {
+        if (m_relevancia) {
+            if (m_colunaId < 0)
+                return false;
+            const int id = sourceModel()->index(linha, m_colunaId).data().toInt();
+            if (!m_relevancia->contains(id))
+                return false;
+        }
+        const Chaves& c = m_chaves[linha];
+        return (m_nome.isEmpty()      || c.nome.contains(m_nome))
+            && (m_categoria.isEmpty() || c.categoria.contains(m_categoria));
+    }
+
+    QVector<int> todasAceitas() const
+    {
+        QVector<int> linhas;
+        for (int linha = 0; linha < m_chaves.size(); ++linha) {
+            if (aceita(linha))
+                linhas.append(linha);
+        }
+        return linhas;
+    }
+
+    Chaves chavesDaLinha(int linha) const
+    {
+        const QAbstractItemModel* origem = sourceModel();
+        Chaves c;
+        c.nome = chaveBusca(origem->index(linha, m_colunaNome).data().toString());
+        c.categoria = (m_colunaCategoria == m_colunaNome)
+            ? c.nome
+            : chaveBusca(origem->index(linha, m_colunaCategoria).data().toString());
+        return c;
+    }
+
+    void recalcularChaves(int primeira, int ultima)
+    {
+        ultima = qMin(ultima, m_chaves.size() - 1);
+        for (int linha = primeira; linha <= ultima; ++linha)
+            m_chaves[linha] = chavesDaLinha(linha);
+    }
+
+    void indexarIds()
+    {
+        if (!m_linhaDoId.isEmpty() || m_colunaId < 0 || !sourceModel())
+            return;
+        m_linhaDoId.reserve(m_chaves.size());
+        for (int linha = 0; linha < m_chaves.size(); ++linha)
+            m_linhaDoId.insert(sourceModel()->index(linha, m_colunaId).data().toInt(), linha);
+    }
+
+    // Sem sinais: quem chama está entre begin/endResetModel
+    void reconstruir()
+    {
+        m_chaves.clear();
+        m_linhas.clear();
+        m_linhaDoId.clear();
+        if (!sourceModel())
+            return;
+
+        m_chaves.resize(sourceModel()->rowCount());
+        recalcularChaves(0, m_chaves.size() - 1);
+        m_linhas = todasAceitas();
+    }
+
+    // Troca o conjunto inteiro como mudança de layout: seleção e linha
+    // atual continuam nas mesmas linhas de origem, se elas ficaram
+    bool trocarLinhas(QVector<int> novas)
+    {
+        if (novas == m_linhas)
+            return false;
+
+        emit layoutAboutToBeChanged();
+        const QModelIndexList antigos = persistentIndexList();
+        QModelIndexList novos;
+        novos.reserve(antigos.size());
+        for (const QModelIndex& i : antigos) {
+            const int origem = m_linhas.value(i.row(), -1);
+            const auto it = std::lower_bound(novas.cbegin(), novas.cend(), origem);
+            novos << ((it != novas.cend() && *it == origem)
+                          ? createIndex(int(it - novas.cbegin()), i.column())
+                          : QModelIndex());
+        }
+        m_linhas = std::move(novas);
+        changePersistentIndexList(antigos, novos);
+        emit layoutChanged();
+        return true;
+    }
+
+    void inserirLinhas(int primeira, int ultima)
+    {
+        const int n = ultima - primeira + 1;
+        m_chaves.insert(primeira, n, Chaves());
+        recalcularChaves(primeira, ultima);
+        m_linhaDoId.clear();
+
+        // As linhas de origem depois das novas andam n posições; as
+        // posições neste proxy não mudam
+        const int p = posicao(primeira);
+        for (int i = p; i < m_linhas.size(); ++i)
+            m_linhas[i] += n;
+
+        QVector<int> novas;
+        for (int linha = primeira; linha <= ultima; ++linha) {
+            if (aceita(linha))
+                novas.append(linha);
+        }
+        if (novas.isEmpty())
+            return;
+
+        beginInsertRows(QModelIndex(), p, p + novas.size() - 1);
+        m_linhas.insert(p, novas.size(), 0);
+        std::copy(novas.cbegin(), novas.cend(), m_linhas.begin() + p);
+        endInsertRows();
+    }
+
+    void removerLinhas(int primeira, int ultima)
+    {
+        const int n = ultima - primeira + 1;
+        m_chaves.remove(primeira, n);
+        m_linhaDoId.clear();
+
+        const int de = posicao(primeira);
+        const int ate = posicao(ultima + 1);
+        m_linhas.remove(de, ate - de);
+        for (int i = de; i < m_linhas.size(); ++i)
+            m_linhas[i] -= n;
+
+        if (m_removendo) {
+            m_removendo = false;
+            endRemoveRows();
+        }
+    }
+
+    void alterarLinhas(const QModelIndex& de, const QModelIndex& ate, const QVector<int>& papeis)
+    {
+        const auto cobre = [&](int coluna) {
+            return coluna >= de.column() && coluna <= ate.column();
+        };
+        if (cobre(m_colunaId))
+            m_linhaDoId.clear();
+
+        if (cobre(m_colunaNome) || cobre(m_colunaCategoria) || cobre(m_colunaId)) {
+            recalcularChaves(de.row(), ate.row());
+            reavaliar(de.row(), qMin(ate.row(), m_chaves.size() - 1));
+        }
+
+        const int p1 = posicao(de.row());
+        const int p2 = posicao(ate.row() + 1);
+        if (p1 < p2)
+            emit dataChanged(index(p1, de.column()), index(p2 - 1, ate.column()), papeis);
+    }
+
+    // Refaz o teste só nas linhas de origem [primeira, ultima]
+    void reavaliar(int primeira, int ultima)
+    {
+        if (primeira > ultima)
+            return;
+
+        // Caso comum (uma linha editada): entra ou sai sozinha
+        if (primeira == ultima) {
+            const int p = posicao(primeira);
+            const bool estava = p < m_linhas.size() && m_linhas[p] == primeira;
+            const bool fica = aceita(primeira);
+            if (estava && !fica) {
+                beginRemoveRows(QModelIndex(), p, p);
+                m_linhas.remove(p);
+                endRemoveRows();
+            } else if (!estava && fica) {
+                beginInsertRows(QModelIndex(), p, p);
+                m_linhas.insert(p, primeira);
+                endInsertRows();
+            }
+            return;
+        }
+
+        const int p1 = posicao(primeira);
+        const int p2 = posicao(ultima + 1);
+        QVector<int> novas = m_linhas.mid(0, p1);
+        for (int linha = primeira; linha <= ultima; ++linha) {
+            if (aceita(linha))
+                novas.append(linha);
+        }
+        novas += m_linhas.mid(p2);
+        trocarLinhas(std::move(novas));
+    }
+};
+
+// ================== FILTRO ==================
+
+FiltroBusca::FiltroBusca(int colunaNome, int colunaCategoria, QObject* parent)
+    : QSortFilterProxyModel(parent)
+    , m_linhas(new LinhasAceitas(colunaNome, colunaCategoria, this))
+{
+}
+
+void FiltroBusca::setSourceModel(QAbstractItemModel* modelo)
+{
+    m_linhas->setSourceModel(modelo);
+    QSortFilterProxyModel::setSourceModel(m_linhas);
+}
+
+QModelIndex FiltroBusca::paraOrigem(const QModelIndex& indice) const
+{
+    return m_linhas->mapToSource(mapToSource(indice));
+}
+
+void FiltroBusca::usarIndice(int colunaId, Indice indice)
+{
+    m_colunaId = colunaId;
+    m_indice   = std::move(indice);
+    m_linhas->definirColunaId(colunaId);
+}
+
+void FiltroBusca::setNomeFiltro(const QString& n)
+{
+    if (!m_indice) {
+        m_nomeFiltro = chaveBusca(n.trimmed());
+        aplicarFiltro();
+        return;
+    }
+
+    m_busca = n.trimmed();
+    m_relevancia.clear();
+    if (!m_busca.isEmpty()) {
+        const QVector<int> ids = m_indice(m_busca);
+        m_relevancia.reserve(ids.size());
+        for (int i = 0; i < ids.size(); ++i)
+            m_relevancia.insert(ids[i], i);
+    }
+
+    // Com o mesmo conjunto de linhas nada foi reordenado, mas a
+    // relevância de cada uma pode ter mudado
+    if (!aplicarFiltro())
+        invalidate();
+}
+
+void FiltroBusca::refazerBusca()
+{
+    if (m_indice && buscaAtiva())
+        setNomeFiltro(m_busca);
+}
+
+void FiltroBusca::setCategoriaFiltro(const QString& c)
+{
+    m_categoriaFiltro = chaveBusca(c.trimmed());
+    aplicarFiltro();
+}
+
+bool FiltroBusca::aplicarFiltro()
+{
+    if (buscaAtiva())
+        return m_linhas->filtrar(QString(), m_categoriaFiltro, &m_relevancia);
+    return m_linhas->filtrar(m_nomeFiltro, m_categoriaFiltro, nullptr);
+}
+
+bool FiltroBusca::lessThan(const QModelIndex& left, const QModelIndex& right) const
+{
+    const bool porId = m_colunaId >= 0
+                    && left.column() == m_colunaId && right.column() == m_colunaId;
+    if (!porId)
+        return QSortFilterProxyModel::lessThan(left, right);
+
+    if (buscaAtiva()) {
+        const int r1 = m_relevancia.value(idDaLinha(left.row()),  INT_MAX);
+        const int r2 = m_relevancia.value(idDaLinha(right.row()), INT_MAX);
+        if (r1 != r2)
+            return r1 < r2;
+    }
+
+    bool ok1 = false, ok2 = false;
+    const int v1 = left.data().toInt(&ok1);
+    const int v2 = right.data().toInt(&ok2);
+    if (ok1 && ok2)
+        return v1 < v2;
+    return QSortFilterProxyModel::lessThan(left, right);
+}
+
+// Linha do proxy interno (a origem deste)
+int FiltroBusca::idDaLinha(int linha) const
+{
+    return sourceModel()->index(linha, m_colunaId).data().toInt();
+}
@@ -0,0 +1,82 @@
+// filtrobusca.h
+#pragma once
+
+#include <QSortFilterProxyModel>
+#include <QString>
+#include <QVector>
+#include <QHash>
+
+#include <functional>
+
+class LinhasAceitas;
+
+// Chave de busca: sem acentos e em case folding ("João" -> "joao").
+// Texto só ASCII não passa pela normalização.
+QString chaveBusca(const QString& texto);
+
+// ===== Filtro das tabelas por nome / categoria =====
+//
+// O filtro fica num proxy interno (LinhasAceitas, no .cpp) entre o modelo
+// de origem e este: ele guarda as chaves de busca já dobradas de cada
+// linha e a lista das linhas de origem aceitas. O QSortFilterProxyModel
+// daqui só ordena o que sobrou.
+//
+// Quando o texto novo contém o anterior (a pessoa continuou digitando),
+// só as linhas já aceitas são testadas de novo; as outras nem são
+// visitadas. Ao apagar texto ou trocar a categoria por outra, é uma
+// passada completa pelas chaves.
+//
+// As chaves e a lista acompanham o modelo de origem (inserção, remoção,
+// reset e dataChanged) sem refiltrar a tabela toda.
+//
+// Com usarIndice(), o texto de busca vai para um índice do repositório
+// (ids do mais relevante para o menos) em vez do contains() na coluna de
+// nome; o índice dobra o texto com a mesma chaveBusca(). Os candidatos
+// são só as linhas dos ids encontrados, e a categoria é testada nelas.
+// Ordenando pela coluna de id, as linhas encontradas ficam na ordem de
+// relevância; as outras colunas continuam ordenando pelo próprio valor.
+//
+// Como a origem deste proxy é o interno, quem precisa da linha do modelo
+// original usa paraOrigem() no lugar de mapToSource().
+class FiltroBusca : public QSortFilterProxyModel
+{
+    Q_OBJECT
+public:
+    FiltroBusca(int colunaNome, int colunaCategoria, QObject* parent = nullptr);
+
+    void setSourceModel(QAbstractItemModel* modelo) override;
+
+    // Índice deste proxy -> índice do modelo passado em setSourceModel()
+    QModelIndex paraOrigem(const QModelIndex& indice) const;
+
+    using Indice = std::function<QVector<int>(const QString&)>;
+    void usarIndice(int colunaId, Indice indice);
+
+    void setNomeFiltro(const QString& n);
+    void setCategoriaFiltro(const QString& c);
+
+    bool buscaAtiva() const { return !m_busca.isEmpty(); }
+
+    // Registros mudaram: o resultado do índice pode ser outro
+    void refazerBusca();
+
+protected:
+    // Coluna de id: relevância com busca ativa, senão o id como número.
+    // Demais colunas: ordem normal do QSortFilterProxyModel
+    bool lessThan(const QModelIndex& left,
+                  const QModelIndex& right) const override;
+
+private:
+    LinhasAceitas* m_linhas;
+
+    QString m_nomeFiltro;        // já dobrados
+    QString m_categoriaFiltro;
+
+    int             m_colunaId{-1};
+    Indice          m_indice;
+    QString         m_busca;
+    QHash<int, int> m_relevancia;   // id -> posição no resultado
+
+    bool aplicarFiltro();
+    int  idDaLinha(int linha) const;
+};
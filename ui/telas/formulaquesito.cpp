@@ -0,0 +1,657 @@
+// formulaquesito.cpp
+#include "formulaquesito.h"
+#include "filtrobusca.h"
+
+#include <QVarLengthArray>
+#include <QRegularExpression>
+
+#include <algorithm>
+
+// ================== COMPILADOR ==================
+
+class CompiladorFormula
+{
+public:
+    // posicoes[secao][quesito]: posição do valor em avaliar() (-1 = sem valor)
+    CompiladorFormula(const Ficha& f, const QVector<QVector<int>>& posicoes,
+                      int secao, int propria)
+        : m_ficha(f), m_posicoes(posicoes), m_secao(secao), m_propria(propria)
+    {
+    }
+
+    bool compilar(const QString& texto, FormulaQuesito& saida, QString& erro);
+
+private:
+    using Op        = FormulaQuesito::Op;
+    using Instrucao = FormulaQuesito::Instrucao;
+    using Codigo    = QVector<Instrucao>;
+
+    enum Tipo { Fim, Numero, Nome, Referencia, Todos,
+                AbreParentese, FechaParentese, Virgula, Operador };
+
+    struct Token {
+        Tipo    tipo{Fim};
+        QString texto;           // como foi escrito (mensagens)
+        QString chave;           // Nome: sem acento, minúsculo; Operador: o símbolo
+        double  numero{0.0};
+        int     secao{-1};
+        int     quesito{-1};
+    };
+
+    struct Argumento {
+        Codigo codigo;
+        double peso{1.0};
+    };
+
+    const Ficha&                  m_ficha;
+    const QVector<QVector<int>>&  m_posicoes;
+    int                           m_secao;
+    int                           m_propria;
+
+    QVector<Token> m_tokens;
+    int            m_pos{0};
+    QString        m_erro;
+
+    bool falhou() const { return !m_erro.isEmpty(); }
+    void falhar(const QString& erro) { if (m_erro.isEmpty()) m_erro = erro; }
+
+    const Token& atual() const { return m_tokens[m_pos]; }
+    bool operador(const char* simbolo) const
+    {
+        return atual().tipo == Operador && atual().chave == QLatin1String(simbolo);
+    }
+
+    static Instrucao instrucao(Op op, int arg = 0, double valor = 0.0)
+    {
+        Instrucao i;
+        i.op    = op;
+        i.arg   = arg;
+        i.valor = valor;
+        return i;
+    }
+
+    bool   separar(const QString& texto);
+    int    secaoPorIdentificador(const QString& id) const;
+    bool   referenciaOuTodos(const QString& palavra, int secao, Token& t);
+
+    Codigo expressao();
+    Codigo soma();
+    Codigo termo();
+    Codigo unario();
+    Codigo primario();
+    Codigo funcao(const Token& nome);
+    Codigo valorDoQuesito(int secao, int quesito, const QString& texto);
+    QVector<Argumento> todos(int secao);
+
+    static int profundidade(const Codigo& c);
+};
+
+// ----- Tokens -----
+
+int CompiladorFormula::secaoPorIdentificador(const QString& id) const
+{
+    for (int s = 0; s < m_ficha.secoes.size(); ++s) {
+        if (m_ficha.secoes[s].identificador.trimmed().compare(id, Qt::CaseInsensitive) == 0)
+            return s;
+    }
+    return -1;
+}
+
+bool CompiladorFormula::referenciaOuTodos(const QString& palavra, int secao, Token& t)
+{
+    static const QRegularExpression reQuesito(QStringLiteral("^q([0-9]+)$"));
+
+    const QString chave = chaveBusca(palavra);
+    if (chave == QLatin1String("todos")) {
+        t.tipo  = Todos;
+        t.secao = secao;
+        return true;
+    }
+    const QRegularExpressionMatch m = reQuesito.match(chave);
+    if (m.hasMatch()) {
+        t.tipo    = Referencia;
+        t.secao   = secao;
+        t.quesito = m.captured(1).toInt() - 1;
+        return true;
+    }
+    return false;
+}
+
+bool CompiladorFormula::separar(const QString& texto)
+{
+    const auto ehPalavra = [](QChar c) {
+        return c.isLetterOrNumber() || c == '_' || c == '.';
+    };
+
+    m_tokens.clear();
+    int i = 0;
+    while (i < texto.size()) {
+        const QChar c = texto[i];
+        if (c.isSpace()) {
+            ++i;
+            continue;
+        }
+
+        Token t;
+        if (ehPalavra(c)) {
+            int fim = i;
+            while (fim < texto.size() && ehPalavra(texto[fim]))
+                ++fim;
+            QString palavra = texto.mid(i, fim - i);
+            i = fim;
+
+            // "B:q3", "B:TODOS"
+            if (i < texto.size() && texto[i] == ':') {
+                const int secao = secaoPorIdentificador(palavra);
+                if (secao < 0) {
+                    falhar(QString("a seção '%1' não existe").arg(palavra));
+                    return false;
+                }
+                fim = ++i;
+                while (fim < texto.size() && ehPalavra(texto[fim]))
+                    ++fim;
+                const QString alvo = texto.mid(i, fim - i);
+                i = fim;
+                t.texto = palavra + ':' + alvo;
+                if (!referenciaOuTodos(alvo, secao, t)) {
+                    falhar(QString("depois de '%1:' vem qN ou TODOS").arg(palavra));
+                    return false;
+                }
+                m_tokens.append(t);
+                continue;
+            }
+
+            t.texto = palavra;
+            if (referenciaOuTodos(palavra, m_secao, t)) {
+                m_tokens.append(t);
+                continue;
+            }
+
+            bool ok = false;
+            const double v = palavra.toDouble(&ok);
+            if (ok && (palavra[0].isDigit() || palavra[0] == '.')) {
+                t.tipo   = Numero;
+                t.numero = v;
+            } else if (palavra[0].isDigit() || palavra[0] == '.') {
+                falhar(QString("número inválido '%1'").arg(palavra));
+                return false;
+            } else {
+                t.tipo  = Nome;
+                t.chave = chaveBusca(palavra);
+            }
+            m_tokens.append(t);
+            continue;
+        }
+
+        const QString dois = texto.mid(i, 2);
+        if (dois == QLatin1String("<=") || dois == QLatin1String(">=")
+            || dois == QLatin1String("<>")) {
+            t.tipo  = Operador;
+            t.texto = t.chave = dois;
+            i += 2;
+        } else if (QStringLiteral("+-*/<>=").contains(c)) {
+            t.tipo  = Operador;
+            t.texto = t.chave = QString(c);
+            ++i;
+        } else if (c == '(') {
+            t.tipo  = AbreParentese;
+            t.texto = c;
+            ++i;
+        } else if (c == ')') {
+            t.tipo  = FechaParentese;
+            t.texto = c;
+            ++i;
+        } else if (c == ',') {
+            t.tipo  = Virgula;
+            t.texto = c;
+            ++i;
+        } else {
+            falhar(QString("caractere inesperado '%1'").arg(c));
+            return false;
+        }
+        m_tokens.append(t);
+    }
+
+    m_tokens.append(Token());   // Fim
+    return true;
+}
+
+// ----- Gramática -----
+//
+// expressao := soma [ (< <= > >= = <>) soma ]
+// soma      := termo { (+ -) termo }
+// termo     := unario { (* /) unario }
+// unario    := - unario | primario
+// primario  := numero | qN | S:qN | ( expressao ) | FUNCAO [ ( args ) ]
+
+CompiladorFormula::Codigo CompiladorFormula::expressao()
+{
+    Codigo c = soma();
+    if (falhou())
+        return {};
+
+    static const struct { const char* simbolo; Op op; } comparacoes[] = {
+        { "<",  FormulaQuesito::Menor },      { "<=", FormulaQuesito::MenorIgual },
+        { ">",  FormulaQuesito::Maior },      { ">=", FormulaQuesito::MaiorIgual },
+        { "=",  FormulaQuesito::Igual },      { "<>", FormulaQuesito::Diferente },
+    };
+    for (const auto& cmp : comparacoes) {
+        if (operador(cmp.simbolo)) {
+            ++m_pos;
+            c += soma();
+            c.append(instrucao(cmp.op));
+            break;
+        }
+    }
+    return falhou() ? Codigo() : c;
+}
+
+CompiladorFormula::Codigo CompiladorFormula::soma()
+{
+    Codigo c = termo();
+    while (!falhou() && (operador("+") || operador("-"))) {
+        const Op op = operador("+") ? FormulaQuesito::Soma : FormulaQuesito::Subtracao;
+        ++m_pos;
+        c += termo();
+        c.append(instrucao(op));
+    }
+    return falhou() ? Codigo() : c;
+}
+
+CompiladorFormula::Codigo CompiladorFormula::termo()
+{
+    Codigo c = unario();
+    while (!falhou() && (operador("*") || operador("/"))) {
+        const Op op = operador("*") ? FormulaQuesito::Multiplicacao : FormulaQuesito::Divisao;
+        ++m_pos;
+        c += unario();
+        c.append(instrucao(op));
+    }
+    return falhou() ? Codigo() : c;
+}
+
+CompiladorFormula::Codigo CompiladorFormula::unario()
+{
+    if (operador("-")) {
+        ++m_pos;
+        Codigo c = unario();
+        c.append(instrucao(FormulaQuesito::Negacao));
+        return falhou() ? Codigo() : c;
+    }
+    return primario();
+}
+
+CompiladorFormula::Codigo CompiladorFormula::primario()
+{
+    const Token t = atual();
+    switch (t.tipo) {
+    case Numero:
+        ++m_pos;
+        return { instrucao(FormulaQuesito::Constante, 0, t.numero) };
+
+    case Referencia:
+        ++m_pos;
+        return valorDoQuesito(t.secao, t.quesito, t.texto);
+
+    case AbreParentese: {
+        ++m_pos;
+        Codigo c = expressao();
+        if (falhou())
+            return {};
+        if (atual().tipo != FechaParentese) {
+            falhar("falta ')'");
+            return {};
+        }
+        ++m_pos;
+        return c;
+    }
+
+    case Nome:
+        ++m_pos;
+        return funcao(t);
+
+    case Todos:
+        falhar("TODOS só pode ser argumento de SOMA, MEDIA, MIN, MAX ou PONDERADA");
+        return {};
+
+    case Fim:
+        falhar("a fórmula terminou no meio de uma expressão");
+        return {};
+
+    default:
+        falhar(QString("'%1' fora do lugar").arg(t.texto));
+        return {};
+    }
+}
+
+CompiladorFormula::Codigo CompiladorFormula::valorDoQuesito(int secao, int quesito,
+                                                            const QString& texto)
+{
+    const QVector<int>& daSecao = m_posicoes[secao];
+    if (quesito < 0 || quesito >= daSecao.size()) {
+        falhar(QString("%1: a seção '%2' tem %3 quesito(s)")
+                   .arg(texto, m_ficha.secoes[secao].identificador)
+                   .arg(daSecao.size()));
+        return {};
+    }
+
+    const int posicao = daSecao[quesito];
+    if (posicao < 0) {
+        falhar(QString("%1 é calculado e não tem fórmula").arg(texto));
+        return {};
+    }
+    if (posicao == m_propria) {
+        falhar(QString("%1 é o próprio quesito").arg(texto));
+        return {};
+    }
+    if (posicao > m_propria) {
+        falhar(QString("%1 é calculado depois deste quesito").arg(texto));
+        return {};
+    }
+    return { instrucao(FormulaQuesito::Valor, posicao) };
+}
+
+QVector<CompiladorFormula::Argumento> CompiladorFormula::todos(int secao)
+{
+    QVector<Argumento> args;
+    const Secao& s = m_ficha.secoes[secao];
+    for (int q = 0; q < s.quesitos.size(); ++q) {
+        const Quesito& quesito = s.quesitos[q];
+        if (quesito.autoCalculado)
+            continue;
+        Argumento a;
+        a.codigo = { instrucao(FormulaQuesito::Valor, m_posicoes[secao][q]) };
+        a.peso   = quesito.temPeso ? quesito.peso : 1.0;
+        args.append(a);
+    }
+    if (args.isEmpty())
+        falhar(QString("a seção '%1' não tem quesitos digitados").arg(s.identificador));
+    return args;
+}
+
+CompiladorFormula::Codigo CompiladorFormula::funcao(const Token& nome)
+{
+    enum Funcao { FSoma, FMedia, FMin, FMax, FPonderada, FSe, FE, FOu };
+    static const struct { const char* chave; Funcao f; } funcoes[] = {
+        { "soma", FSoma }, { "media", FMedia }, { "min", FMin }, { "max", FMax },
+        { "ponderada", FPonderada }, { "se", FSe }, { "e", FE }, { "ou", FOu },
+    };
+
+    int f = -1;
+    for (const auto& fn : funcoes) {
+        if (nome.chave == QLatin1String(fn.chave))
+            f = fn.f;
+    }
+    if (f < 0) {
+        falhar(QString("a função '%1' não existe").arg(nome.texto));
+        return {};
+    }
+    const bool deLista = f <= FPonderada;
+
+    // ----- Argumentos -----
+    QVector<Argumento> args;
+    if (atual().tipo != AbreParentese) {
+        if (!deLista) {
+            falhar(QString("falta '(' depois de %1").arg(nome.texto));
+            return {};
+        }
+        args = todos(m_secao);          // "MEDIA" = "MEDIA(TODOS)"
+    } else {
+        ++m_pos;
+        if (atual().tipo == FechaParentese) {
+            if (deLista)
+                args = todos(m_secao);
+        } else {
+            for (;;) {
+                if (atual().tipo == Todos) {
+                    if (!deLista) {
+                        falhar(QString("%1 não aceita TODOS").arg(nome.texto));
+                        return {};
+                    }
+                    args += todos(atual().secao);
+                    ++m_pos;
+                } else if (atual().tipo == Referencia && deLista) {
+                    // Quesito citado direto: PONDERADA usa o peso dele
+                    const Token& r = atual();
+                    Argumento a;
+                    a.codigo = valorDoQuesito(r.secao, r.quesito, r.texto);
+                    if (!falhou() && r.quesito < m_ficha.secoes[r.secao].quesitos.size()) {
+                        const Quesito& q = m_ficha.secoes[r.secao].quesitos[r.quesito];
+                        a.peso = q.temPeso ? q.peso : 1.0;
+                    }
+                    ++m_pos;
+                    // q1 * 2 etc.: não é só o quesito, vale como expressão
+                    if (atual().tipo != Virgula && atual().tipo != FechaParentese) {
+                        --m_pos;
+                        a.codigo = expressao();
+                        a.peso   = 1.0;
+                    }
+                    args.append(a);
+                } else {
+                    Argumento a;
+                    a.codigo = expressao();
+                    args.append(a);
+                }
+                if (falhou())
+                    return {};
+                if (atual().tipo != Virgula)
+                    break;
+                ++m_pos;
+            }
+        }
+        if (falhou())
+            return {};
+        if (atual().tipo != FechaParentese) {
+            falhar(QString("falta ')' em %1").arg(nome.texto));
+            return {};
+        }
+        ++m_pos;
+    }
+    if (falhou())
+        return {};
+
+    // ----- Código -----
+    const auto encadear = [&args](Op op) {
+        Codigo c = args[0].codigo;
+        for (int i = 1; i < args.size(); ++i) {
+            c += args[i].codigo;
+            c.append(instrucao(op));
+        }
+        return c;
+    };
+
+    switch (f) {
+    case FSoma:
+        return encadear(FormulaQuesito::Soma);
+    case FMedia: {
+        Codigo c = encadear(FormulaQuesito::Soma);
+        c.append(instrucao(FormulaQuesito::Constante, 0, 1.0 / args.size()));
+        c.append(instrucao(FormulaQuesito::Multiplicacao));
+        return c;
+    }
+    case FMin:
+        return encadear(FormulaQuesito::Minimo);
+    case FMax:
+        return encadear(FormulaQuesito::Maximo);
+    case FPonderada: {
+        double total = 0.0;
+        for (const Argumento& a : args)
+            total += a.peso;
+        if (total <= 0.0) {
+            falhar("PONDERADA sem pesos");
+            return {};
+        }
+        // Pesos já divididos pelo total: só multiplicações e somas
+        Codigo c;
+        for (int i = 0; i < args.size(); ++i) {
+            c += args[i].codigo;
+            c.append(instrucao(FormulaQuesito::Constante, 0, args[i].peso / total));
+            c.append(instrucao(FormulaQuesito::Multiplicacao));
+            if (i > 0)
+                c.append(instrucao(FormulaQuesito::Soma));
+        }
+        return c;
+    }
+    case FE:
+    case FOu:
+        if (args.size() < 2) {
+            falhar(QString("%1 precisa de pelo menos dois argumentos").arg(nome.texto));
+            return {};
+        }
+        return encadear(f == FE ? FormulaQuesito::EOp : FormulaQuesito::OuOp);
+    case FSe: {
+        if (args.size() != 3) {
+            falhar("SE precisa de três argumentos: SE(condição, sim, não)");
+            return {};
+        }
+        // cond; SaltoSeFalso -> nao; sim; Salto -> fim; nao
+        Codigo c = args[0].codigo;
+        c.append(instrucao(FormulaQuesito::SaltoSeFalso, args[1].codigo.size() + 1));
+        c += args[1].codigo;
+        c.append(instrucao(FormulaQuesito::Salto, args[2].codigo.size()));
+        c += args[2].codigo;
+        return c;
+    }
+    }
+    return {};
+}
+
+// Pilha máxima, contando os dois ramos de SE (estimativa por cima)
+int CompiladorFormula::profundidade(const Codigo& c)
+{
+    int atual = 0, maximo = 0;
+    for (const Instrucao& i : c) {
+        switch (i.op) {
+        case FormulaQuesito::Constante:
+        case FormulaQuesito::Valor:
+            ++atual;
+            break;
+        case FormulaQuesito::Negacao:
+        case FormulaQuesito::Salto:
+            break;
+        default:
+            --atual;
+            break;
+        }
+        maximo = std::max(maximo, atual);
+    }
+    return maximo;
+}
+
+bool CompiladorFormula::compilar(const QString& texto, FormulaQuesito& saida, QString& erro)
+{
+    m_erro.clear();
+    m_pos = 0;
+
+    Codigo c;
+    if (separar(texto)) {
+        c = expressao();
+        if (!falhou() && atual().tipo != Fim)
+            falhar(QString("'%1' sobrando no fim").arg(atual().texto));
+    }
+    if (falhou()) {
+        erro = m_erro;
+        return false;
+    }
+
+    saida.m_texto        = texto.trimmed();
+    saida.m_codigo       = c;
+    saida.m_profundidade = profundidade(c);
+    return true;
+}
+
+// ================== AVALIAÇÃO ==================
+
+double FormulaQuesito::avaliar(const double* valores) const
+{
+    QVarLengthArray<double, 32> pilha(std::max(1, m_profundidade));
+    double* p = pilha.data();
+    int topo = 0;
+
+    const Instrucao* codigo = m_codigo.constData();
+    const int n = m_codigo.size();
+    for (int pc = 0; pc < n; ++pc) {
+        const Instrucao& in = codigo[pc];
+        switch (in.op) {
+        case Constante: p[topo++] = in.valor;           break;
+        case Valor:     p[topo++] = valores[in.arg];    break;
+        case Negacao:   p[topo - 1] = -p[topo - 1];     break;
+        case Salto:     pc += in.arg;                   break;
+        case SaltoSeFalso:
+            if (p[--topo] == 0.0)
+                pc += in.arg;
+            break;
+        default: {
+            const double b = p[--topo];
+            double& a = p[topo - 1];
+            switch (in.op) {
+            case Soma:          a += b; break;
+            case Subtracao:     a -= b; break;
+            case Multiplicacao: a *= b; break;
+            case Divisao:       a = (b != 0.0) ? a / b : 0.0; break;
+            case Menor:         a = (a <  b) ? 1.0 : 0.0; break;
+            case MenorIgual:    a = (a <= b) ? 1.0 : 0.0; break;
+            case Maior:         a = (a >  b) ? 1.0 : 0.0; break;
+            case MaiorIgual:    a = (a >= b) ? 1.0 : 0.0; break;
+            case Igual:         a = (a == b) ? 1.0 : 0.0; break;
+            case Diferente:     a = (a != b) ? 1.0 : 0.0; break;
+            case Minimo:        a = std::min(a, b); break;
+            case Maximo:        a = std::max(a, b); break;
+            case EOp:           a = (a != 0.0 && b != 0.0) ? 1.0 : 0.0; break;
+            case OuOp:          a = (a != 0.0 || b != 0.0) ? 1.0 : 0.0; break;
+            default: break;
+            }
+        }
+        }
+    }
+    return topo > 0 ? p[topo - 1] : 0.0;
+}
+
+// ================== FICHA ==================
+
+bool compilarFormulas(const Ficha& f, QVector<FormulaQuesito>& formulas, QString* erro)
+{
+    formulas.clear();
+
+    // Posição de cada quesito: digitados primeiro, depois os calculados
+    int digitados = 0;
+    for (const Secao& s : f.secoes) {
+        for (const Quesito& q : s.quesitos)
+            digitados += q.autoCalculado ? 0 : 1;
+    }
+    QVector<QVector<int>> posicoes(f.secoes.size());
+    int entrada = 0, calculado = digitados;
+    for (int s = 0; s < f.secoes.size(); ++s) {
+        for (const Quesito& q : f.secoes[s].quesitos) {
+            if (!q.autoCalculado)
+                posicoes[s].append(entrada++);
+            else if (temFormula(q))
+                posicoes[s].append(calculado++);
+            else
+                posicoes[s].append(-1);
+        }
+    }
+
+    for (int s = 0; s < f.secoes.size(); ++s) {
+        const Secao& secao = f.secoes[s];
+        for (int q = 0; q < secao.quesitos.size(); ++q) {
+            const Quesito& quesito = secao.quesitos[q];
+            if (!temFormula(quesito))
+                continue;
+
+            CompiladorFormula compilador(f, posicoes, s, posicoes[s][q]);
+            FormulaQuesito formula;
+            QString motivo;
+            if (!compilador.compilar(quesito.formula, formula, motivo)) {
+                if (erro)
+                    *erro = QString("Seção %1, quesito %2 (%3): %4")
+                                .arg(secao.identificador).arg(q + 1)
+                                .arg(quesito.nome, motivo);
+                formulas.clear();
+                return false;
+            }
+            formulas.append(formula);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,75 @@
+// formulaquesito.h
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+#include "ficha.h"
+
+// ===== Fórmulas dos quesitos auto-calculados =====
+//
+// Um quesito auto-calculado com fórmula não é digitado: o valor dele sai
+// dos outros quesitos da ficha. A fórmula é compilada uma vez por ficha
+// para um código de pilha, que é executado a cada mudança no formulário e
+// para cada avaliação gravada no recálculo em lote (motornotas.h).
+//
+//   q2                quesito 2 (contando de 1) da mesma seção
+//   B:q3              quesito 3 da seção "B"
+//   TODOS, B:TODOS    quesitos digitados da seção (só como argumento)
+//   + - * /           divisão por zero dá 0
+//   < <= > >= = <>    1 ou 0
+//   SOMA(...) MEDIA(...) MIN(...) MAX(...)
+//   PONDERADA(...)    média com os pesos dos quesitos citados (1 para
+//                     valores que não são quesitos)
+//   SE(cond, sim, nao)
+//   E(...) OU(...)
+//
+// Nomes sem diferença de maiúsculas e acentos ("Média" = "MEDIA"). Função
+// de lista sozinha vale para a própria seção: "MEDIA" = "MEDIA(TODOS)".
+// Um quesito calculado pode usar outro calculado que venha antes dele.
+// A fórmula não pode ter ';' (separador do fichas.txt).
+//
+// Posições em avaliar(valores): primeiro os quesitos digitados, na ordem
+// de Avaliacao::notasQuesitos, depois os calculados com fórmula, na ordem
+// da ficha. Calculados sem fórmula não têm valor (como antes das fórmulas).
+class FormulaQuesito
+{
+public:
+    const QString& texto() const { return m_texto; }
+
+    // 'valores' com as posições anteriores a esta fórmula já preenchidas
+    double avaliar(const double* valores) const;
+
+private:
+    friend class CompiladorFormula;
+
+    enum Op : quint8 {
+        Constante, Valor,
+        Soma, Subtracao, Multiplicacao, Divisao, Negacao,
+        Menor, MenorIgual, Maior, MaiorIgual, Igual, Diferente,
+        Minimo, Maximo, EOp, OuOp,
+        SaltoSeFalso, Salto          // relativos à instrução seguinte
+    };
+
+    struct Instrucao {
+        Op     op;
+        int    arg{0};               // posição (Valor) ou salto
+        double valor{0.0};           // Constante
+    };
+
+    QString            m_texto;
+    QVector<Instrucao> m_codigo;
+    int                m_profundidade{0};
+};
+
+// Compila as fórmulas dos quesitos auto-calculados de f, na ordem da
+// ficha. Em erro devolve false e descreve o primeiro problema em 'erro'
+// ("Seção B, quesito 2: ...").
+bool compilarFormulas(const Ficha& f, QVector<FormulaQuesito>& formulas,
+                      QString* erro = nullptr);
+
+// Quesito auto-calculado que tem valor (entra na nota final)
+inline bool temFormula(const Quesito& q)
+{
+    return q.autoCalculado && !q.formula.trimmed().isEmpty();
+}
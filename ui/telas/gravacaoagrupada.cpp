@@ -0,0 +1,98 @@
+// gravacaoagrupada.cpp
+#include "gravacaoagrupada.h"
+
+#include <QFile>
+
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+bool sincronizarNoDisco(QFile& f)
+{
+    if (!f.flush())
+        return false;
+#ifdef Q_OS_WIN
+    return _commit(f.handle()) == 0;
+#else
+    return ::fsync(f.handle()) == 0;
+#endif
+}
+
+GravacaoAgrupada::GravacaoAgrupada(QObject* parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(JanelaMs);
+    connect(&m_timer, &QTimer::timeout, this, &GravacaoAgrupada::descarregar);
+}
+
+GravacaoAgrupada::~GravacaoAgrupada()
+{
+    descarregar();
+}
+
+void GravacaoAgrupada::agendar(const QString& chave, std::function<bool()> gravar)
+{
+    m_pendentes.insert(chave, std::move(gravar));
+
+    // A janela conta a partir da primeira alteração: cliques seguidos não
+    // adiam a gravação indefinidamente. Uma nova tentativa mais distante
+    // não segura a alteração nova.
+    if (!m_timer.isActive() || m_timer.remainingTime() > JanelaMs)
+        m_timer.start(JanelaMs);
+}
+
+bool GravacaoAgrupada::descarregar()
+{
+    m_timer.stop();
+
+    // Troca antes de gravar: uma gravação pode agendar outra
+    QMap<QString, std::function<bool()>> pendentes;
+    pendentes.swap(m_pendentes);
+
+    QStringList chaves;
+    for (const QString& chave : m_ordem) {
+        if (pendentes.contains(chave))
+            chaves << chave;
+    }
+    for (auto it = pendentes.cbegin(); it != pendentes.cend(); ++it) {
+        if (!m_ordem.contains(it.key()))
+            chaves << it.key();
+    }
+
+    bool ok = true;
+    for (const QString& chave : chaves) {
+        const std::function<bool()>& gravar = pendentes[chave];
+        const bool gravou = gravar();
+        if (gravou) {
+            m_falhas.remove(chave);
+        } else {
+            // Volta para a fila, a menos que já tenha sido reagendada
+            m_falhas.insert(chave);
+            if (!m_pendentes.contains(chave))
+                m_pendentes.insert(chave, gravar);
+        }
+        emit gravacaoConcluida(chave, gravou);
+        ok = gravou && ok;
+    }
+
+    if (ok) {
+        m_esperaRetentativa = RetentativaMs;
+        if (!m_pendentes.isEmpty())
+            m_timer.start(JanelaMs);
+    } else {
+        m_timer.start(m_esperaRetentativa);
+        m_esperaRetentativa = std::min(m_esperaRetentativa * 2, int(RetentativaMaxMs));
+    }
+    return ok;
+}
+
+void GravacaoAgrupada::descartarPendencias()
+{
+    m_timer.stop();
+    m_pendentes.clear();
+}
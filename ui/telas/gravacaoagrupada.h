@@ -0,0 +1,72 @@
+// gravacaoagrupada.h
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QMap>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+#include <functional>
+
+class QFile;
+
+// Força os dados do arquivo aberto para o disco (fsync / _commit)
+bool sincronizarNoDisco(QFile& f);
+
+// ===== Gravação agrupada (group commit) =====
+//
+// Cada alteração agenda a gravação do seu arquivo com agendar(chave, fn).
+// Agendamentos da mesma chave dentro da janela substituem o anterior, e
+// quando a janela fecha todas as gravações pendentes rodam de uma vez —
+// um flush/fsync por arquivo em vez de um por clique.
+//
+// Uma gravação que falha (trava ocupada, disco cheio...) volta para a fila
+// e é tentada de novo com espera crescente, até dar certo ou ser
+// substituída por um agendamento mais novo da mesma chave. A falha só é
+// avisada por gravacaoConcluida(): nada de janela no meio do flush.
+//
+// As chaves de definirOrdem() rodam nessa ordem e antes das demais (que
+// seguem a ordem alfabética).
+class GravacaoAgrupada : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int JanelaMs = 250;
+    static constexpr int RetentativaMs    = 2000;    // primeira nova tentativa
+    static constexpr int RetentativaMaxMs = 60000;
+
+    explicit GravacaoAgrupada(QObject* parent = nullptr);
+    ~GravacaoAgrupada() override;
+
+    void agendar(const QString& chave, std::function<bool()> gravar);
+
+    // Ordem de execução quando várias chaves estão pendentes (uma gravação
+    // que usa o resultado de outra vem depois dela)
+    void definirOrdem(const QStringList& chaves) { m_ordem = chaves; }
+
+    // Executa agora tudo o que estiver pendente (saída do programa,
+    // exportação, recarga). Devolve false se alguma gravação falhou.
+    bool descarregar();
+
+    bool temPendencias() const { return !m_pendentes.isEmpty(); }
+    bool pendente(const QString& chave) const { return m_pendentes.contains(chave); }
+
+    // A última gravação de 'chave' falhou e está na fila para nova tentativa
+    bool falhou(const QString& chave) const { return m_falhas.contains(chave); }
+
+    // Esquece o que estiver na fila (destrutor do dono, depois da última
+    // tentativa: as funções agendadas usam os membros dele)
+    void descartarPendencias();
+
+signals:
+    // Resultado de cada gravação executada
+    void gravacaoConcluida(const QString& chave, bool ok);
+
+private:
+    QTimer m_timer;
+    QMap<QString, std::function<bool()>> m_pendentes;
+    QSet<QString> m_falhas;
+    QStringList   m_ordem;
+    int m_esperaRetentativa{RetentativaMs};
+};
@@ -0,0 +1,350 @@
+// indicetexto.cpp
+#include "indicetexto.h"
+#include "filtrobusca.h"
+
+#include <QtMath>
+#include <QPair>
+
+#include <algorithm>
+
+namespace {
+
+constexpr float PesoNome        = 3.0f;
+constexpr float PesoResponsavel = 2.0f;
+constexpr float PesoDescricao   = 1.0f;
+constexpr float FatorPrefixo    = 0.5f;
+
+} // namespace
+
+// ================== TERMOS ==================
+
+QStringList IndiceTextoProjetos::termos(const QString& texto)
+{
+    const QString chave = chaveBusca(texto);
+    QStringList res;
+    int inicio = -1;
+    for (int i = 0; i <= chave.size(); ++i) {
+        const bool letra = i < chave.size() && chave[i].isLetterOrNumber();
+        if (letra && inicio < 0) {
+            inicio = i;
+        } else if (!letra && inicio >= 0) {
+            res << chave.mid(inicio, i - inicio);
+            inicio = -1;
+        }
+    }
+    return res;
+}
+
+// ================== MANUTENÇÃO ==================
+
+void IndiceTextoProjetos::reconstruir(const QVector<Projeto>& projetos)
+{
+    m_termos.clear();
+    m_termosDoProjeto.clear();
+    m_termosDoProjeto.reserve(projetos.size());
+    for (const Projeto& p : projetos)
+        indexar(p);
+}
+
+void IndiceTextoProjetos::indexar(const Projeto& p)
+{
+    remover(p.id);
+
+    QHash<QString, float> pesos;
+    const auto somar = [&pesos](const QString& texto, float peso) {
+        for (const QString& t : termos(texto))
+            pesos[t] += peso;
+    };
+    somar(p.nome,        PesoNome);
+    somar(p.responsavel, PesoResponsavel);
+    somar(p.descricao,   PesoDescricao);
+
+    QStringList& doProjeto = m_termosDoProjeto[p.id];
+    doProjeto.reserve(pesos.size());
+    for (auto it = pesos.cbegin(); it != pesos.cend(); ++it) {
+        m_termos[it.key()].append(Ocorrencia{p.id, it.value()});
+        doProjeto << it.key();
+    }
+}
+
+void IndiceTextoProjetos::remover(int idProjeto)
+{
+    const auto it = m_termosDoProjeto.find(idProjeto);
+    if (it == m_termosDoProjeto.end())
+        return;
+
+    for (const QString& t : it.value()) {
+        auto lista = m_termos.find(t);
+        if (lista == m_termos.end())
+            continue;
+        QVector<Ocorrencia>& ocorrencias = lista.value();
+        ocorrencias.erase(std::remove_if(ocorrencias.begin(), ocorrencias.end(),
+                                         [idProjeto](const Ocorrencia& o) {
+                                             return o.idProjeto == idProjeto;
+                                         }),
+                          ocorrencias.end());
+        if (ocorrencias.isEmpty())
+            m_termos.erase(lista);
+    }
+    m_termosDoProjeto.erase(it);
+}
+
+// ================== CONSULTA ==================
+
+QVector<int> IndiceTextoProjetos::buscar(const QString& consulta) const
+{
+    QStringList procurados = termos(consulta);
+    procurados.removeDuplicates();
+    if (procurados.isEmpty())
+        return {};
+
+    const float total = float(m_termosDoProjeto.size());
+    QHash<int, float> acumulado;
+
+    for (int n = 0; n < procurados.size(); ++n) {
+        const QString& procurado = procurados[n];
+
+        // Melhor termo de cada projeto entre os que começam com 'procurado'
+        QHash<int, float> melhor;
+        for (auto it = m_termos.lowerBound(procurado);
+             it != m_termos.cend() && it.key().startsWith(procurado); ++it) {
+            const QVector<Ocorrencia>& ocorrencias = it.value();
+            const float raridade = float(qLn(1.0 + total / ocorrencias.size()));
+            const float fator = (it.key().size() == procurado.size()) ? 1.0f : FatorPrefixo;
+            for (const Ocorrencia& o : ocorrencias) {
+                if (n > 0 && !acumulado.contains(o.idProjeto))
+                    continue; // já ficou de fora por um termo anterior
+                float& m = melhor[o.idProjeto];
+                m = std::max(m, o.peso * raridade * fator);
+            }
+        }
+
+        if (n == 0) {
+            acumulado.swap(melhor);
+        } else {
+            for (auto it = acumulado.begin(); it != acumulado.end(); ) {
+                const auto achado = melhor.constFind(it.key());
+                if (achado == melhor.constEnd()) {
+                    it = acumulado.erase(it);
+                } else {
+                    it.value() += achado.value();
+                    ++it;
+                }
+            }
+        }
+        if (acumulado.isEmpty())
+            return {};
+    }
+
+    QVector<int> ids;
+    ids.reserve(acumulado.size());
+    for (auto it = acumulado.cbegin(); it != acumulado.cend(); ++it)
+        ids.append(it.key());
+    std::sort(ids.begin(), ids.end(), [&acumulado](int a, int b) {
+        const float pa = acumulado.value(a);
+        const float pb = acumulado.value(b);
+        return pa != pb ? pa > pb : a < b;
+    });
+    return ids;
+}
+
+// ================== TRIGRAMAS ==================
+
+namespace {
+
+quint64 trigrama(const QChar* c)
+{
+    return (quint64(c[0].unicode()) << 32) | (quint64(c[1].unicode()) << 16) | quint64(c[2].unicode());
+}
+
+quint32 bigrama(const QChar* c)
+{
+    return (quint32(c[0].unicode()) << 16) | quint32(c[1].unicode());
+}
+
+template <typename T>
+void semRepeticao(QVector<T>& v)
+{
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+}
+
+} // namespace
+
+QVector<quint64> IndiceTrigramasAvaliadores::trigramas(const QString& chave)
+{
+    QVector<quint64> res;
+    for (const QString& palavra : IndiceTextoProjetos::termos(chave)) {
+        const QString p = "  " + palavra + ' ';
+        for (int i = 0; i + 3 <= p.size(); ++i)
+            res.append(trigrama(p.constData() + i));
+    }
+    semRepeticao(res);
+    return res;
+}
+
+QVector<quint32> IndiceTrigramasAvaliadores::bigramas(const QString& chave)
+{
+    QVector<quint32> res;
+    for (const QString& palavra : IndiceTextoProjetos::termos(chave)) {
+        for (int i = 0; i + 2 <= palavra.size(); ++i)
+            res.append(bigrama(palavra.constData() + i));
+    }
+    semRepeticao(res);
+    return res;
+}
+
+void IndiceTrigramasAvaliadores::reconstruir(const QVector<Avaliador>& avaliadores)
+{
+    m_postagens.clear();
+    m_postagensBigramas.clear();
+    m_entradas.clear();
+    m_entradas.reserve(avaliadores.size());
+    for (const Avaliador& a : avaliadores)
+        indexar(a);
+}
+
+void IndiceTrigramasAvaliadores::indexar(const Avaliador& a)
+{
+    remover(a.id);
+
+    Entrada e;
+    e.chave[CampoNome]  = chaveBusca(a.nome);
+    e.chave[CampoEmail] = chaveBusca(a.email);
+    for (int campo = 0; campo < NumCampos; ++campo) {
+        const int chave = a.id * NumCampos + campo;
+        e.trigramas[campo] = trigramas(e.chave[campo]);
+        for (quint64 t : e.trigramas[campo])
+            m_postagens[t].append(chave);
+        e.bigramas[campo] = bigramas(e.chave[campo]);
+        for (quint32 b : e.bigramas[campo])
+            m_postagensBigramas[b].append(chave);
+    }
+    m_entradas.insert(a.id, e);
+}
+
+void IndiceTrigramasAvaliadores::remover(int idAvaliador)
+{
+    const auto it = m_entradas.find(idAvaliador);
+    if (it == m_entradas.end())
+        return;
+
+    const auto tirar = [](auto& postagens, const auto& gramas, int chave) {
+        for (const auto g : gramas) {
+            auto lista = postagens.find(g);
+            if (lista == postagens.end())
+                continue;
+            lista.value().removeOne(chave);
+            if (lista.value().isEmpty())
+                postagens.erase(lista);
+        }
+    };
+    for (int campo = 0; campo < NumCampos; ++campo) {
+        const int chave = idAvaliador * NumCampos + campo;
+        tirar(m_postagens, it.value().trigramas[campo], chave);
+        tirar(m_postagensBigramas, it.value().bigramas[campo], chave);
+    }
+    m_entradas.erase(it);
+}
+
+QVector<int> IndiceTrigramasAvaliadores::candidatosContendo(const QString& palavra) const
+{
+    // Um campo que contém 'palavra' tem todos os trigramas (ou bigramas)
+    // internos dela: basta a lista mais curta. Uma letra só não tem como
+    // ser filtrada, e aí o resultado é quase todo mundo de qualquer jeito.
+    if (palavra.size() < 2) {
+        QVector<int> todos;
+        todos.reserve(m_entradas.size() * NumCampos);
+        for (auto it = m_entradas.cbegin(); it != m_entradas.cend(); ++it)
+            for (int campo = 0; campo < NumCampos; ++campo)
+                todos.append(it.key() * NumCampos + campo);
+        return todos;
+    }
+
+    const QVector<int>* menor = nullptr;
+    const auto considerar = [&menor](const QVector<int>* lista) {
+        if (!menor || lista->size() < menor->size())
+            menor = lista;
+    };
+    if (palavra.size() == 2) {
+        const auto lista = m_postagensBigramas.constFind(bigrama(palavra.constData()));
+        if (lista == m_postagensBigramas.constEnd())
+            return {};
+        considerar(&lista.value());
+    } else {
+        for (int i = 0; i + 3 <= palavra.size(); ++i) {
+            const auto lista = m_postagens.constFind(trigrama(palavra.constData() + i));
+            if (lista == m_postagens.constEnd())
+                return {};
+            considerar(&lista.value());
+        }
+    }
+    return *menor;
+}
+
+QVector<int> IndiceTrigramasAvaliadores::buscar(const QString& consulta) const
+{
+    const QString procurado = chaveBusca(consulta.trimmed());
+    const QVector<quint64> daConsulta = trigramas(procurado);
+    if (daConsulta.isEmpty())
+        return {};
+
+    // id * NumCampos + campo -> trigramas em comum; só esses campos (e os
+    // que podem conter a consulta) são pontuados
+    QHash<int, int> comuns;
+    for (quint64 t : daConsulta) {
+        const auto lista = m_postagens.constFind(t);
+        if (lista == m_postagens.constEnd())
+            continue;
+        for (int chave : lista.value())
+            ++comuns[chave];
+    }
+
+    // Quem contém a consulta inteira entra mesmo com poucos trigramas em
+    // comum ("an" dentro de "Fernanda")
+    QString maisLonga;
+    for (const QString& palavra : IndiceTextoProjetos::termos(procurado)) {
+        if (palavra.size() > maisLonga.size())
+            maisLonga = palavra;
+    }
+    for (int chave : candidatosContendo(maisLonga)) {
+        if (!comuns.contains(chave))
+            comuns.insert(chave, 0);
+    }
+
+    QHash<int, double> pontos;   // id -> melhor campo
+    for (auto it = comuns.cbegin(); it != comuns.cend(); ++it) {
+        const int id    = it.key() / NumCampos;
+        const int campo = it.key() % NumCampos;
+        const auto entrada = m_entradas.constFind(id);
+        if (entrada == m_entradas.constEnd())
+            continue;
+        const Entrada& e = entrada.value();
+
+        const int emComum = it.value();
+        const double semelhanca = double(emComum) / daConsulta.size();
+        const bool contem = e.chave[campo].contains(procurado);
+        if (!contem && semelhanca < SemelhancaMinima)
+            continue;
+
+        double p = semelhanca
+                 + 0.1 * double(emComum) / std::max(1, int(e.trigramas[campo].size()));
+        if (contem)
+            p += 1.0;
+
+        double& melhor = pontos[id];
+        melhor = std::max(melhor, p);
+    }
+
+    QVector<QPair<double, int>> ordem;
+    ordem.reserve(pontos.size());
+    for (auto it = pontos.cbegin(); it != pontos.cend(); ++it)
+        ordem.append(qMakePair(-it.value(), it.key()));
+    std::sort(ordem.begin(), ordem.end());
+
+    QVector<int> ids;
+    ids.reserve(ordem.size());
+    for (const auto& par : ordem)
+        ids.append(par.second);
+    return ids;
+}
@@ -0,0 +1,99 @@
+// indicetexto.h
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+
+#include "registros.h"
+
+// ===== Índice invertido dos projetos =====
+//
+// Termo (chave de busca, ver chaveBusca()) -> projetos em que aparece, com
+// o peso do campo: nome vale mais que responsável, que vale mais que a
+// descrição. O dicionário é ordenado, então "proj" encontra "projeto",
+// "projetos"... com uma busca de intervalo.
+//
+//   buscar("robo sol") -> ids dos projetos que têm um termo começando com
+//                         "robo" E um começando com "sol", do mais
+//                         relevante para o menos
+//
+// Relevância: para cada termo da consulta, o melhor termo do projeto que
+// casa com ele (peso do campo x raridade do termo; prefixo vale metade do
+// termo inteiro), somado entre os termos da consulta.
+class IndiceTextoProjetos
+{
+public:
+    void reconstruir(const QVector<Projeto>& projetos);
+
+    // Substitui o que havia indexado para p.id
+    void indexar(const Projeto& p);
+    void remover(int idProjeto);
+
+    QVector<int> buscar(const QString& consulta) const;
+
+    // Termos de busca de um texto ("Robô-Solar 2" -> robo, solar, 2)
+    static QStringList termos(const QString& texto);
+
+private:
+    struct Ocorrencia {
+        int   idProjeto;
+        float peso;
+    };
+
+    QMap<QString, QVector<Ocorrencia>> m_termos;
+    QHash<int, QStringList>            m_termosDoProjeto;
+};
+
+// ===== Índice de trigramas dos avaliadores =====
+//
+// Busca tolerante a erro de digitação em nome e e-mail: cada palavra vira
+// trigramas com espaço nas pontas ("silmara" -> "  s", " si", "sil", ...,
+// "ra ") e um avaliador entra no resultado quando tem pelo menos metade
+// dos trigramas da consulta num dos campos, ou quando o campo contém a
+// consulta inteira. Assim "Silmra" ainda encontra "Silmara" (5 de 7
+// trigramas em comum).
+//
+// Só são pontuados os campos das listas de postagem dos trigramas da
+// consulta; para achar quem contém a consulta, a lista mais curta entre os
+// trigramas (ou bigramas, numa palavra de duas letras) da palavra mais
+// longa dela.
+//
+// Relevância: fração dos trigramas da consulta presentes no campo, com um
+// bônus quando o campo contém a consulta inteira e um desempate a favor
+// do campo mais curto (menos trigramas sobrando).
+class IndiceTrigramasAvaliadores
+{
+public:
+    static constexpr double SemelhancaMinima = 0.5;
+
+    void reconstruir(const QVector<Avaliador>& avaliadores);
+
+    // Substitui o que havia indexado para a.id
+    void indexar(const Avaliador& a);
+    void remover(int idAvaliador);
+
+    QVector<int> buscar(const QString& consulta) const;
+
+private:
+    enum Campo { CampoNome, CampoEmail, NumCampos };
+
+    struct Entrada {
+        QString          chave[NumCampos];       // chaveBusca() do campo
+        QVector<quint64> trigramas[NumCampos];   // sem repetição
+        QVector<quint32> bigramas[NumCampos];    // sem espaço nas pontas
+    };
+
+    // trigrama/bigrama -> id * NumCampos + campo
+    QHash<quint64, QVector<int>> m_postagens;
+    QHash<quint32, QVector<int>> m_postagensBigramas;
+    QHash<int, Entrada>          m_entradas;
+
+    static QVector<quint64> trigramas(const QString& chave);
+    static QVector<quint32> bigramas(const QString& chave);
+
+    // Chaves (id * NumCampos + campo) que podem conter 'palavra' inteira
+    QVector<int> candidatosContendo(const QString& palavra) const;
+};
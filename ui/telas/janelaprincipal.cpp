@@ -4,11 +4,16 @@
 #include <QStackedWidget>
 #include <QToolBar>
 #include <QAction>
+#include <QStatusBar>
+#include <QStringList>
+#include <QApplication>
+#include <QEvent>
 
 #include "paginaprojetos.h"
 #include "paginaavaliadores.h"
 #include "paginafichas.h"
 #include "paginanotas.h"
+#include "repositorio.h"
 
 JanelaPrincipal::JanelaPrincipal(QWidget *parent)
     : QMainWindow(parent)
@@ -24,19 +29,57 @@ JanelaPrincipal::JanelaPrincipal(QWidget *parent)
         setCentralWidget(m_stack);
     }
 
-    // Páginas
-    m_pagProjetos    = new PaginaProjetos(this);
-    m_pagAvaliadores = new PaginaAvaliadores(this);
-    m_pagFichas      = new PaginaFichas(this);
-    m_pagNotas       = new PaginaNotas(this);
-
-    m_stack->addWidget(m_pagProjetos);
-    m_stack->addWidget(m_pagAvaliadores);
-    m_stack->addWidget(m_pagFichas);
-    m_stack->addWidget(m_pagNotas);
+    // Páginas: criadas na primeira visita (ver paginaProjetos()...)
 
     criarToolbar();
-    irProjetos(); // padrão para admin; depois o login ajusta
+    // A primeira página mostrada vem de configurarPorLogin()
+
+    m_relogio.start();
+    qApp->installEventFilter(this);
+
+    // Destruir uma página trava a janela um instante: só com ela ociosa
+    m_liberacao.setInterval(60 * 1000);
+    connect(&m_liberacao, &QTimer::timeout, this, [this] {
+        if (ociosaHaMs() >= OciosaMs)
+            liberarPaginasInativas(InatividadeMs);
+    });
+    m_liberacao.start();
+
+    // Dados ainda chegando (carga em segundo plano): as tabelas já aparecem
+    // e vão sendo preenchidas, mas sem edição até terminar
+    auto& repo = Repositorio::instancia();
+
+    // Gravação adiada que falhou fica na fila: avisa até dar certo
+    connect(&repo, &Repositorio::gravacaoConcluida, this,
+            [this](const QString& colecao, bool ok) {
+        if (!ok) {
+            m_gravacoesFalhando.insert(colecao);
+        } else if (m_gravacoesFalhando.remove(colecao) && m_gravacoesFalhando.isEmpty()) {
+            statusBar()->showMessage("Alterações gravadas.", 5000);
+            return;
+        }
+        if (!m_gravacoesFalhando.isEmpty()) {
+            QStringList colecoes = m_gravacoesFalhando.values();
+            colecoes.sort();
+            statusBar()->showMessage("Não gravado (nova tentativa em instantes): "
+                                     + colecoes.join(", "));
+        }
+    });
+
+    // Conflito com outra estação (pode vir de dentro da gravação adiada:
+    // barra de status em vez de janela)
+    connect(&repo, &Repositorio::gravacaoRecusada, this, [this](const QString& mensagem) {
+        statusBar()->showMessage(mensagem.simplified(), 15000);
+    });
+
+    if (repo.carregando()) {
+        m_stack->setEnabled(false);
+        statusBar()->showMessage("Carregando dados...");
+        connect(&repo, &Repositorio::carregamentoConcluido, this, [this] {
+            m_stack->setEnabled(true);
+            statusBar()->clearMessage();
+        });
+    }
 }
 
 JanelaPrincipal::~JanelaPrincipal()
@@ -61,30 +104,136 @@ void JanelaPrincipal::criarToolbar()
     connect(m_actNotas,       &QAction::triggered, this, &JanelaPrincipal::irNotas);
 }
 
+// ================== PÁGINAS SOB DEMANDA ==================
+
+namespace {
+
+template <typename P>
+P* garantirPagina(P*& pagina, QStackedWidget* stack, QWidget* pai)
+{
+    if (!pagina) {
+        pagina = new P(pai);
+        stack->addWidget(pagina);
+    }
+    return pagina;
+}
+
+} // namespace
+
+PaginaProjetos* JanelaPrincipal::paginaProjetos()
+{
+    return garantirPagina(m_pagProjetos, m_stack, this);
+}
+
+PaginaAvaliadores* JanelaPrincipal::paginaAvaliadores()
+{
+    return garantirPagina(m_pagAvaliadores, m_stack, this);
+}
+
+PaginaFichas* JanelaPrincipal::paginaFichas()
+{
+    return garantirPagina(m_pagFichas, m_stack, this);
+}
+
+PaginaNotas* JanelaPrincipal::paginaNotas()
+{
+    const bool nova = !m_pagNotas;
+    garantirPagina(m_pagNotas, m_stack, this);
+    if (nova)
+        m_pagNotas->setAvaliador(m_cpf, m_nome, m_curso);
+    return m_pagNotas;
+}
+
 void JanelaPrincipal::trocarPagina(QWidget *pagina)
 {
     if (!m_stack || !pagina) return;
+
+    if (QWidget* atual = m_stack->currentWidget(); atual && atual != pagina)
+        m_saiuEm.insert(atual, m_relogio.elapsed());
+    m_saiuEm.remove(pagina);
     m_stack->setCurrentWidget(pagina);
 }
 
 void JanelaPrincipal::irProjetos()
 {
-    trocarPagina(m_pagProjetos);
+    trocarPagina(paginaProjetos());
 }
 
 void JanelaPrincipal::irAvaliadores()
 {
-    trocarPagina(m_pagAvaliadores);
+    trocarPagina(paginaAvaliadores());
 }
 
 void JanelaPrincipal::irFichas()
 {
-    trocarPagina(m_pagFichas);
+    trocarPagina(paginaFichas());
 }
 
 void JanelaPrincipal::irNotas()
 {
-    trocarPagina(m_pagNotas);
+    trocarPagina(paginaNotas());
+}
+
+bool JanelaPrincipal::eventFilter(QObject* alvo, QEvent* evento)
+{
+    switch (evento->type()) {
+    case QEvent::KeyPress:
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseMove:
+    case QEvent::Wheel:
+        m_ultimaEntrada = m_relogio.elapsed();
+        break;
+    default:
+        break;
+    }
+    return QMainWindow::eventFilter(alvo, evento);
+}
+
+// Uma página por vez, só com a janela ociosa
+void JanelaPrincipal::preaquecerProxima()
+{
+    if (!m_preaquecer)
+        return;
+
+    // Usuário mexendo: tenta de novo quando completar OciosaMs parado
+    if (const qint64 ociosa = ociosaHaMs(); ociosa < OciosaMs) {
+        QTimer::singleShot(int(OciosaMs - ociosa), this, &JanelaPrincipal::preaquecerProxima);
+        return;
+    }
+
+    QWidget* criada = nullptr;
+    if (m_admin && !m_pagProjetos)         criada = paginaProjetos();
+    else if (m_admin && !m_pagAvaliadores) criada = paginaAvaliadores();
+    else if (!m_pagFichas)                 criada = paginaFichas();
+    else if (!m_pagNotas)                  criada = paginaNotas();
+    else return;
+
+    // Nunca foi a atual: o tempo sem uso conta a partir de agora, senão
+    // liberarPaginasInativas() não a encontraria
+    m_saiuEm.insert(criada, m_relogio.elapsed());
+
+    // Timer de 0 ms só dispara com a fila de eventos vazia
+    QTimer::singleShot(0, this, &JanelaPrincipal::preaquecerProxima);
+}
+
+void JanelaPrincipal::liberarPaginasInativas(qint64 inativasHaMs)
+{
+    const qint64 agora = m_relogio.elapsed();
+    const auto liberar = [&](auto*& pagina) {
+        if (!pagina || pagina == m_stack->currentWidget())
+            return;
+        const auto it = m_saiuEm.constFind(pagina);
+        if (it == m_saiuEm.constEnd() || agora - it.value() < inativasHaMs)
+            return;
+        m_saiuEm.erase(it);
+        delete pagina; // sai do stack junto
+        pagina = nullptr;
+    };
+
+    liberar(m_pagProjetos);
+    liberar(m_pagAvaliadores);
+    liberar(m_pagFichas);
+    liberar(m_pagNotas);
 }
 
 void JanelaPrincipal::configurarPorLogin(bool admin,
@@ -93,6 +242,9 @@ void JanelaPrincipal::configurarPorLogin(bool admin,
                                          const QString& curso)
 {
     m_admin = admin;
+    m_cpf   = admin ? QString() : cpf;
+    m_nome  = admin ? QString() : nome;
+    m_curso = admin ? QString() : curso;
 
     // Admin vê tudo; avaliador não vê Projetos/Avaliadores
     if (m_actProjetos)    m_actProjetos->setVisible(admin);
@@ -100,17 +252,19 @@ void JanelaPrincipal::configurarPorLogin(bool admin,
     if (m_actFichas)      m_actFichas->setVisible(true);
     if (m_actNotas)       m_actNotas->setVisible(true);
 
+    // PaginaNotas recebe o contexto ao ser criada; se já existe, agora
+    if (m_pagNotas)
+        m_pagNotas->setAvaliador(m_cpf, m_nome, m_curso);
+
     if (!admin) {
-        // MODO AVALIADOR: restringir visão e informar contexto à PaginaNotas
-        if (m_pagNotas) {
-            m_pagNotas->setAvaliador(cpf, nome, curso);
-        }
+        // MODO AVALIADOR: restringir visão; Projetos/Avaliadores nem são criadas
         irNotas();
     } else {
         // MODO ADMIN: PaginaNotas em modo administrativo (sem avaliador)
-        if (m_pagNotas) {
-            m_pagNotas->setAvaliador(QString(), QString(), QString());
-        }
         irProjetos();
     }
+
+    // O login conta como entrada: o preaquecimento espera OciosaMs parado
+    m_ultimaEntrada = m_relogio.elapsed();
+    QTimer::singleShot(OciosaMs, this, &JanelaPrincipal::preaquecerProxima);
 }
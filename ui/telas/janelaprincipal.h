@@ -1,6 +1,10 @@
 #pragma once
 
 #include <QMainWindow>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
 
 class QStackedWidget;
 class QToolBar;
@@ -15,11 +19,24 @@ namespace Ui {
 class JanelaPrincipal;
 }
 
+// As páginas são criadas na primeira visita (irProjetos()...): o avaliador
+// não paga pelas páginas de Projetos/Avaliadores que nem vê. Depois do
+// login, as demais páginas visíveis são criadas aos poucos com a janela
+// ociosa, e uma página que fica muito tempo sem uso é destruída (os dados
+// continuam no Repositorio; a página é refeita se for visitada de novo).
+//
+// "Ociosa" = nenhuma tecla, clique, movimento ou roda do mouse na aplicação
+// há OciosaMs (filtro de eventos no qApp) e a fila de eventos vazia (timer
+// de 0 ms). O Qt não avisa de pouca memória de forma portável, então a
+// liberação é por tempo sem uso, e também só com a janela ociosa.
 class JanelaPrincipal : public QMainWindow
 {
     Q_OBJECT
 
 public:
+    static constexpr int OciosaMs      = 1000;   // sem entrada do usuário
+    static constexpr int InatividadeMs = 10 * 60 * 1000;
+
     explicit JanelaPrincipal(QWidget *parent = nullptr);
     ~JanelaPrincipal();
 
@@ -30,6 +47,17 @@ public:
                             const QString& nome  = QString(),
                             const QString& curso = QString());
 
+    // Cria com a janela ociosa as páginas ainda não visitadas (padrão: sim)
+    void definirPreaquecimento(bool ativo) { m_preaquecer = ativo; }
+
+    // Destrói as páginas fora de uso há mais de 'inativasHaMs'
+    // (0 = todas menos a atual)
+    void liberarPaginasInativas(qint64 inativasHaMs = 0);
+
+protected:
+    // Marca a hora da última entrada do usuário (teclado/mouse)
+    bool eventFilter(QObject* alvo, QEvent* evento) override;
+
 private slots:
     void irProjetos();
     void irAvaliadores();
@@ -52,7 +80,24 @@ private:
     PaginaNotas*       m_pagNotas{};
 
     bool m_admin{false};
+    QString m_cpf, m_nome, m_curso;    // contexto do avaliador (PaginaNotas)
+
+    bool   m_preaquecer{true};
+    QTimer m_liberacao;
+    QElapsedTimer m_relogio;
+    qint64 m_ultimaEntrada{0};         // m_relogio na última tecla/clique
+    QHash<QWidget*, qint64> m_saiuEm;  // página -> quando deixou de ser a atual
+
+    QSet<QString> m_gravacoesFalhando; // coleções com gravação na fila
+
+    // Página pronta para uso (cria na primeira chamada)
+    PaginaProjetos*    paginaProjetos();
+    PaginaAvaliadores* paginaAvaliadores();
+    PaginaFichas*      paginaFichas();
+    PaginaNotas*       paginaNotas();
 
     void criarToolbar();
     void trocarPagina(QWidget* pagina);
+    void preaquecerProxima();
+    qint64 ociosaHaMs() const { return m_relogio.elapsed() - m_ultimaEntrada; }
 };
@@ -0,0 +1,394 @@
+// journalnotas.cpp
+#include "journalnotas.h"
+#include "vinculos.h"
+#include "leitorcsv.h"
+#include "gravacaoagrupada.h"
+#include "travaarquivo.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QHash>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+// ================== CONVERSÃO ==================
+
+QString notaParaLinha(const Nota& n)
+{
+    // QString::number(double) usa o mesmo formato padrão do QTextStream
+    // ('g', 6), então o arquivo fica idêntico ao gravado antes do journal.
+    return QString::number(n.idNota) + ';'
+         + QString::number(n.idProjeto) + ';'
+         + n.cpfAvaliador + ';'            // já está normalizado
+         + n.nomeAvaliador + ';'
+         + QString::number(n.notaFinal) + ';'
+         + QString::number(n.idFicha) + ';'
+         + QString::number(n.versao);
+}
+
+bool linhaParaNota(const LeitorCsv& csv, int primeiro, Nota& n)
+{
+    if (csv.numCampos() - primeiro < 5)
+        return false;
+
+    n.idNota        = csv[primeiro + 0].toInt();
+    n.idProjeto     = csv[primeiro + 1].toInt();
+    n.cpfAvaliador  = normalizarCpf(csv[primeiro + 2].toStringTrimmed());
+    n.nomeAvaliador = csv[primeiro + 3].toStringTrimmed();
+    n.notaFinal     = csv[primeiro + 4].toDouble();
+    n.idFicha       = (csv.numCampos() - primeiro >= 6) ? csv[primeiro + 5].toInt() : 0;
+    n.versao        = (csv.numCampos() - primeiro >= 7) ? csv[primeiro + 6].toInt() : 0;
+    return true;
+}
+
+// ================== HELPERS ==================
+
+namespace {
+
+// Aplica um arquivo de journal sobre o estado já carregado.
+// 'posicao' mapeia idNota -> índice em 'notas'; 'viva' marca as removidas.
+int reaplicarJournal(const QString& arquivo,
+                     QVector<Nota>& notas,
+                     QVector<bool>& viva,
+                     QHash<int, int>& posicao)
+{
+    if (!QFile::exists(arquivo))
+        return 0;
+
+    LeitorCsv csv(arquivo);
+    if (!csv.abrir())
+        return 0;
+
+    int registros = 0;
+    while (csv.proximaLinha()) {
+        if (!csv.linhaCompleta() || csv.numCampos() < 2)
+            continue; // registro truncado (queda no meio da escrita)
+
+        if (csv[0] == "+") {
+            Nota n;
+            if (!linhaParaNota(csv, 1, n))
+                continue;
+
+            const auto it = posicao.constFind(n.idNota);
+            if (it != posicao.constEnd() && viva[it.value()]) {
+                notas[it.value()] = n;
+            } else {
+                posicao.insert(n.idNota, notas.size());
+                notas.append(n);
+                viva.append(true);
+            }
+        } else if (csv[0] == "-") {
+            bool ok = false;
+            const int idNota = csv[1].toInt(&ok);
+            if (!ok)
+                continue;
+
+            const auto it = posicao.constFind(idNota);
+            if (it != posicao.constEnd())
+                viva[it.value()] = false;
+            posicao.remove(idNota);
+        } else {
+            continue;
+        }
+        ++registros;
+    }
+    return registros;
+}
+
+// Estado do disco: snapshot, .1 e (se pedido) o journal atual.
+// Chamar com a trava do notas.csv.
+bool lerDoDisco(const QString& arquivo, bool incluirJournal,
+                QVector<Nota>& notas, int* registrosJournal = nullptr)
+{
+    notas.clear();
+    QVector<bool>   viva;
+    QHash<int, int> posicao;
+
+    if (QFile::exists(arquivo)) {
+        LeitorCsv csv(arquivo);
+        if (!csv.abrir())
+            return false;
+
+        while (csv.proximaLinha()) {
+            if (csv.linhaEmBranco()) continue;
+
+            Nota n;
+            if (!linhaParaNota(csv, 0, n))
+                continue;
+
+            posicao.insert(n.idNota, notas.size());
+            notas.append(n);
+            viva.append(true);
+        }
+    }
+
+    // .1 = journal de uma compactação que não terminou
+    const QString journal = arquivo + ".journal";
+    reaplicarJournal(journal + ".1", notas, viva, posicao);
+    const int registros = incluirJournal ? reaplicarJournal(journal, notas, viva, posicao) : 0;
+    if (registrosJournal)
+        *registrosJournal = registros;
+
+    if (viva.contains(false)) {
+        QVector<Nota> restantes;
+        restantes.reserve(posicao.size());
+        for (int i = 0; i < notas.size(); ++i) {
+            if (viva[i])
+                restantes.append(notas[i]);
+        }
+        notas.swap(restantes);
+    }
+    return true;
+}
+
+// Roda na thread de trabalho: não mostra mensagens, só devolve o resultado.
+// QSaveFile grava num temporário e só troca o arquivo no commit.
+bool gravarSnapshot(const QString& arquivo, const QVector<Nota>& notas)
+{
+    QSaveFile f(arquivo);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Text))
+        return false;
+
+    QTextStream out(&f);
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+    out.setCodec("UTF-8");
+#endif
+    for (const Nota& n : notas)
+        out << notaParaLinha(n) << '\n';
+    out.flush();
+    if (out.status() != QTextStream::Ok) {
+        f.cancelWriting();
+        return false;
+    }
+    return f.commit();
+}
+
+QString chaveNota(int idProjeto, const QString& cpf)
+{
+    return QString::number(idProjeto) + ';' + cpf;
+}
+
+} // namespace
+
+// ================== JOURNAL ==================
+
+JournalNotas::JournalNotas(const QString& arquivoSnapshot)
+    : m_arquivo(arquivoSnapshot)
+{
+}
+
+JournalNotas::~JournalNotas()
+{
+    descarregar();
+    aguardarCompactacao();
+}
+
+void JournalNotas::aguardarCompactacao()
+{
+    m_compactacao.waitForFinished();
+}
+
+bool JournalNotas::carregar(QVector<Nota>& notas)
+{
+    descarregar();
+    aguardarCompactacao();
+
+    TravaArquivo trava(m_arquivo);
+    if (!trava.travada())
+        return false;
+
+    if (!lerDoDisco(m_arquivo, true, notas, &m_registros))
+        return false;
+    m_tamanhoJournal = QFileInfo(arquivoJournal()).size();
+    return true;
+}
+
+bool JournalNotas::substituir(const QVector<Nota>& notas)
+{
+    aguardarCompactacao();
+
+    TravaArquivo trava(m_arquivo);
+    if (!trava.travada() || !gravarSnapshot(m_arquivo, notas))
+        return false;
+
+    QFile::remove(arquivoJournal() + ".1");
+    QFile::remove(arquivoJournal());
+    m_pendentes.clear();
+    m_registros = 0;
+    m_tamanhoJournal = 0;
+    return true;
+}
+
+void JournalNotas::registrarGravacao(const Nota& n)
+{
+    Registro r;
+    r.nota = n;
+    m_pendentes.append(r);
+}
+
+void JournalNotas::registrarRemocao(int idNota)
+{
+    Registro r;
+    r.remocao = true;
+    r.nota.idNota = idNota;
+    m_pendentes.append(r);
+}
+
+bool JournalNotas::descarregar()
+{
+    m_conflitos.clear();
+    m_alteracaoExterna = false;
+    if (m_pendentes.isEmpty())
+        return true;
+
+    TravaArquivo trava(m_arquivo);
+    if (!trava.travada())
+        return false;
+
+    // Outra estação acrescentou (ou girou o journal) desde a nossa última vez
+    const QString journal = arquivoJournal();
+    m_alteracaoExterna = QFileInfo(journal).size() != m_tamanhoJournal;
+
+    QVector<Nota> disco;
+    int registros = 0;
+    if (!lerDoDisco(m_arquivo, true, disco, &registros))
+        return false;
+
+    QHash<int, int>     posicao;   // idNota -> índice em 'disco'
+    QHash<QString, int> porChave;  // projeto;cpf -> idNota
+    int maxId = 0;
+    for (int i = 0; i < disco.size(); ++i) {
+        posicao.insert(disco[i].idNota, i);
+        porChave.insert(chaveNota(disco[i].idProjeto, disco[i].cpfAvaliador), disco[i].idNota);
+        maxId = std::max(maxId, disco[i].idNota);
+    }
+    for (const Registro& r : m_pendentes)
+        maxId = std::max(maxId, r.nota.idNota);
+
+    QHash<int, int> novoId;        // id local -> id atribuído aqui
+    QStringList linhas;
+
+    for (const Registro& r : m_pendentes) {
+        const int id = novoId.value(r.nota.idNota, r.nota.idNota);
+
+        if (r.remocao) {
+            // Remoção não confere versão: apagar sempre vence
+            const auto it = posicao.constFind(id);
+            if (it != posicao.constEnd()) {
+                const Nota& d = disco[it.value()];
+                porChave.remove(chaveNota(d.idProjeto, d.cpfAvaliador));
+                posicao.remove(id);
+            }
+            linhas << "-;" + QString::number(id);
+            continue;
+        }
+
+        Nota n = r.nota;
+        n.idNota = id;
+        const QString chave = chaveNota(n.idProjeto, n.cpfAvaliador);
+
+        int atual = posicao.value(n.idNota, -1);
+        const auto mesmaNota = [&](int i) {
+            return disco[i].idProjeto == n.idProjeto && disco[i].cpfAvaliador == n.cpfAvaliador;
+        };
+
+        // Duas estações criaram notas diferentes com o mesmo id
+        if (atual >= 0 && !mesmaNota(atual) && n.versao == 1 && !porChave.contains(chave)) {
+            n.idNota = ++maxId;
+            novoId.insert(r.nota.idNota, n.idNota);
+            atual = -1;
+            m_alteracaoExterna = true;
+        }
+
+        const int idDaChave = porChave.value(chave, -1);
+        const bool conflito = (atual >= 0)
+            ? (!mesmaNota(atual) || disco[atual].versao != n.versao - 1)
+            : (n.versao > 1 || (idDaChave >= 0 && idDaChave != n.idNota));
+        if (conflito) {
+            m_conflitos << r.nota.idNota;
+            m_alteracaoExterna = true;
+            continue;
+        }
+
+        if (atual >= 0) {
+            disco[atual] = n;
+        } else {
+            posicao.insert(n.idNota, disco.size());
+            disco.append(n);
+        }
+        porChave.insert(chave, n.idNota);
+        linhas << "+;" + notaParaLinha(n);
+    }
+
+    if (!linhas.isEmpty()) {
+        QFile f(journal);
+        if (!f.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+            return false;
+
+        QTextStream out(&f);
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+        out.setCodec("UTF-8");
+#endif
+        for (const QString& registro : linhas)
+            out << registro << '\n';
+        out.flush();
+        if (out.status() != QTextStream::Ok || !sincronizarNoDisco(f))
+            return false;
+    }
+
+    m_pendentes.clear();
+    m_registros = registros + linhas.size();
+    m_tamanhoJournal = QFileInfo(journal).size();
+    return true;
+}
+
+void JournalNotas::compactarEmSegundoPlano()
+{
+    if (m_compactacao.isRunning() || !descarregar())
+        return;
+
+    const QString journal  = arquivoJournal();
+    const QString anterior = journal + ".1";
+
+    {
+        TravaArquivo trava(m_arquivo);
+        if (!trava.travada())
+            return;
+
+        if (QFile::exists(anterior)) {
+            // Sobrou um .1 de uma compactação anterior: junta o journal atual
+            // a ele para não perder a ordem dos registros.
+            QFile origem(journal);
+            QFile destino(anterior);
+            if (!origem.open(QIODevice::ReadOnly)
+                || !destino.open(QIODevice::WriteOnly | QIODevice::Append))
+                return;
+            if (destino.write(origem.readAll()) < 0)
+                return;
+            destino.close();
+            origem.close();
+            QFile::remove(journal);
+        } else if (QFile::exists(journal) && !QFile::rename(journal, anterior)) {
+            return;
+        }
+
+        m_registros = 0;
+        m_tamanhoJournal = 0;
+    }
+
+    // O snapshot novo sai do disco (snapshot + .1), não da memória desta
+    // estação: assim entram também as notas gravadas pelas outras.
+    const QString arquivo = m_arquivo;
+    m_compactacao = QtConcurrent::run([arquivo, anterior]() {
+        TravaArquivo trava(arquivo);
+        if (!trava.travada())
+            return; // fica o .1; a próxima carga ou compactação resolve
+
+        QVector<Nota> notas;
+        if (lerDoDisco(arquivo, false, notas) && gravarSnapshot(arquivo, notas))
+            QFile::remove(anterior);
+    });
+}
@@ -0,0 +1,95 @@
+// journalnotas.h
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+#include <QFuture>
+
+#include "registros.h"
+
+class LeitorCsv;
+
+// Conversão Nota <-> linha do notas.csv
+// Formato: idNota;idProjeto;cpfAvaliador;nomeAvaliador;notaFinal;idFicha;versao
+// 'primeiro' é o índice do campo idNota na linha lida (1 nos registros do journal)
+QString notaParaLinha(const Nota& n);
+bool    linhaParaNota(const LeitorCsv& csv, int primeiro, Nota& n);
+
+// ===== Journal de notas =====
+//
+// Em vez de reescrever o notas.csv a cada alteração, cada mutação vira uma
+// linha acrescentada em "notas.csv.journal" (acumuladas em memória até
+// descarregar(), que faz um único append + fsync):
+//
+//   +;<linha da nota>   -> insere/atualiza a nota (por idNota)
+//   -;<idNota>          -> remove a nota
+//
+// Quando o journal passa de LimiteRegistros, ele é renomeado para
+// "notas.csv.journal.1" e um snapshot completo é gravado em segundo plano
+// (arquivo temporário + rename). O .1 só é apagado depois que o snapshot
+// novo está no lugar, então a carga é sempre: snapshot, .1 (se existir) e
+// journal, nessa ordem. Reaplicar um registro já contido no snapshot não
+// muda o resultado.
+//
+// Várias estações podem gravar no mesmo journal: todo acesso ao disco é
+// feito com a trava "notas.csv.lock" (TravaArquivo). Antes do append,
+// descarregar() relê o estado do disco e confere a versão de cada nota
+// gravada; a que foi alterada por outra estação desde a última carga é
+// recusada (conflitos()). Nota nova cujo id já foi usado por outra estação
+// ganha o próximo id livre. Nos dois casos houveAlteracaoExterna() pede que
+// a memória seja recarregada.
+class JournalNotas
+{
+public:
+    static constexpr int LimiteRegistros = 1000;
+
+    explicit JournalNotas(const QString& arquivoSnapshot);
+    ~JournalNotas();
+
+    JournalNotas(const JournalNotas&) = delete;
+    JournalNotas& operator=(const JournalNotas&) = delete;
+
+    // Snapshot + journal, no formato atual do notas.csv
+    bool carregar(QVector<Nota>& notas);
+
+    void registrarGravacao(const Nota& n);
+    void registrarRemocao(int idNota);
+
+    // Grava os registros acumulados no journal
+    bool descarregar();
+
+    // Resultado do último descarregar()
+    const QList<int>& conflitos() const { return m_conflitos; }
+    bool houveAlteracaoExterna() const { return m_alteracaoExterna; }
+
+    bool precisaCompactar() const { return m_registros >= LimiteRegistros; }
+
+    // Gira o journal e grava o snapshot novo (snapshot + .1 relidos do
+    // disco, com a trava) numa thread de trabalho
+    void compactarEmSegundoPlano();
+
+    // Grava 'notas' como snapshot agora e descarta o journal
+    // (usado pela exportação de outro backend)
+    bool substituir(const QVector<Nota>& notas);
+
+    // Espera a compactação em andamento (se houver)
+    void aguardarCompactacao();
+
+    QString arquivoJournal() const { return m_arquivo + ".journal"; }
+
+private:
+    struct Registro {
+        bool remocao{false};
+        Nota nota;            // remoção: só nota.idNota
+    };
+
+    QString           m_arquivo;
+    int               m_registros{0};     // registros no journal do disco
+    qint64            m_tamanhoJournal{0}; // tamanho após a última leitura/append nossa
+    QVector<Registro> m_pendentes;
+    QList<int>        m_conflitos;
+    bool              m_alteracaoExterna{false};
+    QFuture<void>     m_compactacao;
+};
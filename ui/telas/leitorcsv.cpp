@@ -0,0 +1,169 @@
+// leitorcsv.cpp
+#include "leitorcsv.h"
+
+#include <climits>
+#include <cstring>
+
+namespace {
+
+bool ehEspaco(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+CampoCsv aparado(CampoCsv c)
+{
+    while (c.tamanho > 0 && ehEspaco(c.dados[0])) {
+        ++c.dados;
+        --c.tamanho;
+    }
+    while (c.tamanho > 0 && ehEspaco(c.dados[c.tamanho - 1]))
+        --c.tamanho;
+    return c;
+}
+
+} // namespace
+
+// ================== CAMPO ==================
+
+bool CampoCsv::emBranco() const
+{
+    return aparado(*this).vazio();
+}
+
+QString CampoCsv::toStringTrimmed() const
+{
+    const CampoCsv c = aparado(*this);
+    return QString::fromUtf8(c.dados, c.tamanho);
+}
+
+int CampoCsv::toInt(bool* ok) const
+{
+    // Mesmo comportamento de QString::toInt(): ignora espaços nas pontas,
+    // aceita sinal e devolve 0 em caso de erro.
+    const CampoCsv c = aparado(*this);
+    if (ok) *ok = false;
+    if (c.tamanho == 0)
+        return 0;
+
+    int i = 0;
+    bool negativo = false;
+    if (c.dados[0] == '-' || c.dados[0] == '+') {
+        negativo = (c.dados[0] == '-');
+        ++i;
+    }
+    if (i == c.tamanho)
+        return 0;
+
+    qint64 valor = 0;
+    for (; i < c.tamanho; ++i) {
+        const char ch = c.dados[i];
+        if (ch < '0' || ch > '9')
+            return 0;
+        valor = valor * 10 + (ch - '0');
+        if (valor > qint64(INT_MAX) + 1)
+            return 0;
+    }
+    if (negativo)
+        valor = -valor;
+    if (valor < INT_MIN || valor > INT_MAX)
+        return 0;
+
+    if (ok) *ok = true;
+    return int(valor);
+}
+
+double CampoCsv::toDouble(bool* ok) const
+{
+    // fromRawData não copia; QByteArray::toDouble ignora espaços nas pontas
+    return QByteArray::fromRawData(dados, tamanho).toDouble(ok);
+}
+
+bool CampoCsv::operator==(const char* s) const
+{
+    const int n = int(std::strlen(s));
+    return n == tamanho && std::memcmp(dados, s, size_t(n)) == 0;
+}
+
+// ================== LEITOR ==================
+
+LeitorCsv::LeitorCsv(const QString& arquivo)
+    : m_file(arquivo)
+{
+}
+
+LeitorCsv::LeitorCsv(const QByteArray& dados)
+    : m_fallback(dados)
+    , m_emMemoria(true)
+{
+}
+
+LeitorCsv::~LeitorCsv()
+{
+    if (m_mapa)
+        m_file.unmap(m_mapa);
+}
+
+bool LeitorCsv::abrir()
+{
+    if (m_emMemoria) {
+        m_inicio = m_pos = m_fallback.constData();
+        m_fim = m_pos + m_fallback.size();
+    } else {
+        if (!m_file.open(QIODevice::ReadOnly))
+            return false;
+
+        const qint64 tamanho = m_file.size();
+        if (tamanho <= 0)
+            return true; // arquivo vazio: nenhuma linha
+
+        m_mapa = m_file.map(0, tamanho);
+        if (m_mapa) {
+            m_pos = reinterpret_cast<const char*>(m_mapa);
+            m_fim = m_pos + tamanho;
+        } else {
+            // Sistemas de arquivos sem suporte a mmap: lê tudo de uma vez.
+            // O limite é o que foi lido de fato: o arquivo pode ter sido
+            // truncado depois do size().
+            m_fallback = m_file.readAll();
+            m_pos = m_fallback.constData();
+            m_fim = m_pos + m_fallback.size();
+        }
+        m_inicio = m_pos;
+    }
+
+    // Pula o BOM UTF-8, se houver
+    if (m_fim - m_pos >= 3 && std::memcmp(m_pos, "\xEF\xBB\xBF", 3) == 0)
+        m_pos += 3;
+
+    return true;
+}
+
+bool LeitorCsv::proximaLinha()
+{
+    m_campos.clear();
+    if (!m_pos || m_pos >= m_fim)
+        return false;
+
+    const char* ini = m_pos;
+    const char* nl  = static_cast<const char*>(std::memchr(ini, '\n', size_t(m_fim - ini)));
+    const char* fimLinha = nl ? nl : m_fim;
+    m_pos = nl ? nl + 1 : m_fim;
+    m_linhaCompleta = (nl != nullptr);
+
+    // Arquivos gravados no Windows: "\r\n"
+    if (fimLinha > ini && fimLinha[-1] == '\r')
+        --fimLinha;
+
+    m_linha = CampoCsv{ini, int(fimLinha - ini)};
+
+    const char* campo = ini;
+    for (const char* p = ini; p < fimLinha; ++p) {
+        if (*p == ';') {
+            m_campos.append(CampoCsv{campo, int(p - campo)});
+            campo = p + 1;
+        }
+    }
+    m_campos.append(CampoCsv{campo, int(fimLinha - campo)});
+    return true;
+}
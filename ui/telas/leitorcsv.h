@@ -0,0 +1,87 @@
+// leitorcsv.h
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+#include <QVarLengthArray>
+
+// ===== Campo de uma linha =====
+//
+// Visão sobre os bytes UTF-8 do arquivo mapeado; nada é alocado até o campo
+// ser convertido. Só é válida enquanto o LeitorCsv que a gerou estiver vivo.
+struct CampoCsv {
+    const char* dados{nullptr};
+    int         tamanho{0};
+
+    bool    vazio() const { return tamanho == 0; }
+    bool    emBranco() const;   // só espaços (equivale a trimmed().isEmpty())
+    QString toString() const { return QString::fromUtf8(dados, tamanho); }
+    QString toStringTrimmed() const;
+    int     toInt(bool* ok = nullptr) const;
+    double  toDouble(bool* ok = nullptr) const;
+
+    // Comparação exata com um literal ASCII (ex.: campo == "1")
+    bool operator==(const char* s) const;
+    bool operator!=(const char* s) const { return !(*this == s); }
+};
+
+// ===== Leitor de arquivos ';' / '\n' =====
+//
+// Mapeia o arquivo inteiro com QFile::map e percorre os bytes procurando
+// ';' e '\n'. Cada chamada de proximaLinha() só preenche uma lista de
+// CampoCsv apontando para dentro do mapa — sem QString por linha nem
+// QStringList por conjunto de campos.
+//
+//   LeitorCsv csv("projetos.txt");
+//   if (!csv.abrir()) ...
+//   while (csv.proximaLinha()) {
+//       if (csv.linhaEmBranco() || csv.numCampos() < 5) continue;
+//       const int id = csv[0].toInt();
+//   }
+class LeitorCsv
+{
+public:
+    explicit LeitorCsv(const QString& arquivo);
+    // Lê de um bloco já em memória (ex.: só o trecho novo de um arquivo)
+    explicit LeitorCsv(const QByteArray& dados);
+    ~LeitorCsv();
+
+    LeitorCsv(const LeitorCsv&) = delete;
+    LeitorCsv& operator=(const LeitorCsv&) = delete;
+
+    // false se o arquivo existe mas não pôde ser aberto/mapeado
+    bool abrir();
+
+    bool proximaLinha();
+
+    int      numCampos() const { return int(m_campos.size()); }
+    CampoCsv operator[](int i) const
+    {
+        return (i >= 0 && i < m_campos.size()) ? m_campos[i] : CampoCsv{};
+    }
+
+    // Linha só com espaços (equivale a line.trimmed().isEmpty())
+    bool     linhaEmBranco() const { return m_linha.emBranco(); }
+    CampoCsv linha() const { return m_linha; }
+
+    // false para a última linha de um arquivo que não termina em '\n'
+    // (escrita interrompida no meio)
+    bool     linhaCompleta() const { return m_linhaCompleta; }
+
+    // Bytes consumidos desde o início do arquivo (fim da linha atual)
+    qint64   deslocamento() const { return m_pos - m_inicio; }
+
+private:
+    QFile       m_file;
+    uchar*      m_mapa{nullptr};
+    QByteArray  m_fallback;          // usado se o map não for suportado
+    bool        m_emMemoria{false};  // dados em m_fallback desde o construtor
+    const char* m_inicio{nullptr};
+    const char* m_pos{nullptr};
+    const char* m_fim{nullptr};
+
+    CampoCsv                       m_linha;
+    bool                           m_linhaCompleta{false};
+    QVarLengthArray<CampoCsv, 16>  m_campos;
+};
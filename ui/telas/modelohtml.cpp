@@ -0,0 +1,177 @@
+// modelohtml.cpp
+#include "modelohtml.h"
+
+// ================== DADOS ==================
+
+void DadosModelo::definir(const QString& nome, const QString& texto)
+{
+    definirHtml(nome, texto.toHtmlEscaped());
+}
+
+void DadosModelo::definirHtml(const QString& nome, const QString& html)
+{
+    Valor& v = m_valores[nome];
+    v.texto      = html;
+    v.verdadeiro = !html.isEmpty();
+}
+
+void DadosModelo::definirCondicao(const QString& nome, bool verdadeiro)
+{
+    m_valores[nome].verdadeiro = verdadeiro;
+}
+
+DadosModelo& DadosModelo::acrescentar(const QString& nome)
+{
+    Valor& v = m_valores[nome];
+    v.lista = true;
+    v.itens.emplace_back();
+    return v.itens.back();
+}
+
+// ================== COMPILAÇÃO ==================
+
+ModeloHtml::ModeloHtml(const QString& texto)
+{
+    QVector<int> abertas;   // seções ainda sem {{/nome}}
+    int literais = 0;
+
+    const auto literal = [&](int inicio, int tamanho) {
+        if (tamanho <= 0)
+            return;
+        No no;
+        no.texto = texto.mid(inicio, tamanho);
+        m_nos.append(no);
+        literais += tamanho;
+    };
+
+    int pos = 0;
+    while (pos < texto.size() && m_erro.isEmpty()) {
+        const int abre = texto.indexOf(QLatin1String("{{"), pos);
+        if (abre < 0) {
+            literal(pos, texto.size() - pos);
+            break;
+        }
+        literal(pos, abre - pos);
+
+        const int fecha = texto.indexOf(QLatin1String("}}"), abre + 2);
+        if (fecha < 0) {
+            m_erro = QString("'{{' sem '}}' na posição %1").arg(abre);
+            break;
+        }
+        pos = fecha + 2;
+
+        const QString marcador = texto.mid(abre + 2, fecha - abre - 2).trimmed();
+        if (marcador.isEmpty()) {
+            m_erro = QString("Marcador vazio na posição %1").arg(abre);
+            break;
+        }
+
+        No no;
+        const QChar tipo = marcador.at(0);
+        if (tipo == '#' || tipo == '^' || tipo == '/')
+            no.texto = marcador.mid(1).trimmed();
+        else
+            no.texto = marcador;
+
+        if (tipo == '#' || tipo == '^') {
+            no.tipo = tipo == '#' ? TipoNo::Secao : TipoNo::SecaoInvertida;
+            abertas.append(m_nos.size());
+        } else if (tipo == '/') {
+            if (abertas.isEmpty() || m_nos[abertas.last()].texto != no.texto) {
+                m_erro = QString("{{/%1}} sem a abertura correspondente").arg(no.texto);
+                break;
+            }
+            no.tipo = TipoNo::Fim;
+            m_nos[abertas.takeLast()].fim = m_nos.size();
+        } else {
+            no.tipo = TipoNo::Valor;
+        }
+        m_nos.append(no);
+    }
+
+    if (m_erro.isEmpty() && !abertas.isEmpty())
+        m_erro = QString("{{#%1}} sem {{/%1}}").arg(m_nos[abertas.last()].texto);
+
+    if (!m_erro.isEmpty()) {
+        qWarning("ModeloHtml: %s", qPrintable(m_erro));
+        m_nos.clear();
+        literais = 0;
+    }
+    m_reserva = literais;
+}
+
+// ================== RENDERIZAÇÃO ==================
+
+QString ModeloHtml::render(const DadosModelo& dados) const
+{
+    QString saida;
+    saida.reserve(m_reserva.load(std::memory_order_relaxed));
+
+    Pilha pilha;
+    pilha.reserve(4);
+    pilha.append(&dados);
+    renderizar(0, m_nos.size(), pilha, saida);
+
+    // Próxima renderização já reserva o tamanho da maior saída
+    const int tamanho = int(saida.size());
+    int anterior = m_reserva.load(std::memory_order_relaxed);
+    while (tamanho > anterior
+           && !m_reserva.compare_exchange_weak(anterior, tamanho, std::memory_order_relaxed)) {
+    }
+    return saida;
+}
+
+void ModeloHtml::renderizar(int inicio, int fim, Pilha& pilha, QString& saida) const
+{
+    int i = inicio;
+    while (i < fim) {
+        const No& no = m_nos[i];
+        switch (no.tipo) {
+        case TipoNo::Literal:
+            saida += no.texto;
+            ++i;
+            break;
+
+        case TipoNo::Valor:
+            if (const DadosModelo::Valor* v = procurar(pilha, no.texto))
+                saida += v->texto;
+            ++i;
+            break;
+
+        case TipoNo::Secao:
+        case TipoNo::SecaoInvertida: {
+            const DadosModelo::Valor* v = procurar(pilha, no.texto);
+            const bool presente = v && (v->lista ? !v->itens.empty() : v->verdadeiro);
+
+            if (no.tipo == TipoNo::SecaoInvertida) {
+                if (!presente)
+                    renderizar(i + 1, no.fim, pilha, saida);
+            } else if (presente && v->lista) {
+                for (const DadosModelo& item : v->itens) {
+                    pilha.append(&item);
+                    renderizar(i + 1, no.fim, pilha, saida);
+                    pilha.removeLast();
+                }
+            } else if (presente) {
+                renderizar(i + 1, no.fim, pilha, saida);
+            }
+            i = no.fim + 1;
+            break;
+        }
+
+        case TipoNo::Fim:
+            ++i;
+            break;
+        }
+    }
+}
+
+const DadosModelo::Valor* ModeloHtml::procurar(const Pilha& pilha, const QString& nome)
+{
+    for (int i = pilha.size() - 1; i >= 0; --i) {
+        const auto it = pilha[i]->m_valores.constFind(nome);
+        if (it != pilha[i]->m_valores.constEnd())
+            return &it.value();
+    }
+    return nullptr;
+}
@@ -0,0 +1,87 @@
+// modelohtml.h
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <vector>
+
+// ===== Modelos HTML =====
+//
+// Os HTMLs dos PDFs e das pré-visualizações saem de modelos com marcadores
+// (um subconjunto do Mustache):
+//
+//   {{nome}}                 valor de 'nome'
+//   {{#nome}} ... {{/nome}}  lista: repete o trecho para cada item;
+//                            valor: o trecho só aparece se for verdadeiro
+//                            (condição) ou não vazio (texto)
+//   {{^nome}} ... {{/nome}}  o contrário: aparece se falso, vazio ou sem itens
+//
+// Dentro de uma lista o nome é procurado no item e depois fora dele, então
+// o trecho de um quesito enxerga os campos da seção e da ficha.
+//
+// O texto do modelo é compilado uma vez numa lista de trechos literais e
+// marcadores; render() só concatena, num QString reservado com o tamanho
+// da maior saída anterior. O ModeloHtml compilado não muda: o mesmo pode
+// ser usado por várias threads ao mesmo tempo (PDFs em lote).
+
+// Valores de uma renderização. definir() escapa o HTML na hora (nomes,
+// títulos digitados); definirHtml() guarda o trecho como está.
+class DadosModelo
+{
+public:
+    void definir(const QString& nome, const QString& texto);
+    void definirHtml(const QString& nome, const QString& html);
+    void definirCondicao(const QString& nome, bool verdadeiro);
+
+    // Acrescenta um item à lista 'nome'. A referência vale até o próximo
+    // item da mesma lista.
+    DadosModelo& acrescentar(const QString& nome);
+
+private:
+    friend class ModeloHtml;
+
+    struct Valor {
+        QString                  texto;
+        bool                     verdadeiro{false};
+        bool                     lista{false};
+        std::vector<DadosModelo> itens;
+    };
+
+    QHash<QString, Valor> m_valores;
+};
+
+class ModeloHtml
+{
+public:
+    explicit ModeloHtml(const QString& texto);
+
+    ModeloHtml(const ModeloHtml&) = delete;
+    ModeloHtml& operator=(const ModeloHtml&) = delete;
+
+    // Marcador sem fechamento, fechamento trocado...: o modelo fica vazio
+    bool           valido() const { return m_erro.isEmpty(); }
+    const QString& erro() const   { return m_erro; }
+
+    QString render(const DadosModelo& dados) const;
+
+private:
+    enum class TipoNo : quint8 { Literal, Valor, Secao, SecaoInvertida, Fim };
+
+    struct No {
+        TipoNo  tipo{TipoNo::Literal};
+        QString texto;     // literal ou nome do marcador
+        int     fim{0};    // Secao/SecaoInvertida: posição do Fim
+    };
+
+    using Pilha = QVector<const DadosModelo*>;
+
+    void renderizar(int inicio, int fim, Pilha& pilha, QString& saida) const;
+    static const DadosModelo::Valor* procurar(const Pilha& pilha, const QString& nome);
+
+    QVector<No>              m_nos;
+    QString                  m_erro;
+    mutable std::atomic<int> m_reserva{0};
+};
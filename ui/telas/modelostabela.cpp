@@ -0,0 +1,182 @@
+// modelostabela.cpp
+#include "modelostabela.h"
+#include "repositorio.h"
+
+// ================== BASE ==================
+
+ModeloRegistros::ModeloRegistros(QObject* parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int ModeloRegistros::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_linhas;
+}
+
+void ModeloRegistros::sincronizar()
+{
+    const int atual = quantidadeNoRepositorio();
+
+    if (atual > m_linhas) {
+        // adicionar*() acrescenta no fim do vetor
+        beginInsertRows(QModelIndex(), m_linhas, atual - 1);
+        m_linhas = atual;
+        endInsertRows();
+    } else if (atual < m_linhas) {
+        reiniciar();
+    } else if (m_linhas > 0) {
+        emit dataChanged(index(0, 0), index(m_linhas - 1, columnCount() - 1));
+    }
+}
+
+void ModeloRegistros::atualizarLinha(int linha)
+{
+    if (linha >= 0 && linha < m_linhas)
+        emit dataChanged(index(linha, 0), index(linha, columnCount() - 1));
+}
+
+void ModeloRegistros::reiniciar()
+{
+    beginResetModel();
+    m_linhas = quantidadeNoRepositorio();
+    endResetModel();
+}
+
+// ================== PROJETOS ==================
+
+ModeloProjetos::ModeloProjetos(QObject* parent)
+    : ModeloRegistros(parent)
+{
+    auto& repo = Repositorio::instancia();
+    connect(&repo, &Repositorio::projetosAlterados,    this, &ModeloProjetos::sincronizar);
+    connect(&repo, &Repositorio::projetosRecarregados, this, &ModeloProjetos::reiniciar);
+    connect(&repo, &Repositorio::projetoAlterado, this, [this](int id) {
+        const auto& repo = Repositorio::instancia();
+        if (const Projeto* p = repo.projetoPorId(id))
+            atualizarLinha(int(p - repo.projetos().constData()));
+    });
+    reiniciar();
+}
+
+int ModeloProjetos::quantidadeNoRepositorio() const
+{
+    return Repositorio::instancia().projetos().size();
+}
+
+const Projeto* ModeloProjetos::projeto(int linha) const
+{
+    const auto& projetos = Repositorio::instancia().projetos();
+    return (linha >= 0 && linha < projetos.size()) ? &projetos[linha] : nullptr;
+}
+
+int ModeloProjetos::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : NumColunas;
+}
+
+QVariant ModeloProjetos::data(const QModelIndex& index, int role) const
+{
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    // Vetor pode já ter encolhido antes do sinal (mensagem no meio da gravação)
+    const Projeto* p = projeto(index.row());
+    if (!p)
+        return QVariant();
+
+    switch (index.column()) {
+    case ColId:          return p->id;
+    case ColNome:        return p->nome;
+    case ColDescricao:   return p->descricao;
+    case ColResponsavel: return p->responsavel;
+    case ColCategoria:   return p->categoria;
+    case ColStatus:      return p->status;
+    case ColFicha:       return p->ficha;
+    case ColIdFicha:     return p->idFicha;
+    }
+    return QVariant();
+}
+
+QVariant ModeloProjetos::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    static const char* const Titulos[NumColunas] = {
+        "ID", "Nome", "Descrição", "Responsável", "Área/Categoria", "Status", "Ficha", "IdFicha"
+    };
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole
+        || section < 0 || section >= NumColunas)
+        return QAbstractTableModel::headerData(section, orientation, role);
+    return QString::fromUtf8(Titulos[section]);
+}
+
+// ================== AVALIADORES ==================
+
+ModeloAvaliadores::ModeloAvaliadores(QObject* parent)
+    : ModeloRegistros(parent)
+{
+    auto& repo = Repositorio::instancia();
+    connect(&repo, &Repositorio::avaliadoresAlterados,    this, &ModeloAvaliadores::sincronizar);
+    connect(&repo, &Repositorio::avaliadoresRecarregados, this, &ModeloAvaliadores::reiniciar);
+    connect(&repo, &Repositorio::avaliadorAlterado, this, [this](int id) {
+        const auto& repo = Repositorio::instancia();
+        if (const Avaliador* a = repo.avaliadorPorId(id))
+            atualizarLinha(int(a - repo.avaliadores().constData()));
+    });
+
+    // A contagem de projetos de cada avaliador muda com os vínculos
+    connect(&repo, &Repositorio::vinculosAlterados, this, [this] {
+        if (rowCount() > 0)
+            emit dataChanged(index(0, ColProjetosAtribuidos),
+                             index(rowCount() - 1, ColProjetosAtribuidos));
+    });
+    reiniciar();
+}
+
+int ModeloAvaliadores::quantidadeNoRepositorio() const
+{
+    return Repositorio::instancia().avaliadores().size();
+}
+
+const Avaliador* ModeloAvaliadores::avaliador(int linha) const
+{
+    const auto& avaliadores = Repositorio::instancia().avaliadores();
+    return (linha >= 0 && linha < avaliadores.size()) ? &avaliadores[linha] : nullptr;
+}
+
+int ModeloAvaliadores::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : NumColunas;
+}
+
+QVariant ModeloAvaliadores::data(const QModelIndex& index, int role) const
+{
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    const Avaliador* a = avaliador(index.row());
+    if (!a)
+        return QVariant();
+
+    switch (index.column()) {
+    case ColId:                 return a->id;
+    case ColNome:               return a->nome;
+    case ColEmail:              return a->email;
+    case ColCpf:                return a->cpf;
+    case ColCategoria:          return a->categoria;
+    case ColSenha:              return a->senha;
+    case ColStatus:             return a->status;
+    case ColProjetosAtribuidos: return a->projetosAtribuidos;
+    }
+    return QVariant();
+}
+
+QVariant ModeloAvaliadores::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    static const char* const Titulos[NumColunas] = {
+        "ID", "Nome", "Email", "CPF", "Categoria", "Senha", "Status", "Projetos atrib."
+    };
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole
+        || section < 0 || section >= NumColunas)
+        return QAbstractTableModel::headerData(section, orientation, role);
+    return QString::fromUtf8(Titulos[section]);
+}
@@ -0,0 +1,89 @@
+// modelostabela.h
+#pragma once
+
+#include <QAbstractTableModel>
+
+#include "registros.h"
+
+// ===== Modelos de tabela =====
+//
+// Visões somente leitura sobre os vetores do Repositorio: nada é copiado
+// e não existe um QStandardItem por célula, data() lê direto do registro.
+// Cada modelo acompanha os sinais do repositório:
+//
+//   coleção recarregada               -> reset
+//   registro acrescentado no fim      -> rowsInserted
+//   um registro editado (id)          -> dataChanged só da linha dele
+//   mesma quantidade (edição em lote) -> dataChanged (a seleção fica)
+//   registro removido                 -> reset
+//
+// rowCount() usa a quantidade conhecida pelo modelo, não a do vetor, para
+// as views só verem a mudança entre o begin/end correspondente.
+class ModeloRegistros : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    explicit ModeloRegistros(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+protected:
+    virtual int quantidadeNoRepositorio() const = 0;
+
+    // Chamado nos sinais "alterados" / "recarregados" da coleção
+    void sincronizar();
+    void reiniciar();
+
+    // Chamado nos sinais de um registro só ("projetoAlterado(id)"...)
+    void atualizarLinha(int linha);
+
+private:
+    int m_linhas{0};
+};
+
+class ModeloProjetos : public ModeloRegistros
+{
+    Q_OBJECT
+public:
+    enum Coluna {
+        ColId, ColNome, ColDescricao, ColResponsavel,
+        ColCategoria, ColStatus, ColFicha, ColIdFicha,
+        NumColunas
+    };
+
+    explicit ModeloProjetos(QObject* parent = nullptr);
+
+    int      columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    // nullptr fora do intervalo
+    const Projeto* projeto(int linha) const;
+
+protected:
+    int quantidadeNoRepositorio() const override;
+};
+
+class ModeloAvaliadores : public ModeloRegistros
+{
+    Q_OBJECT
+public:
+    enum Coluna {
+        ColId, ColNome, ColEmail, ColCpf, ColCategoria,
+        ColSenha, ColStatus, ColProjetosAtribuidos,
+        NumColunas
+    };
+
+    explicit ModeloAvaliadores(QObject* parent = nullptr);
+
+    int      columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    const Avaliador* avaliador(int linha) const;
+
+protected:
+    int quantidadeNoRepositorio() const override;
+};
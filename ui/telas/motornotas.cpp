@@ -0,0 +1,219 @@
+// motornotas.cpp
+#include "motornotas.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QThread>
+#include <QPair>
+#include <QVarLengthArray>
+
+#include <algorithm>
+
+namespace {
+
+// Linhas por tarefa do recálculo paralelo; abaixo disso fica na thread atual
+constexpr int LinhasPorBloco = 16384;
+
+// Diferença abaixo disso não conta como nota alterada (arredondamento)
+constexpr double Tolerancia = 1e-9;
+
+// Quatro somas independentes: sem dependência entre iterações o
+// compilador pode usar registradores vetoriais
+double produtoEscalar(const double* a, const double* b, int n)
+{
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i]     * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i)
+        s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+// matriz: 'linhas' x pesos.quantidade(), contígua por linha
+void calcularMatriz(const PesosFicha& pesos, const double* matriz, int linhas, double* saida)
+{
+    const int colunas = pesos.quantidade();
+
+    const auto calcular = [&](int inicio, int fim) {
+        for (int l = inicio; l < fim; ++l)
+            saida[l] = pesos.notaFinal(matriz + qint64(l) * colunas);
+    };
+
+    if (linhas <= LinhasPorBloco) {
+        calcular(0, linhas);
+        return;
+    }
+
+    QVector<QPair<int, int>> blocos;
+    for (int inicio = 0; inicio < linhas; inicio += LinhasPorBloco)
+        blocos.append(qMakePair(inicio, qMin(inicio + LinhasPorBloco, linhas)));
+    QtConcurrent::blockingMap(blocos, [&calcular](const QPair<int, int>& b) {
+        calcular(b.first, b.second);
+    });
+}
+
+} // namespace
+
+// ================== PESOS ==================
+
+PesosFicha::PesosFicha(const Ficha& f)
+    : m_idFicha(f.id)
+{
+    const bool comFormulas = compilarFormulas(f, m_formulas, &m_erroFormulas);
+
+    // Digitados primeiro, depois os calculados (mesma ordem de compilarFormulas)
+    QVector<double> calculados;
+    for (const Secao& s : f.secoes) {
+        for (const Quesito& q : s.quesitos) {
+            const double peso = q.temPeso ? q.peso : 1.0;
+            if (!q.autoCalculado) {
+                m_pesos.append(peso);
+            } else if (comFormulas && temFormula(q)) {
+                calculados.append(peso);
+                m_textosFormulas << q.formula.trimmed();
+            }
+        }
+    }
+    m_digitados = m_pesos.size();
+    m_pesos += calculados;
+
+    double soma = 0.0;
+    for (double p : m_pesos)
+        soma += p;
+    for (double& p : m_pesos)
+        p = (soma > 0.0) ? p / soma : 0.0;
+}
+
+void PesosFicha::calcular(const double* notas, double* saida) const
+{
+    std::copy(notas, notas + m_digitados, saida);
+    for (int i = 0; i < m_formulas.size(); ++i)
+        saida[m_digitados + i] = m_formulas[i].avaliar(saida);
+}
+
+double PesosFicha::notaFinal(const double* notas) const
+{
+    if (m_formulas.isEmpty())
+        return produtoEscalar(m_pesos.constData(), notas, m_pesos.size());
+
+    QVarLengthArray<double, 64> valores(m_pesos.size());
+    calcular(notas, valores.data());
+    return produtoEscalar(m_pesos.constData(), valores.constData(), m_pesos.size());
+}
+
+double PesosFicha::notaFinal(const QVector<double>& notas) const
+{
+    if (notas.size() != m_digitados)
+        return 0.0;
+    return notaFinal(notas.constData());
+}
+
+// ================== RECÁLCULO ==================
+
+int recalcularNotasFinais(const PesosFicha& pesos, QVector<Avaliacao>& avaliacoes)
+{
+    const int colunas = pesos.quantidade();
+
+    QVector<int> linhas;
+    for (int i = 0; i < avaliacoes.size(); ++i) {
+        const Avaliacao& a = avaliacoes[i];
+        if (a.idFicha == pesos.idFicha() && a.notasQuesitos.size() == colunas)
+            linhas.append(i);
+    }
+    if (linhas.isEmpty())
+        return 0;
+
+    QVector<double> matriz(linhas.size() * colunas);
+    double* destino = matriz.data();
+    for (int i : linhas) {
+        std::copy(avaliacoes[i].notasQuesitos.cbegin(),
+                  avaliacoes[i].notasQuesitos.cend(), destino);
+        destino += colunas;
+    }
+
+    QVector<double> notas(linhas.size());
+    calcularMatriz(pesos, matriz.constData(), linhas.size(), notas.data());
+
+    int alteradas = 0;
+    for (int l = 0; l < linhas.size(); ++l) {
+        double& atual = avaliacoes[linhas[l]].notaFinal;
+        if (qAbs(atual - notas[l]) > Tolerancia) {
+            atual = notas[l];
+            ++alteradas;
+        }
+    }
+    return alteradas;
+}
+
+// ================== BENCHMARK ==================
+
+int executarBenchmarkNotas(int quantidade, int quesitos)
+{
+    QTextStream out(stdout);
+    if (quantidade <= 0 || quesitos <= 0) {
+        out << QString("Quantidade de avaliações e de quesitos deve ser positiva.\n");
+        return 1;
+    }
+
+    Ficha f;
+    f.id = 1;
+    Secao s;
+    for (int q = 0; q < quesitos; ++q) {
+        Quesito qs;
+        qs.temPeso = true;
+        qs.peso    = 1 + q % 3;
+        s.quesitos.append(qs);
+    }
+    Quesito calculado;
+    calculado.autoCalculado = true;
+    calculado.formula       = "SE(MIN(TODOS) >= 5, MEDIA(TODOS), PONDERADA(TODOS) / 2)";
+    s.quesitos.append(calculado);
+    f.secoes.append(s);
+    const PesosFicha pesos(f);
+
+    QVector<Avaliacao> avaliacoes(quantidade);
+    for (int i = 0; i < quantidade; ++i) {
+        Avaliacao& a = avaliacoes[i];
+        a.idFicha = f.id;
+        a.notasQuesitos.resize(quesitos);
+        for (int q = 0; q < quesitos; ++q)
+            a.notasQuesitos[q] = (i * 7 + q * 13) % 101 / 10.0;
+    }
+
+    const auto relatar = [&out, quantidade](const char* etapa, qint64 ns) {
+        const double s = ns / 1e9;
+        out << QString("%1: %2 ms, %3 avaliações/s\n")
+                   .arg(QString::fromUtf8(etapa))
+                   .arg(ns / 1e6, 0, 'f', 1)
+                   .arg(s > 0.0 ? quantidade / s : 0.0, 0, 'f', 0);
+    };
+
+    out << QString("%1 avaliações, %2 quesitos, %3 threads\n")
+               .arg(quantidade).arg(quesitos).arg(QThread::idealThreadCount());
+
+    // Referência: uma avaliação por vez, direto do QVector de cada uma
+    QElapsedTimer t;
+    t.start();
+    double soma = 0.0;
+    for (const Avaliacao& a : avaliacoes)
+        soma += pesos.notaFinal(a.notasQuesitos);
+    relatar("uma a uma", t.nsecsElapsed());
+
+    t.restart();
+    const int alteradas = recalcularNotasFinais(pesos, avaliacoes);
+    relatar("recalcularNotasFinais", t.nsecsElapsed());
+
+    // Confere o resultado com a referência
+    double somaLote = 0.0;
+    for (const Avaliacao& a : avaliacoes)
+        somaLote += a.notaFinal;
+    out << QString("%1 notas alteradas, diferença %2\n")
+               .arg(alteradas).arg(qAbs(soma - somaLote), 0, 'g', 3);
+    return qAbs(soma - somaLote) <= 1e-6 * quantidade ? 0 : 1;
+}
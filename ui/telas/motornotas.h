@@ -0,0 +1,74 @@
+// motornotas.h
+#pragma once
+
+#include <QVector>
+#include <QString>
+#include <QStringList>
+
+#include "ficha.h"
+#include "registros.h"
+#include "formulaquesito.h"
+
+// ===== Motor de notas =====
+//
+// A nota final é a média ponderada das notas dos quesitos, com peso 1
+// quando o quesito não tem peso. Entram os quesitos digitados e os
+// auto-calculados com fórmula (formulaquesito.h); calculados sem fórmula
+// ficam de fora. PesosFicha "compila" a ficha uma vez: as fórmulas e os
+// pesos, já divididos pela soma deles, num vetor contíguo na ordem dos
+// valores (digitados, na ordem de Avaliacao::notasQuesitos, e depois os
+// calculados). A nota final passa a ser um produto escalar.
+//
+// Para recalcular muitas avaliações (pesos da ficha alterados), as notas
+// são copiadas para uma matriz contígua (uma linha por avaliação) e as
+// linhas são divididas em blocos processados em paralelo. O laço interno
+// usa quatro acumuladores independentes, o que permite ao compilador
+// vetorizar a soma.
+class PesosFicha
+{
+public:
+    PesosFicha() = default;
+    explicit PesosFicha(const Ficha& f);
+
+    int idFicha() const    { return m_idFicha; }
+    int quantidade() const { return m_digitados; }     // notas digitadas
+    int valores() const    { return m_pesos.size(); }  // digitadas + calculadas
+
+    // Fórmula com erro (ficha gravada antes da validação): os calculados
+    // ficam de fora da nota, como quesitos sem fórmula
+    const QString& erroFormulas() const { return m_erroFormulas; }
+
+    // Mesmos pesos e fórmulas (mudança na ficha que não altera as notas)
+    bool operator==(const PesosFicha& o) const
+    {
+        return m_digitados == o.m_digitados && m_pesos == o.m_pesos
+            && m_textosFormulas == o.m_textosFormulas;
+    }
+    bool operator!=(const PesosFicha& o) const { return !(*this == o); }
+
+    // 'notas' com quantidade() valores
+    double notaFinal(const double* notas) const;
+    double notaFinal(const QVector<double>& notas) const;
+
+    // Preenche 'saida' (valores() posições) com as notas digitadas seguidas
+    // dos quesitos calculados
+    void calcular(const double* notas, double* saida) const;
+
+private:
+    int                     m_idFicha{0};
+    int                     m_digitados{0};
+    QVector<double>         m_pesos;   // normalizados (somam 1)
+    QVector<FormulaQuesito> m_formulas;
+    QStringList             m_textosFormulas;
+    QString                 m_erroFormulas;
+};
+
+// Recalcula notaFinal das avaliações da ficha de 'pesos'. Avaliações com
+// outra quantidade de notas (ficha mudou de estrutura) ficam como estão.
+// Devolve quantas notaFinal mudaram.
+int recalcularNotasFinais(const PesosFicha& pesos, QVector<Avaliacao>& avaliacoes);
+
+// Benchmark do recálculo: 'quantidade' avaliações sintéticas de uma ficha
+// com 'quesitos' quesitos digitados e um calculado por fórmula. Escreve o resultado em stdout (opção
+// --benchmark-notas). Devolve o código de saída do processo.
+int executarBenchmarkNotas(int quantidade, int quesitos = 12);
@@ -1,10 +1,11 @@
 #include "paginaavaliadores.h"
 #include "ui_paginaavaliadores.h"
-#include "vinculos.h"
+#include "repositorio.h"
+#include "modelostabela.h"
+#include "filtrobusca.h"
 
 
 #include <QTableView>
-#include <QStandardItemModel>
 #include <QPushButton>
 #include <QHBoxLayout>
 #include <QHeaderView>
@@ -26,43 +27,17 @@
 
 
 // ====== Filtro para busca + categoria ======
-class AvaliadorFilterModel : public QSortFilterProxyModel {
+// A busca usa o índice de trigramas do repositório (nome e e-mail, com
+// tolerância a erro de digitação); a categoria continua no filtro por coluna.
+class AvaliadorFilterModel : public FiltroBusca {
 public:
     explicit AvaliadorFilterModel(QObject* parent = nullptr)
-        : QSortFilterProxyModel(parent) {}
-
-    void setNomeFiltro(const QString& n) {
-        m_nomeFiltro = n.trimmed();
-        invalidateFilter();
-    }
-
-    void setCategoriaFiltro(const QString& c) {
-        m_categoriaFiltro = c.trimmed();
-        invalidateFilter();
-    }
-
-protected:
-    bool filterAcceptsRow(int source_row,
-                          const QModelIndex& source_parent) const override
+        : FiltroBusca(ModeloAvaliadores::ColNome, ModeloAvaliadores::ColCategoria, parent)
     {
-        if (!sourceModel()) return true;
-
-        const QModelIndex idxNome = sourceModel()->index(source_row, 1, source_parent);
-        const QModelIndex idxCat  = sourceModel()->index(source_row, 4, source_parent);
-        const QString nome = sourceModel()->data(idxNome).toString();
-        const QString cat  = sourceModel()->data(idxCat).toString();
-
-        const bool okNome = m_nomeFiltro.isEmpty()
-                            || nome.contains(m_nomeFiltro, Qt::CaseInsensitive);
-        const bool okCat  = m_categoriaFiltro.isEmpty()
-                           || cat.contains(m_categoriaFiltro, Qt::CaseInsensitive);
-
-        return okNome && okCat;
+        usarIndice(ModeloAvaliadores::ColId, [](const QString& consulta) {
+            return Repositorio::instancia().buscarAvaliadores(consulta);
+        });
     }
-
-private:
-    QString m_nomeFiltro;
-    QString m_categoriaFiltro;
 };
 
 // ====== Helpers internos ======
@@ -79,27 +54,7 @@ bool emailValido(const QString& e) {
 }
 
 bool cpfValido(const QString& cpf) {
-    QString num = cpf;
-    num.remove(QRegularExpression("\\D"));
-    if (num.size() != 11) return false;
-
-    bool allEq = true;
-    for (int i = 1; i < 11; ++i) {
-        if (num[i] != num[0]) { allEq = false; break; }
-    }
-    if (allEq) return false;
-
-    auto calcDigit = [](const QString& n, int len)->int {
-        int sum = 0;
-        for (int i = 0; i < len; ++i)
-            sum += n[i].digitValue() * (len + 1 - i);
-        int r = sum % 11;
-        return (r < 2) ? 0 : 11 - r;
-    };
-
-    int d1 = calcDigit(num, 9);
-    int d2 = calcDigit(num, 10);
-    return d1 == num[9].digitValue() && d2 == num[10].digitValue();
+    return Cpf(cpf).valido();
 }
 
 struct AvaliadorData {
@@ -406,7 +361,7 @@ PaginaAvaliadores::PaginaAvaliadores(QWidget* parent)
     : QWidget(parent)
     , ui(new Ui::PaginaAvaliadores)
     , m_table(new QTableView(this))
-    , m_model(new QStandardItemModel(0, 8, this)) // ID, Nome, Email, CPF, Categoria, Senha, Status, Projetos atrib.
+    , m_model(new ModeloAvaliadores(this)) // lê direto de Repositorio::avaliadores()
     , m_filter(new AvaliadorFilterModel(this))
     , m_btnNovo(new QPushButton(" Adicionar", this))
     , m_btnEditar(new QPushButton("️ Editar", this))
@@ -630,7 +585,7 @@ PaginaAvaliadores::PaginaAvaliadores(QWidget* parent)
     lblBuscar->setObjectName("labelBuscar");
     filterLayout->addWidget(lblBuscar);
 
-    m_editBusca->setPlaceholderText("Digite o nome do avaliador...");
+    m_editBusca->setPlaceholderText("Nome ou e-mail do avaliador...");
     m_editBusca->setMinimumWidth(250);
     filterLayout->addWidget(m_editBusca);
 
@@ -664,8 +619,6 @@ PaginaAvaliadores::PaginaAvaliadores(QWidget* parent)
     root->addWidget(m_labelTotal);
 
     // Configuração do modelo
-    m_model->setHorizontalHeaderLabels(
-        {"ID","Nome","Email","CPF","Categoria","Senha","Status","Projetos atrib."});
     m_filter->setSourceModel(m_model);
     m_table->setModel(m_filter);
     m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
@@ -676,7 +629,14 @@ PaginaAvaliadores::PaginaAvaliadores(QWidget* parent)
     m_table->setAlternatingRowColors(true);
     m_table->setSortingEnabled(true);
     m_table->sortByColumn(0, Qt::AscendingOrder);
-    m_table->setColumnHidden(5, true);
+    // Com busca, a coluna ID ordena por relevância (sem indicador); as
+    // outras colunas ordenam pelo valor e mostram o indicador
+    connect(m_table->horizontalHeader(), &QHeaderView::sortIndicatorChanged, this,
+            [this](int coluna) {
+                m_table->horizontalHeader()->setSortIndicatorShown(
+                    !m_filter->buscaAtiva() || coluna != 0);
+            });
+    m_table->setColumnHidden(ModeloAvaliadores::ColSenha, true);
     m_table->setFocusPolicy(Qt::NoFocus);
 
     // Ajustar largura das colunas
@@ -707,7 +667,16 @@ PaginaAvaliadores::PaginaAvaliadores(QWidget* parent)
             static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
             this, &PaginaAvaliadores::onCategoriaChanged);
 
-    carregarDoArquivo();
+    // O modelo acompanha o repositório (inclusive a contagem de projetos
+    // quando os vínculos mudam); aqui só a busca e o contador
+    auto& repo = Repositorio::instancia();
+    connect(&repo, &Repositorio::avaliadoresAlterados,    this, [this] { m_filter->refazerBusca(); });
+    connect(&repo, &Repositorio::avaliadorAlterado,       this, [this] { m_filter->refazerBusca(); });
+    connect(&repo, &Repositorio::avaliadoresAlterados,    this, &PaginaAvaliadores::atualizarTotal);
+    connect(&repo, &Repositorio::avaliadorAlterado,       this, &PaginaAvaliadores::atualizarTotal);
+    connect(&repo, &Repositorio::avaliadoresRecarregados, this, &PaginaAvaliadores::atualizarTotal);
+    connect(&repo, &Repositorio::carregamentoConcluido,   this, &PaginaAvaliadores::atualizarTotal);
+
     atualizarTotal();
 }
 
@@ -719,35 +688,12 @@ int PaginaAvaliadores::selectedRow() const {
     if (!m_table->model()) return -1;
     const QModelIndex proxyIdx = m_table->currentIndex();
     if (!proxyIdx.isValid()) return -1;
-    const QModelIndex srcIdx = m_filter->mapToSource(proxyIdx);
+    const QModelIndex srcIdx = m_filter->paraOrigem(proxyIdx);
     return srcIdx.row();
 }
 
-void PaginaAvaliadores::addAvaliador(const QString& nome,
-                                    const QString& email,
-                                    const QString& cpf,
-                                    const QString& categoria,
-                                    const QString& senha,
-                                    const QString& status)
-{
-    QList<QStandardItem*> row;
-    auto id = new QStandardItem(QString::number(m_nextId++));
-    id->setEditable(false);
-
-    auto itNome    = new QStandardItem(nome);
-    auto itEmail   = new QStandardItem(email);
-    auto itCpf     = new QStandardItem(cpf);
-    auto itCat     = new QStandardItem(categoria);
-    auto itSenha   = new QStandardItem(senha);
-    auto itStatus  = new QStandardItem(status);
-    auto itProjAtrib = new QStandardItem("0"); // vai ser atualizado depois
-
-    itSenha->setEditable(false);
-    itProjAtrib->setEditable(false);
-    itStatus->setEditable(false);
-
-    row << id << itNome << itEmail << itCpf << itCat << itSenha << itStatus << itProjAtrib;
-    m_model->appendRow(row);
+const Avaliador* PaginaAvaliadores::avaliadorSelecionado() const {
+    return m_model->avaliador(selectedRow());
 }
 
 void PaginaAvaliadores::onNovo() {
@@ -755,14 +701,15 @@ void PaginaAvaliadores::onNovo() {
     if (!abrirDialogoAvaliador(this, data, false))
         return;
 
-    addAvaliador(data.nome,
-                 data.email,
-                 data.cpf,
-                 data.categoria,
-                 data.senha,
-                 "Ativo");
-    salvarNoArquivo();
-    atualizarTotal();
+    Avaliador a;
+    a.nome      = data.nome;
+    a.email     = data.email;
+    a.cpf       = data.cpf;
+    a.categoria = data.categoria;
+    a.senha     = data.senha;
+    a.status    = "Ativo";
+
+    Repositorio::instancia().adicionarAvaliador(a);
 }
 
 void PaginaAvaliadores::onEditar() {
@@ -795,24 +742,27 @@ void PaginaAvaliadores::onEditar() {
         return;
     }
 
+    const Avaliador* atual = avaliadorSelecionado();
+    if (!atual) return;
+    Avaliador a = *atual;
+
     AvaliadorData data;
-    data.nome      = m_model->item(r,1)->text();
-    data.email     = m_model->item(r,2)->text();
-    data.cpf       = m_model->item(r,3)->text();
-    data.categoria = m_model->item(r,4)->text();
-    data.senha     = m_model->item(r,5)->text();
+    data.nome      = a.nome;
+    data.email     = a.email;
+    data.cpf       = a.cpf;
+    data.categoria = a.categoria;
+    data.senha     = a.senha;
 
     if (!abrirDialogoAvaliador(this, data, true))
         return;
 
-    m_model->item(r,1)->setText(data.nome);
-    m_model->item(r,2)->setText(data.email);
-    m_model->item(r,3)->setText(data.cpf);
-    m_model->item(r,4)->setText(data.categoria);
-    m_model->item(r,5)->setText(data.senha);
+    a.nome      = data.nome;
+    a.email     = data.email;
+    a.cpf       = data.cpf;
+    a.categoria = data.categoria;
+    a.senha     = data.senha;
 
-    salvarNoArquivo();
-    atualizarTotal();
+    Repositorio::instancia().atualizarAvaliador(a);
 }
 
 void PaginaAvaliadores::onRemover() {
@@ -845,9 +795,13 @@ void PaginaAvaliadores::onRemover() {
         return;
     }
 
-    const QString nome = m_model->item(r,1)->text();
-    const QString cpf  = m_model->item(r,3)->text();
-    const QString cat  = m_model->item(r,4)->text();
+    const Avaliador* selecionado = avaliadorSelecionado();
+    if (!selecionado) return;
+
+    const int     id   = selecionado->id;
+    const QString nome = selecionado->nome;
+    const QString cpf  = selecionado->cpf;
+    const QString cat  = selecionado->categoria;
 
     QString texto = QString(
                         " <b>Confirmar Exclusão</b><br><br>"
@@ -917,19 +871,8 @@ void PaginaAvaliadores::onRemover() {
     )");
 
     if (box.exec() == QMessageBox::Yes) {
-        // Guarda CPF antes de remover
-        const QString cpfRemovido = cpf;
-
-        m_model->removeRow(r);
-        salvarNoArquivo();
-        atualizarTotal();
-
-        // Limpa vínculos desse avaliador
-        auto lista = carregarVinculos(m_arquivoVinculo);
-        if (!lista.isEmpty()) {
-            removerVinculosPorAvaliador(lista, cpfRemovido);
-            salvarVinculos(m_arquivoVinculo, lista);
-        }
+        // Remove o avaliador e limpa os vínculos dele
+        Repositorio::instancia().removerAvaliador(id);
 
         QMessageBox success(this);
         success.setWindowTitle("Sucesso");
@@ -956,108 +899,23 @@ void PaginaAvaliadores::onRemover() {
 }
 
 void PaginaAvaliadores::onRecarregar() {
-    carregarDoArquivo();
-    atualizarTotal();
-}
-
-bool PaginaAvaliadores::salvarNoArquivo() const {
-    QFile f(m_arquivo);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QMessageBox::warning(nullptr, "Salvar",
-                             "Não foi possível abrir '"+m_arquivo+"' para escrita.");
-        return false;
-    }
-    QTextStream out(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    out.setCodec("UTF-8");
-#endif
-    for (int r = 0; r < m_model->rowCount(); ++r) {
-        QStringList cols;
-        for (int c = 0; c < m_model->columnCount(); ++c) {
-            QString s = m_model->item(r, c)->text();
-            s.replace(';', ',');
-            cols << s;
-        }
-        out << cols.join(';') << '\n';
-    }
-    return true;
-}
-
-bool PaginaAvaliadores::carregarDoArquivo() {
-    QFile f(m_arquivo);
-    if (!f.exists()) {
-        m_model->removeRows(0, m_model->rowCount());
-        m_nextId = 1;
-        return true;
-    }
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QMessageBox::warning(nullptr, "Carregar",
-                             "Não foi possível abrir '"+m_arquivo+"' para leitura.");
-        return false;
-    }
-    m_model->removeRows(0, m_model->rowCount());
-
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
-
-    while (!in.atEnd()) {
-        const QString line = in.readLine();
-        if (line.trimmed().isEmpty()) continue;
-
-        const QStringList p = line.split(';');
-        if (p.size() < 5) continue; // ID + Nome + Email + CPF + Categoria
-
-        const QString id        = p.value(0);
-        const QString nome      = p.value(1);
-        const QString email     = p.value(2);
-        const QString cpf       = p.value(3);
-        const QString categoria = p.value(4);
-        const QString senha     = p.size() >= 6 ? p.value(5) : "";
-        const QString status    = p.size() >= 7 ? p.value(6) : "Ativo";
-        const QString projAtrib = p.size() >= 8 ? p.value(7) : "0";
-
-        QList<QStandardItem*> row;
-        auto idItem = new QStandardItem(id);
-        idItem->setEditable(false);
-
-        auto itNome    = new QStandardItem(nome);
-        auto itEmail   = new QStandardItem(email);
-        auto itCpf     = new QStandardItem(cpf);
-        auto itCat     = new QStandardItem(categoria);
-        auto itSenha   = new QStandardItem(senha);
-        auto itStatus  = new QStandardItem(status);
-        auto itProj    = new QStandardItem(projAtrib);
-
-        itSenha->setEditable(false);
-        itStatus->setEditable(false);
-        itProj->setEditable(false);
-
-        row << idItem << itNome << itEmail << itCpf << itCat << itSenha << itStatus << itProj;
-        m_model->appendRow(row);
-    }
-
-    recomputarNextId();
-    atualizarProjetosAtribuidos();
-    return true;
-}
-
-void PaginaAvaliadores::recomputarNextId() {
-    int maxId = 0;
-    for (int r = 0; r < m_model->rowCount(); ++r) {
-        bool ok = false;
-        int id = m_model->item(r,0)->text().toInt(&ok);
-        if (ok && id > maxId) maxId = id;
-    }
-    m_nextId = maxId + 1;
+    auto& repo = Repositorio::instancia();
+    // A tabela é refeita pelos sinais de recarga
+    repo.recarregarAvaliadores();
+    repo.recarregarVinculos();
 }
 
 void PaginaAvaliadores::onBuscaChanged(const QString& texto) {
-    if (m_filter) {
-        m_filter->setNomeFiltro(texto);
-        atualizarTotal();
+    if (!m_filter) return;
+
+    // Com busca, a ordem é a de semelhança (cabeçalho sem indicador)
+    const bool antes = m_filter->buscaAtiva();
+    m_filter->setNomeFiltro(texto);
+    if (m_filter->buscaAtiva() != antes) {
+        m_table->horizontalHeader()->setSortIndicatorShown(!m_filter->buscaAtiva());
+        m_table->sortByColumn(0, Qt::AscendingOrder);
     }
+    atualizarTotal();
 }
 
 void PaginaAvaliadores::onCategoriaChanged(int index) {
@@ -1074,6 +932,10 @@ void PaginaAvaliadores::onCategoriaChanged(int index) {
 
 void PaginaAvaliadores::atualizarTotal() {
     const int total = m_filter ? m_filter->rowCount() : m_model->rowCount();
+    if (total == 0 && Repositorio::instancia().carregando()) {
+        m_labelTotal->setText(" Carregando avaliadores...");
+        return;
+    }
     if (total == 1)
         m_labelTotal->setText(" 1 registro encontrado");
     else
@@ -1123,14 +985,16 @@ void PaginaAvaliadores::onExportCsv() {
 
     out << "ID;Nome;Email;CPF;Categoria;Senha\n";
 
-    for (int r = 0; r < m_model->rowCount(); ++r) {
-        QStringList cols;
-        for (int c = 0; c < m_model->columnCount(); ++c) {
-            QString s = m_model->item(r, c)->text();
-            s.replace(';', ',');
-            cols << s;
-        }
-        out << cols.join(';') << '\n';
+    const auto limpo = [](QString s) { return s.replace(';', ','); };
+    for (const Avaliador& a : Repositorio::instancia().avaliadores()) {
+        out << a.id                  << ';'
+            << limpo(a.nome)         << ';'
+            << limpo(a.email)        << ';'
+            << limpo(a.cpf)          << ';'
+            << limpo(a.categoria)    << ';'
+            << limpo(a.senha)        << ';'
+            << limpo(a.status)       << ';'
+            << a.projetosAtribuidos  << '\n';
     }
 
     QMessageBox msgBox(this);
@@ -1154,36 +1018,3 @@ void PaginaAvaliadores::onExportCsv() {
     )");
     msgBox.exec();
 }
-
-void PaginaAvaliadores::atualizarProjetosAtribuidos() {
-    auto vincs = carregarVinculos(m_arquivoVinculo);
-    if (m_model->columnCount() < 8) return;
-
-    if (vincs.isEmpty()) {
-        // zera tudo
-        for (int r = 0; r < m_model->rowCount(); ++r) {
-            if (auto it = m_model->item(r, 7)) {
-                it->setText("0");
-            }
-        }
-        return;
-    }
-
-    // Mapa CPF(normalizado) -> contagem
-    QHash<QString,int> mapa;
-    for (const auto& v : vincs) {
-        QString cpfNorm = v.cpfAvaliador;
-        cpfNorm.remove(QRegularExpression("\\D"));
-        if (cpfNorm.isEmpty()) continue;
-        mapa[cpfNorm] += 1;
-    }
-
-    for (int r = 0; r < m_model->rowCount(); ++r) {
-        QString cpf = m_model->item(r, 3)->text();
-        cpf.remove(QRegularExpression("\\D"));
-        const int count = mapa.value(cpf, 0);
-        if (auto it = m_model->item(r, 7)) {
-            it->setText(QString::number(count));
-        }
-    }
-}
@@ -5,12 +5,13 @@
 #include <QString>
 
 class QTableView;
-class QStandardItemModel;
+class ModeloAvaliadores;
 class QPushButton;
 class QLineEdit;
 class QComboBox;
 class QLabel;
 class AvaliadorFilterModel;
+struct Avaliador;
 
 namespace Ui { class PaginaAvaliadores; }
 
@@ -34,33 +35,17 @@ private:
     Ui::PaginaAvaliadores* ui;
 
     QTableView*            m_table{};
-    QStandardItemModel*    m_model{};
+    ModeloAvaliadores*     m_model{};
     AvaliadorFilterModel*  m_filter{};
     QPushButton *m_btnNovo{}, *m_btnEditar{}, *m_btnRemover{}, *m_btnRecarregar{}, *m_btnExportCsv{};
     QLineEdit*  m_editBusca{};
     QComboBox*  m_comboCategoria{};
     QLabel*     m_labelTotal{};
-    int         m_nextId{1};
-
-    const QString m_arquivo        = "avaliadores.csv";
-    const QString m_arquivoVinculo = "vinculos_projetos.csv";
-
-    bool salvarNoArquivo() const;
-    bool carregarDoArquivo();
-    void recomputarNextId();
 
     int  selectedRow() const;
-    void addAvaliador(const QString& nome,
-                      const QString& email,
-                      const QString& cpf,
-                      const QString& categoria,
-                      const QString& senha,
-                      const QString& status = "Ativo");
+    const Avaliador* avaliadorSelecionado() const;
 
     void atualizarTotal();
-
-    // Atualiza a coluna "Projetos atribuídos" com base em vinculos_projetos.csv
-    void atualizarProjetosAtribuidos();
 };
 
 #endif // PAGINAAVALIADORES_H
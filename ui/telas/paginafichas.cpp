@@ -1,5 +1,10 @@
 #include "paginafichas.h"
 #include "ui_paginafichas.h"
+#include "repositorio.h"
+#include "filtrobusca.h"
+#include "motornotas.h"
+#include "formulaquesito.h"
+#include "exportacaopdf.h"
 
 #include <QTableView>
 #include <QStandardItemModel>
@@ -39,43 +44,21 @@
 #include <QMarginsF>
 #include <QTextDocument>
 
+#include <algorithm>
+
 // ================== Filtro para busca + tipo ==================
 
-class FichaFilterModel : public QSortFilterProxyModel {
+// Busca e filtro de tipo olham a mesma coluna (1 = Tipo)
+class FichaFilterModel : public FiltroBusca {
 public:
     explicit FichaFilterModel(QObject* parent = nullptr)
-        : QSortFilterProxyModel(parent) {}
-
-    void setNomeFiltro(const QString& n) {
-        m_nomeFiltro = n.trimmed();
-        invalidateFilter();
-    }
+        : FiltroBusca(1, 1, parent) {}
 
     void setTipoFiltro(const QString& t) {
-        m_tipoFiltro = t.trimmed();
-        invalidateFilter();
+        setCategoriaFiltro(t);
     }
 
 protected:
-    bool filterAcceptsRow(int source_row,
-                          const QModelIndex& source_parent) const override
-    {
-        if (!sourceModel())
-            return true;
-
-        // Coluna 1 = Tipo
-        const QModelIndex idxTipo =
-            sourceModel()->index(source_row, 1, source_parent);
-        const QString tipo = sourceModel()->data(idxTipo).toString();
-
-        const bool okNome = m_nomeFiltro.isEmpty()
-                            || tipo.contains(m_nomeFiltro, Qt::CaseInsensitive);
-        const bool okTipo = m_tipoFiltro.isEmpty()
-                            || tipo.contains(m_tipoFiltro, Qt::CaseInsensitive);
-
-        return okNome && okTipo;
-    }
-
     bool lessThan(const QModelIndex& left,
                   const QModelIndex& right) const override
     {
@@ -88,10 +71,6 @@ protected:
         }
         return QSortFilterProxyModel::lessThan(left, right);
     }
-
-private:
-    QString m_nomeFiltro;
-    QString m_tipoFiltro;
 };
 
 // ================== Helpers internos ==================
@@ -146,6 +125,17 @@ bool abrirDialogoQuesito(QWidget* parent, Quesito& quesito, bool edicao)
     chkAuto->setChecked(quesito.autoCalculado);
     formLayout->addRow("", chkAuto);
 
+    // Fórmula (só para auto-calculado; conferida ao salvar a ficha)
+    auto* edFormula = new QLineEdit(quesito.formula, &dlg);
+    edFormula->setPlaceholderText("Ex: MEDIA(TODOS), SOMA(B:TODOS), SE(q1 >= 6, q2, 0)");
+    edFormula->setToolTip("qN = quesito N da seção, B:qN = quesito N da seção B, "
+                          "TODOS = quesitos digitados da seção.\n"
+                          "Funções: SOMA, MEDIA, MIN, MAX, PONDERADA, SE, E, OU.\n"
+                          "Vazia: o quesito não entra na nota final.");
+    edFormula->setEnabled(quesito.autoCalculado);
+    formLayout->addRow("Fórmula:", edFormula);
+    QObject::connect(chkAuto, &QCheckBox::toggled, edFormula, &QLineEdit::setEnabled);
+
     // Tem peso
     auto* chkPeso = new QCheckBox("Aplicar peso ao quesito", &dlg);
     chkPeso->setChecked(quesito.temPeso);
@@ -187,15 +177,19 @@ bool abrirDialogoQuesito(QWidget* parent, Quesito& quesito, bool edicao)
 
     // Validação
     auto validar = [&]() {
-        bool ok = !edNome->text().trimmed().isEmpty();
+        // ';' separa os campos no fichas.txt
+        bool ok = !edNome->text().trimmed().isEmpty()
+                  && !edFormula->text().contains(';');
         btnSave->setEnabled(ok);
     };
     QObject::connect(edNome, &QLineEdit::textChanged, &dlg, validar);
+    QObject::connect(edFormula, &QLineEdit::textChanged, &dlg, validar);
     validar();
 
     if (dlg.exec() == QDialog::Accepted) {
         quesito.nome = edNome->text().trimmed();
         quesito.autoCalculado = chkAuto->isChecked();
+        quesito.formula = quesito.autoCalculado ? edFormula->text().trimmed() : QString();
         quesito.temPeso = chkPeso->isChecked();
         quesito.peso = spnPeso->value();
         return true;
@@ -778,7 +772,17 @@ bool abrirDialogoFicha(QWidget* parent, Ficha& ficha, bool edicao)
     mainLayout->addLayout(btnLayout);
 
     // ===== CONEXÕES =====
-    QObject::connect(btnSave,   &QPushButton::clicked, &dlg, &QDialog::accept);
+    QObject::connect(btnSave,   &QPushButton::clicked, &dlg, [&]() {
+        // As fórmulas citam quesitos de outras seções: só dá para conferir
+        // com a ficha inteira
+        QVector<FormulaQuesito> formulas;
+        QString erro;
+        if (!compilarFormulas(ficha, formulas, &erro)) {
+            QMessageBox::warning(&dlg, "Fórmula inválida", erro);
+            return;
+        }
+        dlg.accept();
+    });
     QObject::connect(btnCancel, &QPushButton::clicked, &dlg, &QDialog::reject);
 
     QObject::connect(btnPreview, &QPushButton::clicked, &dlg, [&]() {
@@ -906,65 +910,7 @@ void visualizarFicha(QWidget* parent, const Ficha& ficha)
     auto* textBrowser = new QTextEdit(&dlg);
     textBrowser->setReadOnly(true);
 
-    // HTML simples para preview
-    QString html = QString(R"(
-<html>
-<head>
-<style>
-body { font-family: Arial; background: white; color: black; padding: 20px; }
-.header { text-align: center; border-bottom: 2px solid #333; padding-bottom: 10px; margin-bottom: 20px; }
-.title { font-size: 18px; font-weight: bold; }
-.section { margin: 20px 0; }
-.section-title { background: #f0f0f0; padding: 8px; font-weight: bold; margin-top: 15px; }
-table { width: 100%%; border-collapse: collapse; margin: 10px 0; }
-th, td { border: 1px solid #666; padding: 8px; text-align: left; }
-th { background: #e0e0e0; }
-.footer { margin-top: 30px; text-align: center; font-size: 10px; }
-</style>
-</head>
-<body>
-<div class="header">
-<div class="title">FICHA DE AVALIAÇÃO</div>
-<div>%1 - Resolução Nº %2/%3</div>
-<div>Curso: %4</div>
-</div>
-
-<div class="section">
-<strong>Escala de Notas:</strong> %5 a %6
-</div>
-)")
-                       .arg(ficha.tipoFicha,
-                            ficha.resolucaoNum,
-                            ficha.resolucaoAno,
-                            ficha.curso)
-                       .arg(ficha.notaMin)
-                       .arg(ficha.notaMax);
-
-    // Adiciona seções
-    for (const auto& secao : ficha.secoes) {
-        html += QString("<div class='section-title'>%1 - %2</div>")
-        .arg(secao.identificador, secao.titulo);
-        html += "<table><tr><th>Quesito</th><th>Nota</th></tr>";
-
-        for (const auto& q : secao.quesitos) {
-            html += QString("<tr><td>%1</td><td></td></tr>").arg(q.nome);
-        }
-
-        html += "</table>";
-    }
-
-    // Campos opcionais
-    if (ficha.incluirDataAvaliacao)
-        html += "<div class='section'>Data da Avaliação: ___/___/______</div>";
-    if (ficha.incluirProfessorAvaliador)
-        html += "<div class='section'>Professor Avaliador: ________________________________</div>";
-    if (ficha.incluirProfessorOrientador)
-        html += "<div class='section'>Professor Orientador: ________________________________</div>";
-    if (!ficha.textoAprovacao.isEmpty())
-        html += QString("<div class='footer'>%1</div>").arg(ficha.textoAprovacao);
-
-    html += "</body></html>";
-
+    const QString html = htmlPreviaFicha(ficha);
     textBrowser->setHtml(html);
     scroll->setWidget(textBrowser);
     scroll->setWidgetResizable(true);
@@ -1396,7 +1342,16 @@ PaginaFichas::PaginaFichas(QWidget* parent)
             static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
             this, &PaginaFichas::onTipoChanged);
 
-    carregarDoArquivo();
+    // Tabela refeita quando as fichas chegam da carga (em segundo plano)
+    // ou são relidas do backend
+    auto& repo = Repositorio::instancia();
+    connect(&repo, &Repositorio::fichasRecarregadas, this, [this] {
+        preencherTabela();
+        atualizarTotal();
+    });
+    connect(&repo, &Repositorio::carregamentoConcluido, this, &PaginaFichas::atualizarTotal);
+
+    preencherTabela();
     atualizarTotal();
 }
 
@@ -1430,24 +1385,28 @@ int PaginaFichas::selectedRow() const {
     if (!m_table->model()) return -1;
     const QModelIndex proxyIdx = m_table->currentIndex();
     if (!proxyIdx.isValid()) return -1;
-    const QModelIndex srcIdx = m_filter ? m_filter->mapToSource(proxyIdx) : proxyIdx;
+    const QModelIndex srcIdx = m_filter ? m_filter->paraOrigem(proxyIdx) : proxyIdx;
     return srcIdx.row();
 }
 
+const Ficha* PaginaFichas::fichaSelecionada() const {
+    const int r = selectedRow();
+    if (r < 0) return nullptr;
+    const int id = m_model->item(r, 0)->text().toInt();
+    return Repositorio::instancia().fichaPorId(id);
+}
+
 // ================== SLOTS ===================
 
 void PaginaFichas::onNovo() {
     Ficha novaFicha;
-    novaFicha.id = m_nextId;
 
     if (!abrirDialogoFicha(this, novaFicha, false))
         return;
 
-    novaFicha.id = m_nextId++;
-    m_fichas.append(novaFicha);
+    novaFicha.id = Repositorio::instancia().adicionarFicha(novaFicha);
     addFichaToTable(novaFicha);
 
-    salvarNoArquivo();
     atualizarTotal();
 }
 
@@ -1459,12 +1418,40 @@ void PaginaFichas::onEditar() {
         return;
     }
 
-    if (r >= m_fichas.size()) return;
+    const Ficha* atual = fichaSelecionada();
+    if (!atual) return;
 
-    Ficha& ficha = m_fichas[r];
+    Ficha ficha = *atual;
+    const PesosFicha pesosAntes(*atual);
     if (!abrirDialogoFicha(this, ficha, true))
         return;
 
+    Repositorio& repo = Repositorio::instancia();
+    repo.atualizarFicha(ficha);
+
+    // Pesos ou fórmulas alterados: as notas finais já lançadas ficaram
+    // com os antigos
+    if (PesosFicha(ficha) != pesosAntes) {
+        const QVector<Avaliacao>& avaliacoes = repo.avaliacoes();
+        const bool temAvaliacoes = std::any_of(avaliacoes.cbegin(), avaliacoes.cend(),
+                                               [&ficha](const Avaliacao& a) {
+                                                   return a.idFicha == ficha.id;
+                                               });
+        if (temAvaliacoes
+            && QMessageBox::question(this, "Editar Ficha",
+                                     "Os pesos ou as fórmulas dos quesitos mudaram.\n\n"
+                                     "Recalcular as notas finais das avaliações "
+                                     "já lançadas nesta ficha?") == QMessageBox::Yes) {
+            const int alteradas = repo.recalcularNotasDaFicha(ficha.id);
+            if (alteradas < 0)
+                QMessageBox::warning(this, "Editar Ficha",
+                                     "Não foi possível gravar as notas recalculadas.");
+            else
+                QMessageBox::information(this, "Editar Ficha",
+                                         QString("%1 avaliação(ões) recalculada(s).").arg(alteradas));
+        }
+    }
+
     // Atualiza tabela
     m_model->item(r, 1)->setText(ficha.tipoFicha);
     m_model->item(r, 2)->setText(QString("%1/%2").arg(ficha.resolucaoNum, ficha.resolucaoAno));
@@ -1477,7 +1464,6 @@ void PaginaFichas::onEditar() {
     m_model->item(r, 4)->setText(QString::number(totalQuesitos));
     m_model->item(r, 5)->setText(ficha.curso);
 
-    salvarNoArquivo();
     atualizarTotal();
 }
 
@@ -1489,9 +1475,10 @@ void PaginaFichas::onRemover() {
         return;
     }
 
-    if (r >= m_fichas.size()) return;
+    const Ficha* selecionada = fichaSelecionada();
+    if (!selecionada) return;
 
-    const Ficha& ficha = m_fichas[r];
+    const Ficha ficha = *selecionada;
     QString texto = QString(
                         "Ficha encontrada:\n\n"
                         "Tipo: %1\n"
@@ -1532,16 +1519,15 @@ void PaginaFichas::onRemover() {
     )");
 
     if (box.exec() == QMessageBox::Yes) {
-        m_fichas.remove(r);
+        Repositorio::instancia().removerFicha(ficha.id);
         m_model->removeRow(r);
-        salvarNoArquivo();
         atualizarTotal();
     }
 }
 
 void PaginaFichas::onRecarregar() {
-    carregarDoArquivo();
-    atualizarTotal();
+    // A tabela é refeita pelo sinal fichasRecarregadas
+    Repositorio::instancia().recarregarFichas();
 }
 
 void PaginaFichas::onVisualizar() {
@@ -1552,9 +1538,10 @@ void PaginaFichas::onVisualizar() {
         return;
     }
 
-    if (r >= m_fichas.size()) return;
+    const Ficha* ficha = fichaSelecionada();
+    if (!ficha) return;
 
-    visualizarFicha(this, m_fichas[r]);
+    visualizarFicha(this, *ficha);
 }
 
 void PaginaFichas::onExportCsv() {
@@ -1582,7 +1569,7 @@ void PaginaFichas::onExportCsv() {
 
     out << "ID;Tipo;ResolucaoNum;ResolucaoAno;Curso;NotaMin;NotaMax;NumSecoes\n";
 
-    for (const auto& ficha : m_fichas) {
+    for (const auto& ficha : Repositorio::instancia().fichas()) {
         out << ficha.id << ";"
             << ficha.tipoFicha << ";"
             << ficha.resolucaoNum << ";"
@@ -1605,9 +1592,10 @@ void PaginaFichas::onExportPdf() {
         return;
     }
 
-    if (r >= m_fichas.size()) return;
+    const Ficha* selecionada = fichaSelecionada();
+    if (!selecionada) return;
 
-    const Ficha& ficha = m_fichas[r];
+    const Ficha& ficha = *selecionada;
 
     QString filename = QFileDialog::getSaveFileName(
         this,
@@ -1637,466 +1625,13 @@ void PaginaFichas::onExportPdf() {
                              "PDF exportado com sucesso!");
 }
 
-// ================== HTML COMPLETO PARA PDF ===================
-
-QString PaginaFichas::gerarHtmlFicha(const Ficha& ficha) const {
-    QString html = R"(
-<!DOCTYPE html>
-<html>
-<head>
-<meta charset="UTF-8">
-<style>
-* {
-    margin: 0;
-    padding: 0;
-    box-sizing: border-box;
-}
-
-body {
-    font-family: 'Arial', sans-serif;
-    background: white;
-    color: #000;
-    padding: 20px;
-    font-size: 11pt;
-}
-
-.header {
-    text-align: center;
-    border-bottom: 3px solid #000;
-    padding-bottom: 15px;
-    margin-bottom: 25px;
-}
-
-.logo {
-    font-size: 20pt;
-    font-weight: bold;
-    color: #000;
-    margin-bottom: 10px;
-}
-
-.title {
-    font-size: 16pt;
-    font-weight: bold;
-    margin: 10px 0;
-    text-transform: uppercase;
-}
-
-.subtitle {
-    font-size: 10pt;
-    margin: 5px 0;
-}
-
-.info-box {
-    background: #f5f5f5;
-    border: 1px solid #ccc;
-    padding: 15px;
-    margin: 20px 0;
-    border-radius: 5px;
-}
-
-.info-row {
-    margin: 8px 0;
-}
-
-.info-label {
-    font-weight: bold;
-    display: inline-block;
-    width: 180px;
-}
-
-.section {
-    margin: 25px 0;
-    page-break-inside: avoid;
-}
-
-.section-header {
-    background: #e0e0e0;
-    padding: 10px;
-    font-weight: bold;
-    font-size: 12pt;
-    margin: 15px 0 10px 0;
-    border-left: 4px solid #000;
-}
-
-table {
-    width: 100%;
-    border-collapse: collapse;
-    margin: 15px 0;
-}
-
-th {
-    background: #d0d0d0;
-    border: 1px solid #666;
-    padding: 10px;
-    text-align: left;
-    font-weight: bold;
-    font-size: 10pt;
-}
-
-td {
-    border: 1px solid #999;
-    padding: 10px;
-    text-align: left;
-    font-size: 10pt;
-    vertical-align: top;
-}
-
-.quesito-nome {
-    font-weight: normal;
-}
-
-.quesito-auto {
-    font-style: italic;
-    color: #666;
-}
-
-.nota-cell {
-    width: 100px;
-    text-align: center;
-    background: #fafafa;
-}
-
-.campos-preenchimento {
-    margin: 30px 0;
-}
-
-.campo-linha {
-    margin: 15px 0;
-    padding: 10px 0;
-    border-bottom: 1px solid #ccc;
-}
-
-.campo-label {
-    font-weight: bold;
-    display: inline-block;
-    margin-right: 10px;
-}
-
-.campo-underline {
-    display: inline-block;
-    border-bottom: 1px solid #000;
-    width: 400px;
-    height: 20px;
-}
-
-.footer {
-    margin-top: 40px;
-    padding-top: 20px;
-    border-top: 2px solid #000;
-    text-align: center;
-    font-size: 9pt;
-}
-
-.observacoes-box {
-    margin: 20px 0;
-    border: 1px solid #999;
-    min-height: 100px;
-    padding: 10px;
-}
+// ================== TABELA ===================
 
-.escala-notas {
-    background: #f9f9f9;
-    border: 1px solid #ddd;
-    padding: 10px;
-    margin: 15px 0;
-    text-align: center;
-    font-weight: bold;
-}
-
-@media print {
-    body {
-        padding: 10mm;
-    }
-
-    .section {
-        page-break-inside: avoid;
-    }
-}
-</style>
-</head>
-<body>
-)";
-
-    // ===== CABEÇALHO =====
-    html += R"(
-<div class="header">
-    <div class="logo"> FUCAPI - FUNDAÇÃO CENTRO DE ANÁLISE, PESQUISA E INOVAÇÃO</div>
-    <div class="title">FICHA DE AVALIAÇÃO</div>
-)";
-
-    if (!ficha.resolucaoNum.isEmpty()) {
-        html += QString("<div class='subtitle'>RESOLUÇÃO Nº %1/%2</div>")
-                    .arg(ficha.resolucaoNum, ficha.resolucaoAno);
-    }
-
-    html += "</div>";
-
-    // ===== DADOS DE IDENTIFICAÇÃO =====
-    html += R"(<div class="info-box">)";
-    html += QString("<div class='info-row'><span class='info-label'>Tipo da Ficha:</span> %1</div>")
-                .arg(ficha.tipoFicha);
-
-    if (!ficha.curso.isEmpty()) {
-        html += QString("<div class='info-row'><span class='info-label'>Curso:</span> %1</div>")
-        .arg(ficha.curso);
-    }
-
-    html += R"(
-    <div class='info-row'><span class='info-label'>Nome do Aluno(a):</span> <span class='campo-underline'></span></div>
-    <div class='info-row'><span class='info-label'>Título do Trabalho:</span> <span class='campo-underline'></span></div>
-)";
-
-    if (ficha.incluirProfessorOrientador) {
-        html += R"(<div class='info-row'><span class='info-label'>Professor Orientador:</span> <span class='campo-underline'></span></div>)";
-    }
-
-    html += "</div>";
-
-    // ===== ESCALA DE NOTAS =====
-    html += QString("<div class='escala-notas'>ESCALA DE NOTAS: %1 a %2</div>")
-                .arg(ficha.notaMin).arg(ficha.notaMax);
-
-    // ===== SEÇÕES DE AVALIAÇÃO =====
-    for (const auto& secao : ficha.secoes) {
-        html += QString("<div class='section'>");
-        html += QString("<div class='section-header'>%1 - %2</div>")
-                    .arg(secao.identificador, secao.titulo);
-
-        if (!secao.quesitos.isEmpty()) {
-            html += "<table>";
-            html += "<tr><th class='quesito-nome'>Quesito</th><th class='nota-cell'>Nota</th></tr>";
-
-            for (const auto& quesito : secao.quesitos) {
-                QString nomeQuesito = quesito.nome;
-
-                if (quesito.autoCalculado) {
-                    nomeQuesito += " <span class='quesito-auto'>[AUTO-CALCULADO]</span>";
-                }
-
-                if (quesito.temPeso && quesito.peso != 1.0) {
-                    nomeQuesito += QString(" <span class='quesito-auto'>(Peso: %1)</span>")
-                    .arg(quesito.peso);
-                }
-
-                html += QString("<tr><td class='quesito-nome'>%1</td><td class='nota-cell'></td></tr>")
-                            .arg(nomeQuesito);
-            }
-
-            html += "</table>";
-        } else {
-            html += "<p><i>Nenhum quesito cadastrado para esta seção.</i></p>";
-        }
-
-        html += "</div>";
-    }
-
-    // ===== CAMPOS DE PREENCHIMENTO =====
-    html += "<div class='campos-preenchimento'>";
-
-    if (ficha.incluirDataAvaliacao) {
-        html += R"(
-        <div class='campo-linha'>
-            <span class='campo-label'>Data da Avaliação:</span>
-            _____ / _____ / __________
-        </div>)";
-    }
-
-    if (ficha.incluirProfessorAvaliador) {
-        html += R"(
-        <div class='campo-linha'>
-            <span class='campo-label'>Professor Avaliador:</span>
-            <span class='campo-underline'></span>
-        </div>)";
-    }
-
-    if (ficha.incluirObservacoes) {
-        html += R"(
-        <div class='campo-linha'>
-            <span class='campo-label'>Observações / Comentários:</span>
-            <div class='observacoes-box'></div>
-        </div>)";
-    }
-
-    html += "</div>";
-
-    // ===== RODAPÉ =====
-    if (!ficha.textoAprovacao.isEmpty()) {
-        html += QString("<div class='footer'>%1</div>").arg(ficha.textoAprovacao);
-    }
-
-    html += R"(
-</body>
-</html>
-)";
-
-    return html;
-}
-
-// ================== PERSISTÊNCIA ===================
-
-QString PaginaFichas::fichaParaString(const Ficha& f) const {
-    QStringList parts;
-
-    // Dados básicos
-    parts << QString::number(f.id);
-    parts << f.tipoFicha;
-    parts << f.resolucaoNum;
-    parts << f.resolucaoAno;
-    parts << f.curso;
-    parts << f.categoriaCurso;
-    parts << QString::number(f.notaMin);
-    parts << QString::number(f.notaMax);
-    parts << (f.incluirDataAvaliacao ? "1" : "0");
-    parts << (f.incluirProfessorAvaliador ? "1" : "0");
-    parts << (f.incluirProfessorOrientador ? "1" : "0");
-    parts << (f.incluirObservacoes ? "1" : "0");
-    parts << f.textoAprovacao;
-
-    // Número de seções
-    parts << QString::number(f.secoes.size());
-
-    // Serializar cada seção
-    for (const auto& secao : f.secoes) {
-        parts << secao.identificador;
-        parts << secao.titulo;
-        parts << QString::number(secao.quesitos.size());
-
-        // Serializar cada quesito
-        for (const auto& q : secao.quesitos) {
-            parts << q.nome;
-            parts << (q.autoCalculado ? "1" : "0");
-            parts << (q.temPeso ? "1" : "0");
-            parts << QString::number(q.peso);
-        }
-    }
-
-    return parts.join(";");
-}
-
-Ficha PaginaFichas::stringParaFicha(const QString& linha) const {
-    Ficha f;
-    const QStringList p = linha.split(';');
-
-    if (p.size() < 14) return f;
-
-    int idx = 0;
-
-    // Dados básicos
-    f.id = p[idx++].toInt();
-    f.tipoFicha = p[idx++];
-    f.resolucaoNum = p[idx++];
-    f.resolucaoAno = p[idx++];
-    f.curso = p[idx++];
-    f.categoriaCurso = p[idx++];
-    f.notaMin = p[idx++].toDouble();
-    f.notaMax = p[idx++].toDouble();
-    f.incluirDataAvaliacao = (p[idx++] == "1");
-    f.incluirProfessorAvaliador = (p[idx++] == "1");
-    f.incluirProfessorOrientador = (p[idx++] == "1");
-    f.incluirObservacoes = (p[idx++] == "1");
-    f.textoAprovacao = p[idx++];
-
-    // Número de seções
-    int numSecoes = p[idx++].toInt();
-
-    // Deserializar cada seção
-    for (int i = 0; i < numSecoes && idx < p.size(); ++i) {
-        Secao secao;
-
-        secao.identificador = p[idx++];
-        secao.titulo = p[idx++];
-
-        if (idx >= p.size()) break;
-        int numQuesitos = p[idx++].toInt();
-
-        // Deserializar cada quesito
-        for (int j = 0; j < numQuesitos && idx < p.size(); ++j) {
-            Quesito q;
-
-            q.nome = p[idx++];
-            if (idx >= p.size()) break;
-
-            q.autoCalculado = (p[idx++] == "1");
-            if (idx >= p.size()) break;
-
-            q.temPeso = (p[idx++] == "1");
-            if (idx >= p.size()) break;
-
-            q.peso = p[idx++].toDouble();
-
-            secao.quesitos.append(q);
-        }
-
-        f.secoes.append(secao);
-    }
-
-    return f;
-}
-
-bool PaginaFichas::salvarNoArquivo() const {
-    QFile f(m_arquivo);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QMessageBox::warning(nullptr, "Salvar Fichas",
-                             "Não foi possível abrir o arquivo para escrita.");
-        return false;
-    }
-
-    QTextStream out(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    out.setCodec("UTF-8");
-#endif
-
-    for (const auto& ficha : m_fichas) {
-        out << fichaParaString(ficha) << '\n';
-    }
-
-    return true;
-}
-
-bool PaginaFichas::carregarDoArquivo() {
-    QFile f(m_arquivo);
-    if (!f.exists()) {
-        m_fichas.clear();
-        m_model->removeRows(0, m_model->rowCount());
-        m_nextId = 1;
-        return true;
-    }
-
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QMessageBox::warning(nullptr, "Carregar Fichas",
-                             "Não foi possível abrir o arquivo para leitura.");
-        return false;
-    }
-
-    m_fichas.clear();
+void PaginaFichas::preencherTabela() {
     m_model->removeRows(0, m_model->rowCount());
 
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
-
-    while (!in.atEnd()) {
-        const QString line = in.readLine();
-        if (line.trimmed().isEmpty()) continue;
-
-        Ficha ficha = stringParaFicha(line);
-        if (ficha.id > 0) {
-            m_fichas.append(ficha);
-            addFichaToTable(ficha);
-        }
-    }
-
-    recomputarNextId();
-    return true;
-}
-
-void PaginaFichas::recomputarNextId() {
-    int maxId = 0;
-    for (const auto& ficha : m_fichas) {
-        if (ficha.id > maxId) maxId = ficha.id;
-    }
-    m_nextId = maxId + 1;
+    for (const Ficha& ficha : Repositorio::instancia().fichas())
+        addFichaToTable(ficha);
 }
 
 // ================== FILTROS ===================
@@ -2123,6 +1658,10 @@ void PaginaFichas::onTipoChanged(int index) {
 
 void PaginaFichas::atualizarTotal() {
     const int total = m_filter ? m_filter->rowCount() : m_model->rowCount();
+    if (total == 0 && Repositorio::instancia().carregando()) {
+        m_labelTotal->setText("📊 Carregando fichas...");
+        return;
+    }
     if (total == 1)
         m_labelTotal->setText("📊 1 ficha encontrada");
     else
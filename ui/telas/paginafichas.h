@@ -4,6 +4,8 @@
 #include <QString>
 #include <QVector>
 
+#include "ficha.h"
+
 // Forward declarations
 class QTableView;
 class QStandardItemModel;
@@ -17,43 +19,6 @@ namespace Ui {
 class PaginaFichas;
 }
 
-// ===== Estruturas de Dados =====
-
-struct Quesito {
-    QString nome;
-    double notaMin{0.0};
-    double notaMax{10.0};
-    bool temPeso{false};
-    double peso{1.0};
-    bool autoCalculado{false};
-    QString formula; // "MEDIA", "SOMA", etc
-    int ordem{0};
-};
-
-struct Secao {
-    QString identificador;
-    QString titulo;
-    QVector<Quesito> quesitos;
-};
-
-struct Ficha {
-    int id{0};
-    QString tipoFicha;
-    QString resolucaoNum;
-    QString resolucaoAno;
-    QString curso;
-    QString categoriaCurso;
-    double notaMin{0.0};
-    double notaMax{10.0};
-    QVector<Secao> secoes;  // ← Mudou de SecaoAvaliacao para Secao
-
-    bool incluirDataAvaliacao{true};
-    bool incluirProfessorAvaliador{true};
-    bool incluirProfessorOrientador{false};
-    bool incluirObservacoes{false};
-    QString textoAprovacao;
-};
-
 // ===== Classe Principal =====
 
 class PaginaFichas : public QWidget
@@ -79,20 +44,12 @@ private slots:
 
 private:
     // Métodos privados
-    bool salvarNoArquivo() const;
-    bool carregarDoArquivo();
-    void recomputarNextId();
+    void preencherTabela();
     void addFichaToTable(const Ficha& ficha);
     int  selectedRow() const;
+    const Ficha* fichaSelecionada() const;
     void atualizarTotal();
 
-    // Conversão Ficha <-> String (para CSV)
-    QString fichaParaString(const Ficha& f) const;
-    Ficha stringParaFicha(const QString& linha) const;
-
-    // HTML para PDF
-    QString gerarHtmlFicha(const Ficha& ficha) const;   // ✅ ADICIONADO
-
     // Membros da UI
     Ui::PaginaFichas* ui;
 
@@ -112,9 +69,4 @@ private:
     QLabel*      m_labelTotal{};
     QLineEdit*   m_editBusca{};
     QComboBox*   m_comboTipo{};
-
-    // Dados
-    int m_nextId{1};
-    QVector<Ficha> m_fichas; // Armazena as fichas completas
-    const QString m_arquivo = "fichas.txt";
 };
@@ -1,6 +1,9 @@
 #include "paginanotas.h"
 #include "ui_paginanotas.h"
 #include "dialogoavaliacaoficha.h"
+#include "dialogoranking.h"
+#include "dialogopdflote.h"
+#include "repositorio.h"
 
 #include <QTableView>
 #include <QStandardItemModel>
@@ -19,99 +22,17 @@
 #include <QList>
 #include <QStringList>
 #include <QFileDialog>
-#include <QRegularExpression>
-
-// ================== HELPER: Normalizar CPF ==================
-static QString normalizarCpf(const QString& cpf) {
-    QString s = cpf;
-    s.remove(QRegularExpression("\\D")); // remove tudo que não é dígito
-    return s;
-}
-
-// ================== HELPERS INTERNOS (PROJETOS/VÍNCULOS) ==================
+#include <QSignalBlocker>
 
 namespace {
 
-struct ProjetoResumo {
-    int     id{0};
-    QString nome;
-    QString categoria;
-    QString status;
-    int     idFicha{0};
-};
-
-// Carrega projetos do arquivo projetos.txt
-// Formato: ID;Nome;Descricao;Responsavel;Categoria;Status;Ficha;IdFicha
-QMap<int, ProjetoResumo> carregarProjetos(const QString& caminho)
-{
-    QMap<int, ProjetoResumo> mapa;
-    QFile f(caminho);
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return mapa;
-    }
-
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
-
-    while (!in.atEnd()) {
-        const QString line = in.readLine();
-        if (line.trimmed().isEmpty()) continue;
-
-        const QStringList cols = line.split(';');
-        if (cols.size() < 8) continue;
-
-        ProjetoResumo p;
-        p.id        = cols[0].toInt();
-        p.nome      = cols[1].trimmed();
-        p.categoria = cols[4].trimmed();
-        p.status    = cols[5].trimmed();
-        p.idFicha   = cols[7].toInt();
-
-        mapa.insert(p.id, p);
-    }
-
-    return mapa;
-}
+// Colunas de agregado (admin): média e desvio do projeto da nota
+constexpr int ColMediaProjeto  = 6;
+constexpr int ColDesvioProjeto = 7;
 
-// Carrega os projetos vinculados a um avaliador específico
-// Formato do vinculos_projetos.csv: idProjeto;cpfAvaliador
-QList<int> carregarProjetosDoAvaliador(const QString& caminhoVinculos,
-                                       const QString& cpf)
+QString textoAgregado(const AgregadoProjeto* a, double (AgregadoProjeto::*valor)() const)
 {
-    QList<int> lista;
-    QFile f(caminhoVinculos);
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return lista;
-    }
-
-    // Normaliza o CPF do avaliador logado
-    QString cpfNormalizado = normalizarCpf(cpf);
-
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
-
-    while (!in.atEnd()) {
-        const QString line = in.readLine();
-        if (line.trimmed().isEmpty()) continue;
-
-        const QStringList cols = line.split(';');
-        if (cols.size() < 2) continue;
-
-        const int idProj = cols[0].toInt();
-        const QString cpfAval = normalizarCpf(cols[1].trimmed());
-
-        // Compara CPFs normalizados
-        if (cpfAval == cpfNormalizado && idProj > 0) {
-            if (!lista.contains(idProj))
-                lista.append(idProj);
-        }
-    }
-
-    return lista;
+    return a ? QString::number((a->*valor)(), 'f', 2) : QString("—");
 }
 
 } // namespace
@@ -128,6 +49,9 @@ PaginaNotas::PaginaNotas(QWidget* parent)
     , m_btnRemover(new QPushButton("🗑️ Remover", this))
     , m_btnRecarregar(new QPushButton("🔄 Recarregar", this))
     , m_btnExportCsv(new QPushButton("📊 Exportar CSV", this))
+    , m_btnResumo(new QPushButton("📈 Resumo por Projeto", this))
+    , m_btnRanking(new QPushButton("🏆 Ranking", this))
+    , m_btnPdfLote(new QPushButton("🖨 PDFs em Lote", this))
     , m_labelTotal(new QLabel(this))
 {
     ui->setupUi(this);
@@ -137,7 +61,22 @@ PaginaNotas::PaginaNotas(QWidget* parent)
     m_modoAvaliador = false;
     configurarTabelaAdmin();
 
-    carregarNotasDoArquivo();
+    // Projetos incluídos/removidos e recargas refazem a tabela; os
+    // vínculos só entram na tabela do avaliador
+    auto& repo = Repositorio::instancia();
+    connect(&repo, &Repositorio::projetosAlterados, this, &PaginaNotas::recarregarDados);
+    connect(&repo, &Repositorio::notasAlteradas,    this, &PaginaNotas::recarregarDados);
+    connect(&repo, &Repositorio::vinculosAlterados, this, [this] {
+        if (m_modoAvaliador)
+            recarregarDados();
+    });
+
+    // Uma nota ou um projeto alterado (aqui ou em outra estação) mexe só
+    // nas linhas dele
+    connect(&repo, &Repositorio::notaAlterada,    this, &PaginaNotas::atualizarLinhaNota);
+    connect(&repo, &Repositorio::notaRemovida,    this, &PaginaNotas::removerLinhaNota);
+    connect(&repo, &Repositorio::projetoAlterado, this, &PaginaNotas::atualizarLinhasProjeto);
+
     recarregarDados();
 }
 
@@ -271,6 +210,10 @@ void PaginaNotas::configurarUi()
     m_btnRemover->setObjectName("btnDanger");
     m_btnRecarregar->setObjectName("btnSecondary");
     m_btnExportCsv->setObjectName("btnSecondary");
+    m_btnResumo->setObjectName("btnSecondary");
+    m_btnResumo->setCheckable(true);
+    m_btnRanking->setObjectName("btnSecondary");
+    m_btnPdfLote->setObjectName("btnSecondary");
     m_labelTotal->setObjectName("labelTotalNotas");
 
     auto* root = ui->verticalLayout;
@@ -284,6 +227,7 @@ void PaginaNotas::configurarUi()
 
     headerLayout->addWidget(titulo);
     headerLayout->addStretch();
+    headerLayout->addWidget(m_btnResumo);
     headerLayout->addWidget(m_btnNovo);
     headerLayout->addWidget(m_btnRecarregar);
     root->addLayout(headerLayout);
@@ -298,6 +242,8 @@ void PaginaNotas::configurarUi()
     btnLayoutBottom->addWidget(m_btnRemover);
     btnLayoutBottom->addStretch();
     btnLayoutBottom->addWidget(m_btnExportCsv);
+    btnLayoutBottom->addWidget(m_btnRanking);
+    btnLayoutBottom->addWidget(m_btnPdfLote);
     root->addLayout(btnLayoutBottom);
 
     // Rodapé
@@ -320,22 +266,26 @@ void PaginaNotas::configurarUi()
 
     // Conexões
     connect(m_table, &QTableView::doubleClicked,
-            this, [this](const QModelIndex&) { onNovo(); });
+            this, [this](const QModelIndex&) { if (!m_resumo) onNovo(); });
 
     connect(m_btnNovo,       &QPushButton::clicked, this, &PaginaNotas::onNovo);
     connect(m_btnEditar,     &QPushButton::clicked, this, &PaginaNotas::onEditar);
     connect(m_btnRemover,    &QPushButton::clicked, this, &PaginaNotas::onRemover);
     connect(m_btnRecarregar, &QPushButton::clicked, this, &PaginaNotas::onRecarregar);
     connect(m_btnExportCsv,  &QPushButton::clicked, this, &PaginaNotas::onExportCsv);
+    connect(m_btnResumo,     &QPushButton::toggled, this, &PaginaNotas::onResumo);
+    connect(m_btnRanking,    &QPushButton::clicked, this, &PaginaNotas::onRanking);
+    connect(m_btnPdfLote,    &QPushButton::clicked, this, &PaginaNotas::onPdfLote);
 }
 
 void PaginaNotas::configurarTabelaAdmin()
 {
     m_model->clear();
-    m_model->setColumnCount(6);
+    m_model->setColumnCount(8);
     m_model->setHorizontalHeaderLabels({
         "ID Nota", "ID Projeto", "Projeto",
-        "CPF Avaliador", "Avaliador", "Nota Final"
+        "CPF Avaliador", "Avaliador", "Nota Final",
+        "Média Projeto", "Desvio Projeto"
     });
 
     auto header = m_table->horizontalHeader();
@@ -345,12 +295,30 @@ void PaginaNotas::configurarTabelaAdmin()
     header->setSectionResizeMode(3, QHeaderView::ResizeToContents);
     header->setSectionResizeMode(4, QHeaderView::ResizeToContents);
     header->setSectionResizeMode(5, QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(ColMediaProjeto,  QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(ColDesvioProjeto, QHeaderView::ResizeToContents);
 
     m_btnNovo->setText("📝 Nova Nota");
     m_btnEditar->setVisible(true);
     m_btnRemover->setText("🗑️ Remover");
 }
 
+void PaginaNotas::configurarTabelaResumo()
+{
+    m_model->clear();
+    m_model->setColumnCount(7);
+    m_model->setHorizontalHeaderLabels({
+        "ID Projeto", "Projeto", "Notas",
+        "Média", "Desvio Padrão", "Mínima", "Máxima"
+    });
+
+    auto header = m_table->horizontalHeader();
+    header->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(1, QHeaderView::Stretch);
+    for (int c = 2; c < 7; ++c)
+        header->setSectionResizeMode(c, QHeaderView::ResizeToContents);
+}
+
 void PaginaNotas::configurarTabelaAvaliador()
 {
     m_model->clear();
@@ -372,6 +340,22 @@ void PaginaNotas::configurarTabelaAvaliador()
     m_btnRemover->setText("🗑️ Remover Minha Nota");
 }
 
+void PaginaNotas::onResumo(bool ativo)
+{
+    m_resumo = ativo;
+
+    // As ações agem sobre uma nota; no resumo as linhas são projetos
+    m_btnNovo->setEnabled(!ativo);
+    m_btnEditar->setEnabled(!ativo);
+    m_btnRemover->setEnabled(!ativo);
+
+    if (ativo)
+        configurarTabelaResumo();
+    else
+        configurarTabelaAdmin();
+    recarregarDados();
+}
+
 void PaginaNotas::atualizarTotalLabel(int total)
 {
     if (m_modoAvaliador) {
@@ -379,6 +363,11 @@ void PaginaNotas::atualizarTotalLabel(int total)
             m_labelTotal->setText("📊 1 projeto vinculado");
         else
             m_labelTotal->setText(QString("📊 %1 projetos vinculados").arg(total));
+    } else if (m_resumo) {
+        if (total == 1)
+            m_labelTotal->setText("📈 1 projeto");
+        else
+            m_labelTotal->setText(QString("📈 %1 projetos").arg(total));
     } else {
         if (total == 1)
             m_labelTotal->setText("📊 1 nota registrada");
@@ -399,119 +388,69 @@ void PaginaNotas::setAvaliador(const QString& cpf,
 
     m_modoAvaliador = !m_cpfLogado.trimmed().isEmpty();
 
+    // Resumo por projeto só para o administrador
+    m_btnResumo->setVisible(!m_modoAvaliador);
+    m_btnRanking->setVisible(!m_modoAvaliador);
+    m_btnPdfLote->setVisible(!m_modoAvaliador);
+    if (m_modoAvaliador && m_resumo) {
+        const QSignalBlocker bloqueio(m_btnResumo);
+        m_btnResumo->setChecked(false);
+        m_resumo = false;
+        m_btnNovo->setEnabled(true);
+        m_btnEditar->setEnabled(true);
+        m_btnRemover->setEnabled(true);
+    }
+
     if (m_modoAvaliador)
         configurarTabelaAvaliador();
+    else if (m_resumo)
+        configurarTabelaResumo();
     else
         configurarTabelaAdmin();
 
     recarregarDados();
 }
 
-// ================== PERSISTÊNCIA ==================
-
-bool PaginaNotas::carregarNotasDoArquivo()
-{
-    m_notas.clear();
-    m_nextId = 1;
-
-    QFile f(m_arquivoNotas);
-    if (!f.exists()) {
-        return true;
-    }
-
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QMessageBox::warning(this, "Carregar Notas",
-                             "Não foi possível abrir '" + m_arquivoNotas + "' para leitura.");
-        return false;
-    }
-
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
-    int maxId = 0;
-
-    while (!in.atEnd()) {
-        const QString line = in.readLine();
-        if (line.trimmed().isEmpty()) continue;
-
-        const QStringList p = line.split(';');
-        if (p.size() < 5) continue;
-
-        Nota n;
-        n.idNota        = p[0].toInt();
-        n.idProjeto     = p[1].toInt();
-        n.cpfAvaliador  = normalizarCpf(p[2].trimmed());  // ✅ NORMALIZA AO CARREGAR
-        n.nomeAvaliador = p[3].trimmed();
-        n.notaFinal     = p[4].toDouble();
-        n.idFicha       = (p.size() >= 6) ? p[5].toInt() : 0;
-
-        m_notas.append(n);
-        if (n.idNota > maxId) maxId = n.idNota;
-    }
-
-    m_nextId = maxId + 1;
-    return true;
-}
-
-bool PaginaNotas::salvarNotasNoArquivo() const
-{
-    QFile f(m_arquivoNotas);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QMessageBox::warning(nullptr, "Salvar Notas",
-                             "Não foi possível abrir '" + m_arquivoNotas + "' para escrita.");
-        return false;
-    }
-
-    QTextStream out(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    out.setCodec("UTF-8");
-#endif
-
-    for (const Nota& n : m_notas) {
-        out << n.idNota << ";"
-            << n.idProjeto << ";"
-            << n.cpfAvaliador << ";"  // já está normalizado
-            << n.nomeAvaliador << ";"
-            << n.notaFinal << ";"
-            << n.idFicha << "\n";
-    }
-
-    return true;
-}
-
-void PaginaNotas::recomputarNextId()
-{
-    int maxId = 0;
-    for (const Nota& n : m_notas) {
-        if (n.idNota > maxId) maxId = n.idNota;
-    }
-    m_nextId = maxId + 1;
-}
-
 // ================== PREENCHIMENTO DE TABELA ==================
 
 void PaginaNotas::recarregarDados()
 {
     m_model->removeRows(0, m_model->rowCount());
+    m_linhaDaNota.clear();
+    m_linhasDoProjeto.clear();
 
     if (m_modoAvaliador)
         preencherTabelaAvaliador();
+    else if (m_resumo)
+        preencherTabelaResumo();
     else
         preencherTabelaAdmin();
 
     atualizarTotalLabel(m_model->rowCount());
 }
 
+void PaginaNotas::indexarLinha(const QList<QStandardItem*>& row, int idProjeto, int idNota)
+{
+    m_linhasDoProjeto[idProjeto].append(row[0]);
+    if (idNota >= 0)
+        m_linhaDaNota.insert(idNota, row[0]);
+}
+
+QStandardItem* PaginaNotas::celula(QStandardItem* primeira, int coluna) const
+{
+    return m_model->item(primeira->row(), coluna);
+}
+
 void PaginaNotas::preencherTabelaAdmin()
 {
-    QMap<int, ProjetoResumo> projetos = carregarProjetos(m_arquivoProjetos);
+    const auto& repo = Repositorio::instancia();
 
-    for (const Nota& n : m_notas) {
-        const ProjetoResumo p = projetos.value(n.idProjeto);
+    for (const Nota& n : repo.notas()) {
+        const Projeto* p = repo.projetoPorId(n.idProjeto);
 
         const QString nomeProj =
-            p.id > 0 ? p.nome : QString("ID %1 (não encontrado)").arg(n.idProjeto);
+            p ? p->nome : QString("ID %1 (não encontrado)").arg(n.idProjeto);
+        const AgregadoProjeto* ag = repo.agregadoDoProjeto(n.idProjeto);
 
         QList<QStandardItem*> row;
         row << new QStandardItem(QString::number(n.idNota));
@@ -520,10 +459,58 @@ void PaginaNotas::preencherTabelaAdmin()
         row << new QStandardItem(n.cpfAvaliador);
         row << new QStandardItem(n.nomeAvaliador);
         row << new QStandardItem(QString::number(n.notaFinal, 'f', 2));
+        row << new QStandardItem(textoAgregado(ag, &AgregadoProjeto::media));
+        row << new QStandardItem(textoAgregado(ag, &AgregadoProjeto::desvioPadrao));
+
+        row[0]->setEditable(false);
+
+        m_model->appendRow(row);
+        indexarLinha(row, n.idProjeto, n.idNota);
+    }
+}
+
+// Uma linha por projeto, direto dos agregados do repositório
+void PaginaNotas::preencherTabelaResumo()
+{
+    const auto& repo = Repositorio::instancia();
+
+    for (const Projeto& p : repo.projetos()) {
+        const AgregadoProjeto* ag = repo.agregadoDoProjeto(p.id);
+
+        QList<QStandardItem*> row;
+        row << new QStandardItem(QString::number(p.id));
+        row << new QStandardItem(p.nome);
+        row << new QStandardItem(QString::number(ag ? ag->quantidade : 0));
+        row << new QStandardItem(textoAgregado(ag, &AgregadoProjeto::media));
+        row << new QStandardItem(textoAgregado(ag, &AgregadoProjeto::desvioPadrao));
+        row << new QStandardItem(textoAgregado(ag, &AgregadoProjeto::minima));
+        row << new QStandardItem(textoAgregado(ag, &AgregadoProjeto::maxima));
 
         row[0]->setEditable(false);
 
         m_model->appendRow(row);
+        indexarLinha(row, p.id, -1);
+    }
+}
+
+void PaginaNotas::atualizarAgregadosProjeto(int idProjeto)
+{
+    if (m_modoAvaliador)
+        return;   // tabela do avaliador não mostra agregados
+
+    const AgregadoProjeto* ag = Repositorio::instancia().agregadoDoProjeto(idProjeto);
+
+    for (QStandardItem* primeira : m_linhasDoProjeto.value(idProjeto)) {
+        if (m_resumo) {
+            celula(primeira, 2)->setText(QString::number(ag ? ag->quantidade : 0));
+            celula(primeira, 3)->setText(textoAgregado(ag, &AgregadoProjeto::media));
+            celula(primeira, 4)->setText(textoAgregado(ag, &AgregadoProjeto::desvioPadrao));
+            celula(primeira, 5)->setText(textoAgregado(ag, &AgregadoProjeto::minima));
+            celula(primeira, 6)->setText(textoAgregado(ag, &AgregadoProjeto::maxima));
+        } else {
+            celula(primeira, ColMediaProjeto)->setText(textoAgregado(ag, &AgregadoProjeto::media));
+            celula(primeira, ColDesvioProjeto)->setText(textoAgregado(ag, &AgregadoProjeto::desvioPadrao));
+        }
     }
 }
 
@@ -534,31 +521,22 @@ void PaginaNotas::preencherTabelaAvaliador()
     if (m_cpfLogado.isEmpty())
         return;
 
-    // ✅ Carrega projetos vinculados ao avaliador
-    QList<int> projetosAvaliador =
-        carregarProjetosDoAvaliador(m_arquivoVinculos, m_cpfLogado);
-
-    // Carrega os projetos completos
-    QMap<int, ProjetoResumo> projetos =
-        carregarProjetos(m_arquivoProjetos);
+    const auto& repo = Repositorio::instancia();
 
-    // Cria mapa de notas já lançadas
-    QMap<int, double> notasPorProjeto;
-    for (const Nota& n : m_notas) {
-        if (n.cpfAvaliador == m_cpfLogado) {
-            notasPorProjeto[n.idProjeto] = n.notaFinal;
-        }
-    }
+    // ✅ Projetos vinculados ao avaliador (índice do repositório)
+    const QList<int> projetosAvaliador = repo.projetosDoAvaliador(m_cpfLogado);
 
     // Monta tabela
     for (int idProj : projetosAvaliador)
     {
-        if (!projetos.contains(idProj))
+        const Projeto* pp = repo.projetoPorId(idProj);
+        if (!pp)
             continue;
 
-        const ProjetoResumo& p = projetos[idProj];
+        const Projeto& p = *pp;
 
-        double nota = notasPorProjeto.value(idProj, -1);
+        const Nota* n = repo.notaDoAvaliador(idProj, m_cpfLogado);
+        double nota = n ? n->notaFinal : -1;
 
         QString situacao = (nota >= 0) ? "✅ Avaliado" : "⏳ Não avaliado";
         QString notaStr = (nota >= 0)
@@ -575,96 +553,132 @@ void PaginaNotas::preencherTabelaAvaliador()
         row[0]->setEditable(false);
 
         m_model->appendRow(row);
+        indexarLinha(row, p.id, -1);
     }
 
     m_table->resizeColumnsToContents();
 }
 
-// ================== HELPERS ==================
-
-int PaginaNotas::selectedRow() const
+void PaginaNotas::atualizarLinhaNota(int idNota)
 {
-    const auto idx = m_table->currentIndex();
-    return idx.isValid() ? idx.row() : -1;
-}
+    const auto& repo = Repositorio::instancia();
+    const Nota* n = repo.notaPorId(idNota);
+    if (!n)
+        return;
 
-PaginaNotas::Nota* PaginaNotas::encontrarNotaPorId(int idNota)
-{
-    for (Nota& n : m_notas) {
-        if (n.idNota == idNota)
-            return &n;
-    }
-    return nullptr;
-}
+    if (m_modoAvaliador) {
+        if (normalizarCpf(n->cpfAvaliador) != m_cpfLogado)
+            return;
 
-PaginaNotas::Nota* PaginaNotas::encontrarNotaDoAvaliador(int idProjeto, const QString& cpf)
-{
-    QString cpfNorm = normalizarCpf(cpf);
-    for (Nota& n : m_notas) {
-        if (n.idProjeto == idProjeto && n.cpfAvaliador == cpfNorm)
-            return &n;
+        // Linha do projeto (nenhuma se não estiver vinculado a este avaliador)
+        for (QStandardItem* primeira : m_linhasDoProjeto.value(n->idProjeto)) {
+            celula(primeira, 3)->setText("✅ Avaliado");
+            celula(primeira, 4)->setText(QString::number(n->notaFinal, 'f', 2));
+        }
+        return;
     }
-    return nullptr;
-}
 
-void PaginaNotas::removerAvaliacoesDoArquivo(int idNota, int idProjeto, const QString& cpf)
-{
-    QFile f(m_arquivoAvaliacoes);
-    if (!f.exists())
+    if (m_resumo) {
+        atualizarAgregadosProjeto(n->idProjeto);
         return;
+    }
 
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+    const AgregadoProjeto* ag = repo.agregadoDoProjeto(n->idProjeto);
+    const Projeto* p = repo.projetoPorId(n->idProjeto);
+    const QString nomeProj =
+        p ? p->nome : QString("ID %1 (não encontrado)").arg(n->idProjeto);
+
+    const QStringList valores{
+        QString::number(n->idNota),
+        QString::number(n->idProjeto),
+        nomeProj,
+        n->cpfAvaliador,
+        n->nomeAvaliador,
+        QString::number(n->notaFinal, 'f', 2),
+        textoAgregado(ag, &AgregadoProjeto::media),
+        textoAgregado(ag, &AgregadoProjeto::desvioPadrao)
+    };
+
+    if (QStandardItem* primeira = m_linhaDaNota.value(idNota)) {
+        const int idProjetoAntes = celula(primeira, 1)->text().toInt();
+        for (int c = 0; c < valores.size(); ++c)
+            celula(primeira, c)->setText(valores[c]);
+        // A média mudou para todas as notas do projeto (e do anterior)
+        if (idProjetoAntes != n->idProjeto) {
+            m_linhasDoProjeto[idProjetoAntes].removeOne(primeira);
+            m_linhasDoProjeto[n->idProjeto].append(primeira);
+            atualizarAgregadosProjeto(idProjetoAntes);
+        }
+        atualizarAgregadosProjeto(n->idProjeto);
         return;
+    }
 
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
-
-    QVector<QString> linhas;
-    QString cpfNorm = normalizarCpf(cpf);
-
-    while (!in.atEnd()) {
-        const QString line = in.readLine();
-        if (line.trimmed().isEmpty()) continue;
+    // Nota nova: acrescenta a linha
+    QList<QStandardItem*> row;
+    for (const QString& v : valores)
+        row << new QStandardItem(v);
+    row[0]->setEditable(false);
+    m_model->appendRow(row);
+    indexarLinha(row, n->idProjeto, idNota);
+    atualizarAgregadosProjeto(n->idProjeto);
+    atualizarTotalLabel(m_model->rowCount());
+}
 
-        const QStringList p = line.split(';');
-        if (p.size() < 6) {
-            linhas.append(line);
-            continue;
+void PaginaNotas::removerLinhaNota(int idNota, int idProjeto)
+{
+    if (m_modoAvaliador) {
+        // Pode ter sido a nota do avaliador logado
+        if (Repositorio::instancia().notaDoAvaliador(idProjeto, m_cpfLogado))
+            return;
+        for (QStandardItem* primeira : m_linhasDoProjeto.value(idProjeto)) {
+            celula(primeira, 3)->setText("⏳ Não avaliado");
+            celula(primeira, 4)->setText("—");
         }
+        return;
+    }
 
-        int     idNotaLinha = p[0].toInt();
-        int     idProjLinha = p[1].toInt();
-        QString cpfLinha    = normalizarCpf(p[2].trimmed());
-
-        if (idNotaLinha == idNota &&
-            idProjLinha == idProjeto &&
-            cpfLinha     == cpfNorm) {
-            continue;
+    if (!m_resumo) {
+        if (QStandardItem* primeira = m_linhaDaNota.take(idNota)) {
+            m_linhasDoProjeto[celula(primeira, 1)->text().toInt()].removeOne(primeira);
+            m_model->removeRow(primeira->row());
+            atualizarTotalLabel(m_model->rowCount());
         }
-
-        linhas.append(line);
     }
+    atualizarAgregadosProjeto(idProjeto);
+}
 
-    f.close();
-
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+void PaginaNotas::atualizarLinhasProjeto(int idProjeto)
+{
+    const Projeto* p = Repositorio::instancia().projetoPorId(idProjeto);
+    if (!p)
         return;
 
-    QTextStream out(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    out.setCodec("UTF-8");
-#endif
+    for (QStandardItem* primeira : m_linhasDoProjeto.value(idProjeto)) {
+        if (m_modoAvaliador) {
+            celula(primeira, 1)->setText(p->nome);
+            celula(primeira, 2)->setText(p->categoria);
+        } else if (m_resumo) {
+            celula(primeira, 1)->setText(p->nome);
+        } else {
+            celula(primeira, 2)->setText(p->nome);
+        }
+    }
+}
 
-    for (const QString& l : linhas)
-        out << l << '\n';
+// ================== HELPERS ==================
+
+int PaginaNotas::selectedRow() const
+{
+    const auto idx = m_table->currentIndex();
+    return idx.isValid() ? idx.row() : -1;
 }
 
 // ================== SLOTS (CRUD) ==================
 
 void PaginaNotas::onNovo()
 {
+    auto& repo = Repositorio::instancia();
+
     if (m_modoAvaliador) {
         const int r = selectedRow();
         if (r < 0) {
@@ -675,15 +689,15 @@ void PaginaNotas::onNovo()
 
         const int idProj = m_model->item(r, 0)->text().toInt();
 
-        // Carrega projeto
-        QMap<int, ProjetoResumo> projetos = carregarProjetos(m_arquivoProjetos);
-        if (!projetos.contains(idProj)) {
+        // Projeto em memória
+        const Projeto* pp = repo.projetoPorId(idProj);
+        if (!pp) {
             QMessageBox::warning(this, "Projetos",
                                  "Projeto não encontrado no arquivo de projetos.");
             return;
         }
 
-        const ProjetoResumo& p = projetos[idProj];
+        const Projeto p = *pp;
 
         if (p.idFicha <= 0) {
             QMessageBox::warning(this, "Ficha",
@@ -693,13 +707,16 @@ void PaginaNotas::onNovo()
         }
 
         // Verifica se já existe nota
-        Nota* notaExistente = encontrarNotaDoAvaliador(idProj, m_cpfLogado);
+        const Nota* notaExistente = repo.notaDoAvaliador(idProj, m_cpfLogado);
 
-        int idNota = 0;
+        Nota n;
         if (notaExistente) {
-            idNota = notaExistente->idNota;
+            n = *notaExistente;
         } else {
-            idNota = m_nextId;
+            n.idNota        = repo.proximoIdNota();
+            n.idProjeto     = idProj;
+            n.cpfAvaliador  = m_cpfLogado;
+            n.nomeAvaliador = m_nomeLogado;
         }
 
         // ✅ ABRE O DIÁLOGO DE AVALIAÇÃO
@@ -709,36 +726,18 @@ void PaginaNotas::onNovo()
             p.nome,
             m_cpfLogado,
             m_nomeLogado,
-            idNota,
+            n.idNota,
             this
             );
 
         if (dlg.exec() != QDialog::Accepted)
             return;
 
-        double notaFinal = dlg.notaFinal();
-
-        if (!notaExistente) {
-            // Cria nova nota
-            Nota n;
-            n.idNota        = idNota;
-            n.idProjeto     = idProj;
-            n.idFicha       = p.idFicha;
-            n.cpfAvaliador  = m_cpfLogado;
-            n.nomeAvaliador = m_nomeLogado;
-            n.notaFinal     = notaFinal;
+        n.notaFinal = dlg.notaFinal();
+        n.idFicha   = p.idFicha;
 
-            m_notas.append(n);
-            if (idNota >= m_nextId)
-                m_nextId = idNota + 1;
-        } else {
-            // Atualiza nota existente
-            notaExistente->notaFinal = notaFinal;
-            notaExistente->idFicha   = p.idFicha;
-        }
-
-        salvarNotasNoArquivo();
-        recarregarDados();
+        if (!repo.salvarNota(n))
+            return;
 
         QMessageBox::information(this, "Sucesso",
                                  "Avaliação salva com sucesso!");
@@ -770,20 +769,17 @@ void PaginaNotas::onNovo()
             );
         if (!ok) return;
 
-        QMap<int, ProjetoResumo> projetos = carregarProjetos(m_arquivoProjetos);
-        const int idFicha = projetos.value(idProj).idFicha;
+        const Projeto* p = repo.projetoPorId(idProj);
 
         Nota n;
-        n.idNota        = m_nextId++;
+        n.idNota        = repo.proximoIdNota();
         n.idProjeto     = idProj;
-        n.idFicha       = idFicha;
+        n.idFicha       = p ? p->idFicha : 0;
         n.cpfAvaliador  = normalizarCpf(cpf);
         n.nomeAvaliador = nome.trimmed();
         n.notaFinal     = valor;
 
-        m_notas.append(n);
-        salvarNotasNoArquivo();
-        recarregarDados();
+        repo.salvarNota(n);
     }
 }
 
@@ -803,49 +799,51 @@ void PaginaNotas::onEditar()
         return;
     }
 
+    auto& repo = Repositorio::instancia();
+
     const int idNota = m_model->item(r, 0)->text().toInt();
-    Nota* nota = encontrarNotaPorId(idNota);
-    if (!nota)
+    const Nota* atual = repo.notaPorId(idNota);
+    if (!atual)
         return;
 
+    Nota nota = *atual;
+
     bool ok = false;
 
     int idProj = QInputDialog::getInt(
         this, "Editar Nota", "ID do Projeto:",
-        nota->idProjeto, 1, 999999, 1, &ok
+        nota.idProjeto, 1, 999999, 1, &ok
         );
     if (!ok) return;
 
     QString cpf = QInputDialog::getText(
         this, "Editar Nota", "CPF do Avaliador:",
-        QLineEdit::Normal, nota->cpfAvaliador, &ok
+        QLineEdit::Normal, nota.cpfAvaliador, &ok
         );
     if (!ok) return;
 
     QString nome = QInputDialog::getText(
         this, "Editar Nota", "Nome do Avaliador:",
-        QLineEdit::Normal, nota->nomeAvaliador, &ok
+        QLineEdit::Normal, nota.nomeAvaliador, &ok
         );
     if (!ok) return;
 
     double valor = QInputDialog::getDouble(
         this, "Editar Nota", "Nota final (0–10):",
-        nota->notaFinal, 0.0, 10.0, 2, &ok
+        nota.notaFinal, 0.0, 10.0, 2, &ok
         );
     if (!ok) return;
 
-    // Atualiza a nota em memória
-    nota->idProjeto     = idProj;
-    nota->cpfAvaliador  = normalizarCpf(cpf);   // mantém CPF normalizado
-    nota->nomeAvaliador = nome.trimmed();
-    nota->notaFinal     = valor;
+    nota.idProjeto     = idProj;
+    nota.cpfAvaliador  = normalizarCpf(cpf);   // mantém CPF normalizado
+    nota.nomeAvaliador = nome.trimmed();
+    nota.notaFinal     = valor;
 
     // Mantém idFicha em sincronia com o projeto
-    QMap<int, ProjetoResumo> projetos = carregarProjetos(m_arquivoProjetos);
-    nota->idFicha = projetos.value(idProj).idFicha;
+    const Projeto* p = repo.projetoPorId(idProj);
+    nota.idFicha = p ? p->idFicha : 0;
 
-    salvarNotasNoArquivo();
-    recarregarDados();
+    repo.salvarNota(nota);
 }
 
 void PaginaNotas::onRemover()
@@ -861,77 +859,47 @@ void PaginaNotas::onRemover()
         return;
     }
 
+    auto& repo = Repositorio::instancia();
+
     if (m_modoAvaliador) {
         // MODO AVALIADOR: remove apenas a SUA nota daquele projeto
         const int idProj = m_model->item(r, 0)->text().toInt();
 
-        int idx = -1;
-        for (int i = 0; i < m_notas.size(); ++i) {
-            const Nota& n = m_notas[i];
-            if (n.idProjeto == idProj && n.cpfAvaliador == m_cpfLogado) {
-                idx = i;
-                break;
-            }
-        }
-
-        if (idx < 0) {
+        const Nota* n = repo.notaDoAvaliador(idProj, m_cpfLogado);
+        if (!n) {
             QMessageBox::information(this, "Remover Nota",
                                      "Este projeto ainda não possui uma nota sua.");
             return;
         }
 
-        const Nota n = m_notas[idx];
+        const int idNota = n->idNota;
 
         if (QMessageBox::question(this, "Remover Nota",
                                   "Remover sua nota para este projeto?")
             != QMessageBox::Yes)
             return;
 
-        // Remove da memória
-        m_notas.remove(idx);
-        salvarNotasNoArquivo();
-
-        // Remove também as avaliações detalhadas (quesitos)
-        removerAvaliacoesDoArquivo(n.idNota, n.idProjeto, n.cpfAvaliador);
-
-        recarregarDados();
+        // Remove a nota e as avaliações detalhadas (quesitos)
+        repo.removerNota(idNota);
     } else {
         // MODO ADMIN: remove qualquer nota
         const int idNota = m_model->item(r, 0)->text().toInt();
 
-        int idx = -1;
-        for (int i = 0; i < m_notas.size(); ++i) {
-            if (m_notas[i].idNota == idNota) {
-                idx = i;
-                break;
-            }
-        }
-
-        if (idx < 0) return;
-
-        const Nota n = m_notas[idx];
+        if (!repo.notaPorId(idNota)) return;
 
         if (QMessageBox::question(this, "Remover Nota",
                                   "Remover nota selecionada?")
             != QMessageBox::Yes)
             return;
 
-        m_notas.remove(idx);
-        salvarNotasNoArquivo();
-
-        removerAvaliacoesDoArquivo(n.idNota, n.idProjeto, n.cpfAvaliador);
-
-        recarregarDados();
+        repo.removerNota(idNota);
     }
 }
 
 void PaginaNotas::onRecarregar()
 {
-    // Recarrega notas do arquivo e reconstrói a tabela
-    if (!carregarNotasDoArquivo())
-        return;
-
-    recarregarDados();
+    // Relê notas do arquivo; a tabela é refeita pelo sinal notasAlteradas
+    Repositorio::instancia().recarregarNotas();
 }
 
 void PaginaNotas::onExportCsv()
@@ -958,25 +926,24 @@ void PaginaNotas::onExportCsv()
     out.setCodec("UTF-8");
 #endif
 
-    // Carrega resumo dos projetos para enriquecer o CSV
-    QMap<int, ProjetoResumo> projetos = carregarProjetos(m_arquivoProjetos);
+    const auto& repo = Repositorio::instancia();
 
     // Cabeçalho
     out << "IdNota;IdProjeto;Projeto;CategoriaProjeto;StatusProjeto;"
            "IdFicha;CpfAvaliador;NomeAvaliador;NotaFinal\n";
 
-    for (const Nota& n : m_notas) {
-        const ProjetoResumo p = projetos.value(n.idProjeto);
+    for (const Nota& n : repo.notas()) {
+        const Projeto* p = repo.projetoPorId(n.idProjeto);
 
-        QString nomeProj = (p.id > 0)
-                               ? p.nome
+        QString nomeProj = p
+                               ? p->nome
                                : QString("ID %1 (não encontrado)").arg(n.idProjeto);
-        QString categ  = p.categoria;
-        QString status = p.status;
+        QString categ  = p ? p->categoria : QString();
+        QString status = p ? p->status : QString();
 
         // Se a nota ainda estiver sem idFicha (compatível com arquivo antigo),
         // usa o idFicha do projeto
-        int idFichaExport = (n.idFicha > 0) ? n.idFicha : p.idFicha;
+        int idFichaExport = (n.idFicha > 0) ? n.idFicha : (p ? p->idFicha : 0);
 
         // Evita quebrar o CSV com ';' dentro dos textos
         nomeProj.replace(';', ',');
@@ -1001,3 +968,15 @@ void PaginaNotas::onExportCsv()
     QMessageBox::information(this, "Exportar CSV",
                              "Notas exportadas com sucesso.");
 }
+
+void PaginaNotas::onRanking()
+{
+    DialogoRanking dlg(this);
+    dlg.exec();
+}
+
+void PaginaNotas::onPdfLote()
+{
+    DialogoPdfLote dlg(this);
+    dlg.exec();
+}
@@ -2,9 +2,12 @@
 #include <QWidget>
 #include <QString>
 #include <QVector>
+#include <QHash>
+#include <QList>
 
 class QTableView;
 class QStandardItemModel;
+class QStandardItem;
 class QPushButton;
 class QLabel;
 
@@ -28,6 +31,9 @@ private slots:
     void onRemover();
     void onRecarregar();
     void onExportCsv();   // exportar CSV resumo de notas
+    void onResumo(bool ativo);   // alterna notas <-> resumo por projeto (admin)
+    void onRanking();            // top-K por categoria/ficha (admin)
+    void onPdfLote();            // PDFs de todas as avaliações (admin)
 
 private:
     Ui::PaginaNotas*    ui{};
@@ -37,7 +43,10 @@ private:
         *m_btnEditar{},
         *m_btnRemover{},
         *m_btnRecarregar{},
-        *m_btnExportCsv{};
+        *m_btnExportCsv{},
+        *m_btnResumo{},
+        *m_btnRanking{},
+        *m_btnPdfLote{};
     QLabel*             m_labelTotal{};
 
     // Contexto do usuário logado
@@ -45,44 +54,32 @@ private:
     QString m_nomeLogado;
     QString m_cursoLogado;
     bool    m_modoAvaliador{false};
-
-    // Estrutura interna de nota
-    struct Nota {
-        int     idNota{0};
-        int     idProjeto{0};
-        int     idFicha{0};      // vínculo com a ficha
-        QString cpfAvaliador;
-        QString nomeAvaliador;
-        double  notaFinal{0.0};
-    };
-
-    QVector<Nota> m_notas;
-    int           m_nextId{1};
-
-    const QString m_arquivoNotas      = "notas.csv";
-    const QString m_arquivoProjetos   = "projetos.txt";
-    const QString m_arquivoVinculos   = "vinculos_projetos.csv";
-    const QString m_arquivoAvaliacoes = "avaliacoes.csv";
+    bool    m_resumo{false};      // admin: uma linha por projeto
 
     // Configuração de UI/estilo
     void configurarUi();
     void configurarTabelaAdmin();
     void configurarTabelaAvaliador();
+    void configurarTabelaResumo();
     void atualizarTotalLabel(int total);
 
-    // Persistência
-    bool carregarNotasDoArquivo();
-    bool salvarNotasNoArquivo() const;
-    void recomputarNextId();
-
     // Preenchimento da tabela
     void recarregarDados();
     void preencherTabelaAdmin();
     void preencherTabelaAvaliador();
+    void preencherTabelaResumo();
+    void atualizarAgregadosProjeto(int idProjeto);   // colunas do projeto
+    void atualizarLinhaNota(int idNota);   // só a linha afetada
+    void removerLinhaNota(int idNota, int idProjeto);
+    void atualizarLinhasProjeto(int idProjeto);      // nome/categoria
+
+    // Linhas da tabela (primeiro item de cada uma: a posição muda quando
+    // a tabela é ordenada pelo cabeçalho, o item não)
+    QHash<int, QStandardItem*>          m_linhaDaNota;       // admin
+    QHash<int, QVector<QStandardItem*>> m_linhasDoProjeto;
+    void indexarLinha(const QList<QStandardItem*>& row, int idProjeto, int idNota);
+    QStandardItem* celula(QStandardItem* primeira, int coluna) const;
 
     // Helpers
     int  selectedRow() const;
-    Nota* encontrarNotaPorId(int idNota);
-    Nota* encontrarNotaDoAvaliador(int idProjeto, const QString& cpf);
-    void removerAvaliacoesDoArquivo(int idNota, int idProjeto, const QString& cpf);
 };
@@ -2,8 +2,6 @@
 #include "ui_paginaprojetos.h"
 
 #include <QTableView>
-#include <QStandardItemModel>
-#include <QStandardItem>
 #include <QPushButton>
 #include <QHBoxLayout>
 #include <QHeaderView>
@@ -24,66 +22,29 @@
 #include <QVBoxLayout>
 #include <QSortFilterProxyModel>
 
-#include "vinculos.h"
+#include "repositorio.h"
+#include "modelostabela.h"
+#include "filtrobusca.h"
 #include "dialogoselecionarficha.h"
 #include "dialogovincularavaliadores.h"
+#include "distribuicaoavaliadores.h"
+#include "dialogoconflitos.h"
+#include "dialogoagenda.h"
 #include "dialogoavaliacaoficha.h"
 
 // ================== Filtro para busca + categoria (Projetos) ==================
 
-class ProjetoFilterModel : public QSortFilterProxyModel {
+// A busca usa o índice invertido do repositório (nome, descrição e
+// responsável); a categoria continua no filtro por coluna.
+class ProjetoFilterModel : public FiltroBusca {
 public:
     explicit ProjetoFilterModel(QObject* parent = nullptr)
-        : QSortFilterProxyModel(parent) {}
-
-    void setNomeFiltro(const QString& n) {
-        m_nomeFiltro = n.trimmed();
-        invalidateFilter();
-    }
-
-    void setCategoriaFiltro(const QString& c) {
-        m_categoriaFiltro = c.trimmed();
-        invalidateFilter();
-    }
-
-protected:
-    bool filterAcceptsRow(int source_row,
-                          const QModelIndex& source_parent) const override
+        : FiltroBusca(ModeloProjetos::ColNome, ModeloProjetos::ColCategoria, parent)
     {
-        if (!sourceModel()) return true;
-
-        const QModelIndex idxNome = sourceModel()->index(source_row, 1, source_parent);
-        const QModelIndex idxCat  = sourceModel()->index(source_row, 4, source_parent);
-
-        const QString nome = sourceModel()->data(idxNome).toString();
-        const QString cat  = sourceModel()->data(idxCat).toString();
-
-        const bool okNome = m_nomeFiltro.isEmpty()
-                            || nome.contains(m_nomeFiltro, Qt::CaseInsensitive);
-        const bool okCat  = m_categoriaFiltro.isEmpty()
-                           || cat.contains(m_categoriaFiltro, Qt::CaseInsensitive);
-
-        return okNome && okCat;
+        usarIndice(ModeloProjetos::ColId, [](const QString& consulta) {
+            return Repositorio::instancia().buscarProjetos(consulta);
+        });
     }
-
-    // ordenar ID como número, não como texto
-    bool lessThan(const QModelIndex& left,
-                  const QModelIndex& right) const override
-    {
-        if (left.column() == 0 && right.column() == 0 && sourceModel()) {
-            bool ok1 = false, ok2 = false;
-            int v1 = sourceModel()->data(left,  Qt::DisplayRole).toInt(&ok1);
-            int v2 = sourceModel()->data(right, Qt::DisplayRole).toInt(&ok2);
-
-            if (ok1 && ok2)
-                return v1 < v2;
-        }
-        return QSortFilterProxyModel::lessThan(left, right);
-    }
-
-private:
-    QString m_nomeFiltro;
-    QString m_categoriaFiltro;
 };
 
 
@@ -307,11 +268,14 @@ PaginaProjetos::PaginaProjetos(QWidget* parent)
     : QWidget(parent)
     , ui(new Ui::PaginaProjetos)
     , m_table(new QTableView(this))
-    , m_model(new QStandardItemModel(0, 8, this)) // 8 colunas
+    , m_model(new ModeloProjetos(this)) // lê direto de Repositorio::projetos()
     , m_filter(new ProjetoFilterModel(this))
     , m_btnNovo(new QPushButton(" Adicionar", this))
     , m_btnEditar(new QPushButton(" Editar", this))
     , m_btnVincular(new QPushButton(" Vincular Avaliadores", this))
+    , m_btnDistribuir(new QPushButton(" Distribuir Avaliadores", this))
+    , m_btnConflitos(new QPushButton(" Conflitos de Interesse", this))
+    , m_btnAgenda(new QPushButton(" Agenda de Apresentações", this))
     , m_btnDefinirFicha(new QPushButton(" Definir Ficha", this))
     , m_btnRemover(new QPushButton(" Excluir", this))
     , m_btnRecarregar(new QPushButton(" Recarregar", this))
@@ -564,7 +528,7 @@ PaginaProjetos::PaginaProjetos(QWidget* parent)
     lblBuscar->setObjectName("labelBuscar");
     filterLayout->addWidget(lblBuscar);
 
-    m_editBusca->setPlaceholderText("Digite o nome do projeto...");
+    m_editBusca->setPlaceholderText("Nome, descrição ou responsável...");
     m_editBusca->setMinimumWidth(250);
     filterLayout->addWidget(m_editBusca);
 
@@ -595,6 +559,9 @@ PaginaProjetos::PaginaProjetos(QWidget* parent)
     btnLayout->addWidget(btnAvaliar);
 
     btnLayout->addWidget(m_btnVincular);
+    btnLayout->addWidget(m_btnDistribuir);
+    btnLayout->addWidget(m_btnConflitos);
+    btnLayout->addWidget(m_btnAgenda);
     btnLayout->addWidget(m_btnDefinirFicha);
     btnLayout->addWidget(m_btnRemover);
     btnLayout->addStretch();
@@ -605,8 +572,6 @@ PaginaProjetos::PaginaProjetos(QWidget* parent)
     root->addWidget(m_labelTotal);
 
     // Modelo + filtro
-    m_model->setHorizontalHeaderLabels(
-        {"ID","Nome","Descrição","Responsável","Área/Categoria","Status","Ficha","IdFicha"});
     m_filter->setSourceModel(m_model);
     m_table->setModel(m_filter);
     m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
@@ -617,6 +582,13 @@ PaginaProjetos::PaginaProjetos(QWidget* parent)
     m_table->setAlternatingRowColors(true);
     m_table->setSortingEnabled(true);
     m_table->sortByColumn(0, Qt::AscendingOrder);
+    // Com busca, a coluna ID ordena por relevância (sem indicador); as
+    // outras colunas ordenam pelo valor e mostram o indicador
+    connect(m_table->horizontalHeader(), &QHeaderView::sortIndicatorChanged, this,
+            [this](int coluna) {
+                m_table->horizontalHeader()->setSortIndicatorShown(
+                    !m_filter->buscaAtiva() || coluna != 0);
+            });
     m_table->setFocusPolicy(Qt::NoFocus);
 
     auto header = m_table->horizontalHeader();
@@ -629,7 +601,7 @@ PaginaProjetos::PaginaProjetos(QWidget* parent)
     header->setSectionResizeMode(6, QHeaderView::ResizeToContents); // Ficha
     header->setSectionResizeMode(7, QHeaderView::ResizeToContents);
 
-    m_table->setColumnHidden(7, true); // IdFicha escondido
+    m_table->setColumnHidden(ModeloProjetos::ColIdFicha, true);
 
     // Duplo clique = editar
     connect(m_table, &QTableView::doubleClicked,
@@ -644,6 +616,9 @@ PaginaProjetos::PaginaProjetos(QWidget* parent)
     connect(m_btnExportCsv,   &QPushButton::clicked, this, &PaginaProjetos::onExportCsv);
     connect(m_btnDefinirFicha,&QPushButton::clicked, this, &PaginaProjetos::onDefinirFicha);
     connect(m_btnVincular,    &QPushButton::clicked, this, &PaginaProjetos::onVincularAvaliadores);
+    connect(m_btnDistribuir,  &QPushButton::clicked, this, &PaginaProjetos::onDistribuirAvaliadores);
+    connect(m_btnConflitos,   &QPushButton::clicked, this, &PaginaProjetos::onConflitos);
+    connect(m_btnAgenda,      &QPushButton::clicked, this, &PaginaProjetos::onAgenda);
 
     // Filtros
     connect(m_editBusca, &QLineEdit::textChanged,
@@ -652,8 +627,15 @@ PaginaProjetos::PaginaProjetos(QWidget* parent)
             static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
             this, &PaginaProjetos::onCategoriaChanged);
 
-    // Carrega dados e atualiza contador
-    carregarDoArquivo();
+    // O modelo acompanha o repositório sozinho; aqui só a busca e o contador
+    auto& repo = Repositorio::instancia();
+    connect(&repo, &Repositorio::projetosAlterados,     this, [this] { m_filter->refazerBusca(); });
+    connect(&repo, &Repositorio::projetoAlterado,       this, [this] { m_filter->refazerBusca(); });
+    connect(&repo, &Repositorio::projetosAlterados,     this, &PaginaProjetos::atualizarTotal);
+    connect(&repo, &Repositorio::projetoAlterado,       this, &PaginaProjetos::atualizarTotal);
+    connect(&repo, &Repositorio::projetosRecarregados,  this, &PaginaProjetos::atualizarTotal);
+    connect(&repo, &Repositorio::carregamentoConcluido, this, &PaginaProjetos::atualizarTotal);
+
     atualizarTotal();
 }
 
@@ -664,39 +646,18 @@ PaginaProjetos::~PaginaProjetos()
 
 // ================== HELPERS DE MODELO ==================
 
-void PaginaProjetos::addProjeto(const QString& nome,
-                                const QString& desc,
-                                const QString& resp,
-                                const QString& categoria,
-                                const QString& status,
-                                const QString& ficha,
-                                const QString& idFicha)
-{
-    QList<QStandardItem*> row;
-
-    auto* idItem = new QStandardItem(QString::number(m_nextId++));
-    idItem->setEditable(false);
-
-    row << idItem
-        << new QStandardItem(nome)
-        << new QStandardItem(desc)
-        << new QStandardItem(resp)
-        << new QStandardItem(categoria)
-        << new QStandardItem(status)
-        << new QStandardItem(ficha)
-        << new QStandardItem(idFicha);
-
-    m_model->appendRow(row);
-}
-
 int PaginaProjetos::selectedRow() const {
     if (!m_table->model()) return -1;
     const QModelIndex proxyIdx = m_table->currentIndex();
     if (!proxyIdx.isValid()) return -1;
-    const QModelIndex srcIdx = m_filter ? m_filter->mapToSource(proxyIdx) : proxyIdx;
+    const QModelIndex srcIdx = m_filter ? m_filter->paraOrigem(proxyIdx) : proxyIdx;
     return srcIdx.row();
 }
 
+const Projeto* PaginaProjetos::projetoSelecionado() const {
+    return m_model->projeto(selectedRow());
+}
+
 // ================== SLOTS: AÇÕES ==================
 
 void PaginaProjetos::onNovo() {
@@ -705,16 +666,16 @@ void PaginaProjetos::onNovo() {
         return;
 
     // Novo projeto começa "Cadastrado" e sem ficha definida
-    addProjeto(data.nome,
-               data.descricao,
-               data.responsavel,
-               data.categoria,
-               "Cadastrado",
-               "Não definida",
-               "-1");
-
-    salvarNoArquivo();
-    atualizarTotal();
+    Projeto p;
+    p.nome        = data.nome;
+    p.descricao   = data.descricao;
+    p.responsavel = data.responsavel;
+    p.categoria   = data.categoria;
+    p.status      = "Cadastrado";
+    p.ficha       = "Não definida";
+    p.idFicha     = -1;
+
+    Repositorio::instancia().adicionarProjeto(p);
 }
 
 void PaginaProjetos::onEditar() {
@@ -725,23 +686,26 @@ void PaginaProjetos::onEditar() {
         return;
     }
 
+    const Projeto* atual = projetoSelecionado();
+    if (!atual) return;
+    Projeto p = *atual;
+
     ProjetoData data;
-    data.nome        = m_model->item(r, 1)->text();
-    data.descricao   = m_model->item(r, 2)->text();
-    data.responsavel = m_model->item(r, 3)->text();
-    data.categoria   = m_model->item(r, 4)->text();
+    data.nome        = p.nome;
+    data.descricao   = p.descricao;
+    data.responsavel = p.responsavel;
+    data.categoria   = p.categoria;
 
     if (!abrirDialogoProjeto(this, data, true))
         return;
 
-    m_model->item(r, 1)->setText(data.nome);
-    m_model->item(r, 2)->setText(data.descricao);
-    m_model->item(r, 3)->setText(data.responsavel);
-    m_model->item(r, 4)->setText(data.categoria);
-    // Status (5) e Ficha (6) permanecem
+    p.nome        = data.nome;
+    p.descricao   = data.descricao;
+    p.responsavel = data.responsavel;
+    p.categoria   = data.categoria;
+    // Status e Ficha permanecem
 
-    salvarNoArquivo();
-    atualizarTotal();
+    Repositorio::instancia().atualizarProjeto(p);
 }
 
 void PaginaProjetos::onVincularAvaliadores() {
@@ -752,37 +716,85 @@ void PaginaProjetos::onVincularAvaliadores() {
         return;
     }
 
-    bool ok = false;
-    const int idProj = m_model->item(r, 0)->text().toInt(&ok);
-    if (!ok) {
+    const Projeto* atual = projetoSelecionado();
+    if (!atual) {
         QMessageBox::warning(this, "Vincular Avaliadores",
                              "ID de projeto inválido.");
         return;
     }
+    Projeto p = *atual;
 
-    const QString nomeProj      = m_model->item(r, 1)->text();
-    const QString categoriaProj = m_model->item(r, 4)->text();
-
-    DialogoVincularAvaliadores dlg(idProj, nomeProj, categoriaProj, this);
+    DialogoVincularAvaliadores dlg(p.id, p.nome, p.categoria, this);
     dlg.setWindowTitle("Vincular Avaliadores");
 
     if (dlg.exec() == QDialog::Accepted) {
-        const int qtd = dlg.totalSelecionados();
+        p.status = statusPorAvaliadores(dlg.totalSelecionados());
+        Repositorio::instancia().atualizarProjeto(p);
+    }
+}
+
+void PaginaProjetos::onDistribuirAvaliadores() {
+    QMessageBox pergunta(this);
+    pergunta.setWindowTitle("Distribuir Avaliadores");
+    pergunta.setIcon(QMessageBox::Question);
+    pergunta.setText(
+        QString("Vincular avaliadores a todos os projetos, até %1 por projeto, "
+                "só avaliadores ativos da mesma categoria, sem conflito de "
+                "interesse e com a carga equilibrada entre eles.")
+            .arg(MaxAvaliadoresPorProjeto));
+    pergunta.setInformativeText(
+        "Completar: mantém os vínculos atuais e preenche só as vagas.\n"
+        "Refazer: mantém só os vínculos com nota lançada e distribui o resto de novo.");
+    QPushButton* btnCompletar = pergunta.addButton("Completar", QMessageBox::AcceptRole);
+    QPushButton* btnRefazer   = pergunta.addButton("Refazer", QMessageBox::DestructiveRole);
+    pergunta.addButton(QMessageBox::Cancel);
+    pergunta.setDefaultButton(btnCompletar);
+    pergunta.exec();
+
+    if (pergunta.clickedButton() != btnCompletar && pergunta.clickedButton() != btnRefazer)
+        return;
 
-        QString novoStatus;
-        if (qtd == 0)
-            novoStatus = "Cadastrado";
-        else if (qtd < 3)
-            novoStatus = "Aguardando Avaliadores";
-        else
-            novoStatus = "Pronto para Avaliação";
+    auto& repo = Repositorio::instancia();
+    OpcoesDistribuicao opcoes;
+    opcoes.refazer = pergunta.clickedButton() == btnRefazer;
+    opcoes.conflitos = &repo.indiceConflitos();
 
-        if (auto* it = m_model->item(r, 5))
-            it->setText(novoStatus);
+    const ResultadoDistribuicao r = distribuirAvaliadores(
+        repo.projetos(), repo.avaliadores(), repo.vinculos(), repo.notas(), opcoes);
 
-        salvarNoArquivo();
-        atualizarTotal();
+    if (r.avaliadoresPorProjeto.isEmpty()) {
+        QMessageBox::information(this, "Distribuir Avaliadores",
+                                 "Nenhuma vaga que possa ser preenchida.");
+        return;
     }
+
+    if (!repo.definirVinculosEmLote(r.avaliadoresPorProjeto)) {
+        QMessageBox::warning(this, "Distribuir Avaliadores",
+                             "Não foi possível salvar os vínculos.");
+        return;
+    }
+
+    QString resumo = QString("%1 projetos alterados, %2 vínculos novos")
+                         .arg(r.avaliadoresPorProjeto.size())
+                         .arg(r.vinculosNovos);
+    if (opcoes.refazer)
+        resumo += QString(", %1 desfeitos").arg(r.vinculosRemovidos);
+    resumo += QString(".\nCarga por avaliador: de %1 a %2 projetos.")
+                  .arg(r.cargaMinima).arg(r.cargaMaxima);
+    if (r.projetosIncompletos > 0)
+        resumo += QString("\n%1 projetos ficaram com vagas: faltam avaliadores "
+                          "ativos e sem conflito na categoria deles.").arg(r.projetosIncompletos);
+    QMessageBox::information(this, "Distribuir Avaliadores", resumo);
+}
+
+void PaginaProjetos::onConflitos() {
+    DialogoConflitos dlg(this);
+    dlg.exec();
+}
+
+void PaginaProjetos::onAgenda() {
+    DialogoAgenda dlg(this);
+    dlg.exec();
 }
 
 void PaginaProjetos::onDefinirFicha() {
@@ -793,9 +805,12 @@ void PaginaProjetos::onDefinirFicha() {
         return;
     }
 
+    const Projeto* atual = projetoSelecionado();
+    if (!atual) return;
+    Projeto p = *atual;
+
     // pega o curso a partir da categoria: "Graduação - Engenharia de Software"
-    QString categoria = m_model->item(r, 4)->text();
-    QString cursoProj = categoria;
+    QString cursoProj = p.categoria;
     int sep = cursoProj.indexOf('-');
     if (sep >= 0)
         cursoProj = cursoProj.mid(sep + 1).trimmed();
@@ -813,20 +828,15 @@ void PaginaProjetos::onDefinirFicha() {
 
     const QString fichaLabel = dlg.fichaLabelSelecionada();
 
-    // atualiza colunas "Ficha" e "IdFicha"
-    if (auto* itFicha = m_model->item(r, 6))
-        itFicha->setText(fichaLabel);
-    if (auto* itIdFicha = m_model->item(r, 7))
-        itIdFicha->setText(QString::number(fichaId));
+    // atualiza "Ficha" e "IdFicha"
+    p.ficha   = fichaLabel;
+    p.idFicha = fichaId;
 
     // regra de status: se estava "Cadastrado", passa pra "Aguardando Avaliadores"
-    if (auto* itStatus = m_model->item(r, 5)) {
-        if (itStatus->text() == "Cadastrado")
-            itStatus->setText("Aguardando Avaliadores");
-    }
+    if (p.status == "Cadastrado")
+        p.status = "Aguardando Avaliadores";
 
-    salvarNoArquivo();
-    atualizarTotal();
+    Repositorio::instancia().atualizarProjeto(p);
 }
 
 void PaginaProjetos::onRemover() {
@@ -837,9 +847,11 @@ void PaginaProjetos::onRemover() {
         return;
     }
 
-    const QString id   = m_model->item(r,0)->text();
-    const QString nome = m_model->item(r,1)->text();
-    const QString resp = m_model->item(r,3)->text();
+    const Projeto* p = m_model->projeto(r);
+    if (!p) return;
+    const QString id   = QString::number(p->id);
+    const QString nome = p->nome;
+    const QString resp = p->responsavel;
 
     QString texto = QString(
                         "Projeto encontrado:\n\n"
@@ -880,27 +892,14 @@ void PaginaProjetos::onRemover() {
     )");
 
     if (box.exec() == QMessageBox::Yes) {
-        bool okId = false;
-        int idInt = id.toInt(&okId);
-
-        m_model->removeRow(r);
-        salvarNoArquivo();
-        atualizarTotal();
-
-        // Remove vínculos desse projeto (se houver)
-        if (okId) {
-            auto lista = carregarVinculos(m_arquivoVinculo);
-            if (!lista.isEmpty()) {
-                removerVinculosPorProjeto(lista, idInt);
-                salvarVinculos(m_arquivoVinculo, lista);
-            }
-        }
+        // Remove o projeto e os vínculos dele (se houver)
+        Repositorio::instancia().removerProjeto(id.toInt());
     }
 }
 
 void PaginaProjetos::onRecarregar() {
-    carregarDoArquivo();
-    atualizarTotal();
+    // A tabela é refeita pelo sinal projetosRecarregados
+    Repositorio::instancia().recarregarProjetos();
 }
 
 // ================== AVALIAR / GERAR PDF ==================
@@ -914,141 +913,41 @@ void PaginaProjetos::onAvaliarProjeto()
         return;
     }
 
-    bool okId = false;
-    const int idProjeto = m_model->item(r, 0)->text().toInt(&okId);
-    if (!okId) {
+    const Projeto* p = projetoSelecionado();
+    if (!p) {
         QMessageBox::warning(this, "Avaliação",
                              "ID de projeto inválido.");
         return;
     }
 
-    const QString nomeProj    = m_model->item(r, 1)->text();
-    const QString responsavel = m_model->item(r, 3)->text();
-
-    // Usa a ficha já definida na tabela (colunas 6 e 7)
-    const QString idFichaStr = m_model->item(r, 7)->text();
-    bool okFicha = false;
-    const int idFicha = idFichaStr.toInt(&okFicha);
-
-    if (!okFicha || idFicha <= 0) {
+    // Usa a ficha já definida no projeto
+    if (p->idFicha <= 0) {
         QMessageBox::warning(this, "Avaliação",
                              "Este projeto ainda não possui ficha definida.\n"
                              "Use o botão \"Definir Ficha\" antes de avaliar.");
         return;
     }
 
-    const QString nomeFicha = m_model->item(r, 6)->text();
-
     DialogoAvaliacaoFicha dlgAv(
-        idProjeto,
-        idFicha,
-        nomeProj,
-        responsavel,
-        nomeFicha,
+        p->id,
+        p->idFicha,
+        p->nome,
+        p->responsavel,
+        p->ficha,
         this
         );
     dlgAv.setWindowTitle("Avaliar Projeto / Gerar PDF");
     dlgAv.exec();
 }
 
-// ================== PERSISTÊNCIA (projetos.txt) ==================
-
-bool PaginaProjetos::salvarNoArquivo() const {
-    QFile f(m_arquivo);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QMessageBox::warning(nullptr, "Salvar Projetos",
-                             "Não foi possível abrir o arquivo de projetos para escrita.");
-        return false;
-    }
-
-    QTextStream out(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    out.setCodec("UTF-8");
-#endif
-
-    for (int r = 0; r < m_model->rowCount(); ++r) {
-        QStringList cols;
-        for (int c = 0; c < m_model->columnCount(); ++c) {
-            QString s = m_model->item(r, c)->text();
-            s.replace(';', ','); // segurança
-            cols << s;
-        }
-        out << cols.join(';') << '\n';
-    }
-
-    return true;
-}
-
-bool PaginaProjetos::carregarDoArquivo() {
-    QFile f(m_arquivo);
-    if (!f.exists()) {
-        m_model->removeRows(0, m_model->rowCount());
-        m_nextId = 1;
-        return true;
-    }
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QMessageBox::warning(nullptr, "Carregar Projetos",
-                             "Não foi possível abrir o arquivo de projetos para leitura.");
-        return false;
-    }
-
-    m_model->removeRows(0, m_model->rowCount());
-
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
-
-    while (!in.atEnd()) {
-        const QString line = in.readLine();
-        if (line.trimmed().isEmpty()) continue;
-
-        const QStringList p = line.split(';');
-        if (p.size() < 5) continue; // ID + 4 campos básicos
-
-        const QString id         = p.value(0);
-        const QString nome       = p.value(1);
-        const QString desc       = p.value(2);
-        const QString resp       = p.value(3);
-        const QString categoria  = p.value(4);
-        const QString status     = p.size() >= 6 ? p.value(5) : "Cadastrado";
-        const QString ficha      = p.size() >= 7 ? p.value(6) : "Não definida";
-        const QString idFicha    = p.size() >= 8 ? p.value(7) : "-1";
-
-        QList<QStandardItem*> row;
-        auto* idItem = new QStandardItem(id);
-        idItem->setEditable(false);
-
-        row << idItem
-            << new QStandardItem(nome)
-            << new QStandardItem(desc)
-            << new QStandardItem(resp)
-            << new QStandardItem(categoria)
-            << new QStandardItem(status)
-            << new QStandardItem(ficha)
-            << new QStandardItem(idFicha);
-
-        m_model->appendRow(row);
-    }
-
-    recomputarNextId();
-    return true;
-}
-
-void PaginaProjetos::recomputarNextId() {
-    int maxId = 0;
-    for (int r = 0; r < m_model->rowCount(); ++r) {
-        bool ok = false;
-        int id = m_model->item(r,0)->text().toInt(&ok);
-        if (ok && id > maxId) maxId = id;
-    }
-    m_nextId = maxId + 1;
-}
-
 // ================== FOOTER ==================
 
 void PaginaProjetos::atualizarTotal() {
     const int total = m_filter ? m_filter->rowCount() : m_model->rowCount();
+    if (total == 0 && Repositorio::instancia().carregando()) {
+        m_labelTotal->setText(" Carregando projetos...");
+        return;
+    }
     if (total == 1)
         m_labelTotal->setText(" 1 projeto encontrado");
     else
@@ -1082,14 +981,16 @@ void PaginaProjetos::onExportCsv() {
 
     out << "ID;Nome;Descricao;Responsavel;Categoria;Status;Ficha;IdFicha\n";
 
-    for (int r = 0; r < m_model->rowCount(); ++r) {
-        QStringList cols;
-        for (int c = 0; c < m_model->columnCount(); ++c) {
-            QString s = m_model->item(r, c)->text();
-            s.replace(';', ',');
-            cols << s;
-        }
-        out << cols.join(';') << '\n';
+    const auto limpo = [](QString s) { return s.replace(';', ','); };
+    for (const Projeto& p : Repositorio::instancia().projetos()) {
+        out << p.id                   << ';'
+            << limpo(p.nome)          << ';'
+            << limpo(p.descricao)     << ';'
+            << limpo(p.responsavel)   << ';'
+            << limpo(p.categoria)     << ';'
+            << limpo(p.status)        << ';'
+            << limpo(p.ficha)         << ';'
+            << p.idFicha              << '\n';
     }
 
     QMessageBox::information(this, "Exportar CSV",
@@ -1099,10 +1000,16 @@ void PaginaProjetos::onExportCsv() {
 // ================== FILTROS ==================
 
 void PaginaProjetos::onBuscaChanged(const QString& texto) {
-    if (m_filter) {
-        m_filter->setNomeFiltro(texto);
-        atualizarTotal();
+    if (!m_filter) return;
+
+    // Com busca, a ordem é a de relevância (cabeçalho sem indicador)
+    const bool antes = m_filter->buscaAtiva();
+    m_filter->setNomeFiltro(texto);
+    if (m_filter->buscaAtiva() != antes) {
+        m_table->horizontalHeader()->setSortIndicatorShown(!m_filter->buscaAtiva());
+        m_table->sortByColumn(0, Qt::AscendingOrder);
     }
+    atualizarTotal();
 }
 
 void PaginaProjetos::onCategoriaChanged(int index) {
@@ -5,12 +5,13 @@
 
 // Forward declarations
 class QTableView;
-class QStandardItemModel;
+class ModeloProjetos;
 class QPushButton;
 class QLabel;
 class QLineEdit;
 class QComboBox;
 class ProjetoFilterModel;
+struct Projeto;
 
 namespace Ui {
 class PaginaProjetos;
@@ -28,6 +29,9 @@ private slots:
     void onNovo();
     void onEditar();
     void onVincularAvaliadores();
+    void onDistribuirAvaliadores();   // todos os projetos de uma vez
+    void onConflitos();
+    void onAgenda();
     void onDefinirFicha();
     void onRemover();
     void onRecarregar();
@@ -38,19 +42,8 @@ private slots:
 
 private:
     // Métodos privados
-    bool salvarNoArquivo() const;
-    bool carregarDoArquivo();
-    void recomputarNextId();
-
-    void addProjeto(const QString& nome,
-                    const QString& desc,
-                    const QString& resp,
-                    const QString& categoria,
-                    const QString& status,
-                    const QString& ficha,
-                    const QString& idFicha);
-
     int  selectedRow() const;
+    const Projeto* projetoSelecionado() const;
     void atualizarTotal();
 
     // Membros da UI
@@ -58,13 +51,16 @@ private:
 
     // Modelo e Visão
     QTableView*         m_table{};
-    QStandardItemModel* m_model{};
+    ModeloProjetos*     m_model{};
     ProjetoFilterModel* m_filter{};
 
     // Widgets
     QPushButton* m_btnNovo{};
     QPushButton* m_btnEditar{};
     QPushButton* m_btnVincular{};
+    QPushButton* m_btnDistribuir{};
+    QPushButton* m_btnConflitos{};
+    QPushButton* m_btnAgenda{};
     QPushButton* m_btnDefinirFicha{};
     QPushButton* m_btnRemover{};
     QPushButton* m_btnRecarregar{};
@@ -72,9 +68,4 @@ private:
     QLabel*      m_labelTotal{};
     QLineEdit*   m_editBusca{};
     QComboBox*   m_comboCategoria{};
-
-    // Dados
-    int         m_nextId{1};
-    const QString m_arquivo        = "projetos.txt";
-    const QString m_arquivoVinculo = "vinculos_projetos.csv"; // pra limpar vínculos ao remover projeto
 };
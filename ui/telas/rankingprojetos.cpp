@@ -0,0 +1,242 @@
+// rankingprojetos.cpp
+#include "rankingprojetos.h"
+#include "repositorio.h"
+
+#include <algorithm>
+
+namespace {
+
+// Diferença abaixo disso é empate (arredondamento)
+constexpr double Tolerancia = 1e-9;
+
+int quantidadeDigitados(const Ficha& f)
+{
+    int n = 0;
+    for (const Secao& s : f.secoes)
+        for (const Quesito& q : s.quesitos)
+            if (!q.autoCalculado)
+                ++n;
+    return n;
+}
+
+} // namespace
+
+// ================== REGRAS ==================
+
+void RankingProjetos::definirRegras(const RegrasRanking& regras, const Repositorio& repo)
+{
+    const bool reagrupar = regras.agrupamento != m_regras.agrupamento;
+    m_regras = regras;
+
+    if (reagrupar) {
+        reconstruir(repo);
+        return;
+    }
+    for (auto it = m_membros.cbegin(); it != m_membros.cend(); ++it)
+        selecionar(it.key());
+}
+
+bool RankingProjetos::precede(const ItemRanking& a, const ItemRanking& b) const
+{
+    if (qAbs(a.media - b.media) > Tolerancia)
+        return a.media > b.media;
+
+    for (CriterioDesempate c : m_regras.desempate) {
+        switch (c) {
+        case CriterioDesempate::MaiorSecao:
+            if (qAbs(a.melhorSecao - b.melhorSecao) > Tolerancia)
+                return a.melhorSecao > b.melhorSecao;
+            break;
+        case CriterioDesempate::MenorVariancia:
+            if (qAbs(a.variancia - b.variancia) > Tolerancia)
+                return a.variancia < b.variancia;
+            break;
+        case CriterioDesempate::PrimeiraSubmissao:
+            if (a.primeiraNota != b.primeiraNota)
+                return a.primeiraNota < b.primeiraNota;
+            break;
+        }
+    }
+    return a.idProjeto < b.idProjeto;
+}
+
+// ================== MANUTENÇÃO ==================
+
+void RankingProjetos::reconstruir(const Repositorio& repo)
+{
+    m_itens.clear();
+    m_idxItens.clear();
+    m_membros.clear();
+    m_topo.clear();
+    m_avaliacoesDoProjeto.clear();
+
+    const QVector<Avaliacao>& avaliacoes = repo.avaliacoes();
+    for (int i = 0; i < avaliacoes.size(); ++i)
+        m_avaliacoesDoProjeto[avaliacoes[i].idProjeto].append(i);
+
+    // Primeira nota (menor idNota) de cada projeto
+    QHash<int, int> primeira;
+    for (const Nota& n : repo.notas()) {
+        const auto it = primeira.find(n.idProjeto);
+        if (it == primeira.end())
+            primeira.insert(n.idProjeto, n.idNota);
+        else if (n.idNota < it.value())
+            it.value() = n.idNota;
+    }
+
+    for (auto it = primeira.cbegin(); it != primeira.cend(); ++it)
+        atualizarItem(repo, it.key(), it.value());
+
+    for (auto it = m_membros.cbegin(); it != m_membros.cend(); ++it)
+        selecionar(it.key());
+}
+
+void RankingProjetos::acrescentarAvaliacoes(const Repositorio& repo, int primeira, int quantidade)
+{
+    const QVector<Avaliacao>& avaliacoes = repo.avaliacoes();
+    const int fim = qMin(primeira + quantidade, avaliacoes.size());
+    for (int i = primeira; i < fim; ++i)
+        m_avaliacoesDoProjeto[avaliacoes[i].idProjeto].append(i);
+}
+
+bool RankingProjetos::atualizarNota(const Repositorio& repo, int idNota)
+{
+    const Nota* n = repo.notaPorId(idNota);
+    if (!n)
+        return false;
+
+    atualizarItem(repo, n->idProjeto, idNota);
+    const auto it = m_idxItens.constFind(n->idProjeto);
+    if (it != m_idxItens.constEnd())
+        selecionar(m_itens[it.value()].grupo);
+    return true;
+}
+
+// Média, variância e quantidade vêm dos agregados do repositório (O(1));
+// só a nota de seção olha as avaliações, e apenas as deste projeto
+void RankingProjetos::atualizarItem(const Repositorio& repo, int idProjeto, int idNota)
+{
+    const Projeto* p = repo.projetoPorId(idProjeto);
+    const AgregadoProjeto* ag = repo.agregadoDoProjeto(idProjeto);
+    if (!p || !ag)
+        return;   // nota de projeto removido
+
+    const auto it = m_idxItens.constFind(idProjeto);
+    if (it == m_idxItens.constEnd()) {
+        ItemRanking novo;
+        novo.idProjeto    = idProjeto;
+        novo.grupo        = grupoDo(*p, repo);
+        novo.primeiraNota = idNota;
+        m_idxItens.insert(idProjeto, m_itens.size());
+        m_membros[novo.grupo].append(m_itens.size());
+        m_itens.append(novo);
+    }
+
+    ItemRanking& item = m_itens[m_idxItens.value(idProjeto)];
+    item.quantidadeNotas = ag->quantidade;
+    item.media           = ag->media();
+    item.variancia       = ag->variancia();
+    item.melhorSecao     = melhorSecao(repo, idProjeto);
+    item.primeiraNota    = qMin(item.primeiraNota, idNota);
+}
+
+// Escolhe os K primeiros do grupo com um heap cujo topo é o pior deles:
+// cada projeto só entra se passar à frente desse pior
+void RankingProjetos::selecionar(const QString& grupo)
+{
+    const QVector<int> membros = m_membros.value(grupo);
+    if (membros.isEmpty()) {
+        m_topo.remove(grupo);
+        return;
+    }
+
+    const int k = qMax(1, m_regras.tamanho);
+    const auto naFrente = [this](const ItemRanking* a, const ItemRanking* b) {
+        return precede(*a, *b);
+    };
+
+    QVector<const ItemRanking*> heap;
+    heap.reserve(qMin(k, membros.size()));
+    for (int i : membros) {
+        const ItemRanking* item = m_itens.constData() + i;
+        if (heap.size() < k) {
+            heap.append(item);
+            std::push_heap(heap.begin(), heap.end(), naFrente);
+        } else if (precede(*item, *heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), naFrente);
+            heap.last() = item;
+            std::push_heap(heap.begin(), heap.end(), naFrente);
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), naFrente);
+
+    QVector<ItemRanking>& topo = m_topo[grupo];
+    topo.clear();
+    topo.reserve(heap.size());
+    for (const ItemRanking* item : heap) {
+        topo.append(*item);
+        topo.last().posicao = topo.size();
+    }
+}
+
+// ================== CRITÉRIOS ==================
+
+QString RankingProjetos::grupoDo(const Projeto& p, const Repositorio& repo) const
+{
+    QString grupo;
+    if (m_regras.agrupamento == AgrupamentoRanking::Categoria) {
+        grupo = p.categoria.trimmed();
+        return grupo.isEmpty() ? QString("(sem categoria)") : grupo;
+    }
+
+    const Ficha* f = repo.fichaPorId(p.idFicha);
+    grupo = f ? f->tipoFicha.trimmed() : QString();
+    return grupo.isEmpty() ? QString("(sem ficha)") : grupo;
+}
+
+// Maior média de seção do projeto: média dos quesitos digitados de cada
+// seção, na última avaliação de cada avaliador (a que vale para a nota)
+double RankingProjetos::melhorSecao(const Repositorio& repo, int idProjeto) const
+{
+    const QVector<Avaliacao>& avaliacoes = repo.avaliacoes();
+
+    QHash<Cpf, int> ultima;
+    for (int i : m_avaliacoesDoProjeto.value(idProjeto))
+        ultima.insert(Cpf(avaliacoes[i].cpfAvaliador), i);
+
+    QVector<double> somas;     // por seção
+    QVector<int>    contagens;
+    for (auto it = ultima.cbegin(); it != ultima.cend(); ++it) {
+        const Avaliacao& a = avaliacoes[it.value()];
+        const Ficha* f = repo.fichaPorId(a.idFicha);
+        if (!f || a.notasQuesitos.size() != quantidadeDigitados(*f))
+            continue;
+
+        if (somas.size() < f->secoes.size()) {
+            somas.resize(f->secoes.size());
+            contagens.resize(f->secoes.size());
+        }
+
+        int pos = 0;
+        for (int s = 0; s < f->secoes.size(); ++s) {
+            double soma = 0.0;
+            int digitados = 0;
+            for (const Quesito& q : f->secoes[s].quesitos) {
+                if (q.autoCalculado)
+                    continue;
+                soma += a.notasQuesitos[pos++];
+                ++digitados;
+            }
+            if (digitados == 0)
+                continue;
+            somas[s] += soma / digitados;
+            ++contagens[s];
+        }
+    }
+
+    double melhor = 0.0;
+    for (int s = 0; s < somas.size(); ++s)
+        if (contagens[s] > 0)
+            melhor = qMax(melhor, somas[s] / contagens[s]);
+    return melhor;
+}
@@ -0,0 +1,91 @@
+// rankingprojetos.h
+#pragma once
+
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "registros.h"
+
+class Repositorio;
+
+// ===== Ranking dos projetos =====
+//
+// Os K primeiros projetos de cada grupo (categoria do projeto ou tipo da
+// ficha), pela média das notas. Cada grupo guarda os seus projetos e o
+// topo é escolhido com um heap de K posições (O(n log K)), sem ordenar o
+// grupo inteiro. Uma nota alterada refaz só o projeto dela e o topo do
+// grupo dele.
+//
+// Médias iguais (diferença até 1e-9) são desempatadas pelos critérios de
+// RegrasRanking::desempate, na ordem dada, e por último pelo ID do projeto.
+
+enum class CriterioDesempate : quint8 {
+    MaiorSecao,          // maior média de uma seção da ficha
+    MenorVariancia,      // notas mais parecidas entre os avaliadores
+    PrimeiraSubmissao    // primeira nota lançada antes (menor idNota)
+};
+
+enum class AgrupamentoRanking : quint8 {
+    Categoria,           // Projeto::categoria (Técnico, Graduação...)
+    TipoFicha            // Ficha::tipoFicha da ficha do projeto
+};
+
+struct RegrasRanking {
+    int                        tamanho{3};   // K
+    AgrupamentoRanking         agrupamento{AgrupamentoRanking::Categoria};
+    QVector<CriterioDesempate> desempate{CriterioDesempate::MaiorSecao,
+                                         CriterioDesempate::MenorVariancia,
+                                         CriterioDesempate::PrimeiraSubmissao};
+};
+
+struct ItemRanking {
+    int     idProjeto{0};
+    QString grupo;
+    int     quantidadeNotas{0};
+    double  media{0.0};
+    double  variancia{0.0};
+    double  melhorSecao{0.0};
+    int     primeiraNota{0};
+    int     posicao{0};          // 1..K dentro do grupo (só no topo)
+};
+
+class RankingProjetos
+{
+public:
+    const RegrasRanking& regras() const { return m_regras; }
+    void definirRegras(const RegrasRanking& regras, const Repositorio& repo);
+
+    // Uma passada pelas notas e avaliações
+    void reconstruir(const Repositorio& repo);
+
+    // Avaliações acrescentadas ao fim de Repositorio::avaliacoes() (só
+    // indexa; as notas correspondentes chegam por atualizarNota)
+    void acrescentarAvaliacoes(const Repositorio& repo, int primeira, int quantidade);
+
+    // Nota lançada ou alterada: refaz o projeto dela e o topo do grupo.
+    // Devolve false se a nota não existe mais (caso de reconstruir).
+    bool atualizarNota(const Repositorio& repo, int idNota);
+
+    QStringList grupos() const { return m_topo.keys(); }
+    QVector<ItemRanking> topo(const QString& grupo) const { return m_topo.value(grupo); }
+
+    // a fica à frente de b
+    bool precede(const ItemRanking& a, const ItemRanking& b) const;
+
+private:
+    QString grupoDo(const Projeto& p, const Repositorio& repo) const;
+    double  melhorSecao(const Repositorio& repo, int idProjeto) const;
+    void    atualizarItem(const Repositorio& repo, int idProjeto, int idNota);
+    void    selecionar(const QString& grupo);
+
+    RegrasRanking m_regras;
+
+    QVector<ItemRanking>          m_itens;        // projetos com nota
+    QHash<int, int>               m_idxItens;     // idProjeto -> posição
+    QMap<QString, QVector<int>>   m_membros;      // grupo -> posições
+    QMap<QString, QVector<ItemRanking>> m_topo;   // grupo -> K primeiros
+    QHash<int, QVector<int>>      m_avaliacoesDoProjeto;
+};
@@ -0,0 +1,62 @@
+// registros.h
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+// ===== Registros dos arquivos de dados =====
+
+// projetos.txt: ID;Nome;Descricao;Responsavel;Categoria;Status;Ficha;IdFicha;Versao
+//
+// 'versao' conta as gravações do registro: quem grava informa a versão em
+// que se baseou e a gravação é recusada se outra estação gravou antes
+// (ver armazenamentoarquivos.cpp). Arquivos antigos, sem a coluna, ficam 0.
+struct Projeto {
+    int     id{0};
+    QString nome;
+    QString descricao;
+    QString responsavel;
+    QString categoria;
+    QString status{"Cadastrado"};
+    QString ficha{"Não definida"};
+    int     idFicha{-1};
+    int     versao{0};
+};
+
+// avaliadores.csv: ID;Nome;Email;CPF;Categoria;Senha;Status;ProjetosAtrib;Versao
+struct Avaliador {
+    int     id{0};
+    QString nome;
+    QString email;
+    QString cpf;
+    QString categoria;
+    QString senha;
+    QString status{"Ativo"};
+    int     projetosAtribuidos{0};
+    int     versao{0};
+};
+
+// notas.csv: idNota;idProjeto;cpfAvaliador;nomeAvaliador;notaFinal;idFicha;versao
+struct Nota {
+    int     idNota{0};
+    int     idProjeto{0};
+    int     idFicha{0};
+    QString cpfAvaliador;   // sempre normalizado (só dígitos)
+    QString nomeAvaliador;
+    double  notaFinal{0.0};
+    int     versao{0};
+};
+
+// avaliacoes.csv: idProjeto;nomeProjeto;responsavel;idFicha;nomeFicha;
+//                 cpfAvaliador;nomeAvaliador;notaFinal;notasQuesitos(a|b|c)
+struct Avaliacao {
+    int     idProjeto{0};
+    QString nomeProjeto;
+    QString responsavel;
+    int     idFicha{0};
+    QString nomeFicha;
+    QString cpfAvaliador;
+    QString nomeAvaliador;
+    double  notaFinal{0.0};
+    QVector<double> notasQuesitos;
+};
@@ -0,0 +1,917 @@
+// repositorio.cpp
+#include "repositorio.h"
+#include "armazenamentoarquivos.h"
+#include "acompanhamentoavaliacoes.h"
+#include "motornotas.h"
+
+#include <QTimer>
+#include <QFutureWatcher>
+#include <QMessageBox>
+#include <QtConcurrent>
+#include <QThreadPool>
+#include <QSet>
+
+#include <algorithm>
+
+Repositorio* Repositorio::s_instancia = nullptr;
+
+namespace {
+
+// Roda 'ler' numa thread de trabalho e entrega o vetor lido para
+// 'entregar' na thread de 'dono'
+template <typename T, typename Ler, typename Entregar>
+void lerEmSegundoPlano(QObject* dono, Ler ler, Entregar entregar)
+{
+    struct Lido {
+        QVector<T> dados;
+        bool       ok{false};
+    };
+
+    auto* observador = new QFutureWatcher<Lido>(dono);
+    QObject::connect(observador, &QFutureWatcherBase::finished, dono, [observador, entregar] {
+        Lido lido = observador->result();
+        observador->deleteLater();
+        entregar(lido.dados, lido.ok);
+    });
+    observador->setFuture(QtConcurrent::run([ler] {
+        Lido lido;
+        lido.ok = ler(lido.dados);
+        return lido;
+    }));
+}
+
+} // namespace
+
+// ================== CONSTRUTOR / INSTÂNCIA ==================
+
+Repositorio::Repositorio(QObject* parent)
+    : QObject(parent)
+    , m_armazenamento(new ArmazenamentoArquivos)
+{
+    Q_ASSERT(!s_instancia);
+    s_instancia = this;
+    conectarArmazenamento();
+
+    // Índice de conflitos depende destes cadastros; refeito sob demanda
+    const auto desatualizar = [this] { m_conflitosDesatualizados = true; };
+    connect(this, &Repositorio::projetosAlterados,    this, desatualizar);
+    connect(this, &Repositorio::avaliadoresAlterados, this, desatualizar);
+    connect(this, &Repositorio::projetoAlterado,      this, desatualizar);
+    connect(this, &Repositorio::avaliadorAlterado,    this, desatualizar);
+    connect(this, &Repositorio::fichasAlteradas,      this, desatualizar);
+    connect(this, &Repositorio::conflitosAlterados,   this, desatualizar);
+}
+
+Repositorio::~Repositorio()
+{
+    // Leituras da carga inicial ainda rodando usam o backend
+    QThreadPool::globalInstance()->waitForDone();
+
+    // Gravações agrupadas ainda na fila vão para o disco antes de sair
+    m_armazenamento->descarregar();
+    m_armazenamento->definirAvisoGravacao(nullptr);
+    m_armazenamento->definirAvisoConflitos(nullptr);
+
+    if (s_instancia == this)
+        s_instancia = nullptr;
+}
+
+Repositorio& Repositorio::instancia()
+{
+    Q_ASSERT(s_instancia);
+    return *s_instancia;
+}
+
+void Repositorio::definirArmazenamento(std::unique_ptr<Armazenamento> armazenamento)
+{
+    if (armazenamento) {
+        m_armazenamento = std::move(armazenamento);
+        conectarArmazenamento();
+    }
+}
+
+void Repositorio::conectarArmazenamento()
+{
+    // Outra estação mexeu na mesma coleção: relê fora da pilha da gravação
+    m_armazenamento->definirAvisoAlteracaoExterna([this](const QString& colecao) {
+        QTimer::singleShot(0, this, [this, colecao] { recarregarColecao(colecao); });
+    });
+    m_armazenamento->definirAvisoGravacao([this](const QString& colecao, bool ok) {
+        emit gravacaoConcluida(colecao, ok);
+    });
+    m_armazenamento->definirAvisoConflitos(
+        [this](const QString&, const QList<int>&, const QString& mensagem) {
+            emit gravacaoRecusada(mensagem);
+        });
+
+    AcompanhamentoAvaliacoes* acomp = m_armazenamento->acompanhamentoAvaliacoes();
+    if (!acomp)
+        return;
+
+    // Durante a carga inicial o acompanhamento ainda não foi posicionado;
+    // o que chegar até lá entra pela própria carga
+    connect(acomp, &AcompanhamentoAvaliacoes::novasAvaliacoes,
+            this, [this](const QVector<Avaliacao>& novas) {
+        if (!carregando())
+            mesclarAvaliacoesExternas(novas);
+    });
+    // Arquivo reescrito por outra estação: não dá para saber o que mudou
+    connect(acomp, &AcompanhamentoAvaliacoes::arquivoSubstituido, this, [this] {
+        if (carregando())
+            return;
+        recarregarAvaliacoes();
+        recarregarNotas();
+    });
+}
+
+void Repositorio::recarregarColecao(const QString& colecao)
+{
+    if (colecao == "projetos")         recarregarProjetos();
+    else if (colecao == "avaliadores") recarregarAvaliadores();
+    else if (colecao == "fichas")      recarregarFichas();
+    else if (colecao == "vinculos")    recarregarVinculos();
+    else if (colecao == "notas")       recarregarNotas();
+    else if (colecao == "avaliacoes")  recarregarAvaliacoes();
+    else if (colecao == "conflitos")   recarregarConflitos();
+}
+
+bool Repositorio::carregarTudo()
+{
+    if (!m_armazenamento->abrir())
+        return false;
+
+    bool ok = recarregarFichas();
+    ok = recarregarProjetos()    && ok;
+    ok = recarregarAvaliadores() && ok;
+    ok = recarregarVinculos()    && ok;
+    ok = recarregarNotas()       && ok;
+    ok = recarregarAvaliacoes()  && ok;
+    ok = recarregarConflitos()   && ok;
+    return ok;
+}
+
+void Repositorio::carregarEmSegundoPlano()
+{
+    if (carregando())
+        return;
+
+    Armazenamento* arm = m_armazenamento.get();
+    if (!arm->leituraParalela()) {
+        emit carregamentoConcluido(carregarTudo());
+        return;
+    }
+    if (!arm->abrir()) {
+        emit carregamentoConcluido(false);
+        return;
+    }
+
+    m_cargasPendentes = 6;
+    m_cargaOk = recarregarConflitos();   // lista pequena: lida aqui mesmo
+
+    lerEmSegundoPlano<Ficha>(this,
+        [arm](QVector<Ficha>& v) { return arm->lerFichas(v); },
+        [this](QVector<Ficha>& v, bool ok) { substituirFichas(v); concluirCarga(ok); });
+    lerEmSegundoPlano<Projeto>(this,
+        [arm](QVector<Projeto>& v) { return arm->lerProjetos(v); },
+        [this](QVector<Projeto>& v, bool ok) { substituirProjetos(v); concluirCarga(ok); });
+    lerEmSegundoPlano<Avaliador>(this,
+        [arm](QVector<Avaliador>& v) { return arm->lerAvaliadores(v); },
+        [this](QVector<Avaliador>& v, bool ok) { substituirAvaliadores(v); concluirCarga(ok); });
+    lerEmSegundoPlano<VinculoProjeto>(this,
+        [arm](QVector<VinculoProjeto>& v) { return arm->lerVinculos(v); },
+        [this](QVector<VinculoProjeto>& v, bool ok) { substituirVinculos(v); concluirCarga(ok); });
+    lerEmSegundoPlano<Nota>(this,
+        [arm](QVector<Nota>& v) { return arm->lerNotas(v); },
+        [this](QVector<Nota>& v, bool ok) { substituirNotas(v); concluirCarga(ok); });
+    lerEmSegundoPlano<Avaliacao>(this,
+        [arm](QVector<Avaliacao>& v) { return arm->lerAvaliacoes(v); },
+        [this, arm](QVector<Avaliacao>& v, bool ok) {
+            if (ok)
+                arm->avaliacoesLidas(v);
+            substituirAvaliacoes(v);
+            concluirCarga(ok);
+        });
+}
+
+void Repositorio::concluirCarga(bool ok)
+{
+    m_cargaOk = m_cargaOk && ok;
+    if (--m_cargasPendentes > 0)
+        return;
+
+    if (!m_cargaOk) {
+        QMessageBox::warning(nullptr, "Carregar",
+                             "Alguns arquivos de dados não puderam ser lidos ("
+                                 + m_armazenamento->descricao() + ").");
+    }
+    emit carregamentoConcluido(m_cargaOk);
+}
+
+// ================== ÍNDICES ==================
+
+void Repositorio::reindexarProjetos()
+{
+    m_idxProjetos.clear();
+    m_idxProjetos.reserve(m_projetos.size());
+    int maxId = 0;
+    for (int i = 0; i < m_projetos.size(); ++i) {
+        m_idxProjetos.insert(m_projetos[i].id, i);
+        maxId = std::max(maxId, m_projetos[i].id);
+    }
+    m_nextIdProjeto = maxId + 1;
+}
+
+void Repositorio::reindexarAvaliadores()
+{
+    m_idxAvaliadoresId.clear();
+    m_idxAvaliadoresCpf.clear();
+    m_idxAvaliadoresId.reserve(m_avaliadores.size());
+    m_idxAvaliadoresCpf.reserve(m_avaliadores.size());
+    int maxId = 0;
+    for (int i = 0; i < m_avaliadores.size(); ++i) {
+        const Avaliador& a = m_avaliadores[i];
+        m_idxAvaliadoresId.insert(a.id, i);
+        const Cpf cpf(a.cpf);
+        if (!cpf.vazio() && !m_idxAvaliadoresCpf.contains(cpf))
+            m_idxAvaliadoresCpf.insert(cpf, i);
+        maxId = std::max(maxId, a.id);
+    }
+    m_nextIdAvaliador = maxId + 1;
+}
+
+void Repositorio::reindexarFichas()
+{
+    m_idxFichas.clear();
+    m_idxFichas.reserve(m_fichas.size());
+    int maxId = 0;
+    for (int i = 0; i < m_fichas.size(); ++i) {
+        m_idxFichas.insert(m_fichas[i].id, i);
+        maxId = std::max(maxId, m_fichas[i].id);
+    }
+    m_nextIdFicha = maxId + 1;
+}
+
+void Repositorio::reindexarVinculos()
+{
+    m_idxVinculos.reconstruir(m_vinculos);
+    atualizarContagemProjetos();
+}
+
+void Repositorio::reindexarNotas()
+{
+    m_idxNotas.clear();
+    m_idxNotaDoAvaliador.clear();
+    m_idxNotas.reserve(m_notas.size());
+    m_idxNotaDoAvaliador.reserve(m_notas.size());
+    int maxId = 0;
+    for (int i = 0; i < m_notas.size(); ++i) {
+        const Nota& n = m_notas[i];
+        m_idxNotas.insert(n.idNota, i);
+        // Mesma busca linear de antes: vale a primeira nota do par
+        const auto chave = qMakePair(n.idProjeto, Cpf(n.cpfAvaliador));
+        if (!m_idxNotaDoAvaliador.contains(chave))
+            m_idxNotaDoAvaliador.insert(chave, i);
+        maxId = std::max(maxId, n.idNota);
+    }
+    m_nextIdNota = maxId + 1;
+}
+
+void Repositorio::atualizarContagemProjetos()
+{
+    for (Avaliador& a : m_avaliadores)
+        a.projetosAtribuidos = m_idxVinculos.contarProjetos(Cpf(a.cpf));
+}
+
+// ================== PROJETOS ==================
+
+const Projeto* Repositorio::projetoPorId(int id) const
+{
+    const auto it = m_idxProjetos.constFind(id);
+    return it == m_idxProjetos.constEnd() ? nullptr : &m_projetos[it.value()];
+}
+
+int Repositorio::adicionarProjeto(Projeto p)
+{
+    p.id = m_nextIdProjeto++;
+    p.versao = 1;
+    m_idxProjetos.insert(p.id, m_projetos.size());
+    m_idxTextoProjetos.indexar(p);
+    m_projetos.append(p);
+    m_armazenamento->gravarProjetoNovo(m_projetos, p);
+    emit projetosAlterados();
+    return p.id;
+}
+
+bool Repositorio::atualizarProjeto(const Projeto& p)
+{
+    const auto it = m_idxProjetos.constFind(p.id);
+    if (it == m_idxProjetos.constEnd())
+        return false;
+    Projeto& alvo = m_projetos[it.value()];
+    const int versao = alvo.versao + 1;   // baseada na versão carregada aqui
+    alvo = p;
+    alvo.versao = versao;
+    m_idxTextoProjetos.indexar(alvo);
+    const bool ok = m_armazenamento->gravarProjeto(m_projetos, alvo);
+    emit projetoAlterado(p.id);
+    return ok;
+}
+
+bool Repositorio::removerProjeto(int id)
+{
+    const auto it = m_idxProjetos.constFind(id);
+    if (it == m_idxProjetos.constEnd())
+        return false;
+    m_projetos.remove(it.value());
+    m_idxTextoProjetos.remover(id);
+    const int proximo = m_nextIdProjeto;
+    reindexarProjetos();
+    m_nextIdProjeto = std::max(proximo, m_nextIdProjeto);
+    const bool ok = m_armazenamento->removerProjeto(m_projetos, id);
+    emit projetosAlterados();
+
+    // Remove vínculos desse projeto (se houver)
+    const int antes = m_vinculos.size();
+    removerVinculosPorProjeto(m_vinculos, id);
+    if (m_vinculos.size() != antes) {
+        m_idxVinculos.removerProjeto(id);
+        atualizarContagemProjetos();
+        m_armazenamento->gravarVinculosDoProjeto(m_vinculos, id);
+        emit vinculosAlterados();
+    }
+    return ok;
+}
+
+bool Repositorio::recarregarProjetos()
+{
+    QVector<Projeto> lidos;
+    const bool ok = m_armazenamento->carregarProjetos(lidos);
+    substituirProjetos(lidos);
+    return ok;
+}
+
+QVector<int> Repositorio::buscarProjetos(const QString& consulta) const
+{
+    return m_idxTextoProjetos.buscar(consulta);
+}
+
+void Repositorio::substituirProjetos(QVector<Projeto>& lidos)
+{
+    m_projetos.swap(lidos);
+    reindexarProjetos();
+    m_idxTextoProjetos.reconstruir(m_projetos);
+    emit projetosAlterados();
+    emit projetosRecarregados();
+}
+
+// ================== AVALIADORES ==================
+
+const Avaliador* Repositorio::avaliadorPorId(int id) const
+{
+    const auto it = m_idxAvaliadoresId.constFind(id);
+    return it == m_idxAvaliadoresId.constEnd() ? nullptr : &m_avaliadores[it.value()];
+}
+
+const Avaliador* Repositorio::avaliadorPorCpf(const QString& cpf) const
+{
+    const auto it = m_idxAvaliadoresCpf.constFind(Cpf(cpf));
+    return it == m_idxAvaliadoresCpf.constEnd() ? nullptr : &m_avaliadores[it.value()];
+}
+
+int Repositorio::adicionarAvaliador(Avaliador a)
+{
+    a.id = m_nextIdAvaliador++;
+    a.versao = 1;
+    a.projetosAtribuidos = contarProjetosDoAvaliador(a.cpf);
+    m_avaliadores.append(a);
+    m_idxTrigramasAvaliadores.indexar(a);
+    const int proximo = m_nextIdAvaliador;
+    reindexarAvaliadores();
+    m_nextIdAvaliador = std::max(proximo, m_nextIdAvaliador);
+    m_armazenamento->gravarAvaliadorNovo(m_avaliadores, a);
+    emit avaliadoresAlterados();
+    return a.id;
+}
+
+bool Repositorio::atualizarAvaliador(const Avaliador& a)
+{
+    const auto it = m_idxAvaliadoresId.constFind(a.id);
+    if (it == m_idxAvaliadoresId.constEnd())
+        return false;
+    Avaliador& alvo = m_avaliadores[it.value()];
+    const int versao = alvo.versao + 1;
+    alvo = a;
+    alvo.versao = versao;
+    alvo.projetosAtribuidos = contarProjetosDoAvaliador(a.cpf);
+    const Avaliador gravado = alvo;
+    m_idxTrigramasAvaliadores.indexar(gravado);
+    const int proximo = m_nextIdAvaliador;
+    reindexarAvaliadores();
+    m_nextIdAvaliador = std::max(proximo, m_nextIdAvaliador);
+    const bool ok = m_armazenamento->gravarAvaliador(m_avaliadores, gravado);
+    emit avaliadorAlterado(gravado.id);
+    return ok;
+}
+
+bool Repositorio::removerAvaliador(int id)
+{
+    const auto it = m_idxAvaliadoresId.constFind(id);
+    if (it == m_idxAvaliadoresId.constEnd())
+        return false;
+
+    // Guarda CPF antes de remover
+    const QString cpfRemovido = m_avaliadores[it.value()].cpf;
+
+    m_avaliadores.remove(it.value());
+    m_idxTrigramasAvaliadores.remover(id);
+    const int proximo = m_nextIdAvaliador;
+    reindexarAvaliadores();
+    m_nextIdAvaliador = std::max(proximo, m_nextIdAvaliador);
+    const bool ok = m_armazenamento->removerAvaliador(m_avaliadores, id);
+    emit avaliadoresAlterados();
+
+    // Limpa vínculos desse avaliador
+    const int antes = m_vinculos.size();
+    removerVinculosPorAvaliador(m_vinculos, cpfRemovido);
+    if (m_vinculos.size() != antes) {
+        m_idxVinculos.removerAvaliador(Cpf(cpfRemovido));
+        atualizarContagemProjetos();
+        m_armazenamento->removerVinculosDoAvaliador(m_vinculos, cpfRemovido);
+        emit vinculosAlterados();
+    }
+    return ok;
+}
+
+bool Repositorio::recarregarAvaliadores()
+{
+    QVector<Avaliador> lidos;
+    const bool ok = m_armazenamento->carregarAvaliadores(lidos);
+    substituirAvaliadores(lidos);
+    return ok;
+}
+
+QVector<int> Repositorio::buscarAvaliadores(const QString& consulta) const
+{
+    return m_idxTrigramasAvaliadores.buscar(consulta);
+}
+
+void Repositorio::substituirAvaliadores(QVector<Avaliador>& lidos)
+{
+    m_avaliadores.swap(lidos);
+    reindexarAvaliadores();
+    m_idxTrigramasAvaliadores.reconstruir(m_avaliadores);
+    atualizarContagemProjetos();
+    emit avaliadoresAlterados();
+    emit avaliadoresRecarregados();
+}
+
+// ================== FICHAS ==================
+
+const Ficha* Repositorio::fichaPorId(int id) const
+{
+    const auto it = m_idxFichas.constFind(id);
+    return it == m_idxFichas.constEnd() ? nullptr : &m_fichas[it.value()];
+}
+
+int Repositorio::adicionarFicha(Ficha f)
+{
+    f.id = m_nextIdFicha++;
+    m_idxFichas.insert(f.id, m_fichas.size());
+    m_fichas.append(f);
+    m_armazenamento->gravarFichaNova(m_fichas, f);
+    emit fichasAlteradas();
+    return f.id;
+}
+
+bool Repositorio::atualizarFicha(const Ficha& f)
+{
+    const auto it = m_idxFichas.constFind(f.id);
+    if (it == m_idxFichas.constEnd())
+        return false;
+    m_fichas[it.value()] = f;
+    const bool ok = m_armazenamento->gravarFicha(m_fichas, f);
+    emit fichasAlteradas();
+    return ok;
+}
+
+int Repositorio::recalcularNotasDaFicha(int idFicha)
+{
+    const Ficha* f = fichaPorId(idFicha);
+    if (!f)
+        return -1;
+
+    const PesosFicha pesos(*f);
+    const int alteradas = recalcularNotasFinais(pesos, m_avaliacoes);
+    if (alteradas == 0)
+        return 0;
+    const bool ok = m_armazenamento->recalcularNotasDaFicha(m_avaliacoes, pesos);
+    emit avaliacoesAlteradas();
+
+    // A nota de (projeto, avaliador) é a da última avaliação lançada
+    QHash<QPair<int, Cpf>, double> ultimas;
+    for (const Avaliacao& a : m_avaliacoes) {
+        if (a.idFicha == idFicha)
+            ultimas.insert(qMakePair(a.idProjeto, Cpf(a.cpfAvaliador)), a.notaFinal);
+    }
+
+    bool notasOk = true;
+    bool notasMudaram = false;
+    for (auto it = ultimas.cbegin(); it != ultimas.cend(); ++it) {
+        const int i = indiceNotaDoAvaliador(it.key().first, it.key().second);
+        if (i < 0 || m_notas[i].idFicha != idFicha
+            || qAbs(m_notas[i].notaFinal - it.value()) <= 1e-9)
+            continue;
+        Nota& n = m_notas[i];
+        m_agregados.substituir(n.idProjeto, n.notaFinal, n.idProjeto, it.value());
+        n.notaFinal = it.value();
+        ++n.versao;
+        notasOk = m_armazenamento->gravarNota(m_notas, n) && notasOk;
+        notasMudaram = true;
+    }
+    if (notasMudaram)
+        emit notasAlteradas();
+
+    return (ok && notasOk) ? alteradas : -1;
+}
+
+bool Repositorio::removerFicha(int id)
+{
+    const auto it = m_idxFichas.constFind(id);
+    if (it == m_idxFichas.constEnd())
+        return false;
+    m_fichas.remove(it.value());
+    const int proximo = m_nextIdFicha;
+    reindexarFichas();
+    m_nextIdFicha = std::max(proximo, m_nextIdFicha);
+    const bool ok = m_armazenamento->removerFicha(m_fichas, id);
+    emit fichasAlteradas();
+    return ok;
+}
+
+bool Repositorio::recarregarFichas()
+{
+    QVector<Ficha> lidas;
+    const bool ok = m_armazenamento->carregarFichas(lidas);
+    substituirFichas(lidas);
+    return ok;
+}
+
+void Repositorio::substituirFichas(QVector<Ficha>& lidas)
+{
+    m_fichas.swap(lidas);
+    reindexarFichas();
+    emit fichasAlteradas();
+    emit fichasRecarregadas();
+}
+
+// ================== VÍNCULOS ==================
+
+QList<int> Repositorio::projetosDoAvaliador(const QString& cpf) const
+{
+    return m_idxVinculos.projetosDoAvaliador(Cpf(cpf));
+}
+
+QStringList Repositorio::avaliadoresDoProjeto(int idProjeto) const
+{
+    return m_idxVinculos.avaliadoresDoProjeto(idProjeto);
+}
+
+int Repositorio::contarProjetosDoAvaliador(const QString& cpf) const
+{
+    return m_idxVinculos.contarProjetos(Cpf(cpf));
+}
+
+bool Repositorio::vinculado(int idProjeto, const QString& cpf) const
+{
+    return m_idxVinculos.vinculado(idProjeto, Cpf(cpf));
+}
+
+bool Repositorio::definirAvaliadoresDoProjeto(int idProjeto, const QStringList& cpfs)
+{
+    // Mesmo conjunto de avaliadores: nada a gravar
+    QSet<Cpf> atuais, novos;
+    for (const QString& cpf : m_idxVinculos.avaliadoresDoProjeto(idProjeto))
+        atuais.insert(Cpf(cpf));
+    for (const QString& cpf : cpfs)
+        novos.insert(Cpf(cpf));
+    if (atuais == novos)
+        return true;
+
+    removerVinculosPorProjeto(m_vinculos, idProjeto);
+    for (const QString& cpf : cpfs) {
+        VinculoProjeto v;
+        v.idProjeto    = idProjeto;
+        v.cpfAvaliador = cpf;
+        m_vinculos.push_back(v);
+    }
+
+    m_idxVinculos.definirProjeto(idProjeto, cpfs);
+    atualizarContagemProjetos();
+    const bool ok = m_armazenamento->gravarVinculosDoProjeto(m_vinculos, idProjeto);
+    emit vinculosAlterados();
+    return ok;
+}
+
+bool Repositorio::definirVinculosEmLote(const QHash<int, QStringList>& avaliadoresPorProjeto)
+{
+    if (avaliadoresPorProjeto.isEmpty())
+        return true;
+
+    QSet<int> ids;
+    ids.reserve(avaliadoresPorProjeto.size());
+    for (auto it = avaliadoresPorProjeto.cbegin(); it != avaliadoresPorProjeto.cend(); ++it)
+        ids.insert(it.key());
+
+    m_vinculos.erase(std::remove_if(m_vinculos.begin(), m_vinculos.end(),
+                                    [&ids](const VinculoProjeto& v) {
+                                        return ids.contains(v.idProjeto);
+                                    }),
+                     m_vinculos.end());
+    for (auto it = avaliadoresPorProjeto.cbegin(); it != avaliadoresPorProjeto.cend(); ++it) {
+        for (const QString& cpf : it.value()) {
+            VinculoProjeto v;
+            v.idProjeto    = it.key();
+            v.cpfAvaliador = cpf;
+            m_vinculos.push_back(v);
+        }
+        m_idxVinculos.definirProjeto(it.key(), it.value());
+    }
+    atualizarContagemProjetos();
+    bool ok = m_armazenamento->gravarVinculosDosProjetos(m_vinculos, ids);
+
+    bool statusAlterado = false;
+    for (auto it = avaliadoresPorProjeto.cbegin(); it != avaliadoresPorProjeto.cend(); ++it) {
+        const auto idx = m_idxProjetos.constFind(it.key());
+        if (idx == m_idxProjetos.constEnd())
+            continue;
+        Projeto& p = m_projetos[idx.value()];
+        const QString status = statusPorAvaliadores(it.value().size());
+        if (p.status == status)
+            continue;
+        p.status = status;
+        ++p.versao;
+        ok = m_armazenamento->gravarProjeto(m_projetos, p) && ok;
+        statusAlterado = true;
+    }
+
+    emit vinculosAlterados();
+    if (statusAlterado)
+        emit projetosAlterados();
+    return ok;
+}
+
+bool Repositorio::recarregarVinculos()
+{
+    QVector<VinculoProjeto> lidos;
+    const bool ok = m_armazenamento->carregarVinculos(lidos);
+    substituirVinculos(lidos);
+    return ok;
+}
+
+void Repositorio::substituirVinculos(QVector<VinculoProjeto>& lidos)
+{
+    m_vinculos.swap(lidos);
+    reindexarVinculos();
+    emit vinculosAlterados();
+}
+
+// ================== CONFLITOS ==================
+
+bool Repositorio::definirConflitosDeclarados(const QVector<ConflitoDeclarado>& conflitos)
+{
+    m_conflitos = conflitos;
+    const bool ok = m_armazenamento->gravarConflitos(m_conflitos);
+    emit conflitosAlterados();
+    return ok;
+}
+
+bool Repositorio::recarregarConflitos()
+{
+    QVector<ConflitoDeclarado> lidos;
+    const bool ok = m_armazenamento->carregarConflitos(lidos);
+    m_conflitos.swap(lidos);
+    emit conflitosAlterados();
+    return ok;
+}
+
+const IndiceConflitos& Repositorio::indiceConflitos() const
+{
+    if (m_conflitosDesatualizados) {
+        m_idxConflitos.reconstruir(m_projetos, m_avaliadores, m_fichas, m_conflitos);
+        m_conflitosDesatualizados = false;
+    }
+    return m_idxConflitos;
+}
+
+MotivoConflito Repositorio::conflito(int idProjeto, const QString& cpf) const
+{
+    return indiceConflitos().conflito(idProjeto, Cpf(cpf));
+}
+
+// ================== NOTAS ==================
+
+const Nota* Repositorio::notaPorId(int idNota) const
+{
+    const auto it = m_idxNotas.constFind(idNota);
+    return it == m_idxNotas.constEnd() ? nullptr : &m_notas[it.value()];
+}
+
+int Repositorio::indiceNotaDoAvaliador(int idProjeto, const Cpf& cpf) const
+{
+    return m_idxNotaDoAvaliador.value(qMakePair(idProjeto, cpf), -1);
+}
+
+const Nota* Repositorio::notaDoAvaliador(int idProjeto, const QString& cpf) const
+{
+    const int i = indiceNotaDoAvaliador(idProjeto, Cpf(cpf));
+    return i < 0 ? nullptr : &m_notas[i];
+}
+
+bool Repositorio::salvarNota(const Nota& n)
+{
+    Nota gravada = n;
+    const auto chave = qMakePair(n.idProjeto, Cpf(n.cpfAvaliador));
+    bool mudouDeChave = false;
+    const auto it = m_idxNotas.constFind(n.idNota);
+    if (it == m_idxNotas.constEnd()) {
+        gravada.versao = 1;
+        m_agregados.acrescentar(n.idProjeto, n.notaFinal);
+        m_idxNotas.insert(n.idNota, m_notas.size());
+        if (!m_idxNotaDoAvaliador.contains(chave))
+            m_idxNotaDoAvaliador.insert(chave, m_notas.size());
+        m_notas.append(gravada);
+    } else {
+        Nota& atual = m_notas[it.value()];
+        const bool mesmaChave = atual.idProjeto == n.idProjeto
+                                && Cpf(atual.cpfAvaliador) == chave.second;
+        gravada.versao = atual.versao + 1;
+        m_agregados.substituir(atual.idProjeto, atual.notaFinal, n.idProjeto, n.notaFinal);
+        atual = gravada;
+        if (!mesmaChave) {
+            mudouDeChave = true;
+            const int proximo = m_nextIdNota;
+            reindexarNotas();
+            m_nextIdNota = std::max(proximo, m_nextIdNota);
+        }
+    }
+    if (n.idNota >= m_nextIdNota)
+        m_nextIdNota = n.idNota + 1;
+
+    const bool ok = m_armazenamento->gravarNota(m_notas, gravada);
+    // Nota que trocou de projeto/avaliador mexe em dois grupos: refaz tudo
+    if (mudouDeChave)
+        emit notasAlteradas();
+    else
+        emit notaAlterada(gravada.idNota);
+    return ok;
+}
+
+bool Repositorio::removerNota(int idNota)
+{
+    const auto it = m_idxNotas.constFind(idNota);
+    if (it == m_idxNotas.constEnd())
+        return false;
+
+    const Nota n = m_notas[it.value()];
+    const Cpf cpfDaNota(n.cpfAvaliador);
+    m_agregados.retirar(n.idProjeto, n.notaFinal);
+    m_notas.remove(it.value());
+    const int proximo = m_nextIdNota;
+    reindexarNotas();
+    m_nextIdNota = std::max(proximo, m_nextIdNota);
+    const bool ok = m_armazenamento->removerNota(m_notas, idNota);
+    emit notaRemovida(idNota, n.idProjeto);
+
+    // Remove também as avaliações detalhadas (quesitos)
+    const int antes = m_avaliacoes.size();
+    m_avaliacoes.erase(std::remove_if(m_avaliacoes.begin(), m_avaliacoes.end(),
+                                      [&n, &cpfDaNota](const Avaliacao& a) {
+                                          return a.idProjeto == n.idProjeto
+                                              && Cpf(a.cpfAvaliador) == cpfDaNota;
+                                      }),
+                       m_avaliacoes.end());
+    if (m_avaliacoes.size() != antes) {
+        m_armazenamento->removerAvaliacoes(m_avaliacoes, n.idProjeto, n.cpfAvaliador);
+        emit avaliacoesAlteradas();
+    }
+    return ok;
+}
+
+bool Repositorio::recarregarNotas()
+{
+    QVector<Nota> lidas;
+    const bool ok = m_armazenamento->carregarNotas(lidas);
+    substituirNotas(lidas);
+    return ok;
+}
+
+void Repositorio::substituirNotas(QVector<Nota>& lidas)
+{
+    m_notas.swap(lidas);
+    reindexarNotas();
+    m_agregados.reconstruir(m_notas);
+    emit notasAlteradas();
+
+    // Notas de avaliações externas que já chegaram ao backend
+    for (auto it = m_notasEsperadas.begin(); it != m_notasEsperadas.end(); ) {
+        if (m_idxNotaDoAvaliador.contains(*it))
+            it = m_notasEsperadas.erase(it);
+        else
+            ++it;
+    }
+    if (!m_notasEsperadas.isEmpty()) {
+        if (++m_tentativasNotasEsperadas < MaxTentativasNotasEsperadas) {
+            agendarRecargaNotasEsperadas();
+        } else {
+            // A estação de origem não gravou a nota (caiu, desistiu): a
+            // avaliação fica só no avaliacoes.csv
+            m_notasEsperadas.clear();
+            m_tentativasNotasEsperadas = 0;
+        }
+    }
+}
+
+// ================== AVALIAÇÕES (QUESITOS) ==================
+
+bool Repositorio::registrarAvaliacao(const Avaliacao& a)
+{
+    m_avaliacoes.append(a);
+    if (!m_armazenamento->registrarAvaliacao(m_avaliacoes, a)) {
+        m_avaliacoes.removeLast();
+        return false;
+    }
+
+    emit avaliacoesAlteradas();
+    return true;
+}
+
+bool Repositorio::recarregarAvaliacoes()
+{
+    QVector<Avaliacao> lidas;
+    const bool ok = m_armazenamento->carregarAvaliacoes(lidas);
+    substituirAvaliacoes(lidas);
+    return ok;
+}
+
+void Repositorio::substituirAvaliacoes(QVector<Avaliacao>& lidas)
+{
+    m_avaliacoes.swap(lidas);
+    emit avaliacoesAlteradas();
+}
+
+void Repositorio::mesclarAvaliacoesExternas(const QVector<Avaliacao>& novas)
+{
+    if (novas.isEmpty())
+        return;
+
+    const int primeira = m_avaliacoes.size();
+    m_avaliacoes += novas;
+
+    QList<int> alteradas;
+    for (const Avaliacao& a : novas) {
+        const Cpf cpf(a.cpfAvaliador);
+        const int i = indiceNotaDoAvaliador(a.idProjeto, cpf);
+
+        if (i < 0) {
+            // Nota ainda não conhecida aqui: quem grava é a estação de
+            // origem, no journal, logo depois da avaliação. Uma nota local
+            // inventada aqui viraria uma segunda nota do mesmo (projeto,
+            // avaliador) se fosse editada; as notas são relidas do backend.
+            if (!m_notasEsperadas.contains(qMakePair(a.idProjeto, cpf))) {
+                m_notasEsperadas.insert(qMakePair(a.idProjeto, cpf));
+                m_tentativasNotasEsperadas = 0;
+            }
+            continue;
+        }
+
+        Nota* n = &m_notas[i];
+        m_agregados.substituir(n->idProjeto, n->notaFinal, n->idProjeto, a.notaFinal);
+        n->idFicha       = a.idFicha;
+        n->nomeAvaliador = a.nomeAvaliador;
+        n->notaFinal     = a.notaFinal;
+
+        if (!alteradas.contains(n->idNota))
+            alteradas.append(n->idNota);
+    }
+
+    emit avaliacoesAcrescentadas(primeira, novas.size());
+    for (int idNota : alteradas)
+        emit notaAlterada(idNota);
+
+    if (!m_notasEsperadas.isEmpty())
+        agendarRecargaNotasEsperadas();
+}
+
+void Repositorio::agendarRecargaNotasEsperadas()
+{
+    if (m_recargaNotasAgendada)
+        return;
+    m_recargaNotasAgendada = true;
+
+    // Dá tempo para a gravação agrupada da estação de origem chegar ao disco
+    QTimer::singleShot(EsperaNotasExternasMs, this, [this] {
+        m_recargaNotasAgendada = false;
+        if (!m_notasEsperadas.isEmpty() && !carregando())
+            recarregarNotas();
+    });
+}
@@ -0,0 +1,244 @@
+// repositorio.h
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QPair>
+
+#include <memory>
+
+#include "registros.h"
+#include "cpf.h"
+#include "ficha.h"
+#include "vinculos.h"
+#include "conflitos.h"
+#include "indicetexto.h"
+#include "agregadosnotas.h"
+
+class Armazenamento;
+
+// ===== Repositório =====
+//
+// Dono único dos dados do sistema. Os dados são lidos uma vez na
+// inicialização e as páginas/diálogos consultam a memória pelos acessores e
+// índices abaixo. Toda alteração passa por aqui e é gravada no backend de
+// armazenamento (arquivos texto ou SQLite, ver armazenamento.h).
+//
+// Cada gravação de projeto, avaliador ou nota incrementa a 'versao' do
+// registro; o backend recusa a gravação se outra estação gravou o mesmo
+// registro depois da versão carregada aqui, e a coleção é recarregada.
+class Repositorio : public QObject
+{
+    Q_OBJECT
+public:
+    explicit Repositorio(QObject* parent = nullptr);
+    ~Repositorio() override;
+
+    static Repositorio& instancia();
+
+    // Backend de persistência (padrão: arquivos texto). Trocar antes de
+    // carregarTudo(); o repositório passa a ser o dono do objeto.
+    void definirArmazenamento(std::unique_ptr<Armazenamento> armazenamento);
+    Armazenamento& armazenamento() const { return *m_armazenamento; }
+
+    // Carrega todos os dados do backend
+    bool carregarTudo();
+
+    // Carregamento inicial sem segurar a janela: as coleções são lidas ao
+    // mesmo tempo em threads de trabalho e cada uma entra na memória (com o
+    // sinal de alteração dela) assim que fica pronta. No fim,
+    // carregamentoConcluido(). Backends sem leitura paralela são
+    // carregados na hora, como em carregarTudo().
+    void carregarEmSegundoPlano();
+    bool carregando() const { return m_cargasPendentes > 0; }
+
+    // ----- Projetos -----
+    const QVector<Projeto>& projetos() const { return m_projetos; }
+    const Projeto* projetoPorId(int id) const;
+    int  adicionarProjeto(Projeto p);              // devolve o id atribuído
+    bool atualizarProjeto(const Projeto& p);
+    bool removerProjeto(int id);                   // remove também os vínculos
+    bool recarregarProjetos();
+
+    // Busca em nome, descrição e responsável (todos os termos, aceitando
+    // prefixo); ids do mais relevante para o menos
+    QVector<int> buscarProjetos(const QString& consulta) const;
+
+    // ----- Avaliadores -----
+    const QVector<Avaliador>& avaliadores() const { return m_avaliadores; }
+    const Avaliador* avaliadorPorId(int id) const;
+    const Avaliador* avaliadorPorCpf(const QString& cpf) const;
+    int  adicionarAvaliador(Avaliador a);
+    bool atualizarAvaliador(const Avaliador& a);
+    bool removerAvaliador(int id);                 // remove também os vínculos
+    bool recarregarAvaliadores();
+
+    // Busca por nome ou e-mail tolerante a erro de digitação (trigramas);
+    // ids do mais parecido para o menos
+    QVector<int> buscarAvaliadores(const QString& consulta) const;
+
+    // ----- Fichas -----
+    const QVector<Ficha>& fichas() const { return m_fichas; }
+    const Ficha* fichaPorId(int id) const;
+    int  adicionarFicha(Ficha f);
+    bool atualizarFicha(const Ficha& f);
+    bool removerFicha(int id);
+    bool recarregarFichas();
+
+    // Depois de mudar os pesos dos quesitos: refaz a notaFinal das
+    // avaliações já lançadas na ficha e a nota de cada (projeto, avaliador)
+    // correspondente. Devolve quantas avaliações mudaram (-1 se não gravou).
+    int  recalcularNotasDaFicha(int idFicha);
+
+    // ----- Vínculos -----
+    const QVector<VinculoProjeto>& vinculos() const { return m_vinculos; }
+    QList<int>     projetosDoAvaliador(const QString& cpf) const;
+    QStringList    avaliadoresDoProjeto(int idProjeto) const;
+    int            contarProjetosDoAvaliador(const QString& cpf) const;
+    bool           vinculado(int idProjeto, const QString& cpf) const;
+    bool definirAvaliadoresDoProjeto(int idProjeto, const QStringList& cpfs);
+    // Vários projetos de uma vez (distribuição automática): uma gravação
+    // e um aviso só; o status dos projetos segue statusPorAvaliadores()
+    bool definirVinculosEmLote(const QHash<int, QStringList>& avaliadoresPorProjeto);
+    bool recarregarVinculos();
+
+    // ----- Conflitos de interesse -----
+    const QVector<ConflitoDeclarado>& conflitosDeclarados() const { return m_conflitos; }
+    bool definirConflitosDeclarados(const QVector<ConflitoDeclarado>& conflitos);
+    bool recarregarConflitos();
+    // Índice dos projetos, avaliadores, fichas e conflitos declarados,
+    // refeito na primeira consulta depois de uma alteração desses cadastros
+    const IndiceConflitos& indiceConflitos() const;
+    MotivoConflito conflito(int idProjeto, const QString& cpf) const;
+
+    // ----- Notas -----
+    const QVector<Nota>& notas() const { return m_notas; }
+    const Nota* notaPorId(int idNota) const;
+    const Nota* notaDoAvaliador(int idProjeto, const QString& cpf) const;
+    int  proximoIdNota() const { return m_nextIdNota; }
+    bool salvarNota(const Nota& n);                // insere ou atualiza por idNota
+    bool removerNota(int idNota);                  // remove também as avaliações
+    bool recarregarNotas();
+
+    // Média, desvio, mínima e máxima das notas de cada projeto, mantidas a
+    // cada alteração (nullptr = projeto sem notas)
+    const AgregadoProjeto* agregadoDoProjeto(int idProjeto) const
+    {
+        return m_agregados.doProjeto(idProjeto);
+    }
+    const QHash<int, AgregadoProjeto>& agregadosProjetos() const { return m_agregados.projetos(); }
+
+    // ----- Avaliações detalhadas (quesitos) -----
+    const QVector<Avaliacao>& avaliacoes() const { return m_avaliacoes; }
+    bool registrarAvaliacao(const Avaliacao& a);   // append em avaliacoes.csv
+    bool recarregarAvaliacoes();
+
+    // Avaliações acrescentadas por outras estações (ver acompanhamentoavaliacoes.h):
+    // entram no fim de avaliacoes() e atualizam a nota de (projeto, avaliador)
+    // só em memória — quem gravou foi a estação de origem. Se a nota ainda
+    // não existe aqui, as notas são relidas do backend em seguida.
+    void mesclarAvaliacoesExternas(const QVector<Avaliacao>& novas);
+
+signals:
+    void carregamentoConcluido(bool ok);
+
+    // Coleção inteira trocada pelo conteúdo do backend (carga ou recarga):
+    // as tabelas precisam ser refeitas
+    void projetosRecarregados();
+    void avaliadoresRecarregados();
+    void fichasRecarregadas();
+
+    void projetosAlterados();
+    void avaliadoresAlterados();
+    void fichasAlteradas();
+    void vinculosAlterados();
+    void notasAlteradas();
+    void avaliacoesAlteradas();
+    void conflitosAlterados();
+
+    // Um registro editado no lugar (mesma posição no vetor): emitidos em vez
+    // de projetosAlterados()/avaliadoresAlterados(), para as tabelas
+    // redesenharem só a linha dele
+    void projetoAlterado(int id);
+    void avaliadorAlterado(int id);
+
+    // Alterações pontuais (desta ou de outras estações): só as linhas
+    // afetadas precisam ser redesenhadas
+    void notaAlterada(int idNota);
+    void notaRemovida(int idNota, int idProjeto);
+    void avaliacoesAcrescentadas(int primeira, int quantidade);
+
+    // Gravação adiada de 'colecao' concluída; ok == false: não foi para o
+    // disco e o backend vai tentar de novo
+    void gravacaoConcluida(const QString& colecao, bool ok);
+
+    // Alteração daqui recusada porque outra estação gravou o mesmo registro
+    // antes; a coleção é relida em seguida
+    void gravacaoRecusada(const QString& mensagem);
+
+private:
+    static Repositorio* s_instancia;
+
+    QVector<Projeto>        m_projetos;
+    QVector<Avaliador>      m_avaliadores;
+    QVector<Ficha>          m_fichas;
+    QVector<VinculoProjeto> m_vinculos;
+    QVector<Nota>           m_notas;
+    QVector<Avaliacao>      m_avaliacoes;
+    QVector<ConflitoDeclarado> m_conflitos;
+
+    // Índices: chave -> posição no vetor
+    QHash<int, int>     m_idxProjetos;
+    QHash<int, int>     m_idxAvaliadoresId;
+    QHash<Cpf, int>     m_idxAvaliadoresCpf;
+    QHash<int, int>     m_idxFichas;
+    QHash<int, int>     m_idxNotas;
+    IndiceVinculos      m_idxVinculos;
+    QHash<QPair<int, Cpf>, int> m_idxNotaDoAvaliador; // (projeto, CPF) -> posição
+    IndiceTextoProjetos        m_idxTextoProjetos;
+    IndiceTrigramasAvaliadores m_idxTrigramasAvaliadores;
+    AgregadosNotas             m_agregados;
+    mutable IndiceConflitos    m_idxConflitos;
+    mutable bool               m_conflitosDesatualizados{true};
+
+    std::unique_ptr<Armazenamento> m_armazenamento;
+
+    int m_nextIdProjeto{1};
+    int m_nextIdAvaliador{1};
+    int m_nextIdFicha{1};
+    int m_nextIdNota{1};
+
+    // (projeto, CPF) de avaliações externas cuja nota ainda não foi lida
+    // do backend (ver mesclarAvaliacoesExternas)
+    static constexpr int EsperaNotasExternasMs      = 1000;
+    static constexpr int MaxTentativasNotasEsperadas = 5;
+    QSet<QPair<int, Cpf>> m_notasEsperadas;
+    int  m_tentativasNotasEsperadas{0};
+    bool m_recargaNotasAgendada{false};
+    void agendarRecargaNotasEsperadas();
+
+    int  m_cargasPendentes{0};
+    bool m_cargaOk{true};
+
+    void reindexarProjetos();
+    void reindexarAvaliadores();
+    void reindexarFichas();
+    void reindexarVinculos();
+    void reindexarNotas();
+    void atualizarContagemProjetos();
+    int  indiceNotaDoAvaliador(int idProjeto, const Cpf& cpf) const;
+    void conectarArmazenamento();
+    void concluirCarga(bool ok);
+
+    // Trocam a coleção em memória pela lida do backend
+    void substituirProjetos(QVector<Projeto>& lidos);
+    void substituirAvaliadores(QVector<Avaliador>& lidos);
+    void substituirFichas(QVector<Ficha>& lidas);
+    void substituirVinculos(QVector<VinculoProjeto>& lidos);
+    void substituirNotas(QVector<Nota>& lidas);
+    void substituirAvaliacoes(QVector<Avaliacao>& lidas);
+    void recarregarColecao(const QString& colecao);
+};
@@ -0,0 +1,28 @@
+// travaarquivo.cpp
+#include "travaarquivo.h"
+
+TravaArquivo::TravaArquivo(const QString& arquivo, int esperaMs)
+    : m_arquivo(arquivo)
+    , m_trava(arquivo + ".lock")
+{
+    m_trava.setStaleLockTime(ExpiraMs);
+    m_travada = m_trava.tryLock(esperaMs);
+}
+
+TravaArquivo::~TravaArquivo()
+{
+    if (m_travada)
+        m_trava.unlock();
+}
+
+QString TravaArquivo::descricaoErro() const
+{
+    switch (m_trava.error()) {
+    case QLockFile::LockFailedError:
+        return "'" + m_arquivo + "' está sendo gravado por outra estação. Tente novamente.";
+    case QLockFile::PermissionError:
+        return "Sem permissão para criar '" + m_arquivo + ".lock'.";
+    default:
+        return "Não foi possível travar '" + m_arquivo + "' para gravação.";
+    }
+}
@@ -0,0 +1,39 @@
+// travaarquivo.h
+#pragma once
+
+#include <QString>
+#include <QLockFile>
+
+// ===== Trava entre estações =====
+//
+// Várias estações gravam na mesma pasta compartilhada. Cada arquivo de dados
+// tem uma trava "<arquivo>.lock" (QLockFile) que só fica presa durante a
+// seção crítica curta de uma gravação: reler o disco, mesclar e gravar.
+//
+//   TravaArquivo trava(ArquivoProjetos);
+//   if (!trava.travada()) ...   // outra estação segurou além da espera
+//
+// A trava de uma estação que caiu expira depois de ExpiraMs (o QLockFile
+// não consegue conferir o processo dono em outra máquina).
+class TravaArquivo
+{
+public:
+    static constexpr int EsperaMs = 5000;
+    static constexpr int ExpiraMs = 30000;
+
+    explicit TravaArquivo(const QString& arquivo, int esperaMs = EsperaMs);
+    ~TravaArquivo();
+
+    TravaArquivo(const TravaArquivo&) = delete;
+    TravaArquivo& operator=(const TravaArquivo&) = delete;
+
+    bool travada() const { return m_travada; }
+
+    // Texto para mensagens quando travada() == false
+    QString descricaoErro() const;
+
+private:
+    QString   m_arquivo;
+    QLockFile m_trava;
+    bool      m_travada{false};
+};
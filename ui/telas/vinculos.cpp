@@ -1,53 +1,61 @@
 // vinculos.cpp
 #include "vinculos.h"
+#include "leitorcsv.h"
 
 #include <QFile>
+#include <QSaveFile>
 #include <QTextStream>
-#include <QRegularExpression>
 #include <QHash>
 
-static QString normalizarCpf(const QString& cpf) {
-    QString s = cpf;
-    s.remove(QRegularExpression("\\D")); // remove tudo que não é dígito
-    return s;
+#include <algorithm>
+
+QString normalizarCpf(const QString& cpf) {
+    return Cpf(cpf).digitos();
+}
+
+QString statusPorAvaliadores(int quantidade) {
+    if (quantidade == 0)
+        return "Cadastrado";
+    if (quantidade < MaxAvaliadoresPorProjeto)
+        return "Aguardando Avaliadores";
+    return "Pronto para Avaliação";
 }
 
 QVector<VinculoProjeto> carregarVinculos(const QString& arquivo) {
     QVector<VinculoProjeto> res;
+    lerVinculos(arquivo, res);
+    return res;
+}
 
-    QFile f(arquivo);
-    if (!f.exists())
-        return res; // sem vínculos ainda
-
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
-        return res;
+bool lerVinculos(const QString& arquivo, QVector<VinculoProjeto>& res) {
+    res.clear();
 
-    QTextStream in(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-    in.setCodec("UTF-8");
-#endif
+    if (!QFile::exists(arquivo))
+        return true; // sem vínculos ainda
 
-    while (!in.atEnd()) {
-        const QString line = in.readLine().trimmed();
-        if (line.isEmpty()) continue;
+    LeitorCsv csv(arquivo);
+    if (!csv.abrir())
+        return false;
 
-        const QStringList p = line.split(';');
-        if (p.size() < 2) continue;
+    while (csv.proximaLinha()) {
+        if (csv.linhaEmBranco()) continue;
+        if (csv.numCampos() < 2) continue;
 
         bool ok = false;
-        int idProj = p[0].toInt(&ok);
+        int idProj = csv[0].toInt(&ok);
         if (!ok) continue;
 
         VinculoProjeto v;
         v.idProjeto    = idProj;
-        v.cpfAvaliador = p[1].trimmed();
+        v.cpfAvaliador = csv[1].toStringTrimmed();
         res.push_back(v);
     }
-    return res;
+    return true;
 }
 
 bool salvarVinculos(const QString& arquivo, const QVector<VinculoProjeto>& lista) {
-    QFile f(arquivo);
+    // Temporário + fsync + rename: o arquivo antigo só some no commit()
+    QSaveFile f(arquivo);
     if (!f.open(QIODevice::WriteOnly | QIODevice::Text))
         return false;
 
@@ -59,36 +67,100 @@ bool salvarVinculos(const QString& arquivo, const QVector<VinculoProjeto>& lista
     for (const auto& v : lista) {
         out << v.idProjeto << ';' << v.cpfAvaliador << '\n';
     }
-    return true;
+    out.flush();
+    if (out.status() != QTextStream::Ok) {
+        f.cancelWriting();
+        return false;
+    }
+    return f.commit();
+}
+
+// erase-remove: uma passada só, em vez de removeAt() a cada vínculo
+void removerVinculosPorProjeto(QVector<VinculoProjeto>& lista, int idProjeto) {
+    lista.erase(std::remove_if(lista.begin(), lista.end(),
+                               [idProjeto](const VinculoProjeto& v) {
+                                   return v.idProjeto == idProjeto;
+                               }),
+                lista.end());
 }
 
-int contarProjetosDoAvaliador(const QVector<VinculoProjeto>& lista, const QString& cpf) {
-    const QString alvo = normalizarCpf(cpf);
-    if (alvo.isEmpty()) return 0;
+void removerVinculosPorAvaliador(QVector<VinculoProjeto>& lista, const QString& cpf) {
+    const Cpf alvo(cpf);
+    if (alvo.vazio()) return;
+
+    lista.erase(std::remove_if(lista.begin(), lista.end(),
+                               [&alvo](const VinculoProjeto& v) {
+                                   return v.cpf() == alvo;
+                               }),
+                lista.end());
+}
 
-    int count = 0;
-    for (const auto& v : lista) {
-        if (normalizarCpf(v.cpfAvaliador) == alvo)
-            ++count;
+// ================== ÍNDICE ==================
+
+void IndiceVinculos::reconstruir(const QVector<VinculoProjeto>& lista)
+{
+    m_avaliadoresPorProjeto.clear();
+    m_projetosPorAvaliador.clear();
+    for (const auto& v : lista)
+        acrescentar(v.idProjeto, v.cpfAvaliador);
+}
+
+void IndiceVinculos::acrescentar(int idProjeto, const QString& cpf)
+{
+    m_avaliadoresPorProjeto[idProjeto].append(cpf);
+
+    const Cpf chave(cpf);
+    if (chave.vazio() || idProjeto <= 0)
+        return;
+    QList<int>& projetos = m_projetosPorAvaliador[chave];
+    if (!projetos.contains(idProjeto))
+        projetos.append(idProjeto);
+}
+
+void IndiceVinculos::definirProjeto(int idProjeto, const QStringList& cpfs)
+{
+    removerProjeto(idProjeto);
+    for (const QString& cpf : cpfs)
+        acrescentar(idProjeto, cpf);
+}
+
+void IndiceVinculos::removerProjeto(int idProjeto)
+{
+    const QStringList cpfs = m_avaliadoresPorProjeto.take(idProjeto);
+    for (const QString& cpf : cpfs) {
+        const auto it = m_projetosPorAvaliador.find(Cpf(cpf));
+        if (it == m_projetosPorAvaliador.end())
+            continue;
+        it.value().removeAll(idProjeto);
+        if (it.value().isEmpty())
+            m_projetosPorAvaliador.erase(it);
     }
-    return count;
 }
 
-void removerVinculosPorProjeto(QVector<VinculoProjeto>& lista, int idProjeto) {
-    for (int i = lista.size() - 1; i >= 0; --i) {
-        if (lista[i].idProjeto == idProjeto) {
-            lista.removeAt(i);
-        }
+void IndiceVinculos::removerAvaliador(const Cpf& cpf)
+{
+    const QList<int> projetos = m_projetosPorAvaliador.take(cpf);
+    for (int idProjeto : projetos) {
+        const auto it = m_avaliadoresPorProjeto.find(idProjeto);
+        if (it == m_avaliadoresPorProjeto.end())
+            continue;
+        QStringList& cpfs = it.value();
+        cpfs.erase(std::remove_if(cpfs.begin(), cpfs.end(),
+                                  [&cpf](const QString& c) { return Cpf(c) == cpf; }),
+                   cpfs.end());
+        if (cpfs.isEmpty())
+            m_avaliadoresPorProjeto.erase(it);
     }
 }
 
-void removerVinculosPorAvaliador(QVector<VinculoProjeto>& lista, const QString& cpf) {
-    const QString alvo = normalizarCpf(cpf);
-    if (alvo.isEmpty()) return;
+int IndiceVinculos::contarProjetos(const Cpf& cpf) const
+{
+    const auto it = m_projetosPorAvaliador.constFind(cpf);
+    return it == m_projetosPorAvaliador.constEnd() ? 0 : it.value().size();
+}
 
-    for (int i = lista.size() - 1; i >= 0; --i) {
-        if (normalizarCpf(lista[i].cpfAvaliador) == alvo) {
-            lista.removeAt(i);
-        }
-    }
+bool IndiceVinculos::vinculado(int idProjeto, const Cpf& cpf) const
+{
+    const auto it = m_projetosPorAvaliador.constFind(cpf);
+    return it != m_projetosPorAvaliador.constEnd() && it.value().contains(idProjeto);
 }
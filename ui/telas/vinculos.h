@@ -2,24 +2,73 @@
 #pragma once
 #include <QString>
 #include <QVector>
+#include <QList>
+#include <QHash>
+#include <QStringList>
+
+#include "cpf.h"
 
 // Representa um vínculo "projeto X é avaliado pelo CPF Y"
 struct VinculoProjeto {
     int idProjeto{0};
     QString cpfAvaliador; // pode vir com ou sem máscara
+
+    Cpf cpf() const { return Cpf(cpfAvaliador); }
 };
 
+// Limite de avaliadores por projeto
+constexpr int MaxAvaliadoresPorProjeto = 3;
+
+// Status do projeto pela quantidade de avaliadores vinculados
+// ("Cadastrado", "Aguardando Avaliadores", "Pronto para Avaliação")
+QString statusPorAvaliadores(int quantidade);
+
+// CPF só com os 11 dígitos (Cpf::digitos()); vazio se não for um CPF
+QString normalizarCpf(const QString& cpf);
+
 // Carrega todos os vínculos do arquivo (um por linha: idProjeto;cpfAvaliador)
 QVector<VinculoProjeto> carregarVinculos(const QString& arquivo);
 
-// Salva a lista completa de vínculos no arquivo (sobrescreve)
-bool salvarVinculos(const QString& arquivo, const QVector<VinculoProjeto>& lista);
+// O mesmo, distinguindo arquivo ilegível (false) de arquivo vazio ou
+// inexistente (true, lista vazia): quem regrava o arquivo precisa saber
+bool lerVinculos(const QString& arquivo, QVector<VinculoProjeto>& vinculos);
 
-// Conta quantos projetos um avaliador (CPF) tem vinculados
-int contarProjetosDoAvaliador(const QVector<VinculoProjeto>& lista, const QString& cpf);
+// Salva a lista completa de vínculos no arquivo (sobrescreve de forma atômica)
+bool salvarVinculos(const QString& arquivo, const QVector<VinculoProjeto>& lista);
 
 // Remove todos os vínculos de um projeto específico
 void removerVinculosPorProjeto(QVector<VinculoProjeto>& lista, int idProjeto);
 
 // Remove todos os vínculos de um avaliador (por CPF)
 void removerVinculosPorAvaliador(QVector<VinculoProjeto>& lista, const QString& cpf);
+
+// ===== Índice de vínculos =====
+//
+// Os dois sentidos da relação, para não varrer a lista de vínculos:
+//
+//   projeto   -> CPFs vinculados (como foram gravados)
+//   avaliador -> projetos (sem repetição)
+//
+// As contagens são o tamanho da lista guardada. As alterações mexem só
+// nas entradas do projeto ou do avaliador afetado.
+class IndiceVinculos
+{
+public:
+    void reconstruir(const QVector<VinculoProjeto>& lista);
+
+    // Troca os avaliadores de um projeto
+    void definirProjeto(int idProjeto, const QStringList& cpfs);
+    void removerProjeto(int idProjeto);
+    void removerAvaliador(const Cpf& cpf);
+
+    QStringList avaliadoresDoProjeto(int idProjeto) const { return m_avaliadoresPorProjeto.value(idProjeto); }
+    QList<int>  projetosDoAvaliador(const Cpf& cpf) const  { return m_projetosPorAvaliador.value(cpf); }
+    int         contarProjetos(const Cpf& cpf) const;
+    bool        vinculado(int idProjeto, const Cpf& cpf) const;
+
+private:
+    QHash<int, QStringList> m_avaliadoresPorProjeto;
+    QHash<Cpf, QList<int>>  m_projetosPorAvaliador;
+
+    void acrescentar(int idProjeto, const QString& cpf);
+};